@@ -15,9 +15,9 @@ set CFLAGS=-std=c99 -O2 -lm
 
 echo Building main.exe ...
 gcc -o main.exe %CSRC%\main.c ^
-  %CSRC%\blocks\conv.c %CSRC%\blocks\c3.c %CSRC%\blocks\decode.c %CSRC%\blocks\detect.c %CSRC%\blocks\nms.c %CSRC%\blocks\sppf.c ^
-  %CSRC%\operations\bottleneck.c %CSRC%\operations\concat.c %CSRC%\operations\conv2d.c %CSRC%\operations\maxpool2d.c %CSRC%\operations\silu.c %CSRC%\operations\upsample.c ^
-  %CSRC%\utils\feature_pool.c %CSRC%\utils\image_loader.c %CSRC%\utils\weights_loader.c %CSRC%\utils\timing.c %CSRC%\utils\uart_dump.c ^
+  %CSRC%\blocks\conv.c %CSRC%\blocks\c3.c %CSRC%\blocks\decode.c %CSRC%\blocks\detect.c %CSRC%\blocks\nms.c %CSRC%\blocks\sppf.c %CSRC%\blocks\det_sort.c %CSRC%\blocks\yolov5n.c ^
+  %CSRC%\operations\bottleneck.c %CSRC%\operations\concat.c %CSRC%\operations\conv2d.c %CSRC%\operations\maxpool2d.c %CSRC%\operations\silu.c %CSRC%\operations\upsample.c %CSRC%\operations\halo.c %CSRC%\operations\conv2d_spm.c %CSRC%\operations\conv2d_q.c ^
+  %CSRC%\utils\feature_pool.c %CSRC%\utils\image_loader.c %CSRC%\utils\weights_loader.c %CSRC%\utils\timing.c %CSRC%\utils\uart_dump.c %CSRC%\utils\mem_plan.c %CSRC%\utils\pool_first_fit.c %CSRC%\utils\pool_tlsf.c %CSRC%\utils\letterbox.c %CSRC%\utils\weights_stream.c %CSRC%\utils\dma.c %CSRC%\utils\cache_sim.c ^
   %INC% %CFLAGS%
 if errorlevel 1 exit /b 1
 
@@ -2,31 +2,62 @@
 #include "../operations/conv2d.h"
 #include "../operations/silu.h"
 #include "../operations/bottleneck.h"
-#include "../operations/concat.h"
+#include "../operations/halo.h"
+#include "../operations/conv2d_q.h"
 #include "../utils/feature_pool.h"
 #include "../utils/timing.h"
+#include <stddef.h>
 #include <stdint.h>
 #ifdef BARE_METAL
 #include "xil_printf.h"
 #endif
 
+/* oc_scale != NULL: 출력 채널별 scale INT8 (cv1+cv2 합친 가중치).
+ * y_n_stride: y 이미지 간격 (0 = 연속) → concat 채널 구간에 배치 그대로 씀, SiLU도 그 구간만 */
 static void conv1x1(
     const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
-    const void* w_ptr, float w_scale, int w_is_int8, int32_t c_out, const float* bias,
-    float* y)
+    const void* w_ptr, float w_scale, int w_is_int8, const float* oc_scale, int32_t c_out, const float* bias,
+    float* y, int32_t y_halo, int32_t y_n_stride)
 {
-    if (w_is_int8) {
-        conv2d_nchw_f32_w8(x, n, c_in, h, w,
-                           (const int8_t*)w_ptr, w_scale, c_out, 1, 1,
-                           bias, 1, 1, 0, 0, 1,
-                           y, h, w);
+    const int32_t y_n = y_n_stride ? y_n_stride : c_out * HALO_PLANE(h, w, y_halo);
+#ifdef YOLO_FIXED_POINT
+    /* 정수 경로: Q int32 워드 버퍼, INT8 가중치 */
+    (void)w_is_int8;
+    if (oc_scale) {
+        conv2d_nchw_q_w8oc_halo((const int32_t*)x, 0, 0, n, c_in, h, w,
+                                (const int8_t*)w_ptr, oc_scale, c_out, 1, 1,
+                                bias, 1, 1, 0, 0,
+                                (int32_t*)y, y_halo, y_n_stride, h, w);
     } else {
-        conv2d_nchw_f32(x, n, c_in, h, w,
-                        (const float*)w_ptr, c_out, 1, 1,
-                        bias, 1, 1, 0, 0, 1,
-                        y, h, w);
+        conv2d_nchw_q_w8_halo((const int32_t*)x, 0, 0, n, c_in, h, w,
+                              (const int8_t*)w_ptr, w_scale, c_out, 1, 1,
+                              bias, 1, 1, 0, 0,
+                              (int32_t*)y, y_halo, y_n_stride, h, w);
     }
-    silu_nchw_f32(y, n, c_out, h, w, y);
+    int32_t* y_q = (int32_t*)y - (y_halo * HALO_PITCH(w, y_halo) + y_halo);
+    for (int32_t ni = 0; ni < n; ni++)
+        silu_nchw_q(y_q + ni * y_n, 1, c_out, h + 2 * y_halo, w + 2 * y_halo, y_q + ni * y_n);
+#else
+    if (oc_scale) {
+        conv2d_nchw_f32_w8oc_halo(x, 0, 0, n, c_in, h, w,
+                                  (const int8_t*)w_ptr, oc_scale, c_out, 1, 1,
+                                  bias, 1, 1, 0, 0,
+                                  y, y_halo, y_n_stride, h, w);
+    } else if (w_is_int8) {
+        conv2d_nchw_f32_w8_halo(x, 0, 0, n, c_in, h, w,
+                                (const int8_t*)w_ptr, w_scale, c_out, 1, 1,
+                                bias, 1, 1, 0, 0, 1,
+                                y, y_halo, y_n_stride, h, w);
+    } else {
+        conv2d_nchw_f32_halo(x, 0, 0, n, c_in, h, w,
+                             (const float*)w_ptr, c_out, 1, 1,
+                             bias, 1, 1, 0, 0, 1,
+                             y, y_halo, y_n_stride, h, w);
+    }
+    float* y_buf = y - (y_halo * HALO_PITCH(w, y_halo) + y_halo);
+    for (int32_t ni = 0; ni < n; ni++)
+        silu_nchw_f32(y_buf + ni * y_n, 1, c_out, h + 2 * y_halo, w + 2 * y_halo, y_buf + ni * y_n);
+#endif
 }
 
 void c3_nchw_f32(
@@ -40,63 +71,94 @@ void c3_nchw_f32(
     const void** bn_cv2_w, const float* bn_cv2_scale, const int* bn_cv2_is_int8,
     const float* const* bn_cv2_bias,
     int32_t shortcut,
-    float* y)
+    float* y, int32_t y_halo)
+{
+    c3_nchw_f32_merged(x, n, c_in, h, w,
+                       cv1_w, cv1_scale, cv1_is_int8, cv1_c_out, cv1_bias,
+                       cv2_w, cv2_scale, cv2_is_int8, cv2_c_out, cv2_bias,
+                       NULL, NULL, NULL,
+                       cv3_w, cv3_scale, cv3_is_int8, cv3_c_out, cv3_bias,
+                       n_bottleneck,
+                       bn_cv1_w, bn_cv1_scale, bn_cv1_is_int8, bn_cv1_bias,
+                       bn_cv2_w, bn_cv2_scale, bn_cv2_is_int8, bn_cv2_bias,
+                       shortcut, y, y_halo);
+}
+
+void c3_nchw_f32_merged(
+    const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
+    const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
+    const void* cv12_w, const float* cv12_scale, const float* cv12_bias,
+    const void* cv3_w, float cv3_scale, int cv3_is_int8, int32_t cv3_c_out, const float* cv3_bias,
+    int32_t n_bottleneck,
+    const void** bn_cv1_w, const float* bn_cv1_scale, const int* bn_cv1_is_int8,
+    const float* const* bn_cv1_bias,
+    const void** bn_cv2_w, const float* bn_cv2_scale, const int* bn_cv2_is_int8,
+    const float* const* bn_cv2_bias,
+    int32_t shortcut,
+    float* y, int32_t y_halo)
 {
-    size_t cv1_bytes = (size_t)n * (size_t)cv1_c_out * (size_t)h * (size_t)w * sizeof(float);
-    size_t cv2_bytes = (size_t)n * (size_t)cv2_c_out * (size_t)h * (size_t)w * sizeof(float);
-    size_t cat_bytes = (size_t)n * (size_t)(cv1_c_out + cv2_c_out) * (size_t)h * (size_t)w * sizeof(float);
+    /* concat_out 이미지마다 [cv1 | cv2] 채널 구간: cv1/cv2가 바로 concat 레이아웃으로 쓰고,
+     * bottleneck 마지막 출력이 cv1 구간을 덮어씀 → cv1_out/cv2_out 버퍼와 concat 복사 없음 */
+    const int32_t c12 = cv1_c_out + cv2_c_out;
+    const int32_t img = c12 * h * w;
+    size_t cat_bytes = (size_t)n * (size_t)img * sizeof(float);
+    size_t bn_bytes = (size_t)n * (size_t)cv1_c_out * (size_t)h * (size_t)w * sizeof(float);
 
     float* concat_out = (float*)feature_pool_alloc(cat_bytes);
-    float* cv1_out = (float*)feature_pool_alloc(cv1_bytes);
-    float* cv2_out = (float*)feature_pool_alloc(cv2_bytes);
-    float* bn_a = (float*)feature_pool_alloc(cv1_bytes);
-    float* bn_b = (float*)feature_pool_alloc(cv1_bytes);
+    float* bn_a = n_bottleneck > 1 ? (float*)feature_pool_alloc(bn_bytes) : NULL;
+    float* bn_b = n_bottleneck > 2 ? (float*)feature_pool_alloc(bn_bytes) : NULL;
 
-    if (!concat_out || !cv1_out || !cv2_out || !bn_a || !bn_b) {
+    if (!concat_out || (n_bottleneck > 1 && !bn_a) || (n_bottleneck > 2 && !bn_b)) {
 #ifdef BARE_METAL
-        xil_printf("C3 pool alloc failed cat=%08X cv1=%08X cv2=%08X bn_a=%08X bn_b=%08X\n",
-                   (unsigned)(uintptr_t)concat_out, (unsigned)(uintptr_t)cv1_out,
-                   (unsigned)(uintptr_t)cv2_out, (unsigned)(uintptr_t)bn_a,
-                   (unsigned)(uintptr_t)bn_b);
+        xil_printf("C3 pool alloc failed cat=%08X bn_a=%08X bn_b=%08X\n",
+                   (unsigned)(uintptr_t)concat_out, (unsigned)(uintptr_t)bn_a, (unsigned)(uintptr_t)bn_b);
 #endif
         if (bn_b) feature_pool_free(bn_b);
         if (bn_a) feature_pool_free(bn_a);
-        if (cv2_out) feature_pool_free(cv2_out);
-        if (cv1_out) feature_pool_free(cv1_out);
         if (concat_out) feature_pool_free(concat_out);
         return;
     }
-    
-    yolo_timing_begin("cv1");
-    conv1x1(x, n, c_in, h, w, cv1_w, cv1_scale, cv1_is_int8, cv1_c_out, cv1_bias, cv1_out);
-    yolo_timing_end();
-    yolo_timing_begin("cv2");
-    conv1x1(x, n, c_in, h, w, cv2_w, cv2_scale, cv2_is_int8, cv2_c_out, cv2_bias, cv2_out);
-    yolo_timing_end();
+
+    if (cv12_w) {
+        /* 합친 1x1 한 번: 입력을 한 번만 읽음 */
+        yolo_timing_begin("cv1+cv2");
+        conv1x1(x, n, c_in, h, w, cv12_w, 0.0f, cv12_scale != NULL, cv12_scale, c12, cv12_bias, concat_out, 0, 0);
+        yolo_timing_end();
+    } else {
+        /* 따로: 각 conv가 배치 그대로 이미지 간격 img로 자기 구간에 씀 */
+        yolo_timing_begin("cv1");
+        conv1x1(x, n, c_in, h, w, cv1_w, cv1_scale, cv1_is_int8, NULL, cv1_c_out, cv1_bias,
+                concat_out, 0, img);
+        yolo_timing_end();
+        yolo_timing_begin("cv2");
+        conv1x1(x, n, c_in, h, w, cv2_w, cv2_scale, cv2_is_int8, NULL, cv2_c_out, cv2_bias,
+                concat_out + cv1_c_out * h * w, 0, img);
+        yolo_timing_end();
+    }
+    /* 첫 bottleneck은 concat 안 cv1 구간을 읽고 마지막은 그 구간에 씀 (이미지 간격 c12 채널, nb == 1이면 제자리) */
     yolo_timing_begin("bottleneck");
-    const float* bn_in = cv1_out;
-    float* bn_out = bn_a;
+    const float* bn_in = concat_out;
+    int32_t in_stride = img;
     for (int32_t i = 0; i < n_bottleneck; i++) {
-        bn_out = (i % 2 == 0) ? bn_a : bn_b;
-        bottleneck_nchw_f32(
-            bn_in, n, cv1_c_out, h, w,
+        const int32_t last = i == n_bottleneck - 1;
+        float* bn_out = last ? concat_out : (i % 2 == 0) ? bn_a : bn_b;
+        const int32_t out_stride = last ? img : cv1_c_out * h * w;
+        bottleneck_nchw_f32_strided(
+            bn_in, in_stride, n, cv1_c_out, h, w,
             bn_cv1_w[i], bn_cv1_scale[i], bn_cv1_is_int8[i], cv1_c_out, bn_cv1_bias[i],
             bn_cv2_w[i], bn_cv2_scale[i], bn_cv2_is_int8[i], cv1_c_out, bn_cv2_bias[i],
             shortcut,
-            bn_out);
+            bn_out, out_stride);
         bn_in = bn_out;
+        in_stride = out_stride;
     }
     yolo_timing_end();
-    yolo_timing_begin("concat");
-    concat_nchw_f32(bn_out, cv1_c_out, cv2_out, cv2_c_out, n, h, w, concat_out);
-    yolo_timing_end();
     yolo_timing_begin("cv3");
-    conv1x1(concat_out, n, cv1_c_out + cv2_c_out, h, w, cv3_w, cv3_scale, cv3_is_int8, cv3_c_out, cv3_bias, y);
+    conv1x1(concat_out, n, c12, h, w, cv3_w, cv3_scale, cv3_is_int8, NULL, cv3_c_out, cv3_bias, y, y_halo, 0);
     yolo_timing_end();
 
+    if (bn_b) feature_pool_free(bn_b);
+    if (bn_a) feature_pool_free(bn_a);
     feature_pool_free(concat_out);
-    feature_pool_free(bn_b);
-    feature_pool_free(bn_a);
-    feature_pool_free(cv2_out);
-    feature_pool_free(cv1_out);
 }
@@ -15,6 +15,23 @@ void c3_nchw_f32(
     const void** bn_cv2_w, const float* bn_cv2_scale, const int* bn_cv2_is_int8,
     const float* const* bn_cv2_bias,
     int32_t shortcut,  // 1=add residual in bottleneck, 0=no shortcut
-    float* y);
+    float* y, int32_t y_halo);  // y_halo > 0: y는 halo 레이아웃 내부 포인터 (테두리는 호출자가 0으로)
+
+/* cv1+cv2를 입력 한 번 읽는 1x1 하나로 (cv12_*: 출력 채널 [cv1 | cv2] 순서로 합친 가중치/bias,
+ * cv12_scale은 INT8일 때 출력 채널별 scale, FP32는 NULL). cv12_w == NULL이면 cv1/cv2 따로 (c3_nchw_f32와 같음).
+ * 결과는 c3_nchw_f32와 비트 동일 */
+void c3_nchw_f32_merged(
+    const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
+    const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
+    const void* cv12_w, const float* cv12_scale, const float* cv12_bias,
+    const void* cv3_w, float cv3_scale, int cv3_is_int8, int32_t cv3_c_out, const float* cv3_bias,
+    int32_t n_bottleneck,
+    const void** bn_cv1_w, const float* bn_cv1_scale, const int* bn_cv1_is_int8,
+    const float* const* bn_cv1_bias,
+    const void** bn_cv2_w, const float* bn_cv2_scale, const int* bn_cv2_is_int8,
+    const float* const* bn_cv2_bias,
+    int32_t shortcut,
+    float* y, int32_t y_halo);
 
 #endif // C3_H
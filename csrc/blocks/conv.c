@@ -1,6 +1,8 @@
 #include "conv.h"
 #include "../operations/conv2d.h"
 #include "../operations/silu.h"
+#include "../operations/halo.h"
+#include "../operations/conv2d_q.h"
 #include "../utils/timing.h"
 
 void conv_block_nchw_f32(
@@ -11,21 +13,89 @@ void conv_block_nchw_f32(
     int32_t pad_h, int32_t pad_w,
     const float* bias,
     float* y, int32_t h_out, int32_t w_out)
+{
+    conv_block_nchw_f32_halo(x, 0, n, c_in, h_in, w_in, w, w_scale, w_is_int8, c_out, k_h, k_w,
+                             stride_h, stride_w, pad_h, pad_w, bias, y, 0, h_out, w_out);
+}
+
+void conv_block_nchw_f32_halo(
+    const float* x, int32_t x_halo, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float w_scale, int w_is_int8,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const float* bias,
+    float* y, int32_t y_halo, int32_t h_out, int32_t w_out)
 {
     yolo_timing_begin("conv2d");
+#ifdef YOLO_FIXED_POINT
+    /* 정수 경로: x/y 버퍼는 Q int32 워드, 가중치 INT8 (ctx_bind에서 확인) */
+    (void)w_is_int8;
+    if (w)
+        conv2d_nchw_q_w8_halo((const int32_t*)x, x_halo, 0, n, c_in, h_in, w_in,
+                              (const int8_t*)w, w_scale, c_out, k_h, k_w,
+                              bias, stride_h, stride_w, pad_h, pad_w,
+                              (int32_t*)y, y_halo, 0, h_out, w_out);
+    yolo_timing_end();
+    yolo_timing_begin("silu");
+    int32_t* y_q = (int32_t*)y - (y_halo * HALO_PITCH(w_out, y_halo) + y_halo);
+    silu_nchw_q(y_q, n, c_out, h_out + 2 * y_halo, w_out + 2 * y_halo, y_q);
+    yolo_timing_end();
+#else
     if (w_is_int8 && w) {
-        conv2d_nchw_f32_w8(x, n, c_in, h_in, w_in,
-                           (const int8_t*)w, w_scale, c_out, k_h, k_w,
-                           bias, stride_h, stride_w, pad_h, pad_w, 1,
-                           y, h_out, w_out);
+        conv2d_nchw_f32_w8_halo(x, x_halo, 0, n, c_in, h_in, w_in,
+                                (const int8_t*)w, w_scale, c_out, k_h, k_w,
+                                bias, stride_h, stride_w, pad_h, pad_w, 1,
+                                y, y_halo, 0, h_out, w_out);
     } else if (w) {
-        conv2d_nchw_f32(x, n, c_in, h_in, w_in,
-                        (const float*)w, c_out, k_h, k_w,
-                        bias, stride_h, stride_w, pad_h, pad_w, 1,
-                        y, h_out, w_out);
+        conv2d_nchw_f32_halo(x, x_halo, 0, n, c_in, h_in, w_in,
+                             (const float*)w, c_out, k_h, k_w,
+                             bias, stride_h, stride_w, pad_h, pad_w, 1,
+                             y, y_halo, 0, h_out, w_out);
     }
     yolo_timing_end();
     yolo_timing_begin("silu");
-    silu_nchw_f32(y, n, c_out, h_out, w_out, y);
+    /* halo 포함 전체 plane에 적용: 테두리 0은 SiLU 후에도 0 */
+    float* y_buf = y - (y_halo * HALO_PITCH(w_out, y_halo) + y_halo);
+    silu_nchw_f32(y_buf, n, c_out, h_out + 2 * y_halo, w_out + 2 * y_halo, y_buf);
+    yolo_timing_end();
+#endif
+}
+
+void conv_block_u8_f32_halo(
+    const uint8_t* x, int32_t x_c_stride, int32_t x_h_stride, int32_t x_w_stride,
+    int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w_t, int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const float* bias,
+    float* y, int32_t y_halo, int32_t h_out, int32_t w_out)
+{
+    yolo_timing_begin("conv2d");
+    conv2d_u8_f32_halo(x, x_c_stride, x_h_stride, x_w_stride, c_in, h_in, w_in, w_t, c_out, k_h, k_w,
+                       bias, stride_h, stride_w, pad_h, pad_w, y, y_halo, h_out, w_out);
+    yolo_timing_end();
+    yolo_timing_begin("silu");
+    float* y_buf = y - (y_halo * HALO_PITCH(w_out, y_halo) + y_halo);
+    silu_nchw_f32(y_buf, 1, c_out, h_out + 2 * y_halo, w_out + 2 * y_halo, y_buf);
+    yolo_timing_end();
+}
+
+void conv_block_image_q_halo(
+    const uint8_t* x_u8, const float* x_f32, int32_t x_c_stride, int32_t x_h_stride, int32_t x_w_stride,
+    int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float w_scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const float* bias,
+    int32_t* y, int32_t y_halo, int32_t h_out, int32_t w_out)
+{
+    yolo_timing_begin("conv2d");
+    conv2d_image_q_w8_halo(x_u8, x_f32, x_c_stride, x_h_stride, x_w_stride, c_in, h_in, w_in, w, w_scale,
+                           c_out, k_h, k_w, bias, stride_h, stride_w, pad_h, pad_w, y, y_halo, h_out, w_out);
+    yolo_timing_end();
+    yolo_timing_begin("silu");
+    int32_t* y_buf = y - (y_halo * HALO_PITCH(w_out, y_halo) + y_halo);
+    silu_nchw_q(y_buf, 1, c_out, h_out + 2 * y_halo, w_out + 2 * y_halo, y_buf);
     yolo_timing_end();
 }
@@ -13,4 +13,35 @@ void conv_block_nchw_f32(
     const float* bias,
     float* y, int32_t h_out, int32_t w_out);
 
+/* Halo 레이아웃 입출력 (operations/halo.h). x/y는 내부 포인터, y 테두리는 0으로 유지됨 (SiLU(0)=0) */
+void conv_block_nchw_f32_halo(
+    const float* x, int32_t x_halo, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float w_scale, int w_is_int8,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const float* bias,
+    float* y, int32_t y_halo, int32_t h_out, int32_t w_out);
+
+/* uint8 이미지 입력 (stem): w_t는 conv2d_fold_u8_weights로 /255를 접은 가중치. 입력 stride는 conv2d_u8_f32_halo와 같음 */
+void conv_block_u8_f32_halo(
+    const uint8_t* x, int32_t x_c_stride, int32_t x_h_stride, int32_t x_w_stride,
+    int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w_t, int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const float* bias,
+    float* y, int32_t y_halo, int32_t h_out, int32_t w_out);
+
+/* 정수 경로 stem (-DYOLO_FIXED_POINT): 이미지 1장 (x_u8 또는 x_f32, 입력 stride는 위와 같음) → Q int32 출력.
+ * 가중치는 INT8 원본 (OIHW) + scale */
+void conv_block_image_q_halo(
+    const uint8_t* x_u8, const float* x_f32, int32_t x_c_stride, int32_t x_h_stride, int32_t x_w_stride,
+    int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float w_scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    const float* bias,
+    int32_t* y, int32_t y_halo, int32_t h_out, int32_t w_out);
+
 #endif // CONV_H
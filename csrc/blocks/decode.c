@@ -1,5 +1,6 @@
 #include "decode.h"
 #include "../utils/timing.h"
+#include "../operations/silu.h"
 #include <math.h>
 #include <stdlib.h>
 
@@ -18,6 +19,22 @@ int32_t decode_nchw_f32(
     const float anchors[3][6],
     detection_t* detections,
     int32_t max_detections)
+{
+    return decode_nchw_f32_hw(p3, p3_h, p3_w, p4, p4_h, p4_w, p5, p5_h, p5_w, num_classes, conf_threshold,
+                              input_size, input_size, strides, anchors, detections, max_detections);
+}
+
+int32_t decode_nchw_f32_hw(
+    const float* p3, int32_t p3_h, int32_t p3_w,
+    const float* p4, int32_t p4_h, int32_t p4_w,
+    const float* p5, int32_t p5_h, int32_t p5_w,
+    int32_t num_classes,
+    float conf_threshold,
+    int32_t input_h, int32_t input_w,
+    const float strides[3],
+    const float anchors[3][6],
+    detection_t* detections,
+    int32_t max_detections)
 {
     yolo_timing_begin("decode");
     int32_t count = 0;
@@ -77,10 +94,10 @@ int32_t decode_nchw_f32(
                     float ww = (tw * 2.0f) * (tw * 2.0f) * aw;
                     float hh = (th * 2.0f) * (th * 2.0f) * ah;
 
-                    detections[count].x = cx / (float)input_size;
-                    detections[count].y = cy / (float)input_size;
-                    detections[count].w = ww / (float)input_size;
-                    detections[count].h = hh / (float)input_size;
+                    detections[count].x = cx / (float)input_w;
+                    detections[count].y = cy / (float)input_h;
+                    detections[count].w = ww / (float)input_w;
+                    detections[count].h = hh / (float)input_h;
                     detections[count].conf = conf;
                     detections[count].cls_id = max_cls_id;
                     count++;
@@ -92,3 +109,91 @@ done:
     yolo_timing_end();
     return count;
 }
+
+int32_t decode_nchw_q_hw(
+    const int32_t* p3, int32_t p3_h, int32_t p3_w,
+    const int32_t* p4, int32_t p4_h, int32_t p4_w,
+    const int32_t* p5, int32_t p5_h, int32_t p5_w,
+    int32_t num_classes,
+    int32_t conf_threshold_q15,
+    const int32_t strides[3],
+    const int32_t anchors[3][6],
+    detection_q_t* detections,
+    int32_t max_detections)
+{
+    yolo_timing_begin("decode");
+    int32_t count = 0;
+    const int32_t no = 5 + num_classes;
+    const int32_t sh = 15 - DET_Q_FRAC;   /* Q15 픽셀 → DET_Q_FRAC */
+
+    for (int scale = 0; scale < 3; scale++) {
+        const int32_t* feat = scale == 0 ? p3 : scale == 1 ? p4 : p5;
+        const int32_t gh = scale == 0 ? p3_h : scale == 1 ? p4_h : p5_h;
+        const int32_t gw = scale == 0 ? p3_w : scale == 1 ? p4_w : p5_w;
+        const int32_t stride = strides[scale];
+        const int32_t* anc = anchors[scale];
+        if (!feat) continue;
+
+        const int32_t gsize = gh * gw;
+
+        for (int32_t y = 0; y < gh; y++) {
+            for (int32_t x = 0; x < gw; x++) {
+                const int32_t spatial = y * gw + x;
+
+                for (int a = 0; a < 3; a++) {
+                    const int32_t* f = feat + (a * no) * gsize + spatial;
+
+                    /* 클래스: 로짓 최대 (첫 번째 우선) → sigmoid 한 번 */
+                    int32_t max_logit = f[5 * gsize];
+                    int32_t max_cls_id = 0;
+                    for (int32_t c = 1; c < num_classes; c++) {
+                        const int32_t v = f[(5 + c) * gsize];
+                        if (v > max_logit) { max_logit = v; max_cls_id = c; }
+                    }
+                    const int32_t conf = (sigmoid_q15(f[4 * gsize]) * sigmoid_q15(max_logit)) >> 15;
+                    if (conf < conf_threshold_q15) continue;
+                    if (count >= max_detections) goto done;
+
+                    const int32_t tx = sigmoid_q15(f[0]);
+                    const int32_t ty = sigmoid_q15(f[gsize]);
+                    const int32_t tw2 = 2 * sigmoid_q15(f[2 * gsize]);
+                    const int32_t th2 = 2 * sigmoid_q15(f[3 * gsize]);
+
+                    /* (2t + grid - 0.5) × stride, Q15 픽셀 */
+                    const int32_t cx = (2 * tx + (x << 15) - (1 << 14)) * stride;
+                    const int32_t cy = (2 * ty + (y << 15) - (1 << 14)) * stride;
+                    /* (2t)^2 × anchor, Q15 픽셀 */
+                    const int64_t ww = (((int64_t)tw2 * tw2) >> 15) * anc[a * 2 + 0];
+                    const int64_t hh = (((int64_t)th2 * th2) >> 15) * anc[a * 2 + 1];
+
+                    detection_q_t* d = &detections[count];
+                    d->x = (cx + (1 << (sh - 1))) >> sh;
+                    d->y = (cy + (1 << (sh - 1))) >> sh;
+                    d->w = (int32_t)((ww + (1 << (sh - 1))) >> sh);
+                    d->h = (int32_t)((hh + (1 << (sh - 1))) >> sh);
+                    d->conf = conf;
+                    d->cls_id = max_cls_id;
+                    count++;
+                }
+            }
+        }
+    }
+done:
+    yolo_timing_end();
+    return count;
+}
+
+void detection_q_to_f32(const detection_q_t* in, int32_t count, int32_t input_h, int32_t input_w,
+                        detection_t* out)
+{
+    const float sx = 1.0f / (float)(input_w << DET_Q_FRAC);
+    const float sy = 1.0f / (float)(input_h << DET_Q_FRAC);
+    for (int32_t i = 0; i < count; i++) {
+        out[i].x = (float)in[i].x * sx;
+        out[i].y = (float)in[i].y * sy;
+        out[i].w = (float)in[i].w * sx;
+        out[i].h = (float)in[i].h * sy;
+        out[i].conf = (float)in[i].conf * (1.0f / 32768.0f);
+        out[i].cls_id = in[i].cls_id;
+    }
+}
@@ -26,7 +26,7 @@ typedef struct YOLO_PACKED {
 /**
  * Classic YOLOv5n Anchor-based Decode
  *
- * 입력: (1, 255, H, W) x 3 scale. 255 = 3 * 85 (x,y,w,h,obj, cls0..79).
+ * 입력: (1, 255, H, W) x 3 scale. H, W는 scale마다 독립 (직사각형 입력 가능). 255 = 3 * 85 (x,y,w,h,obj, cls0..79).
  * Layout: [anchor0_85, anchor1_85, anchor2_85] (channel-major).
  *
  * conf = obj_conf * max_cls_conf.
@@ -46,4 +46,44 @@ int32_t decode_nchw_f32(
     detection_t* detections,
     int32_t max_detections);
 
+/* 직사각형 입력 (input_h x input_w): x/w는 input_w, y/h는 input_h로 normalize */
+int32_t decode_nchw_f32_hw(
+    const float* p3, int32_t p3_h, int32_t p3_w,
+    const float* p4, int32_t p4_h, int32_t p4_w,
+    const float* p5, int32_t p5_h, int32_t p5_w,
+    int32_t num_classes,
+    float conf_threshold,
+    int32_t input_h, int32_t input_w,
+    const float strides[3],
+    const float anchors[3][6],
+    detection_t* detections,
+    int32_t max_detections);
+
+/* ===== 정수 경로 (-DYOLO_FIXED_POINT) =====
+ * 입력은 Q(YOLO_Q_FRAC) int32 로짓 (operations/qformat.h), sigmoid는 Q15 표 (sigmoid_q15).
+ * 클래스는 로짓 argmax (sigmoid 단조 → 같은 클래스), conf = obj × cls (Q15).
+ * 박스는 픽셀 × 2^DET_Q_FRAC 중심/크기: stride·anchor 정수, 곱·시프트만 (부동소수 연산 없음). */
+#define DET_Q_FRAC 8
+
+typedef struct {
+    int32_t x, y, w, h;   /* 중심 및 크기 (픽셀 × 2^DET_Q_FRAC) */
+    int32_t conf;         /* Q15 */
+    int32_t cls_id;
+} detection_q_t;
+
+int32_t decode_nchw_q_hw(
+    const int32_t* p3, int32_t p3_h, int32_t p3_w,
+    const int32_t* p4, int32_t p4_h, int32_t p4_w,
+    const int32_t* p5, int32_t p5_h, int32_t p5_w,
+    int32_t num_classes,
+    int32_t conf_threshold_q15,
+    const int32_t strides[3],
+    const int32_t anchors[3][6],  /* 픽셀 (decode_nchw_f32의 anchors와 같은 값) */
+    detection_q_t* detections,
+    int32_t max_detections);
+
+/* 정수 박스 → detection_t (normalized). API 출력 경계에서 NMS 결과에만 */
+void detection_q_to_f32(const detection_q_t* in, int32_t count, int32_t input_h, int32_t input_w,
+                        detection_t* out);
+
 #endif /* DECODE_H */
@@ -0,0 +1,198 @@
+#include "det_sort.h"
+
+/* 이 크기 이하 구간은 삽입정렬 (퀵정렬 재귀/분할 오버헤드보다 빠름) */
+#define DET_SORT_INSERTION_MAX 16
+
+/* a가 b보다 앞에 와야 하면 1: conf 내림차순, 동점은 cls_id → x → y 오름차순 */
+static inline int det_before(const detection_t* a, const detection_t* b) {
+    if (a->conf != b->conf) return a->conf > b->conf;
+    if (a->cls_id != b->cls_id) return a->cls_id < b->cls_id;
+    if (a->x != b->x) return a->x < b->x;
+    return a->y < b->y;
+}
+
+static inline void det_swap(detection_t* a, detection_t* b) {
+    detection_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static void insertion_sort(detection_t* d, int32_t lo, int32_t hi) {
+    for (int32_t i = lo + 1; i <= hi; i++) {
+        detection_t v = d[i];
+        int32_t j = i - 1;
+        while (j >= lo && det_before(&v, &d[j])) {
+            d[j + 1] = d[j];
+            j--;
+        }
+        d[j + 1] = v;
+    }
+}
+
+/* 힙정렬: 깊이 제한 초과 시 폴백. "앞에 올 것"이 루트에서 가장 늦게 나오도록 min-heap(역순) 사용 */
+static void sift_down(detection_t* d, int32_t root, int32_t n) {
+    for (;;) {
+        int32_t child = 2 * root + 1;
+        if (child >= n) break;
+        if (child + 1 < n && det_before(&d[child + 1], &d[child])) child++;
+        if (!det_before(&d[child], &d[root])) break;
+        det_swap(&d[root], &d[child]);
+        root = child;
+    }
+}
+
+static void heap_sort(detection_t* d, int32_t n) {
+    for (int32_t i = n / 2 - 1; i >= 0; i--) sift_down(d, i, n);
+    for (int32_t end = n - 1; end > 0; end--) {
+        det_swap(&d[0], &d[end]);
+        sift_down(d, 0, end);
+    }
+    /* min-heap 추출 결과는 "뒤에 올 것"부터 앞에 쌓였으므로 뒤집기 */
+    for (int32_t i = 0, j = n - 1; i < j; i++, j--) det_swap(&d[i], &d[j]);
+}
+
+/* median-of-3 → pivot을 d[hi-1]에 두고 Hoare 분할. 반환: pivot 최종 위치 */
+static int32_t partition(detection_t* d, int32_t lo, int32_t hi) {
+    int32_t mid = lo + (hi - lo) / 2;
+    if (det_before(&d[mid], &d[lo])) det_swap(&d[mid], &d[lo]);
+    if (det_before(&d[hi], &d[lo])) det_swap(&d[hi], &d[lo]);
+    if (det_before(&d[hi], &d[mid])) det_swap(&d[hi], &d[mid]);
+    det_swap(&d[mid], &d[hi - 1]);
+    const detection_t pivot = d[hi - 1];
+
+    int32_t i = lo, j = hi - 1;
+    for (;;) {
+        while (det_before(&d[++i], &pivot)) {}
+        while (det_before(&pivot, &d[--j])) {}
+        if (i >= j) break;
+        det_swap(&d[i], &d[j]);
+    }
+    det_swap(&d[i], &d[hi - 1]);
+    return i;
+}
+
+static void intro_sort(detection_t* d, int32_t lo, int32_t hi, int depth) {
+    /* 작은 쪽만 재귀, 큰 쪽은 루프 → 스택 깊이 O(log n) */
+    while (hi - lo + 1 > DET_SORT_INSERTION_MAX) {
+        if (depth-- == 0) {
+            heap_sort(d + lo, hi - lo + 1);
+            return;
+        }
+        int32_t p = partition(d, lo, hi);
+        if (p - lo < hi - p) {
+            intro_sort(d, lo, p - 1, depth);
+            lo = p + 1;
+        } else {
+            intro_sort(d, p + 1, hi, depth);
+            hi = p - 1;
+        }
+    }
+    insertion_sort(d, lo, hi);
+}
+
+void det_sort_by_conf(detection_t* dets, int32_t num) {
+    if (!dets || num < 2) return;
+    int depth = 0;
+    for (int32_t m = num; m > 1; m >>= 1) depth += 2;  /* 2*floor(log2 n) */
+    intro_sort(dets, 0, num - 1, depth);
+}
+
+int det_is_sorted_by_conf(const detection_t* dets, int32_t num) {
+    if (!dets) return 1;
+    for (int32_t i = 1; i < num; i++) {
+        if (dets[i - 1].conf < dets[i].conf) return 0;
+    }
+    return 1;
+}
+
+/* ===== 정수 detection (-DYOLO_FIXED_POINT): 같은 introsort, 키 = Q15 conf ===== */
+
+/* det_before와 같은 순서: conf 내림차순, 동점은 cls_id → x → y 오름차순 */
+static inline int det_q_before(const detection_q_t* a, const detection_q_t* b) {
+    if (a->conf != b->conf) return a->conf > b->conf;
+    if (a->cls_id != b->cls_id) return a->cls_id < b->cls_id;
+    if (a->x != b->x) return a->x < b->x;
+    return a->y < b->y;
+}
+
+static inline void det_q_swap(detection_q_t* a, detection_q_t* b) {
+    detection_q_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static void insertion_sort_q(detection_q_t* d, int32_t lo, int32_t hi) {
+    for (int32_t i = lo + 1; i <= hi; i++) {
+        detection_q_t v = d[i];
+        int32_t j = i - 1;
+        while (j >= lo && det_q_before(&v, &d[j])) {
+            d[j + 1] = d[j];
+            j--;
+        }
+        d[j + 1] = v;
+    }
+}
+
+static void sift_down_q(detection_q_t* d, int32_t root, int32_t n) {
+    for (;;) {
+        int32_t child = 2 * root + 1;
+        if (child >= n) break;
+        if (child + 1 < n && det_q_before(&d[child + 1], &d[child])) child++;
+        if (!det_q_before(&d[child], &d[root])) break;
+        det_q_swap(&d[root], &d[child]);
+        root = child;
+    }
+}
+
+static void heap_sort_q(detection_q_t* d, int32_t n) {
+    for (int32_t i = n / 2 - 1; i >= 0; i--) sift_down_q(d, i, n);
+    for (int32_t end = n - 1; end > 0; end--) {
+        det_q_swap(&d[0], &d[end]);
+        sift_down_q(d, 0, end);
+    }
+    for (int32_t i = 0, j = n - 1; i < j; i++, j--) det_q_swap(&d[i], &d[j]);
+}
+
+static int32_t partition_q(detection_q_t* d, int32_t lo, int32_t hi) {
+    int32_t mid = lo + (hi - lo) / 2;
+    if (det_q_before(&d[mid], &d[lo])) det_q_swap(&d[mid], &d[lo]);
+    if (det_q_before(&d[hi], &d[lo])) det_q_swap(&d[hi], &d[lo]);
+    if (det_q_before(&d[hi], &d[mid])) det_q_swap(&d[hi], &d[mid]);
+    det_q_swap(&d[mid], &d[hi - 1]);
+    const detection_q_t pivot = d[hi - 1];
+
+    int32_t i = lo, j = hi - 1;
+    for (;;) {
+        while (det_q_before(&d[++i], &pivot)) {}
+        while (det_q_before(&pivot, &d[--j])) {}
+        if (i >= j) break;
+        det_q_swap(&d[i], &d[j]);
+    }
+    det_q_swap(&d[i], &d[hi - 1]);
+    return i;
+}
+
+static void intro_sort_q(detection_q_t* d, int32_t lo, int32_t hi, int depth) {
+    while (hi - lo + 1 > DET_SORT_INSERTION_MAX) {
+        if (depth-- == 0) {
+            heap_sort_q(d + lo, hi - lo + 1);
+            return;
+        }
+        int32_t p = partition_q(d, lo, hi);
+        if (p - lo < hi - p) {
+            intro_sort_q(d, lo, p - 1, depth);
+            lo = p + 1;
+        } else {
+            intro_sort_q(d, p + 1, hi, depth);
+            hi = p - 1;
+        }
+    }
+    insertion_sort_q(d, lo, hi);
+}
+
+void det_sort_q_by_conf(detection_q_t* dets, int32_t num) {
+    if (!dets || num < 2) return;
+    int depth = 0;
+    for (int32_t m = num; m > 1; m >>= 1) depth += 2;
+    intro_sort_q(dets, 0, num - 1, depth);
+}
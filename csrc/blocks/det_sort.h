@@ -0,0 +1,23 @@
+#ifndef DET_SORT_H
+#define DET_SORT_H
+
+#include <stdint.h>
+#include "decode.h"
+
+/**
+ * detection 정렬 (confidence 내림차순, NMS 전처리)
+ *
+ * Introsort: median-of-3 퀵정렬 + 깊이 초과 시 힙정렬 + 작은 구간 삽입정렬.
+ * In-place, 동적 할당 없음 → O(n log n) 최악 보장 (bare-metal 포함).
+ * 동점 conf는 cls_id, x, y 오름차순으로 정렬 → 입력 순서와 무관하게 결과 결정적.
+ */
+void det_sort_by_conf(detection_t* dets, int32_t num);
+
+/** 이미 내림차순이면 1 (O(n) 검사, nms()에서 불필요한 정렬 생략용) */
+int det_is_sorted_by_conf(const detection_t* dets, int32_t num);
+
+/** 정수 detection (Q15 conf) 정렬: det_sort_by_conf와 같은 introsort·같은 동점 순서 (cls_id, x, y).
+ *  Q15로 양자화하면 conf 동점이 흔해지므로 동점 순서가 FP32 경로와 같아야 NMS 결과가 같음 */
+void det_sort_q_by_conf(detection_q_t* dets, int32_t num);
+
+#endif /* DET_SORT_H */
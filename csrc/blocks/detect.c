@@ -1,8 +1,10 @@
 #include "detect.h"
 #include "../operations/conv2d.h"
+#include "../operations/conv2d_q.h"
 #include "../utils/timing.h"
 
 void detect_nchw_f32(
+    int32_t n,
     const float* p3, int32_t p3_c, int32_t p3_h, int32_t p3_w,
     const float* p4, int32_t p4_c, int32_t p4_h, int32_t p4_w,
     const float* p5, int32_t p5_c, int32_t p5_h, int32_t p5_w,
@@ -11,33 +13,48 @@ void detect_nchw_f32(
     const void* m2_w, float m2_scale, int m2_is_int8, const float* m2_b,
     float* p3_out, float* p4_out, float* p5_out)
 {
-    yolo_timing_begin("detect");
-    if (m0_is_int8) {
-        conv2d_nchw_f32_w8(p3, 1, p3_c, p3_h, p3_w,
-            (const int8_t*)m0_w, m0_scale, 255, 1, 1, m0_b, 1, 1, 0, 0, 1,
-            p3_out, p3_h, p3_w);
-    } else {
-        conv2d_nchw_f32(p3, 1, p3_c, p3_h, p3_w,
-            (const float*)m0_w, 255, 1, 1, m0_b, 1, 1, 0, 0, 1,
-            p3_out, p3_h, p3_w);
-    }
-    if (m1_is_int8) {
-        conv2d_nchw_f32_w8(p4, 1, p4_c, p4_h, p4_w,
-            (const int8_t*)m1_w, m1_scale, 255, 1, 1, m1_b, 1, 1, 0, 0, 1,
-            p4_out, p4_h, p4_w);
-    } else {
-        conv2d_nchw_f32(p4, 1, p4_c, p4_h, p4_w,
-            (const float*)m1_w, 255, 1, 1, m1_b, 1, 1, 0, 0, 1,
-            p4_out, p4_h, p4_w);
-    }
-    if (m2_is_int8) {
-        conv2d_nchw_f32_w8(p5, 1, p5_c, p5_h, p5_w,
-            (const int8_t*)m2_w, m2_scale, 255, 1, 1, m2_b, 1, 1, 0, 0, 1,
-            p5_out, p5_h, p5_w);
+    detect_nchw_f32_halo(n, p3, p3_c, p3_h, p3_w, p4, p4_c, p4_h, p4_w, p5, p5_c, p5_h, p5_w, 0, 0, 0,
+                         m0_w, m0_scale, m0_is_int8, m0_b, m1_w, m1_scale, m1_is_int8, m1_b,
+                         m2_w, m2_scale, m2_is_int8, m2_b, p3_out, p4_out, p5_out);
+}
+
+/* 1x1 conv 하나 (출력 조밀). 배치 n장을 한 번에 → 헤드 가중치도 배치 블록 단위로 재사용 */
+static void head_conv(const float* x, int32_t x_halo, int32_t n, int32_t c, int32_t h, int32_t w,
+                      const void* m_w, float m_scale, int m_is_int8, const float* m_b, float* y)
+{
+#ifdef YOLO_FIXED_POINT
+    /* 정수 경로: 출력도 Q int32 로짓 (decode_nchw_q_hw 입력) */
+    (void)m_is_int8;
+    conv2d_nchw_q_w8_halo((const int32_t*)x, x_halo, 0, n, c, h, w,
+        (const int8_t*)m_w, m_scale, 255, 1, 1, m_b, 1, 1, 0, 0,
+        (int32_t*)y, 0, 0, h, w);
+#else
+    if (m_is_int8) {
+        conv2d_nchw_f32_w8_halo(x, x_halo, 0, n, c, h, w,
+            (const int8_t*)m_w, m_scale, 255, 1, 1, m_b, 1, 1, 0, 0, 1,
+            y, 0, 0, h, w);
     } else {
-        conv2d_nchw_f32(p5, 1, p5_c, p5_h, p5_w,
-            (const float*)m2_w, 255, 1, 1, m2_b, 1, 1, 0, 0, 1,
-            p5_out, p5_h, p5_w);
+        conv2d_nchw_f32_halo(x, x_halo, 0, n, c, h, w,
+            (const float*)m_w, 255, 1, 1, m_b, 1, 1, 0, 0, 1,
+            y, 0, 0, h, w);
     }
+#endif
+}
+
+void detect_nchw_f32_halo(
+    int32_t n,
+    const float* p3, int32_t p3_c, int32_t p3_h, int32_t p3_w,
+    const float* p4, int32_t p4_c, int32_t p4_h, int32_t p4_w,
+    const float* p5, int32_t p5_c, int32_t p5_h, int32_t p5_w,
+    int32_t p3_halo, int32_t p4_halo, int32_t p5_halo,
+    const void* m0_w, float m0_scale, int m0_is_int8, const float* m0_b,
+    const void* m1_w, float m1_scale, int m1_is_int8, const float* m1_b,
+    const void* m2_w, float m2_scale, int m2_is_int8, const float* m2_b,
+    float* p3_out, float* p4_out, float* p5_out)
+{
+    yolo_timing_begin("detect");
+    head_conv(p3, p3_halo, n, p3_c, p3_h, p3_w, m0_w, m0_scale, m0_is_int8, m0_b, p3_out);
+    head_conv(p4, p4_halo, n, p4_c, p4_h, p4_w, m1_w, m1_scale, m1_is_int8, m1_b, p4_out);
+    head_conv(p5, p5_halo, n, p5_c, p5_h, p5_w, m2_w, m2_scale, m2_is_int8, m2_b, p5_out);
     yolo_timing_end();
 }
@@ -1,4 +1,5 @@
 #include "nms.h"
+#include "det_sort.h"
 #include "../utils/timing.h"
 #include <stdlib.h>
 #include <string.h>
@@ -48,6 +49,12 @@ int nms(
     if (!detections || num_detections <= 0 || !output_detections || !output_count) {
         return -1;
     }
+    /* 입력이 conf 내림차순이 아니면 먼저 정렬 (이미 정렬된 경우 O(n) 검사만) */
+    if (!det_is_sorted_by_conf(detections, num_detections)) {
+        yolo_timing_begin("sort");
+        det_sort_by_conf(detections, num_detections);
+        yolo_timing_end();
+    }
     yolo_timing_begin("nms");
     *output_detections = NULL;
     *output_count = 0;
@@ -97,3 +104,492 @@ int nms(
     yolo_timing_end();
     return 0;
 }
+
+size_t nms_workspace_size(int32_t max_candidates, int32_t num_classes) {
+    if (max_candidates < 0 || num_classes <= 0) return 0;
+    return NMS_WORKSPACE_BYTES(max_candidates, num_classes);
+}
+
+int nms_workspace_init(nms_workspace_t* ws, void* buf, size_t buf_bytes,
+                       int32_t max_candidates, int32_t num_classes) {
+    if (!ws || !buf || max_candidates < 0 || num_classes <= 0) return -1;
+    if (buf_bytes < NMS_WORKSPACE_BYTES(max_candidates, num_classes)) return -1;
+
+    const size_t f_bytes = NMS_WS_ALIGN_UP((size_t)max_candidates * 4u);
+    uintptr_t p = ((uintptr_t)buf + NMS_WS_ALIGN - 1u) & ~(uintptr_t)(NMS_WS_ALIGN - 1u);
+    ws->x1 = (float*)p;        p += f_bytes;
+    ws->y1 = (float*)p;        p += f_bytes;
+    ws->x2 = (float*)p;        p += f_bytes;
+    ws->y2 = (float*)p;        p += f_bytes;
+    ws->area = (float*)p;      p += f_bytes;
+    ws->order = (int32_t*)p;   p += f_bytes;
+    ws->grid_pos = (int32_t*)p; p += f_bytes;
+    ws->grid_start = (int32_t*)p;
+    p += NMS_WS_ALIGN_UP(((size_t)NMS_GRID_DIM * NMS_GRID_DIM + 1u) * 4u);
+    ws->mask_rows = (uint64_t*)p;
+    p += NMS_WS_ALIGN_UP((size_t)NMS_WS_MASK_WORDS(max_candidates) * 64u * 8u);
+    ws->mask_removed = (uint64_t*)p;
+    p += NMS_WS_ALIGN_UP((size_t)NMS_WS_MASK_WORDS(max_candidates) * 8u);
+    ws->cls_start = (int32_t*)p;
+    p += NMS_WS_ALIGN_UP(((size_t)num_classes + 1u) * 4u);
+    ws->suppressed = (uint8_t*)p;
+    p += NMS_WS_ALIGN_UP((size_t)max_candidates);
+    ws->keep = (uint8_t*)p;
+    ws->capacity = max_candidates;
+    ws->num_classes = num_classes;
+    ws->grid_min_candidates = NMS_GRID_MIN_CANDIDATES;
+    return 0;
+}
+
+/* 억제 판정 1건 (calculate_iou와 동일 연산 순서: 교집합 없거나 union<=0이면 IoU 0으로 보고 비교) */
+static inline int nms_iou_gt(float bx1, float by1, float bx2, float by2, float ba,
+                             float x1, float y1, float x2, float y2, float a, float thr) {
+    const float iw = (bx2 < x2 ? bx2 : x2) - (bx1 > x1 ? bx1 : x1);
+    const float ih = (by2 < y2 ? by2 : y2) - (by1 > y1 ? by1 : y1);
+    if (iw < 0.0f || ih < 0.0f) return 0.0f > thr;
+    const float inter = iw * ih;
+    const float uni = ba + a - inter;
+    if (uni <= 0.0f) return 0.0f > thr;
+    return inter / uni > thr;
+}
+
+/* GCC/Clang 벡터 확장: 호스트는 SSE/NEON 4-lane, 벡터 유닛 없는 타겟은 컴파일러가 스칼라로 전개 */
+#if defined(__GNUC__) && !defined(NMS_NO_VECTOR_EXT)
+#define NMS_V4 1
+typedef float nms_v4f __attribute__((vector_size(16)));
+typedef int32_t nms_v4i __attribute__((vector_size(16)));
+
+static inline nms_v4f nms_v4_load(const float* p) {
+    nms_v4f v;
+    memcpy(&v, p, sizeof(v));  /* 비정렬 로드 (j = i+1 부터 시작) */
+    return v;
+}
+
+static inline nms_v4f nms_v4_sel(nms_v4i m, nms_v4f a, nms_v4f b) {
+    return (nms_v4f)(((nms_v4i)a & m) | ((nms_v4i)b & ~m));
+}
+#endif
+
+/* 버킷 [s, e) 안에서 greedy 억제. i 유지 시 j>i를 SoA 위에서 4개씩 판정 */
+static void nms_suppress_bucket(nms_workspace_t* ws, int32_t s, int32_t e, float iou_threshold) {
+    const float* x1 = ws->x1;
+    const float* y1 = ws->y1;
+    const float* x2 = ws->x2;
+    const float* y2 = ws->y2;
+    const float* area = ws->area;
+    uint8_t* sup = ws->suppressed;
+
+    for (int32_t i = s; i < e; i++) {
+        if (sup[i]) continue;
+        ws->keep[ws->order[i]] = 1;
+        const float bx1 = x1[i], by1 = y1[i], bx2 = x2[i], by2 = y2[i], ba = area[i];
+        int32_t j = i + 1;
+#ifdef NMS_V4
+        const nms_v4f vbx1 = {bx1, bx1, bx1, bx1}, vby1 = {by1, by1, by1, by1};
+        const nms_v4f vbx2 = {bx2, bx2, bx2, bx2}, vby2 = {by2, by2, by2, by2};
+        const nms_v4f vba = {ba, ba, ba, ba};
+        const nms_v4f vthr = {iou_threshold, iou_threshold, iou_threshold, iou_threshold};
+        const nms_v4f vzero = {0.0f, 0.0f, 0.0f, 0.0f}, vone = {1.0f, 1.0f, 1.0f, 1.0f};
+        for (; j + 4 <= e; j += 4) {
+            const nms_v4f cx1 = nms_v4_load(x1 + j), cy1 = nms_v4_load(y1 + j);
+            const nms_v4f cx2 = nms_v4_load(x2 + j), cy2 = nms_v4_load(y2 + j);
+            const nms_v4f ca = nms_v4_load(area + j);
+            const nms_v4f iw = nms_v4_sel(vbx2 < cx2, vbx2, cx2) - nms_v4_sel(vbx1 > cx1, vbx1, cx1);
+            const nms_v4f ih = nms_v4_sel(vby2 < cy2, vby2, cy2) - nms_v4_sel(vby1 > cy1, vby1, cy1);
+            const nms_v4i overlap = (iw >= vzero) & (ih >= vzero);
+            const nms_v4f inter = nms_v4_sel(overlap, iw * ih, vzero);
+            const nms_v4f uni = vba + ca - inter;
+            const nms_v4i pos = uni > vzero;
+            const nms_v4f iou = nms_v4_sel(pos, inter / nms_v4_sel(pos, uni, vone), vzero);
+            const nms_v4i hit = iou > vthr;
+            sup[j + 0] |= (uint8_t)(hit[0] & 1);
+            sup[j + 1] |= (uint8_t)(hit[1] & 1);
+            sup[j + 2] |= (uint8_t)(hit[2] & 1);
+            sup[j + 3] |= (uint8_t)(hit[3] & 1);
+        }
+#endif
+        for (; j < e; j++) {
+            sup[j] |= (uint8_t)nms_iou_gt(bx1, by1, bx2, by2, ba,
+                                          x1[j], y1[j], x2[j], y2[j], area[j], iou_threshold);
+        }
+    }
+}
+
+/* 좌표 → 셀 인덱스. (v - lo) / cell 은 v에 대해 단조 증가 → 범위 질의 셀 경계가 보수적으로 맞음 */
+static inline int32_t nms_grid_cell(float v, float lo, float inv_cell) {
+    const float f = (v - lo) * inv_cell;
+    if (!(f > 0.0f)) return 0;
+    if (f >= (float)(NMS_GRID_DIM - 1)) return NMS_GRID_DIM - 1;
+    return (int32_t)f;
+}
+
+/* 버킷 [s, e) 공간 그리드 greedy 억제. 박스는 좌상단(x1, y1)이 속한 셀에 한 번만 등록.
+ * iou > thr(>=0) 이려면 교집합 폭/높이 > 0 이므로
+ *   x1[j] < x2[i],  x1[j] > x1[i] - max_w   (y도 동일)
+ * 하한은 반올림 여유를 둔 보수적 경계 (넓게 잡아도 같은 nms_iou_gt로 판정하므로 결과 불변).
+ * 셀 안 위치는 버킷 순서(conf 순) 오름차순 → j > i 검사만으로 greedy 순서 유지. */
+static void nms_grid_bucket(nms_workspace_t* ws, int32_t s, int32_t e, float iou_threshold) {
+    const float* x1 = ws->x1;
+    const float* y1 = ws->y1;
+    const float* x2 = ws->x2;
+    const float* y2 = ws->y2;
+    const float* area = ws->area;
+    uint8_t* sup = ws->suppressed;
+    int32_t* gpos = ws->grid_pos;
+    int32_t* gstart = ws->grid_start;
+    const int32_t ncell = NMS_GRID_DIM * NMS_GRID_DIM;
+
+    float min_x = x1[s], max_x = x1[s], min_y = y1[s], max_y = y1[s];
+    float max_w = 0.0f, max_h = 0.0f;
+    for (int32_t k = s; k < e; k++) {
+        if (x1[k] < min_x) min_x = x1[k];
+        if (x1[k] > max_x) max_x = x1[k];
+        if (y1[k] < min_y) min_y = y1[k];
+        if (y1[k] > max_y) max_y = y1[k];
+        if (x2[k] - x1[k] > max_w) max_w = x2[k] - x1[k];
+        if (y2[k] - y1[k] > max_h) max_h = y2[k] - y1[k];
+    }
+    /* 셀 크기 >= 최대 박스 크기 → 질의 범위가 축당 2~3셀 */
+    float cell_w = (max_x - min_x) / (float)NMS_GRID_DIM;
+    float cell_h = (max_y - min_y) / (float)NMS_GRID_DIM;
+    if (cell_w < max_w) cell_w = max_w;
+    if (cell_h < max_h) cell_h = max_h;
+    const float inv_w = cell_w > 0.0f ? 1.0f / cell_w : 0.0f;
+    const float inv_h = cell_h > 0.0f ? 1.0f / cell_h : 0.0f;
+
+    /* counting sort: 셀별 개수 → prefix → 버킷 순서대로 scatter (셀 안 순서 유지) */
+    for (int32_t c = 0; c <= ncell; c++) gstart[c] = 0;
+    for (int32_t k = s; k < e; k++) {
+        const int32_t c = nms_grid_cell(y1[k], min_y, inv_h) * NMS_GRID_DIM +
+                          nms_grid_cell(x1[k], min_x, inv_w);
+        gstart[c + 1]++;
+    }
+    for (int32_t c = 0; c < ncell; c++) gstart[c + 1] += gstart[c];
+    for (int32_t k = s; k < e; k++) {
+        const int32_t c = nms_grid_cell(y1[k], min_y, inv_h) * NMS_GRID_DIM +
+                          nms_grid_cell(x1[k], min_x, inv_w);
+        gpos[s + gstart[c]++] = k;
+    }
+    for (int32_t c = ncell; c > 0; c--) gstart[c] = gstart[c - 1];
+    gstart[0] = 0;
+
+    for (int32_t i = s; i < e; i++) {
+        if (sup[i]) continue;
+        ws->keep[ws->order[i]] = 1;
+        const float bx1 = x1[i], by1 = y1[i], bx2 = x2[i], by2 = y2[i], ba = area[i];
+        const float lo_x = bx1 - (max_w + 1e-4f * (fabsf(bx1) + max_w));
+        const float lo_y = by1 - (max_h + 1e-4f * (fabsf(by1) + max_h));
+        const int32_t cx0 = nms_grid_cell(lo_x, min_x, inv_w), cx1 = nms_grid_cell(bx2, min_x, inv_w);
+        const int32_t cy0 = nms_grid_cell(lo_y, min_y, inv_h), cy1 = nms_grid_cell(by2, min_y, inv_h);
+
+        for (int32_t cy = cy0; cy <= cy1; cy++) {
+            for (int32_t cx = cx0; cx <= cx1; cx++) {
+                const int32_t c = cy * NMS_GRID_DIM + cx;
+                for (int32_t k = gstart[c]; k < gstart[c + 1]; k++) {
+                    const int32_t j = gpos[s + k];
+                    if (j <= i || sup[j]) continue;
+                    sup[j] = (uint8_t)nms_iou_gt(bx1, by1, bx2, by2, ba,
+                                                 x1[j], y1[j], x2[j], y2[j], area[j], iou_threshold);
+                }
+            }
+        }
+    }
+}
+
+/* 정렬 확인 + 클래스 버킷팅 + SoA 채우기. cls_id 범위 밖이면 -1 */
+static int nms_prepare(detection_t* detections, int32_t num_detections, nms_workspace_t* ws) {
+    const int32_t nc = ws->num_classes;
+    int32_t* cls_start = ws->cls_start;
+    for (int32_t c = 0; c <= nc; c++) cls_start[c] = 0;
+    for (int32_t i = 0; i < num_detections; i++) {
+        const int32_t c = detections[i].cls_id;
+        if ((uint32_t)c >= (uint32_t)nc) return -1;
+        cls_start[c + 1]++;
+    }
+    for (int32_t c = 0; c < nc; c++) cls_start[c + 1] += cls_start[c];
+
+    /* counting sort scatter: cls_start[c]를 커서로 쓴 뒤 다시 한 칸씩 밀어 복원 */
+    for (int32_t i = 0; i < num_detections; i++) {
+        const detection_t* d = &detections[i];
+        const int32_t pos = cls_start[d->cls_id]++;
+        const float x1 = d->x - d->w / 2.0f;
+        const float y1 = d->y - d->h / 2.0f;
+        const float x2 = d->x + d->w / 2.0f;
+        const float y2 = d->y + d->h / 2.0f;
+        ws->x1[pos] = x1;
+        ws->y1[pos] = y1;
+        ws->x2[pos] = x2;
+        ws->y2[pos] = y2;
+        ws->area[pos] = (x2 - x1) * (y2 - y1);
+        ws->order[pos] = i;
+        ws->suppressed[pos] = 0;
+        ws->keep[i] = 0;
+    }
+    for (int32_t c = nc; c > 0; c--) cls_start[c] = cls_start[c - 1];
+    cls_start[0] = 0;
+    return 0;
+}
+
+/* 클래스 간 독립이므로, 전역 conf 순서로 앞에서 max_detections개 = nms() 결과 */
+static int32_t nms_emit(const detection_t* detections, int32_t num_detections, const nms_workspace_t* ws,
+                        int32_t max_detections, detection_t* output_detections) {
+    int32_t out = 0;
+    for (int32_t i = 0; i < num_detections && out < max_detections; i++) {
+        if (ws->keep[i]) output_detections[out++] = detections[i];
+    }
+    return out;
+}
+
+int nms_bucketed(
+    detection_t* detections, int32_t num_detections,
+    nms_workspace_t* ws,
+    float iou_threshold, int32_t max_detections,
+    detection_t* output_detections, int32_t* output_count) {
+
+    if (!detections || num_detections < 0 || !ws || !output_detections || !output_count) return -1;
+    *output_count = 0;
+    if (num_detections > ws->capacity) return -1;
+    if (num_detections == 0) return 0;
+
+    if (!det_is_sorted_by_conf(detections, num_detections)) {
+        yolo_timing_begin("sort");
+        det_sort_by_conf(detections, num_detections);
+        yolo_timing_end();
+    }
+    yolo_timing_begin("nms");
+    if (nms_prepare(detections, num_detections, ws) != 0) { yolo_timing_end(); return -1; }
+
+    const int32_t* cls_start = ws->cls_start;
+    /* 음수/NaN 임계값은 교집합 0인 쌍도 억제할 수 있어 그리드 불가 → 전수 루프 */
+    const int grid_ok = iou_threshold >= 0.0f;
+    for (int32_t c = 0; c < ws->num_classes; c++) {
+        const int32_t n = cls_start[c + 1] - cls_start[c];
+        if (n <= 0) continue;
+        if (grid_ok && n >= ws->grid_min_candidates)
+            nms_grid_bucket(ws, cls_start[c], cls_start[c + 1], iou_threshold);
+        else
+            nms_suppress_bucket(ws, cls_start[c], cls_start[c + 1], iou_threshold);
+    }
+
+    *output_count = nms_emit(detections, num_detections, ws, max_detections, output_detections);
+    yolo_timing_end();
+    return 0;
+}
+
+/* ===== 비트마스크 IoU 행렬 NMS ===== */
+
+/* 행 i의 마스크: 버킷 [s, e)에서 j > i 이고 IoU > thr 인 열 j를 비트 (j - s)로 기록.
+ * 열은 64개(워드) 단위, 워드 안에서는 4-lane 벡터 판정 결과를 4비트씩 OR. */
+static void nms_mask_row(const nms_workspace_t* ws, int32_t s, int32_t e, int32_t i,
+                         float iou_threshold, uint64_t* row) {
+    const float* x1 = ws->x1;
+    const float* y1 = ws->y1;
+    const float* x2 = ws->x2;
+    const float* y2 = ws->y2;
+    const float* area = ws->area;
+    const float bx1 = x1[i], by1 = y1[i], bx2 = x2[i], by2 = y2[i], ba = area[i];
+    const int32_t w0 = (i + 1 - s) >> 6;
+    const int32_t nw = (e - s + 63) >> 6;
+    for (int32_t w = 0; w < w0; w++) row[w] = 0;
+#ifdef NMS_V4
+    const nms_v4f vbx1 = {bx1, bx1, bx1, bx1}, vby1 = {by1, by1, by1, by1};
+    const nms_v4f vbx2 = {bx2, bx2, bx2, bx2}, vby2 = {by2, by2, by2, by2};
+    const nms_v4f vba = {ba, ba, ba, ba};
+    const nms_v4f vthr = {iou_threshold, iou_threshold, iou_threshold, iou_threshold};
+    const nms_v4f vzero = {0.0f, 0.0f, 0.0f, 0.0f}, vone = {1.0f, 1.0f, 1.0f, 1.0f};
+#endif
+    for (int32_t w = w0; w < nw; w++) {
+        const int32_t base = s + (w << 6);
+        const int32_t end = base + 64 < e ? base + 64 : e;
+        int32_t j = base > i + 1 ? base : i + 1;
+        uint64_t m = 0;
+#ifdef NMS_V4
+        for (; j + 4 <= end; j += 4) {
+            const nms_v4f cx1 = nms_v4_load(x1 + j), cy1 = nms_v4_load(y1 + j);
+            const nms_v4f cx2 = nms_v4_load(x2 + j), cy2 = nms_v4_load(y2 + j);
+            const nms_v4f ca = nms_v4_load(area + j);
+            const nms_v4f iw = nms_v4_sel(vbx2 < cx2, vbx2, cx2) - nms_v4_sel(vbx1 > cx1, vbx1, cx1);
+            const nms_v4f ih = nms_v4_sel(vby2 < cy2, vby2, cy2) - nms_v4_sel(vby1 > cy1, vby1, cy1);
+            const nms_v4i overlap = (iw >= vzero) & (ih >= vzero);
+            const nms_v4f inter = nms_v4_sel(overlap, iw * ih, vzero);
+            const nms_v4f uni = vba + ca - inter;
+            const nms_v4i pos = uni > vzero;
+            const nms_v4f iou = nms_v4_sel(pos, inter / nms_v4_sel(pos, uni, vone), vzero);
+            const nms_v4i hit = iou > vthr;
+            const uint64_t bits = (uint64_t)((hit[0] & 1) | (hit[1] & 2) | (hit[2] & 4) | (hit[3] & 8));
+            m |= bits << (j - base);
+        }
+#endif
+        for (; j < end; j++) {
+            m |= (uint64_t)nms_iou_gt(bx1, by1, bx2, by2, ba,
+                                      x1[j], y1[j], x2[j], y2[j], area[j], iou_threshold) << (j - base);
+        }
+        row[w] = m;
+    }
+}
+
+/* 버킷 [s, e): 64행 블록마다 (이전 블록에서 이미 제거되지 않은) 행의 마스크를 만든 뒤,
+ * 블록 안 greedy는 removed 비트 검사 + 행 마스크 OR 만으로 처리. */
+static void nms_bitmask_bucket(nms_workspace_t* ws, int32_t s, int32_t e, float iou_threshold) {
+    const int32_t n = e - s;
+    const int32_t nw = (n + 63) >> 6;
+    uint64_t* removed = ws->mask_removed;
+    for (int32_t w = 0; w < nw; w++) removed[w] = 0;
+
+    for (int32_t rb = 0; rb < n; rb += 64) {
+        const int32_t rows = n - rb < 64 ? n - rb : 64;
+        const uint64_t blk_removed = removed[rb >> 6];
+        for (int32_t r = 0; r < rows; r++) {
+            if ((blk_removed >> r) & 1u) continue;
+            nms_mask_row(ws, s, e, s + rb + r, iou_threshold, ws->mask_rows + (size_t)r * (size_t)nw);
+        }
+        for (int32_t r = 0; r < rows; r++) {
+            if ((removed[rb >> 6] >> r) & 1u) continue;
+            ws->keep[ws->order[s + rb + r]] = 1;
+            const uint64_t* row = ws->mask_rows + (size_t)r * (size_t)nw;
+            for (int32_t w = rb >> 6; w < nw; w++) removed[w] |= row[w];
+        }
+    }
+}
+
+static int nms_bitmask_one(detection_t* detections, int32_t num_detections, nms_workspace_t* ws,
+                           float iou_threshold, int32_t max_detections,
+                           detection_t* output_detections, int32_t* output_count) {
+    *output_count = 0;
+    if (!detections || num_detections < 0 || !output_detections) return -1;
+    if (num_detections > ws->capacity) return -1;
+    if (num_detections == 0) return 0;
+    if (!det_is_sorted_by_conf(detections, num_detections)) det_sort_by_conf(detections, num_detections);
+    if (nms_prepare(detections, num_detections, ws) != 0) return -1;
+
+    const int32_t* cls_start = ws->cls_start;
+    for (int32_t c = 0; c < ws->num_classes; c++) {
+        if (cls_start[c + 1] - cls_start[c] > 0)
+            nms_bitmask_bucket(ws, cls_start[c], cls_start[c + 1], iou_threshold);
+    }
+    *output_count = nms_emit(detections, num_detections, ws, max_detections, output_detections);
+    return 0;
+}
+
+int nms_bitmask(
+    detection_t* detections, int32_t num_detections,
+    nms_workspace_t* ws,
+    float iou_threshold, int32_t max_detections,
+    detection_t* output_detections, int32_t* output_count) {
+
+    if (!ws || !output_count) return -1;
+    yolo_timing_begin("nms");
+    const int ret = nms_bitmask_one(detections, num_detections, ws, iou_threshold, max_detections,
+                                    output_detections, output_count);
+    yolo_timing_end();
+    return ret;
+}
+
+int nms_bitmask_batch(nms_batch_item_t* items, int32_t num_images, nms_workspace_t* ws,
+                      float iou_threshold, int32_t max_detections) {
+    if (!items || num_images < 0 || !ws) return -1;
+    int ret = 0;
+    yolo_timing_begin("nms");
+    for (int32_t b = 0; b < num_images; b++) {
+        nms_batch_item_t* it = &items[b];
+        if (nms_bitmask_one(it->detections, it->num_detections, ws, iou_threshold, max_detections,
+                            it->output, &it->output_count) != 0)
+            ret = -1;
+    }
+    yolo_timing_end();
+    return ret;
+}
+
+/* 정수 IoU > thr (교차 곱). 코너 단위 = 박스 좌표의 1/2 */
+static inline int nms_iou_q_gt(int32_t ax1, int32_t ay1, int32_t ax2, int32_t ay2,
+                               int32_t bx1, int32_t by1, int32_t bx2, int32_t by2, int32_t thr_q15) {
+    const int64_t iw = (int64_t)(ax2 < bx2 ? ax2 : bx2) - (ax1 > bx1 ? ax1 : bx1);
+    const int64_t ih = (int64_t)(ay2 < by2 ? ay2 : by2) - (ay1 > by1 ? ay1 : by1);
+    if (iw < 0 || ih < 0) return 0;
+    const int64_t inter = iw * ih;
+    const int64_t uni = (int64_t)(ax2 - ax1) * (ay2 - ay1) + (int64_t)(bx2 - bx1) * (by2 - by1) - inter;
+    if (uni <= 0) return 0;
+    return inter * 32768 > (int64_t)thr_q15 * uni;
+}
+
+/* nms_prepare의 정수판: 클래스 버킷팅 + 정수 코너 (2·중심 ± 크기)를 SoA float 슬롯(같은 4바이트)에 둠 */
+static int nms_prepare_q(const detection_q_t* detections, int32_t num_detections, nms_workspace_t* ws) {
+    const int32_t nc = ws->num_classes;
+    int32_t* cls_start = ws->cls_start;
+    int32_t* x1 = (int32_t*)ws->x1;
+    int32_t* y1 = (int32_t*)ws->y1;
+    int32_t* x2 = (int32_t*)ws->x2;
+    int32_t* y2 = (int32_t*)ws->y2;
+    for (int32_t c = 0; c <= nc; c++) cls_start[c] = 0;
+    for (int32_t i = 0; i < num_detections; i++) {
+        const int32_t c = detections[i].cls_id;
+        if ((uint32_t)c >= (uint32_t)nc) return -1;
+        cls_start[c + 1]++;
+    }
+    for (int32_t c = 0; c < nc; c++) cls_start[c + 1] += cls_start[c];
+
+    for (int32_t i = 0; i < num_detections; i++) {
+        const detection_q_t* d = &detections[i];
+        const int32_t pos = cls_start[d->cls_id]++;
+        x1[pos] = 2 * d->x - d->w;
+        y1[pos] = 2 * d->y - d->h;
+        x2[pos] = 2 * d->x + d->w;
+        y2[pos] = 2 * d->y + d->h;
+        ws->order[pos] = i;
+        ws->suppressed[pos] = 0;
+        ws->keep[i] = 0;
+    }
+    for (int32_t c = nc; c > 0; c--) cls_start[c] = cls_start[c - 1];
+    cls_start[0] = 0;
+    return 0;
+}
+
+/* 버킷 [s, e) greedy (nms_suppress_bucket의 정수판) */
+static void nms_suppress_bucket_q(nms_workspace_t* ws, int32_t s, int32_t e, int32_t thr_q15) {
+    const int32_t* x1 = (const int32_t*)ws->x1;
+    const int32_t* y1 = (const int32_t*)ws->y1;
+    const int32_t* x2 = (const int32_t*)ws->x2;
+    const int32_t* y2 = (const int32_t*)ws->y2;
+    uint8_t* sup = ws->suppressed;
+    for (int32_t i = s; i < e; i++) {
+        if (sup[i]) continue;
+        ws->keep[ws->order[i]] = 1;
+        const int32_t bx1 = x1[i], by1 = y1[i], bx2 = x2[i], by2 = y2[i];
+        for (int32_t j = i + 1; j < e; j++) {
+            if (sup[j]) continue;
+            sup[j] = (uint8_t)nms_iou_q_gt(bx1, by1, bx2, by2, x1[j], y1[j], x2[j], y2[j], thr_q15);
+        }
+    }
+}
+
+int nms_q(
+    detection_q_t* detections, int32_t num_detections,
+    nms_workspace_t* ws,
+    int32_t iou_threshold_q15, int32_t max_detections,
+    detection_q_t* output_detections, int32_t* output_count)
+{
+    if (!detections || !ws || !output_detections || !output_count) return -1;
+    *output_count = 0;
+    if (num_detections > ws->capacity) return -1;
+    if (num_detections <= 0) return 0;
+
+    yolo_timing_begin("sort");
+    det_sort_q_by_conf(detections, num_detections);
+    yolo_timing_end();
+
+    yolo_timing_begin("nms");
+    if (nms_prepare_q(detections, num_detections, ws) != 0) { yolo_timing_end(); return -1; }
+    const int32_t* cls_start = ws->cls_start;
+    for (int32_t c = 0; c < ws->num_classes; c++) {
+        if (cls_start[c + 1] > cls_start[c])
+            nms_suppress_bucket_q(ws, cls_start[c], cls_start[c + 1], iou_threshold_q15);
+    }
+    /* nms_emit와 같음: 전역 conf 순서로 앞에서 max_detections개 */
+    int32_t kept = 0;
+    for (int32_t i = 0; i < num_detections && kept < max_detections; i++) {
+        if (ws->keep[i]) output_detections[kept++] = detections[i];
+    }
+    *output_count = kept;
+    yolo_timing_end();
+    return 0;
+}
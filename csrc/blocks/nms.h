@@ -1,17 +1,119 @@
 #ifndef NMS_H
 #define NMS_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "decode.h"
 
 float calculate_iou(const detection_t* box1, const detection_t* box2);
 
+/* detections가 conf 내림차순이 아니면 det_sort_by_conf로 제자리 정렬 후 NMS */
 int nms(
-    detection_t* detections,           // 입력: detection 배열
+    detection_t* detections,           // 입력: detection 배열 (필요 시 제자리 정렬됨)
     int32_t num_detections,            // 입력: detection 개수
     detection_t** output_detections,    // 출력: NMS 적용 후 detection 배열 (동적 할당)
     int32_t* output_count,             // 출력: 남은 detection 개수
     float iou_threshold,               // IoU 임계값 (일반적으로 0.45)
     int32_t max_detections);           // 최대 detection 개수
 
+/* ===== 할당 없는 클래스 버킷 NMS (bare-metal 프레임 경로) =====
+ * 후보를 클래스별로 버킷팅(counting sort, 클래스 내 conf 순서 유지)하고,
+ * 박스는 SoA(x1,y1,x2,y2,area)로 한 번만 계산해 둔다. 억제 루프는 SoA 위에서
+ * 분기 없이 돌아 컴파일러 자동 벡터화 대상. 모든 버퍼는 호출자 scratch에서 분할.
+ * 결과는 nms()와 비트 단위 동일 (같은 부동소수 연산 순서 사용). */
+
+#define NMS_WS_ALIGN 16u
+#define NMS_WS_ALIGN_UP(x) (((size_t)(x) + NMS_WS_ALIGN - 1u) & ~(size_t)(NMS_WS_ALIGN - 1u))
+
+/* 버킷 후보 수가 이 이상이면 공간 그리드(NMS_GRID_DIM^2 셀)로 겹칠 수 있는 이웃만 검사
+ * (그 미만은 전수 벡터 루프가 더 빠름). ws->grid_min_candidates로 런타임 변경 가능
+ * (0: 항상 그리드, INT32_MAX: 끔). 결과는 어느 경로든 동일. */
+#ifndef NMS_GRID_MIN_CANDIDATES
+#define NMS_GRID_MIN_CANDIDATES 256
+#endif
+#ifndef NMS_GRID_DIM
+#define NMS_GRID_DIM 16
+#endif
+
+/* 비트마스크 NMS: 버킷 후보 64개당 uint64 1워드 */
+#define NMS_WS_MASK_WORDS(max_candidates) (((size_t)(max_candidates) + 63u) / 64u)
+
+/** scratch 크기 (정적 배열 선언용 상수식): SoA 5개 + 버킷 인덱스 + 그리드 인덱스/셀 오프셋
+ *  + 비트마스크 64행 블록/removed + 클래스 오프셋 + 플래그 2개 */
+#define NMS_WORKSPACE_BYTES(max_candidates, num_classes) \
+    (NMS_WS_ALIGN \
+     + 7u * NMS_WS_ALIGN_UP((size_t)(max_candidates) * 4u) \
+     + NMS_WS_ALIGN_UP(((size_t)NMS_GRID_DIM * NMS_GRID_DIM + 1u) * 4u) \
+     + NMS_WS_ALIGN_UP(NMS_WS_MASK_WORDS(max_candidates) * 64u * 8u) \
+     + NMS_WS_ALIGN_UP(NMS_WS_MASK_WORDS(max_candidates) * 8u) \
+     + NMS_WS_ALIGN_UP(((size_t)(num_classes) + 1u) * 4u) \
+     + 2u * NMS_WS_ALIGN_UP((size_t)(max_candidates)))
+
+typedef struct {
+    float* x1;            /* 버킷 순서 SoA: 코너 + 면적 */
+    float* y1;
+    float* x2;
+    float* y2;
+    float* area;
+    int32_t* order;       /* 버킷 위치 → 입력(정렬된) 인덱스 */
+    int32_t* grid_pos;    /* 그리드: 셀 순서로 나열한 버킷 위치 */
+    int32_t* grid_start;  /* 셀 k = grid_pos[grid_start[k] .. grid_start[k+1]) */
+    uint64_t* mask_rows;  /* 비트마스크: 64행 블록의 행별 IoU>thr 마스크 (행당 MASK_WORDS 워드) */
+    uint64_t* mask_removed; /* 비트마스크: 버킷 위치 기준 제거 비트 */
+    int32_t* cls_start;   /* 클래스 c 버킷 = [cls_start[c], cls_start[c+1]) */
+    uint8_t* suppressed;  /* 버킷 위치 기준 */
+    uint8_t* keep;        /* 입력 인덱스 기준 */
+    int32_t capacity;
+    int32_t num_classes;
+    int32_t grid_min_candidates;   /* init 시 NMS_GRID_MIN_CANDIDATES */
+} nms_workspace_t;
+
+size_t nms_workspace_size(int32_t max_candidates, int32_t num_classes);
+
+/* buf(buf_bytes)를 분할해 ws 구성. 부족하면 -1. buf는 호출자 소유 (정적 배열/풀 등). */
+int nms_workspace_init(nms_workspace_t* ws, void* buf, size_t buf_bytes,
+                       int32_t max_candidates, int32_t num_classes);
+
+/* detections: 필요 시 제자리 정렬됨. cls_id는 [0, num_classes) 이어야 함.
+ * output_detections: 호출자 버퍼 (max_detections개 이상). 반환 0 성공, -1 실패 */
+int nms_bucketed(
+    detection_t* detections, int32_t num_detections,
+    nms_workspace_t* ws,
+    float iou_threshold, int32_t max_detections,
+    detection_t* output_detections, int32_t* output_count);
+
+/* ===== 비트마스크 IoU 행렬 NMS (배치 후처리) =====
+ * 클래스 버킷마다 상삼각 IoU>thr 관계를 64비트 마스크 행으로 만들고(4-lane 벡터 판정),
+ * greedy 유지 판정은 removed 비트 검사 + 행 마스크 OR 로 처리. 64행 블록 단위로 계산해
+ * scratch는 후보 수에 선형. 이전 블록에서 제거된 행은 마스크를 만들지 않음.
+ * nms_workspace_t/nms_bucketed와 같은 입력 조건, 결과는 nms()와 비트 단위 동일. */
+int nms_bitmask(
+    detection_t* detections, int32_t num_detections,
+    nms_workspace_t* ws,
+    float iou_threshold, int32_t max_detections,
+    detection_t* output_detections, int32_t* output_count);
+
+typedef struct {
+    detection_t* detections;   /* 입력: 이미지 1장의 후보 (필요 시 제자리 정렬됨) */
+    int32_t num_detections;    /* 입력: ws->capacity 이하 */
+    detection_t* output;       /* 출력: 호출자 버퍼 (max_detections개 이상) */
+    int32_t output_count;      /* 출력 */
+} nms_batch_item_t;
+
+/* 여러 이미지의 후보 목록을 한 번에 처리 (workspace 재사용, "nms" 타이밍 1회).
+ * 실패한 이미지는 output_count=0, 하나라도 실패하면 -1 */
+int nms_bitmask_batch(nms_batch_item_t* items, int32_t num_images, nms_workspace_t* ws,
+                      float iou_threshold, int32_t max_detections);
+
+/* ===== 정수 NMS (-DYOLO_FIXED_POINT) =====
+ * det_sort_q_by_conf (introsort, 동점 cls_id → x → y = FP32 det_sort와 같은 순서) 후 nms_bucketed처럼 클래스 버킷별 greedy.
+ * 박스 코너 = 2·중심 ± 크기 (정수 그대로), IoU > thr ⇔ 교집합 × 2^15 > thr_q15 × 합집합 (int64, 나눗셈 없음).
+ * ws: nms_workspace_init된 것 (SoA 슬롯에 정수 코너). detections는 제자리 정렬됨, cls_id는 [0, num_classes).
+ * output_detections: 호출자 버퍼 (max_detections개 이상). 반환 0 성공, -1 실패 (후보 > capacity, cls_id 범위 밖) */
+int nms_q(
+    detection_q_t* detections, int32_t num_detections,
+    nms_workspace_t* ws,
+    int32_t iou_threshold_q15, int32_t max_detections,
+    detection_q_t* output_detections, int32_t* output_count);
+
 #endif // NMS_H
@@ -2,65 +2,77 @@
 #include "../operations/conv2d.h"
 #include "../operations/silu.h"
 #include "../operations/maxpool2d.h"
-#include "../operations/concat.h"
+#include "../operations/conv2d_q.h"
 #include "../utils/feature_pool.h"
 #include "../utils/timing.h"
 
+/* 1x1 conv + SiLU (FP32 또는 INT8 가중치). y_n_stride: y 이미지 간격 (0 = 연속, concat 구간이면 SiLU도 그 구간만) */
+static void conv1x1(
+    const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const void* w_ptr, float w_scale, int w_is_int8, int32_t c_out, const float* bias,
+    float* y, int32_t y_n_stride)
+{
+    const int32_t y_n = y_n_stride ? y_n_stride : c_out * h * w;
+#ifdef YOLO_FIXED_POINT
+    /* 정수 경로: Q int32 워드 버퍼, INT8 가중치 */
+    (void)w_is_int8;
+    conv2d_nchw_q_w8_halo((const int32_t*)x, 0, 0, n, c_in, h, w, (const int8_t*)w_ptr, w_scale, c_out, 1, 1,
+                          bias, 1, 1, 0, 0, (int32_t*)y, 0, y_n_stride, h, w);
+    for (int32_t ni = 0; ni < n; ni++)
+        silu_nchw_q((const int32_t*)y + ni * y_n, 1, c_out, h, w, (int32_t*)y + ni * y_n);
+#else
+    if (w_is_int8)
+        conv2d_nchw_f32_w8_halo(x, 0, 0, n, c_in, h, w, (const int8_t*)w_ptr, w_scale, c_out, 1, 1,
+                                bias, 1, 1, 0, 0, 1, y, 0, y_n_stride, h, w);
+    else
+        conv2d_nchw_f32_halo(x, 0, 0, n, c_in, h, w, (const float*)w_ptr, c_out, 1, 1,
+                             bias, 1, 1, 0, 0, 1, y, 0, y_n_stride, h, w);
+    for (int32_t ni = 0; ni < n; ni++)
+        silu_nchw_f32(y + ni * y_n, 1, c_out, h, w, y + ni * y_n);
+#endif
+}
+
 void sppf_nchw_f32(
     const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
-    const float* cv1_w, int32_t cv1_c_out, const float* cv1_bias,
-    const float* cv2_w, int32_t cv2_c_out, const float* cv2_bias,
+    const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
+    const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
     int32_t pool_k,
     float* y)
 {
-    const int32_t pad = pool_k / 2;
-
-    size_t x1_bytes = (size_t)n * (size_t)cv1_c_out * (size_t)h * (size_t)w * sizeof(float);
-    size_t cat_bytes = (size_t)n * (size_t)(4 * cv1_c_out) * (size_t)h * (size_t)w * sizeof(float);
+    /* cv2 입력 concat 버퍼 [x1 | y1 | y2 | y3]에 cv1·풀링이 바로 씀 (구간 버퍼·concat 복사 없음) */
+    const int32_t seg = cv1_c_out * h * w;
+    const int32_t img_stride = 4 * seg;
+    size_t cat_bytes = (size_t)n * (size_t)img_stride * sizeof(float);
+    size_t tmp_bytes = (size_t)(2 * w) * sizeof(float);
 
-    float* x1 = (float*)feature_pool_alloc(x1_bytes);
-    float* y1 = (float*)feature_pool_alloc(x1_bytes);
-    float* y2 = (float*)feature_pool_alloc(x1_bytes);
-    float* y3 = (float*)feature_pool_alloc(x1_bytes);
     float* cat = (float*)feature_pool_alloc(cat_bytes);
+    float* row_tmp = (float*)feature_pool_alloc(tmp_bytes);
 
-    if (!x1 || !y1 || !y2 || !y3 || !cat) {
+    if (!cat || !row_tmp) {
+        if (row_tmp) feature_pool_free(row_tmp);
         if (cat) feature_pool_free(cat);
-        if (y3) feature_pool_free(y3);
-        if (y2) feature_pool_free(y2);
-        if (y1) feature_pool_free(y1);
-        if (x1) feature_pool_free(x1);
         return;
     }
+    /* cv1은 배치 그대로 이미지 간격 img_stride로 x1 구간에 씀 (가중치 블록은 배치 블록마다 한 번) */
     yolo_timing_begin("cv1");
-    conv2d_nchw_f32(x, n, c_in, h, w,
-                    cv1_w, cv1_c_out, 1, 1,
-                    cv1_bias, 1, 1, 0, 0, 1,
-                    x1, h, w);
-    silu_nchw_f32(x1, n, cv1_c_out, h, w, x1);
+    conv1x1(x, n, c_in, h, w, cv1_w, cv1_scale, cv1_is_int8, cv1_c_out, cv1_bias, cat, img_stride);
     yolo_timing_end();
 
     yolo_timing_begin("maxpool");
-    maxpool2d_nchw_f32(x1, n, cv1_c_out, h, w, pool_k, 1, pad, y1, h, w);
-    maxpool2d_nchw_f32(y1, n, cv1_c_out, h, w, pool_k, 1, pad, y2, h, w);
-    maxpool2d_nchw_f32(y2, n, cv1_c_out, h, w, pool_k, 1, pad, y3, h, w);
+#ifdef YOLO_FIXED_POINT
+    int32_t* cat_q = (int32_t*)cat;
+    maxpool2d_sppf_nchw_q(cat_q, n, cv1_c_out, h, w, pool_k, img_stride,
+                          cat_q + seg, cat_q + 2 * seg, cat_q + 3 * seg, (int32_t*)row_tmp);
+#else
+    maxpool2d_sppf_nchw_f32(cat, n, cv1_c_out, h, w, pool_k, img_stride,
+                            cat + seg, cat + 2 * seg, cat + 3 * seg, row_tmp);
+#endif
     yolo_timing_end();
 
-    yolo_timing_begin("concat");
-    concat4_nchw_f32(x1, cv1_c_out, y1, cv1_c_out, y2, cv1_c_out, y3, cv1_c_out,
-                     n, h, w, cat);
-    yolo_timing_end();
     yolo_timing_begin("cv2");
-    conv2d_nchw_f32(cat, n, 4 * cv1_c_out, h, w,
-                    cv2_w, cv2_c_out, 1, 1,
-                    cv2_bias, 1, 1, 0, 0, 1,
-                    y, h, w);
-    silu_nchw_f32(y, n, cv2_c_out, h, w, y);
+    conv1x1(cat, n, 4 * cv1_c_out, h, w, cv2_w, cv2_scale, cv2_is_int8, cv2_c_out, cv2_bias, y, 0);
     yolo_timing_end();
 
+    feature_pool_free(row_tmp);
     feature_pool_free(cat);
-    feature_pool_free(y3);
-    feature_pool_free(y2);
-    feature_pool_free(y1);
-    feature_pool_free(x1);
 }
@@ -3,10 +3,11 @@
 
 #include <stdint.h>
 
+/* w: float* 또는 int8_t* (is_int8에 따름, scale은 INT8일 때만). W8은 conv 루프 안에서 즉시 복원 (FP32 사본 없음) */
 void sppf_nchw_f32(
     const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
-    const float* cv1_w, int32_t cv1_c_out, const float* cv1_bias,
-    const float* cv2_w, int32_t cv2_c_out, const float* cv2_bias,
+    const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
+    const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
     int32_t pool_k,
     float* y);
 
@@ -0,0 +1,1050 @@
+/**
+ * YOLOv5n 추론 컨텍스트: init(가중치 로드 + 풀/메모리 계획) / infer(Backbone → Neck → Detect → decode → NMS) / destroy
+ */
+#include "yolov5n.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "conv.h"
+#include "c3.h"
+#include "sppf.h"
+#include "detect.h"
+#include "det_sort.h"
+#include "../operations/upsample.h"
+#include "../operations/concat.h"
+#include "../operations/conv2d.h"
+#include "../operations/halo.h"
+#include "../operations/qformat.h"
+#include "../utils/mcycle.h"
+#include "../utils/timing.h"
+#include "../utils/cache_sim.h"
+#ifdef BARE_METAL
+#include "platform_config.h"
+#include "xil_cache.h"
+#ifndef CPU_MHZ
+#define CPU_MHZ 100
+#endif
+#define LAYER_MS(c) ((double)(c)/((double)CPU_MHZ*1000.0))
+/* xil_printf는 %f 미지원 → BARE_METAL에서는 정수 ms(%llu)만 사용 */
+#define LAYER_MS_INT(c) ((unsigned long long)((c) / ((uint64_t)CPU_MHZ * 1000ULL)))
+#define LAYER_LOG(i, cycles, ptr) CTX_LOG("  L%d %llu ms (0x%08X)\n", (i), LAYER_MS_INT(cycles), (unsigned)(*(const uint32_t*)(ptr)))
+#else
+#define LAYER_MS(c) ((c)/1000.0)
+#define LAYER_LOG(i, cycles, ptr) CTX_LOG("  L%d %.2f ms (0x%08X)\n", (i), LAYER_MS(cycles), (unsigned)(*(const uint32_t*)(ptr)))
+#endif
+
+/* 레이어 로그는 ctx->verbose일 때만 (벤치마크 반복 프레임은 끔) */
+#define CTX_LOG(...) do { if (ctx->verbose) YOLO_LOG(__VA_ARGS__); } while (0)
+#define LAYER_OPS(id) do { if (ctx->verbose) yolo_timing_print_layer_ops(id); } while (0)
+
+/* 연산 시간 기록과 풀 alloc 기록에 같은 레이어 번호. 스트리밍이면 레이어 가중치 확보 + 다음 레이어 미리 읽기 */
+#define SET_LAYER(id) do { \
+    yolo_timing_set_layer(id); feature_pool_set_layer(id); CSIM_LAYER(id); \
+    if (ctx->stream && weights_stream_layer(ctx->stream, id) != 0) { \
+        CTX_LOG("ERROR: Weights stream read failed (L%d)\n", (int)(id)); \
+        feature_pool_clear(); feature_pool_bind(prev_pool); \
+        return -1; \
+    } \
+} while (0)
+
+/* 이름 조회는 init 전용 (프레임 경로는 ctx->bind) */
+#define W(name) weights_get_tensor_data(&ctx->weights, name)
+
+/* 바인딩된 conv 가중치 → (ptr, scale, is_int8) 인자 3개 */
+#define BIND_W(cb) (cb)->w.data, (cb)->w.scale, (cb)->w.is_int8
+/* C3 cv1+cv2 합친 1x1 인자 (c3_nchw_f32_merged 순서: w, 출력 채널별 scale, bias) */
+#define BIND_C3_CV12(lb) (lb)->cv12_w, (lb)->cv12_s, (lb)->cv12_b
+/* C3 bottleneck 인자 (c3_nchw_f32 순서: n, cv1 w/scale/is_int8/bias, cv2 ...) */
+#define BIND_C3_M(lb) (lb)->n, (lb)->m_cv1w, (lb)->m_cv1s, (lb)->m_cv1i, (lb)->m_cv1b, \
+                      (lb)->m_cv2w, (lb)->m_cv2s, (lb)->m_cv2i, (lb)->m_cv2b
+
+/* 레이어별 가중치 종류: 1..3 = C3 (bottleneck 수), 0 = 없음 (Upsample/Concat) */
+#define BIND_CONV   (-1)
+#define BIND_SPPF   (-2)
+#define BIND_DETECT (-3)
+static const int8_t LAYER_BIND[YOLO_NUM_LAYERS + 1] = {
+    BIND_CONV, BIND_CONV, 1, BIND_CONV, 2, BIND_CONV, 3, BIND_CONV, 1, BIND_SPPF,  /* L0..L9 */
+    BIND_CONV, 0, 0, 1, BIND_CONV, 0, 0, 1, BIND_CONV, 0, 1, BIND_CONV, 0, 1,      /* L10..L23 */
+    BIND_DETECT};
+
+#ifdef YOLO_FIXED_POINT
+static const int32_t ANCHORS_Q[3][6] = {
+    {10, 13, 16, 30, 33, 23},
+    {30, 61, 62, 45, 59, 119},
+    {116, 90, 156, 198, 373, 326}
+};
+#else
+static const float ANCHORS[3][6] = {
+    {10.0f, 13.0f, 16.0f, 30.0f, 33.0f, 23.0f},
+    {30.0f, 61.0f, 62.0f, 45.0f, 59.0f, 119.0f},
+    {116.0f, 90.0f, 156.0f, 198.0f, 373.0f, 326.0f}
+};
+#endif
+
+/* Detect 출력 p3/p4/p5 (이미지 1장, float 개수): stride 8/16/32 격자 × 255 */
+#define HEAD_FLOATS(h, w) ((size_t)255 * ((size_t)((h) / 8) * ((w) / 8) + (size_t)((h) / 16) * ((w) / 16) + \
+                                          (size_t)((h) / 32) * ((w) / 32)))
+
+/* 배치 n, 입력 in_h x in_w용 풀 + 정적 메모리 계획: 피처맵/블록 임시 버퍼 수명 기반 오프셋 → 실행 중 alloc O(1).
+ * 같은 이벤트 열을 동적 할당자로 재생한 high-water와 함께 출력. 계획 실패 시 동적 할당 유지 */
+static int ctx_plan(yolo_ctx_t* ctx, int32_t n, int32_t in_h, int32_t in_w) {
+#ifdef BARE_METAL
+    if ((size_t)n * HEAD_FLOATS(in_h, in_w) * sizeof(float) > (size_t)DETECT_HEAD_SIZE) {
+        CTX_LOG("ERROR: batch %d x %dx%d exceeds DETECT_HEAD_SIZE\n", (int)n, (int)in_w, (int)in_h);
+        return -1;
+    }
+    const int head_in_pool = 0;  /* p3/p4/p5는 DETECT_HEAD_BASE */
+#else
+    /* 피처맵은 모두 n, 입력 면적에 비례 → 풀도 비례 (640x640 이하 1장은 기본 크기).
+     * 입력 픽셀당 바이트는 기본 크기/640² 올림 */
+    const size_t area = (size_t)in_h * (size_t)in_w, area_640 = (size_t)YOLO_INPUT_SIZE * YOLO_INPUT_SIZE;
+    size_t pool_size = FEATURE_POOL_HOST_SIZE;
+    if (area > area_640) pool_size = (FEATURE_POOL_HOST_SIZE / area_640 + 1u) * area;
+    pool_size *= (size_t)n;
+    if (ctx->pool && ctx->pool_size != pool_size) {
+        feature_pool_destroy(ctx->pool);
+        ctx->pool = NULL;
+    }
+    if (!ctx->pool) {
+        ctx->pool = feature_pool_create(NULL, pool_size);
+        if (!ctx->pool) return -1;
+        ctx->pool_size = pool_size;
+    }
+    const int head_in_pool = 1;
+#endif
+    ctx->batch = n;
+    ctx->in_h = in_h;
+    ctx->in_w = in_w;
+    ctx->plan_active = 0;
+    ctx->plan_high_water = 0;
+    feature_pool_t* prev_pool = feature_pool_bind(ctx->pool);
+    feature_pool_use_plan(NULL);
+    feature_pool_clear();  /* 이전 배치 계획 해제 → 빈 풀에서 dry run */
+#ifndef YOLO_NO_MEM_PLAN
+    if (mem_plan_build_yolov5n_shape(&ctx->plan, n, in_h, in_w, head_in_pool) == 0) {
+        ctx->plan_high_water = feature_pool_dry_run(&ctx->plan);
+        if (feature_pool_use_plan(&ctx->plan) == 0) {
+            ctx->plan_active = 1;
+            CTX_LOG("Pool plan (batch %d, %dx%d): %d tensors, planned peak %u KB (live %u KB), allocator high-water %u KB\n",
+                    (int)n, (int)in_w, (int)in_h, (int)ctx->plan.num_tensors, (unsigned)(ctx->plan.peak / 1024u),
+                    (unsigned)(ctx->plan.live_peak / 1024u), (unsigned)(ctx->plan_high_water / 1024u));
+        } else {
+            CTX_LOG("Pool plan: peak %u KB exceeds pool, using allocator\n", (unsigned)(ctx->plan.peak / 1024u));
+        }
+    }
+#else
+    (void)head_in_pool;
+#endif
+    feature_pool_bind(prev_pool);
+    return 0;
+}
+
+/* <prefix>.weight / <prefix>.bias → cb (bias는 FP32). 0 성공, -1 없음 */
+static int bind_conv(const weights_loader_t* wl, const char* prefix, yolo_conv_bind_t* cb) {
+    char name[64];
+    weights_ref_t b;
+    snprintf(name, sizeof(name), "%s.weight", prefix);
+    if (weights_bind(wl, name, &cb->w) != 0) return -1;
+#ifdef YOLO_FIXED_POINT
+    if (!cb->w.is_int8) return -1;  /* 정수 경로는 INT8 conv 가중치만 */
+#endif
+    snprintf(name, sizeof(name), "%s.bias", prefix);
+    if (weights_bind(wl, name, &b) != 0 || b.is_int8) return -1;
+    cb->b = (const float*)b.data;
+    cb->c_out = (int32_t)b.num_elements;
+    return 0;
+}
+
+/* 레이어별 가중치 이름 → 포인터/scale/dtype 1회 (프레임 경로는 ctx->bind만 읽음). 0 성공, -1 텐서 없음 */
+static int ctx_bind(yolo_ctx_t* ctx) {
+    const weights_loader_t* wl = &ctx->weights;
+    char prefix[48];
+    int32_t convs = 0;
+    memset(ctx->bind, 0, sizeof(ctx->bind));
+    for (int l = 0; l <= YOLO_NUM_LAYERS; l++) {
+        yolo_layer_bind_t* lb = &ctx->bind[l];
+        const int kind = LAYER_BIND[l];
+        if (kind == BIND_CONV) {
+            snprintf(prefix, sizeof(prefix), "model.%d.conv", l);
+            if (bind_conv(wl, prefix, &lb->cv[0]) != 0) return -1;
+            convs += 1;
+        } else if (kind == BIND_DETECT) {
+            for (int k = 0; k < 3; k++) {
+                snprintf(prefix, sizeof(prefix), "model.%d.m.%d", l, k);
+                if (bind_conv(wl, prefix, &lb->cv[k]) != 0) return -1;
+            }
+            convs += 3;
+        } else if (kind != 0) {
+            /* SPPF: cv1/cv2, C3: cv1/cv2/cv3 + bottleneck m.i.cv1/cv2 */
+            const int ncv = kind == BIND_SPPF ? 2 : 3;
+            for (int k = 0; k < ncv; k++) {
+                snprintf(prefix, sizeof(prefix), "model.%d.cv%d.conv", l, k + 1);
+                if (bind_conv(wl, prefix, &lb->cv[k]) != 0) return -1;
+            }
+            convs += ncv;
+            lb->n = kind > 0 ? kind : 0;
+            for (int m = 0; m < lb->n; m++) {
+                yolo_conv_bind_t c1, c2;
+                snprintf(prefix, sizeof(prefix), "model.%d.m.%d.cv1.conv", l, m);
+                if (bind_conv(wl, prefix, &c1) != 0) return -1;
+                snprintf(prefix, sizeof(prefix), "model.%d.m.%d.cv2.conv", l, m);
+                if (bind_conv(wl, prefix, &c2) != 0) return -1;
+                lb->m_cv1w[m] = c1.w.data; lb->m_cv1s[m] = c1.w.scale; lb->m_cv1i[m] = c1.w.is_int8; lb->m_cv1b[m] = c1.b;
+                lb->m_cv2w[m] = c2.w.data; lb->m_cv2s[m] = c2.w.scale; lb->m_cv2i[m] = c2.w.is_int8; lb->m_cv2b[m] = c2.b;
+            }
+            convs += 2 * lb->n;
+        }
+    }
+    ctx->bound_tensors = 2 * convs;
+    CTX_LOG("Weights bound: %d of %d tensors\n", (int)ctx->bound_tensors, (int)wl->num_tensors);
+    return 0;
+}
+
+/* C3 cv1+cv2 → 출력 채널 [cv1 | cv2]로 합친 가중치 (OIHW라 이어 붙이기만), bias, INT8이면 출력 채널별 scale.
+ * 전 레이어를 한 블록에 (float 먼저, INT8 가중치 뒤). 가중치가 상주하지 않거나(스트리밍) heap을 안 쓰는
+ * 정적 테이블이면, 또는 메모리 부족이면 건너뜀 → c3는 cv1/cv2 따로 (결과 같음) */
+static void ctx_merge_c3(yolo_ctx_t* ctx) {
+    if (ctx->stream || ctx->weights.embedded) return;
+    size_t f32_count = 0, i8_count = 0;
+    for (int l = 0; l < YOLO_NUM_LAYERS; l++) {
+        const yolo_layer_bind_t* lb = &ctx->bind[l];
+        if (LAYER_BIND[l] <= 0 || lb->cv[0].w.is_int8 != lb->cv[1].w.is_int8) continue;
+        const size_t oc = (size_t)(lb->cv[0].c_out + lb->cv[1].c_out);
+        const size_t we = lb->cv[0].w.num_elements + lb->cv[1].w.num_elements;
+        f32_count += oc + (lb->cv[0].w.is_int8 ? oc : we);
+        i8_count += lb->cv[0].w.is_int8 ? we : 0;
+    }
+    const size_t bytes = f32_count * sizeof(float) + i8_count;
+    float* f = (float*)malloc(bytes);
+    if (!f) {
+        CTX_LOG("C3 cv1+cv2 merge skipped (%u bytes)\n", (unsigned)bytes);
+        return;
+    }
+    int8_t* q = (int8_t*)(f + f32_count);
+    ctx->c3_merged = f;
+    ctx->c3_merged_bytes = bytes;
+    for (int l = 0; l < YOLO_NUM_LAYERS; l++) {
+        yolo_layer_bind_t* lb = &ctx->bind[l];
+        if (LAYER_BIND[l] <= 0 || lb->cv[0].w.is_int8 != lb->cv[1].w.is_int8) continue;
+        const yolo_conv_bind_t* c1 = &lb->cv[0];
+        const yolo_conv_bind_t* c2 = &lb->cv[1];
+        memcpy(f, c1->b, (size_t)c1->c_out * sizeof(float));
+        memcpy(f + c1->c_out, c2->b, (size_t)c2->c_out * sizeof(float));
+        lb->cv12_b = f;
+        f += c1->c_out + c2->c_out;
+        if (c1->w.is_int8) {
+            for (int32_t i = 0; i < c1->c_out; i++) f[i] = c1->w.scale;
+            for (int32_t i = 0; i < c2->c_out; i++) f[c1->c_out + i] = c2->w.scale;
+            lb->cv12_s = f;
+            f += c1->c_out + c2->c_out;
+            memcpy(q, c1->w.data, c1->w.num_elements);
+            memcpy(q + c1->w.num_elements, c2->w.data, c2->w.num_elements);
+            lb->cv12_w = q;
+            q += c1->w.num_elements + c2->w.num_elements;
+        } else {
+            memcpy(f, c1->w.data, c1->w.num_elements * sizeof(float));
+            memcpy(f + c1->w.num_elements, c2->w.data, c2->w.num_elements * sizeof(float));
+            lb->cv12_w = f;
+            f += c1->w.num_elements + c2->w.num_elements;
+        }
+    }
+    CTX_LOG("C3 cv1+cv2 merged: %u bytes\n", (unsigned)bytes);
+}
+
+/* 가중치 로드 후 공통: 가중치 바인딩 + 풀 생성 + 배치 1 계획 + NMS workspace 분할 */
+static int ctx_setup(yolo_ctx_t* ctx) {
+    ctx->verbose = YOLO_VERBOSE;
+    ctx->conf_threshold = YOLO_CONF_THRESHOLD;
+    ctx->iou_threshold = YOLO_IOU_THRESHOLD;
+#ifdef BARE_METAL
+    feature_pool_init();  /* FEATURE_POOL_BASE (기본 풀) */
+    ctx->pool = NULL;
+#endif
+    if (ctx_bind(ctx) != 0) return -1;
+    ctx_merge_c3(ctx);
+#ifndef YOLO_FIXED_POINT
+    {   /* uint8 이미지: 정규화(/255)를 L0 가중치에 접어 둠 → 입력 변환 패스 없음 */
+        const weights_ref_t* w0 = &ctx->bind[0].cv[0].w;
+        conv2d_fold_u8_weights(w0->data, w0->scale, w0->is_int8, 16, 3, 6, 6, ctx->stem_w_u8);
+    }
+#endif
+    if (nms_workspace_init(&ctx->nms_ws, ctx->nms_scratch, sizeof(ctx->nms_scratch),
+                           YOLO_MAX_DETECTIONS, YOLO_NUM_CLASSES) != 0)
+        return -1;
+    return ctx_plan(ctx, 1, YOLO_INPUT_SIZE, YOLO_INPUT_SIZE);
+}
+
+#ifndef BARE_METAL
+int yolo_ctx_init_from_file(yolo_ctx_t* ctx, const char* weights_path) {
+    if (!ctx || !weights_path) return -1;
+    memset(ctx, 0, sizeof(*ctx));
+#ifdef USE_WEIGHTS_W8
+    if (weights_load_from_file_w8(weights_path, &ctx->weights) != 0) return -1;
+#else
+    if (weights_load_from_file(weights_path, &ctx->weights) != 0) return -1;
+#endif
+    if (ctx_setup(ctx) != 0) {
+        yolo_ctx_destroy(ctx);
+        return -1;
+    }
+    return 0;
+}
+#endif
+
+int yolo_ctx_init_from_memory(yolo_ctx_t* ctx, uintptr_t weights_base, size_t weights_size) {
+    if (!ctx) return -1;
+    memset(ctx, 0, sizeof(*ctx));
+#ifdef USE_WEIGHTS_W8
+#ifdef BARE_METAL
+    if (weights_init_from_memory_w8(weights_base, weights_size, &ctx->weights) != 0) return -1;
+#else
+    (void)weights_base;
+    (void)weights_size;
+    return -1;
+#endif
+#else
+    if (weights_init_from_memory(weights_base, weights_size, &ctx->weights) != 0) return -1;
+#endif
+#ifdef BARE_METAL
+    {
+        const float* bias24 = (const float*)W("model.24.m.0.bias");
+        if (bias24) {
+            uint32_t u0 = *(const uint32_t*)&bias24[0];
+            uint32_t u4 = *(const uint32_t*)&bias24[4];
+            YOLO_LOG("DBG model.24.m.0.bias @0x%08X [0]=0x%08X [4]=0x%08X\n",
+                     (unsigned)(uintptr_t)bias24, (unsigned)u0, (unsigned)u4);
+        }
+    }
+#endif
+    if (ctx_setup(ctx) != 0) {
+        yolo_ctx_destroy(ctx);
+        return -1;
+    }
+    return 0;
+}
+
+/* 스트림 open 후: L0 확보 (init에서 stem_w_u8로 접음) → 공통 setup */
+static int ctx_setup_streaming(yolo_ctx_t* ctx) {
+    if (!ctx->stream || weights_stream_layer(ctx->stream, 0) != 0 || ctx_setup(ctx) != 0) {
+        yolo_ctx_destroy(ctx);
+        return -1;
+    }
+    return 0;
+}
+
+#ifndef BARE_METAL
+int yolo_ctx_init_streaming_file(yolo_ctx_t* ctx, const char* path) {
+    if (!ctx || !path) return -1;
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->stream = weights_stream_open_file(path, &ctx->weights);
+    return ctx_setup_streaming(ctx);
+}
+#endif
+
+int yolo_ctx_init_streaming_memory(yolo_ctx_t* ctx, const void* base, size_t size) {
+    if (!ctx || !base) return -1;
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->stream = weights_stream_open_memory(base, size, &ctx->weights);
+    return ctx_setup_streaming(ctx);
+}
+
+#ifdef YOLO_EMBEDDED_MODEL
+int yolo_ctx_init_embedded(yolo_ctx_t* ctx) {
+    if (!ctx) return -1;
+    memset(ctx, 0, sizeof(*ctx));
+    if (weights_init_embedded(&ctx->weights) != 0) return -1;
+    if (ctx_setup(ctx) != 0) {
+        yolo_ctx_destroy(ctx);
+        return -1;
+    }
+    return 0;
+}
+#endif
+
+void yolo_ctx_destroy(yolo_ctx_t* ctx) {
+    if (!ctx) return;
+    if (ctx->pool) {
+        feature_pool_destroy(ctx->pool);
+        ctx->pool = NULL;
+    } else {
+        feature_pool_t* prev_pool = feature_pool_bind(NULL);
+        feature_pool_reset();
+        feature_pool_bind(prev_pool);
+    }
+    weights_stream_close(ctx->stream);  /* reader 종료 후 (loader가 슬롯/메타데이터를 가리킴) */
+    ctx->stream = NULL;
+    weights_free(&ctx->weights);
+    free(ctx->c3_merged);
+    ctx->c3_merged = NULL;
+    ctx->c3_merged_bytes = 0;
+    ctx->plan_active = 0;
+}
+
+int yolo_ctx_set_input(yolo_ctx_t* ctx, int32_t n, int32_t in_h, int32_t in_w) {
+    if (!ctx || n <= 0 || in_h < 32 || in_w < 32 || in_h % 32 != 0 || in_w % 32 != 0) return -1;
+    if (n == ctx->batch && in_h == ctx->in_h && in_w == ctx->in_w) return 0;
+    return ctx_plan(ctx, n, in_h, in_w);
+}
+
+int yolo_ctx_set_batch(yolo_ctx_t* ctx, int32_t n) {
+    if (!ctx) return -1;
+    return yolo_ctx_set_input(ctx, n, ctx->in_h, ctx->in_w);
+}
+
+int yolo_infer(yolo_ctx_t* ctx, const preprocessed_image_t* img,
+               detection_t* out, int32_t max_out, int32_t* num_out) {
+    return yolo_infer_batch(ctx, &img, 1, out, max_out, num_out);
+}
+
+int yolo_infer_batch(yolo_ctx_t* ctx, const preprocessed_image_t* const* imgs, int32_t n,
+                     detection_t* out, int32_t max_out, int32_t* num_out) {
+    if (!ctx || !imgs || n <= 0 || !out || max_out <= 0 || !num_out || !imgs[0]) return -1;
+    /* 배치 안 이미지는 같은 크기 (3 x in_h x in_w, 32의 배수). 픽셀 형식은 이미지마다 달라도 됨 (L0만 다름) */
+    const int32_t in_h = imgs[0]->h, in_w = imgs[0]->w;
+    for (int32_t i = 0; i < n; i++) {
+        if (!imgs[i] || imgs[i]->c != 3 || imgs[i]->h != in_h || imgs[i]->w != in_w) return -1;
+        if (imgs[i]->format == IMAGE_FMT_F32_CHW ? !imgs[i]->data : !imgs[i]->data_u8) return -1;
+        num_out[i] = 0;
+    }
+    if (yolo_ctx_set_input(ctx, n, in_h, in_w) != 0) return -1;
+    yolo_profile_t* prof = &ctx->profile;
+    yolo_layer_bind_t* wb = ctx->bind;
+    /* stride 2/4/8/16/32 출력 크기 (640x640: 320/160/80/40/20) */
+    const int32_t h2 = in_h / 2, w2 = in_w / 2, h4 = in_h / 4, w4 = in_w / 4, h8 = in_h / 8, w8 = in_w / 8;
+    const int32_t h16 = in_h / 16, w16 = in_w / 16, h32 = in_h / 32, w32 = in_w / 32;
+
+    /* 3x3 conv 입력(l0/l2/l4/l6/l17/l20)은 halo 레이아웃 → 다음 conv가 경계 분기 없이 fast path */
+    size_t sz_l0  = HALO_BYTES(n, 16, h2, w2, FMAP_HALO);
+    size_t sz_l1  = (size_t)n * 32 * h4 * w4 * sizeof(float);
+    size_t sz_l2  = HALO_BYTES(n, 32, h4, w4, FMAP_HALO);
+    size_t sz_l3  = (size_t)n * 64 * h8 * w8 * sizeof(float);
+    size_t sz_l4  = HALO_BYTES(n, 64, h8, w8, FMAP_HALO);
+    size_t sz_l5  = (size_t)n * 128 * h16 * w16 * sizeof(float);
+    size_t sz_l6  = HALO_BYTES(n, 128, h16, w16, FMAP_HALO);
+    size_t sz_l7  = (size_t)n * 256 * h32 * w32 * sizeof(float);
+    size_t sz_l8  = (size_t)n * 256 * h32 * w32 * sizeof(float);
+    size_t sz_l9  = (size_t)n * 256 * h32 * w32 * sizeof(float);
+    size_t sz_l10 = (size_t)n * 128 * h32 * w32 * sizeof(float);
+    size_t sz_l11 = (size_t)n * 128 * h16 * w16 * sizeof(float);
+    size_t sz_l12 = (size_t)n * 256 * h16 * w16 * sizeof(float);
+    size_t sz_l13 = (size_t)n * 128 * h16 * w16 * sizeof(float);
+    size_t sz_l14 = (size_t)n * 64 * h16 * w16 * sizeof(float);
+    size_t sz_l15 = (size_t)n * 64 * h8 * w8 * sizeof(float);
+    size_t sz_l16 = (size_t)n * 128 * h8 * w8 * sizeof(float);
+    size_t sz_l17 = HALO_BYTES(n, 64, h8, w8, FMAP_HALO);
+    size_t sz_l18 = (size_t)n * 64 * h16 * w16 * sizeof(float);
+    size_t sz_l19 = (size_t)n * 128 * h16 * w16 * sizeof(float);
+    size_t sz_l20 = HALO_BYTES(n, 128, h16, w16, FMAP_HALO);
+    size_t sz_l21 = (size_t)n * 128 * h32 * w32 * sizeof(float);
+    size_t sz_l22 = (size_t)n * 256 * h32 * w32 * sizeof(float);
+    size_t sz_l23 = (size_t)n * 256 * h32 * w32 * sizeof(float);
+    size_t sz_p3  = (size_t)n * 255 * h8 * w8 * sizeof(float);
+    size_t sz_p4  = (size_t)n * 255 * h16 * w16 * sizeof(float);
+    size_t sz_p5  = (size_t)n * 255 * h32 * w32 * sizeof(float);
+
+    float* l0 = NULL, * l1 = NULL, * l2 = NULL, * l3 = NULL, * l4 = NULL;
+    float* l5 = NULL, * l6 = NULL, * l7 = NULL, * l8 = NULL, * l9 = NULL;
+    float* l10 = NULL, * l11 = NULL, * l12 = NULL, * l13 = NULL, * l14 = NULL;
+    float* l15 = NULL, * l16 = NULL, * l17 = NULL, * l18 = NULL, * l19 = NULL;
+    float* l20 = NULL, * l21 = NULL, * l22 = NULL, * l23 = NULL;
+    float* p3 = NULL, * p4 = NULL, * p5 = NULL;
+    /* halo 피처맵의 풀 블록 (l0 등은 내부 포인터) */
+    float* l0_buf = NULL, * l2_buf = NULL, * l4_buf = NULL, * l6_buf = NULL, * l17_buf = NULL, * l20_buf = NULL;
+
+/* 실패 시 풀 비우고(다음 프레임 재사용 가능) 바인딩 복구 */
+#define POOL_ALLOC(ptr, sz) do { \
+    (ptr) = (float*)feature_pool_alloc(sz); \
+    if (!(ptr)) { \
+        CTX_LOG("ERROR: Feature pool allocation failed\n"); \
+        feature_pool_clear(); feature_pool_bind(prev_pool); \
+        return -1; \
+    } \
+} while(0)
+/* halo 레이아웃: 풀 블록 할당 → 테두리 0 → 내부 포인터 */
+#define POOL_ALLOC_HALO(buf, ptr, sz, c, h, w) do { \
+    POOL_ALLOC(buf, sz); \
+    halo_clear_border((buf), n * (c), (h), (w), FMAP_HALO); \
+    (ptr) = halo_interior((buf), (w), FMAP_HALO); \
+} while(0)
+
+#ifdef BARE_METAL
+    {
+        const void* pw = wb[0].cv[0].w.data;  /* W8이면 INT8 원시 4바이트 */
+        uint32_t u_img = imgs[0]->data ? *(const uint32_t*)imgs[0]->data : (uint32_t)imgs[0]->data_u8[0];
+        uint32_t u_w   = pw ? *(const uint32_t*)pw : 0u;
+        CTX_LOG("DBG img[0]=0x%08X w0[0]=0x%08X\n", (unsigned)u_img, (unsigned)u_w);
+    }
+#endif
+    CTX_LOG("Running inference...\n");
+    feature_pool_t* prev_pool = feature_pool_bind(ctx->pool);
+    yolo_timing_reset();
+    feature_pool_plan_rewind();
+    conv2d_reset_border_tiles();
+    uint64_t t_total_start = timer_read64();
+    uint64_t t_stage_start;
+    uint64_t t_layer;
+
+    CTX_LOG("Backbone: ");
+
+    // ===== Backbone =====
+    t_stage_start = timer_read64();
+    SET_LAYER(0);
+    // Layer 0: Conv 6x6 s2 (입력은 이미지별 버퍼 → 배치로 복사하지 않고 이미지마다 l0의 자기 자리에)
+    // uint8 이미지는 픽셀을 직접 읽음 (/255는 stem_w_u8에 접힘)
+    POOL_ALLOC_HALO(l0_buf, l0, sz_l0, 16, h2, w2);
+    t_layer = timer_read64();
+    { const yolo_conv_bind_t* cb = &wb[0].cv[0];
+      for (int32_t i = 0; i < n; i++) {
+          const preprocessed_image_t* im = imgs[i];
+          float* y0 = l0 + (size_t)i * 16 * HALO_PLANE(h2, w2, FMAP_HALO);
+#ifdef YOLO_FIXED_POINT
+          /* 정수 경로: 픽셀 → Q (uint8 /255 표, FP32 비트 변환), INT8 가중치 원본 */
+          if (im->format == IMAGE_FMT_U8_HWC)
+              conv_block_image_q_halo(im->data_u8, NULL, 1, in_w * 3, 3, 3, in_h, in_w,
+                  (const int8_t*)cb->w.data, cb->w.scale, 16, 6, 6, 2, 2, 2, 2, cb->b, (int32_t*)y0, FMAP_HALO, h2, w2);
+          else if (im->format == IMAGE_FMT_U8_CHW)
+              conv_block_image_q_halo(im->data_u8, NULL, in_h * in_w, in_w, 1, 3, in_h, in_w,
+                  (const int8_t*)cb->w.data, cb->w.scale, 16, 6, 6, 2, 2, 2, 2, cb->b, (int32_t*)y0, FMAP_HALO, h2, w2);
+          else
+              conv_block_image_q_halo(NULL, im->data, in_h * in_w, in_w, 1, 3, in_h, in_w,
+                  (const int8_t*)cb->w.data, cb->w.scale, 16, 6, 6, 2, 2, 2, 2, cb->b, (int32_t*)y0, FMAP_HALO, h2, w2);
+#else
+          if (im->format == IMAGE_FMT_U8_HWC)
+              conv_block_u8_f32_halo(im->data_u8, 1, in_w * 3, 3, 3, in_h, in_w, ctx->stem_w_u8, 16, 6, 6, 2, 2, 2, 2,
+                  cb->b, y0, FMAP_HALO, h2, w2);
+          else if (im->format == IMAGE_FMT_U8_CHW)
+              conv_block_u8_f32_halo(im->data_u8, in_h * in_w, in_w, 1, 3, in_h, in_w, ctx->stem_w_u8, 16, 6, 6, 2, 2, 2, 2,
+                  cb->b, y0, FMAP_HALO, h2, w2);
+          else
+              conv_block_nchw_f32_halo(im->data, 0, 1, 3, in_h, in_w, BIND_W(cb), 16, 6, 6, 2, 2, 2, 2,
+                  cb->b, y0, FMAP_HALO, h2, w2);
+#endif
+      } }
+    prof->layer[0] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(0, prof->layer[0], &l0[0]);
+    LAYER_OPS(0);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l0, 16);
+#endif
+
+    SET_LAYER(1);
+    // Layer 1: Conv 3x3 s2
+    POOL_ALLOC(l1, sz_l1);
+    t_layer = timer_read64();
+    { const yolo_conv_bind_t* cb = &wb[1].cv[0];
+      conv_block_nchw_f32_halo(l0, FMAP_HALO, n, 16, h2, w2, BIND_W(cb), 32, 3, 3, 2, 2, 1, 1,
+          cb->b, l1, 0, h4, w4); }
+    prof->layer[1] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(1, prof->layer[1], &l1[0]);
+    LAYER_OPS(1);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l1, 16);
+#endif
+    feature_pool_free(l0_buf);
+
+    SET_LAYER(2);
+    // Layer 2: C3 (n=1)
+#ifdef BARE_METAL
+    { size_t largest = feature_pool_get_largest_free(); CTX_LOG("  before L2 pool largest_free=%u\n", (unsigned)largest); }
+#endif
+    POOL_ALLOC_HALO(l2_buf, l2, sz_l2, 32, h4, w4);
+    { yolo_layer_bind_t* lb = &wb[2];
+      t_layer = timer_read64();
+      c3_nchw_f32_merged(l1, n, 32, h4, w4,
+          BIND_W(&lb->cv[0]), 16, lb->cv[0].b,
+          BIND_W(&lb->cv[1]), 16, lb->cv[1].b, BIND_C3_CV12(lb),
+          BIND_W(&lb->cv[2]), 32, lb->cv[2].b,
+          BIND_C3_M(lb), 1, l2, FMAP_HALO);
+      prof->layer[2] = timer_delta64(t_layer, timer_read64());
+    }
+    LAYER_LOG(2, prof->layer[2], &l2[0]);
+    LAYER_OPS(2);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l2, 16);
+#endif
+    feature_pool_free(l1);
+
+    SET_LAYER(3);
+    // Layer 3: Conv 3x3 s2
+    POOL_ALLOC(l3, sz_l3);
+    t_layer = timer_read64();
+    { const yolo_conv_bind_t* cb = &wb[3].cv[0];
+      conv_block_nchw_f32_halo(l2, FMAP_HALO, n, 32, h4, w4, BIND_W(cb), 64, 3, 3, 2, 2, 1, 1,
+          cb->b, l3, 0, h8, w8); }
+    prof->layer[3] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(3, prof->layer[3], &l3[0]);
+    LAYER_OPS(3);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l3, 16);
+#endif
+    feature_pool_free(l2_buf);
+
+    SET_LAYER(4);
+    // Layer 4: C3 (n=2)
+    POOL_ALLOC_HALO(l4_buf, l4, sz_l4, 64, h8, w8);
+    { yolo_layer_bind_t* lb = &wb[4];
+      t_layer = timer_read64();
+      c3_nchw_f32_merged(l3, n, 64, h8, w8, BIND_W(&lb->cv[0]), 32, lb->cv[0].b, BIND_W(&lb->cv[1]), 32, lb->cv[1].b, BIND_C3_CV12(lb), BIND_W(&lb->cv[2]), 64, lb->cv[2].b,
+          BIND_C3_M(lb), 1, l4, FMAP_HALO);
+      prof->layer[4] = timer_delta64(t_layer, timer_read64());
+    }
+    LAYER_LOG(4, prof->layer[4], &l4[0]);
+    LAYER_OPS(4);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l4, 16);
+#endif
+    feature_pool_free(l3);
+
+    SET_LAYER(5);
+    // Layer 5: Conv 3x3 s2
+    POOL_ALLOC(l5, sz_l5);
+    t_layer = timer_read64();
+    { const yolo_conv_bind_t* cb = &wb[5].cv[0];
+      conv_block_nchw_f32_halo(l4, FMAP_HALO, n, 64, h8, w8, BIND_W(cb), 128, 3, 3, 2, 2, 1, 1,
+          cb->b, l5, 0, h16, w16); }
+    prof->layer[5] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(5, prof->layer[5], &l5[0]);
+    LAYER_OPS(5);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l5, 16);
+#endif
+
+    SET_LAYER(6);
+    // Layer 6: C3 (n=3)
+    POOL_ALLOC_HALO(l6_buf, l6, sz_l6, 128, h16, w16);
+    { yolo_layer_bind_t* lb = &wb[6];
+      t_layer = timer_read64();
+      c3_nchw_f32_merged(l5, n, 128, h16, w16, BIND_W(&lb->cv[0]), 64, lb->cv[0].b, BIND_W(&lb->cv[1]), 64, lb->cv[1].b, BIND_C3_CV12(lb), BIND_W(&lb->cv[2]), 128, lb->cv[2].b,
+          BIND_C3_M(lb), 1, l6, FMAP_HALO);
+      prof->layer[6] = timer_delta64(t_layer, timer_read64());
+    }
+    LAYER_LOG(6, prof->layer[6], &l6[0]);
+    LAYER_OPS(6);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l6, 16);
+#endif
+    feature_pool_free(l5);
+
+    SET_LAYER(7);
+    // Layer 7: Conv 3x3 s2
+    POOL_ALLOC(l7, sz_l7);
+    t_layer = timer_read64();
+    { const yolo_conv_bind_t* cb = &wb[7].cv[0];
+      conv_block_nchw_f32_halo(l6, FMAP_HALO, n, 128, h16, w16, BIND_W(cb), 256, 3, 3, 2, 2, 1, 1,
+          cb->b, l7, 0, h32, w32); }
+    prof->layer[7] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(7, prof->layer[7], &l7[0]);
+    LAYER_OPS(7);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l7, 16);
+#endif
+
+    SET_LAYER(8);
+    // Layer 8: C3 (n=1)
+    POOL_ALLOC(l8, sz_l8);
+    { yolo_layer_bind_t* lb = &wb[8];
+      t_layer = timer_read64();
+      c3_nchw_f32_merged(l7, n, 256, h32, w32, BIND_W(&lb->cv[0]), 128, lb->cv[0].b, BIND_W(&lb->cv[1]), 128, lb->cv[1].b, BIND_C3_CV12(lb), BIND_W(&lb->cv[2]), 256, lb->cv[2].b,
+          BIND_C3_M(lb), 1, l8, 0);
+      prof->layer[8] = timer_delta64(t_layer, timer_read64());
+    }
+    LAYER_LOG(8, prof->layer[8], &l8[0]);
+    LAYER_OPS(8);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l8, 16);
+#endif
+    feature_pool_free(l7);
+
+    SET_LAYER(9);
+    // Layer 9: SPPF
+    POOL_ALLOC(l9, sz_l9);
+    t_layer = timer_read64();
+    sppf_nchw_f32(l8, n, 256, h32, w32,
+        BIND_W(&wb[9].cv[0]), 128, wb[9].cv[0].b,
+        BIND_W(&wb[9].cv[1]), 256, wb[9].cv[1].b,
+        5, l9);
+    prof->layer[9] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(9, prof->layer[9], &l9[0]);
+    LAYER_OPS(9);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l9, 16);
+#endif
+    feature_pool_free(l8);
+    prof->backbone = timer_delta64(t_stage_start, timer_read64());
+
+    // ===== Neck =====
+    CTX_LOG("\nNeck: ");
+    t_stage_start = timer_read64();
+    SET_LAYER(10);
+    // Layer 10: Conv 1x1
+    POOL_ALLOC(l10, sz_l10);
+    t_layer = timer_read64();
+    { const yolo_conv_bind_t* cb = &wb[10].cv[0];
+      conv_block_nchw_f32(l9, n, 256, h32, w32, BIND_W(cb), 128, 1, 1, 1, 1, 0, 0,
+          cb->b, l10, h32, w32); }
+    prof->layer[10] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(10, prof->layer[10], &l10[0]);
+    LAYER_OPS(10);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l10, 16);
+#endif
+    feature_pool_free(l9);
+
+    SET_LAYER(11);
+    // Layer 11: Upsample
+    POOL_ALLOC(l11, sz_l11);
+    t_layer = timer_read64();
+    upsample_nearest2x_nchw_f32(l10, n, 128, h32, w32, l11);
+    prof->layer[11] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(11, prof->layer[11], &l11[0]);
+    LAYER_OPS(11);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l11, 16);
+#endif
+
+    SET_LAYER(12);
+    // Layer 12: Concat (l11 + l6)
+    POOL_ALLOC(l12, sz_l12);
+    t_layer = timer_read64();
+    yolo_timing_begin("concat");
+    concat_nchw_f32_halo(l11, 128, 0, l6, 128, FMAP_HALO, n, h16, w16, l12);
+    yolo_timing_end();
+    prof->layer[12] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(12, prof->layer[12], &l12[0]);
+    LAYER_OPS(12);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l12, 16);
+#endif
+    feature_pool_free(l11);
+    feature_pool_free(l6_buf);
+
+    SET_LAYER(13);
+    // Layer 13: C3 (n=1)
+    POOL_ALLOC(l13, sz_l13);
+    { yolo_layer_bind_t* lb = &wb[13];
+      t_layer = timer_read64();
+      c3_nchw_f32_merged(l12, n, 256, h16, w16, BIND_W(&lb->cv[0]), 64, lb->cv[0].b, BIND_W(&lb->cv[1]), 64, lb->cv[1].b, BIND_C3_CV12(lb), BIND_W(&lb->cv[2]), 128, lb->cv[2].b,
+          BIND_C3_M(lb), 0, l13, 0);
+      prof->layer[13] = timer_delta64(t_layer, timer_read64());
+    }
+    LAYER_LOG(13, prof->layer[13], &l13[0]);
+    LAYER_OPS(13);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l13, 16);
+#endif
+    feature_pool_free(l12);
+
+    SET_LAYER(14);
+    // Layer 14: Conv 1x1
+    POOL_ALLOC(l14, sz_l14);
+    t_layer = timer_read64();
+    { const yolo_conv_bind_t* cb = &wb[14].cv[0];
+      conv_block_nchw_f32(l13, n, 128, h16, w16, BIND_W(cb), 64, 1, 1, 1, 1, 0, 0,
+          cb->b, l14, h16, w16); }
+    prof->layer[14] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(14, prof->layer[14], &l14[0]);
+    LAYER_OPS(14);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l14, 16);
+#endif
+    feature_pool_free(l13);
+
+    SET_LAYER(15);
+    // Layer 15: Upsample
+    POOL_ALLOC(l15, sz_l15);
+    t_layer = timer_read64();
+    upsample_nearest2x_nchw_f32(l14, n, 64, h16, w16, l15);
+    prof->layer[15] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(15, prof->layer[15], &l15[0]);
+    LAYER_OPS(15);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l15, 16);
+#endif
+
+    SET_LAYER(16);
+    // Layer 16: Concat (l15 + l4)
+    POOL_ALLOC(l16, sz_l16);
+    t_layer = timer_read64();
+    yolo_timing_begin("concat");
+    concat_nchw_f32_halo(l15, 64, 0, l4, 64, FMAP_HALO, n, h8, w8, l16);
+    yolo_timing_end();
+    prof->layer[16] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(16, prof->layer[16], &l16[0]);
+    LAYER_OPS(16);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l16, 16);
+#endif
+    feature_pool_free(l15);
+    feature_pool_free(l4_buf);
+
+    SET_LAYER(17);
+    // Layer 17: C3 (n=1) -> P3
+    POOL_ALLOC_HALO(l17_buf, l17, sz_l17, 64, h8, w8);
+    { yolo_layer_bind_t* lb = &wb[17];
+      t_layer = timer_read64();
+      c3_nchw_f32_merged(l16, n, 128, h8, w8, BIND_W(&lb->cv[0]), 32, lb->cv[0].b, BIND_W(&lb->cv[1]), 32, lb->cv[1].b, BIND_C3_CV12(lb), BIND_W(&lb->cv[2]), 64, lb->cv[2].b,
+          BIND_C3_M(lb), 0, l17, FMAP_HALO);
+      prof->layer[17] = timer_delta64(t_layer, timer_read64());
+    }
+    LAYER_LOG(17, prof->layer[17], &l17[0]);
+    LAYER_OPS(17);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l17, 16);
+#endif
+    feature_pool_free(l16);
+
+    SET_LAYER(18);
+    // Layer 18: Conv 3x3 s2
+    POOL_ALLOC(l18, sz_l18);
+    t_layer = timer_read64();
+    { const yolo_conv_bind_t* cb = &wb[18].cv[0];
+      conv_block_nchw_f32_halo(l17, FMAP_HALO, n, 64, h8, w8, BIND_W(cb), 64, 3, 3, 2, 2, 1, 1,
+          cb->b, l18, 0, h16, w16); }
+    prof->layer[18] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(18, prof->layer[18], &l18[0]);
+    LAYER_OPS(18);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l18, 16);
+#endif
+
+    SET_LAYER(19);
+    // Layer 19: Concat (l18 + l14)
+    POOL_ALLOC(l19, sz_l19);
+    t_layer = timer_read64();
+    yolo_timing_begin("concat");
+    concat_nchw_f32(l18, 64, l14, 64, n, h16, w16, l19);
+    yolo_timing_end();
+    prof->layer[19] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(19, prof->layer[19], &l19[0]);
+    LAYER_OPS(19);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l19, 16);
+#endif
+    feature_pool_free(l18);
+    feature_pool_free(l14);
+
+    SET_LAYER(20);
+    // Layer 20: C3 (n=1) -> P4
+    POOL_ALLOC_HALO(l20_buf, l20, sz_l20, 128, h16, w16);
+    { yolo_layer_bind_t* lb = &wb[20];
+      t_layer = timer_read64();
+      c3_nchw_f32_merged(l19, n, 128, h16, w16, BIND_W(&lb->cv[0]), 64, lb->cv[0].b, BIND_W(&lb->cv[1]), 64, lb->cv[1].b, BIND_C3_CV12(lb), BIND_W(&lb->cv[2]), 128, lb->cv[2].b,
+          BIND_C3_M(lb), 0, l20, FMAP_HALO);
+      prof->layer[20] = timer_delta64(t_layer, timer_read64());
+    }
+    LAYER_LOG(20, prof->layer[20], &l20[0]);
+    LAYER_OPS(20);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l20, 16);
+#endif
+    feature_pool_free(l19);
+
+    SET_LAYER(21);
+    // Layer 21: Conv 3x3 s2
+    POOL_ALLOC(l21, sz_l21);
+    t_layer = timer_read64();
+    { const yolo_conv_bind_t* cb = &wb[21].cv[0];
+      conv_block_nchw_f32_halo(l20, FMAP_HALO, n, 128, h16, w16, BIND_W(cb), 128, 3, 3, 2, 2, 1, 1,
+          cb->b, l21, 0, h32, w32); }
+    prof->layer[21] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(21, prof->layer[21], &l21[0]);
+    LAYER_OPS(21);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l21, 16);
+#endif
+
+    SET_LAYER(22);
+    // Layer 22: Concat (l21 + l10)
+    POOL_ALLOC(l22, sz_l22);
+    t_layer = timer_read64();
+    yolo_timing_begin("concat");
+    concat_nchw_f32(l21, 128, l10, 128, n, h32, w32, l22);
+    yolo_timing_end();
+    prof->layer[22] = timer_delta64(t_layer, timer_read64());
+    LAYER_LOG(22, prof->layer[22], &l22[0]);
+    LAYER_OPS(22);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l22, 16);
+#endif
+    feature_pool_free(l21);
+    feature_pool_free(l10);
+
+    SET_LAYER(23);
+    // Layer 23: C3 (n=1) -> P5
+    POOL_ALLOC(l23, sz_l23);
+    { yolo_layer_bind_t* lb = &wb[23];
+      t_layer = timer_read64();
+      c3_nchw_f32_merged(l22, n, 256, h32, w32, BIND_W(&lb->cv[0]), 128, lb->cv[0].b, BIND_W(&lb->cv[1]), 128, lb->cv[1].b, BIND_C3_CV12(lb), BIND_W(&lb->cv[2]), 256, lb->cv[2].b,
+          BIND_C3_M(lb), 0, l23, 0);
+      prof->layer[23] = timer_delta64(t_layer, timer_read64());
+    }
+    LAYER_LOG(23, prof->layer[23], &l23[0]);
+    LAYER_OPS(23);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)l23, 16);
+#endif
+    feature_pool_free(l22);
+    prof->neck = timer_delta64(t_stage_start, timer_read64());
+
+    // ===== Detect Head =====
+    CTX_LOG("\nHead: ");
+    SET_LAYER(24);
+    t_stage_start = timer_read64();
+#ifdef BARE_METAL
+    (void)sz_p3;
+    (void)sz_p4;
+    (void)sz_p5;
+    p3 = (float*)DETECT_HEAD_BASE;
+    p4 = p3 + (size_t)n * (255 * h8 * w8);
+    p5 = p4 + (size_t)n * (255 * h16 * w16);
+#else
+    POOL_ALLOC(p3, sz_p3);
+    POOL_ALLOC(p4, sz_p4);
+    POOL_ALLOC(p5, sz_p5);
+#endif
+#undef POOL_ALLOC_HALO
+#undef POOL_ALLOC
+    { const yolo_layer_bind_t* lb = &wb[24];
+      detect_nchw_f32_halo(
+          n, l17, 64, h8, w8, l20, 128, h16, w16, l23, 256, h32, w32, FMAP_HALO, FMAP_HALO, 0,
+          BIND_W(&lb->cv[0]), lb->cv[0].b,
+          BIND_W(&lb->cv[1]), lb->cv[1].b,
+          BIND_W(&lb->cv[2]), lb->cv[2].b,
+          p3, p4, p5);
+    }
+    CTX_LOG("Detect\n");
+    prof->head = timer_delta64(t_stage_start, timer_read64());
+#ifdef BARE_METAL
+    CTX_LOG("  det %llu ms\n", LAYER_MS_INT(prof->head));
+#else
+    CTX_LOG("  det %.2f ms\n", LAYER_MS(prof->head));
+#endif
+    LAYER_OPS(24);
+#ifdef BARE_METAL
+    Xil_DCacheFlushRange((uintptr_t)DETECT_HEAD_BASE, (unsigned int)DETECT_HEAD_SIZE);
+    __sync_synchronize();
+#endif
+    feature_pool_free(l17_buf);
+    feature_pool_free(l20_buf);
+    feature_pool_free(l23);
+#ifndef BARE_METAL
+    feature_pool_free(p3);
+    feature_pool_free(p4);
+    feature_pool_free(p5);
+#endif
+    if (ctx->verbose) {
+        feature_pool_stats_t ps;
+        feature_pool_get_stats(&ps);
+        YOLO_LOG("  conv border-path tiles %u\n", (unsigned)conv2d_get_border_tiles());
+        YOLO_LOG("  pool high-water %u KB, peak live %u KB @ L%d, %d allocs (%d failed), free blocks %u, frag %d%%\n",
+                 (unsigned)(ps.high_water / 1024u), (unsigned)(ps.peak_live_bytes / 1024u), (int)ps.peak_layer,
+                 (int)ps.num_allocs, (int)ps.failed_allocs, (unsigned)ps.free_blocks,
+                 (int)(ps.peak_fragmentation * 100.0f));
+    }
+
+    // ===== Decode / NMS (이미지별) =====
+    /* 후처리 버퍼는 컨텍스트 안 (프레임마다 힙 할당 없음). 이미지 i의 Detect 출력은 p3/p4/p5 + i*255*h*w */
+    prof->decode = 0;
+    prof->nms = 0;
+    /* 격자 stride는 실제 입력/격자 크기에서 (32의 배수 입력이면 8/16/32) */
+#ifdef YOLO_FIXED_POINT
+    /* 정수 경로: 로짓 Q → 정수 decode/NMS, NMS 결과만 detection_t로 */
+    const int32_t strides_q[3] = {in_w / w8, in_w / w16, in_w / w32};
+    const int32_t conf_q15 = q_from_f32(ctx->conf_threshold, 15), iou_q15 = q_from_f32(ctx->iou_threshold, 15);
+#else
+    const float strides[3] = {(float)in_w / (float)w8, (float)in_w / (float)w16, (float)in_w / (float)w32};
+#endif
+    for (int32_t i = 0; i < n; i++) {
+        SET_LAYER(25);
+        t_stage_start = timer_read64();
+#ifdef YOLO_FIXED_POINT
+        int32_t num_dets = decode_nchw_q_hw(
+            (const int32_t*)p3 + (size_t)i * 255 * h8 * w8, h8, w8,
+            (const int32_t*)p4 + (size_t)i * 255 * h16 * w16, h16, w16,
+            (const int32_t*)p5 + (size_t)i * 255 * h32 * w32, h32, w32,
+            YOLO_NUM_CLASSES, conf_q15, strides_q, ANCHORS_Q, ctx->dets_q, YOLO_MAX_DETECTIONS);
+#else
+        int32_t num_dets = decode_nchw_f32_hw(
+            p3 + (size_t)i * 255 * h8 * w8, h8, w8,
+            p4 + (size_t)i * 255 * h16 * w16, h16, w16,
+            p5 + (size_t)i * 255 * h32 * w32, h32, w32,
+            YOLO_NUM_CLASSES, ctx->conf_threshold, in_h, in_w, strides, ANCHORS,
+            ctx->dets, YOLO_MAX_DETECTIONS);
+#endif
+        CTX_LOG("Decoded: %d detections\n", num_dets);
+        prof->decode += timer_delta64(t_stage_start, timer_read64());
+        if (i == 0) {
+            int do_dbg = 0;
+#ifdef BARE_METAL
+            do_dbg = (num_dets == 0);
+#else
+            do_dbg = 1;
+#endif
+            if (do_dbg) {
+                union { float f; uint32_t u; } u0 = { .f = p3[0] }, u1 = { .f = p3[1] }, u4 = { .f = p3[4 * h8 * w8] };
+                CTX_LOG("DBG p3[0]=0x%08X p3[1]=0x%08X p3[obj0]=0x%08X\n", (unsigned)u0.u, (unsigned)u1.u, (unsigned)u4.u);
+            }
+        }
+
+        // NMS (conf 정렬 포함)
+        SET_LAYER(26);
+        t_stage_start = timer_read64();
+#ifdef YOLO_FIXED_POINT
+        int32_t num_nms = 0;
+        if (nms_q(ctx->dets_q, num_dets, &ctx->nms_ws, iou_q15,
+                  max_out < YOLO_MAX_DETECTIONS ? max_out : YOLO_MAX_DETECTIONS,
+                  ctx->dets_q_out, &num_nms) != 0) {
+            CTX_LOG("ERROR: NMS failed\n");
+            num_nms = 0;
+        }
+        detection_q_to_f32(ctx->dets_q_out, num_nms, in_h, in_w, out + (size_t)i * max_out);
+#else
+        yolo_timing_begin("sort");
+        det_sort_by_conf(ctx->dets, num_dets);
+        yolo_timing_end();
+        int32_t num_nms = 0;
+        if (nms_bucketed(ctx->dets, num_dets, &ctx->nms_ws, ctx->iou_threshold,
+                         max_out < YOLO_MAX_DETECTIONS ? max_out : YOLO_MAX_DETECTIONS,
+                         out + (size_t)i * max_out, &num_nms) != 0) {
+            CTX_LOG("ERROR: NMS failed\n");
+            num_nms = 0;
+        }
+#endif
+        prof->nms += timer_delta64(t_stage_start, timer_read64());
+        num_out[i] = num_nms;
+    }
+#ifdef BARE_METAL
+    CTX_LOG("  dec %llu ms\n", LAYER_MS_INT(prof->decode));
+#else
+    CTX_LOG("  dec %.2f ms\n", LAYER_MS(prof->decode));
+#endif
+    LAYER_OPS(25);
+#ifdef BARE_METAL
+    CTX_LOG("  nms %llu ms\n", LAYER_MS_INT(prof->nms));
+#else
+    CTX_LOG("  nms %.2f ms\n", LAYER_MS(prof->nms));
+#endif
+    LAYER_OPS(26);
+    {
+        const uint64_t total = prof->total = timer_delta64(t_total_start, timer_read64());
+#ifdef BARE_METAL
+        {
+            CTX_LOG("[mcycle] backbone=%llu neck=%llu head=%llu decode=%llu nms=%llu total=%llu\n",
+                     (unsigned long long)prof->backbone, (unsigned long long)prof->neck,
+                     (unsigned long long)prof->head, (unsigned long long)prof->decode,
+                     (unsigned long long)prof->nms, (unsigned long long)total);
+            CTX_LOG("[time @ %dMHz] backbone=%llu neck=%llu head=%llu decode=%llu nms=%llu total=%llu ms\n",
+                     (int)CPU_MHZ, LAYER_MS_INT(prof->backbone), LAYER_MS_INT(prof->neck),
+                     LAYER_MS_INT(prof->head), LAYER_MS_INT(prof->decode), LAYER_MS_INT(prof->nms),
+                     LAYER_MS_INT(total));
+        }
+#else
+        CTX_LOG("[time] backbone=%.2f ms neck=%.2f ms head=%.2f ms decode=%.2f ms nms=%.2f ms total=%.2f ms\n",
+                 prof->backbone / 1000.0, prof->neck / 1000.0, prof->head / 1000.0,
+                 prof->decode / 1000.0, prof->nms / 1000.0, total / 1000.0);
+#endif
+    }
+    feature_pool_bind(prev_pool);
+    return 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * YOLOv5n 추론 컨텍스트: 가중치 1회 로드, 프레임마다 infer.
+ * init: 가중치 로드 + 레이어별 가중치 바인딩 + 피처맵 풀 생성 + 정적 메모리 계획 (로더/파싱/이름 조회 비용은 여기서만).
+ * infer: 전처리된 이미지 1장 → Backbone/Neck/Detect → decode → NMS.
+ *   입력은 32의 배수인 임의 H x W: 레이어 크기·decode 격자/stride를 입력에서 계산 (640x384 rect, 320, 416 등).
+ * infer_batch: n장을 NCHW 배치 하나로 Backbone/Neck/Detect (conv는 가중치를 배치 블록 단위로 재사용),
+ *   decode/NMS는 이미지별. 풀/계획은 배치 크기별 → yolo_ctx_set_batch로 미리 준비.
+ *   풀은 계획 오프셋(O(1)), decode/NMS 버퍼는 컨텍스트 안 → 프레임 경로에 힙 할당 없음.
+ * 컨텍스트끼리 공유 상태 없음: 풀은 infer 동안 호출 스레드에 바인딩(feature_pool_bind),
+ *   conv 누적 버퍼·연산 시간 기록은 스레드별 → 컨텍스트 여러 개를 한 프로세스(스레드별 1개)에서 사용 가능.
+ * BARE_METAL: 풀은 FEATURE_POOL_BASE, Detect 출력은 DETECT_HEAD_BASE 고정 → 컨텍스트 1개,
+ *   배치는 n × Detect 출력이 DETECT_HEAD_SIZE, 계획 peak가 FEATURE_POOL_SIZE 안일 때만.
+ */
+#ifndef YOLOV5N_H
+#define YOLOV5N_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "decode.h"
+#include "nms.h"
+#include "../utils/weights_loader.h"
+#include "../utils/weights_stream.h"
+#include "../utils/image_loader.h"
+#include "../utils/feature_pool.h"
+#include "../utils/mem_plan.h"
+
+#define YOLO_INPUT_SIZE     640  /* 기본 입력 (정사각형). 실제 크기는 이미지 헤더의 h, w */
+#define YOLO_NUM_CLASSES    80
+#define YOLO_MAX_DETECTIONS 300
+#define YOLO_NUM_LAYERS     24   /* L0..L23 (Detect 제외) */
+#define YOLO_STEM_WEIGHTS   (16 * 3 * 6 * 6)  /* L0 Conv 6x6, 3→16 */
+#define YOLO_C3_MAX_N       3    /* C3 bottleneck 최대 개수 (L6) */
+
+#ifndef YOLO_CONF_THRESHOLD
+#define YOLO_CONF_THRESHOLD 0.20f
+#endif
+#ifndef YOLO_IOU_THRESHOLD
+#define YOLO_IOU_THRESHOLD  0.45f
+#endif
+
+#ifndef YOLO_VERBOSE
+#define YOLO_VERBOSE 1
+#endif
+
+#if defined(BARE_METAL)
+#include "xil_printf.h"
+#define YOLO_LOG(...) xil_printf(__VA_ARGS__)
+#elif YOLO_VERBOSE
+#include <stdio.h>
+#define YOLO_LOG(...) printf(__VA_ARGS__)
+#else
+#define YOLO_LOG(...) ((void)0)
+#endif
+
+/** 마지막 infer 구간 시간 (호스트 us, BARE_METAL mcycle) */
+typedef struct {
+    uint64_t layer[YOLO_NUM_LAYERS];  /* 연산만 (풀 alloc/로그 제외) */
+    uint64_t backbone, neck, head, decode, nms, total;
+} yolo_profile_t;
+
+/** Conv 하나의 바인딩: 가중치 (FP32 또는 INT8 + scale), bias (FP32) */
+typedef struct {
+    weights_ref_t w;
+    const float* b;
+    int32_t c_out;                 /* bias 개수 */
+} yolo_conv_bind_t;
+
+/**
+ * 레이어 하나가 쓰는 가중치 (init 시 이름 조회 1회 → 프레임 경로는 포인터만, 문자열 처리 없음).
+ * Conv: cv[0]. C3: cv[0..2] = cv1/cv2/cv3, m_* = bottleneck (c3_nchw_f32 인자 배열 그대로).
+ * SPPF: cv[0..1] = cv1/cv2. Detect: cv[0..2] = m.0/m.1/m.2. Upsample/Concat: 비어 있음
+ * C3 cv12_*: cv1+cv2를 출력 채널 [cv1 | cv2]로 합친 사본 (init 시 ctx->c3_merged 안, 입력을 한 번 읽는 1x1 하나).
+ *   가중치가 상주하지 않는 스트리밍·정적 테이블(embedded)이면 NULL → cv1/cv2 따로
+ */
+typedef struct {
+    yolo_conv_bind_t cv[3];
+    int32_t n;                                   /* C3 bottleneck 수 */
+    const void* m_cv1w[YOLO_C3_MAX_N];
+    float m_cv1s[YOLO_C3_MAX_N];
+    int m_cv1i[YOLO_C3_MAX_N];
+    const float* m_cv1b[YOLO_C3_MAX_N];
+    const void* m_cv2w[YOLO_C3_MAX_N];
+    float m_cv2s[YOLO_C3_MAX_N];
+    int m_cv2i[YOLO_C3_MAX_N];
+    const float* m_cv2b[YOLO_C3_MAX_N];
+    const void* cv12_w;                          /* FP32 또는 INT8 (cv1/cv2와 같은 dtype) */
+    const float* cv12_s;                         /* INT8: 출력 채널별 scale, FP32: NULL */
+    const float* cv12_b;
+} yolo_layer_bind_t;
+
+typedef struct {
+    weights_loader_t weights;
+    weights_stream_t* stream;      /* 레이어 스트리밍이면 payload는 슬롯 2개 안 (NULL: 가중치 전부 상주) */
+    yolo_layer_bind_t bind[YOLO_NUM_LAYERS + 1];  /* L0..L23 + Detect(24) */
+    int32_t bound_tensors;                         /* 바인딩한 텐서 수 */
+    void* c3_merged;                               /* C3 cv1+cv2 합친 가중치/bias/scale (한 번 malloc, destroy에서 해제) */
+    size_t c3_merged_bytes;
+    feature_pool_t* pool;          /* NULL: 기본 풀 (BARE_METAL) */
+    size_t pool_size;              /* 호스트: pool 생성 크기 */
+    mem_plan_t plan;
+    int32_t batch;                 /* 풀/계획이 준비된 배치 크기 */
+    int32_t in_h, in_w;            /* 풀/계획이 준비된 입력 크기 (init: 640x640) */
+    int plan_active;               /* 1: 풀이 계획 모드 */
+    size_t plan_high_water;        /* 같은 이벤트 열을 동적 할당자로 재생한 high-water */
+    int verbose;                   /* 1: 레이어별 로그 (YOLO_LOG). init 시 YOLO_VERBOSE */
+    float conf_threshold;
+    float iou_threshold;
+    yolo_profile_t profile;
+    nms_workspace_t nms_ws;
+    float stem_w_u8[YOLO_STEM_WEIGHTS];     /* uint8 이미지용 L0 가중치: /255 접고 [ic][kh][kw][oc] (init 시 1회) */
+    detection_t dets[YOLO_MAX_DETECTIONS];  /* decode 출력 (NMS 입력) */
+#ifdef YOLO_FIXED_POINT
+    detection_q_t dets_q[YOLO_MAX_DETECTIONS];      /* 정수 decode 출력 (NMS 입력) */
+    detection_q_t dets_q_out[YOLO_MAX_DETECTIONS];  /* 정수 NMS 출력 → detection_t로 변환 */
+#endif
+    uint8_t nms_scratch[NMS_WORKSPACE_BYTES(YOLO_MAX_DETECTIONS, YOLO_NUM_CLASSES)];
+} yolo_ctx_t;
+
+#ifndef BARE_METAL
+/** 파일에서 가중치 로드 (-DUSE_WEIGHTS_W8이면 weights_w8.bin 형식). 0 성공, -1 실패 */
+int yolo_ctx_init_from_file(yolo_ctx_t* ctx, const char* weights_path);
+#endif
+
+/** DDR(메모리)의 가중치를 제자리 참조. 호스트 W8은 미지원 (-1) */
+int yolo_ctx_init_from_memory(yolo_ctx_t* ctx, uintptr_t weights_base, size_t weights_size);
+
+/**
+ * 레이어 스트리밍 (컨테이너 .ymdl만): 가중치를 레이어 단위로 더블 버퍼에 읽으며 추론 → 상주 가중치는 가장 큰 레이어 2개분.
+ * 레이어 진입 시 그 레이어를 확보하고 다음 레이어를 미리 읽음 (호스트: reader 스레드). ctx->stream으로 통계 조회.
+ * 컨텍스트 1개당 스트림 1개 (슬롯을 레이어 순서로 재사용). 0 성공, -1 실패
+ */
+#ifndef BARE_METAL
+int yolo_ctx_init_streaming_file(yolo_ctx_t* ctx, const char* path);
+#endif
+/** base: 플래시 대용 메모리 안 컨테이너 (스트림보다 오래 유지) */
+int yolo_ctx_init_streaming_memory(yolo_ctx_t* ctx, const void* base, size_t size);
+
+#ifdef YOLO_EMBEDDED_MODEL
+/** 링크된 모델 (tools/gen_embedded_model.py): 가중치 파싱·heap 없음, DDR 적재 불필요. 0 성공, -1 실패 */
+int yolo_ctx_init_embedded(yolo_ctx_t* ctx);
+#endif
+
+/**
+ * img: 3 x H x W NCHW FP32 또는 uint8 CHW/HWC (image_loader, uint8은 L0가 직접 읽음). H, W는 32의 배수 (기본 640x640, 직사각형 letterbox 가능). out: NMS 결과 (conf 내림차순, 좌표 normalized),
+ * max_out개까지. num_out에 개수. 반환 0 성공, -1 실패 (풀 부족/계획 불일치, 컨텍스트는 재사용 가능)
+ */
+int yolo_infer(yolo_ctx_t* ctx, const preprocessed_image_t* img,
+               detection_t* out, int32_t max_out, int32_t* num_out);
+
+/**
+ * 배치 n장, 입력 in_h x in_w(32의 배수)용 풀/메모리 계획 준비 (호스트: 풀을 n·면적에 비례해 다시 만듦).
+ * infer(_batch)가 다른 n/크기로 불리면 자동으로 호출되지만 계획 비용이 프레임에 들어가므로 미리 호출.
+ * 0 성공, -1 실패 (32의 배수 아님, BARE_METAL: Detect 출력/풀 부족)
+ */
+int yolo_ctx_set_input(yolo_ctx_t* ctx, int32_t n, int32_t in_h, int32_t in_w);
+
+/** 입력 크기는 그대로 두고 배치만 변경 */
+int yolo_ctx_set_batch(yolo_ctx_t* ctx, int32_t n);
+
+/**
+ * imgs[0..n-1]: 같은 크기(3 x H x W) 이미지 n장. out: 이미지 i의 결과는 out + i*max_out (max_out개까지),
+ * num_out[i]에 개수. 결과는 이미지를 하나씩 yolo_infer한 것과 비트 동일. 0 성공, -1 실패
+ */
+int yolo_infer_batch(yolo_ctx_t* ctx, const preprocessed_image_t* const* imgs, int32_t n,
+                     detection_t* out, int32_t max_out, int32_t* num_out);
+
+void yolo_ctx_destroy(yolo_ctx_t* ctx);
+
+#endif /* YOLOV5N_H */
@@ -1,6 +1,8 @@
 #include "bottleneck.h"
 #include "conv2d.h"
 #include "silu.h"
+#include "halo.h"
+#include "conv2d_q.h"
 #include "../utils/feature_pool.h"
 
 void bottleneck_nchw_f32(
@@ -10,54 +12,105 @@ void bottleneck_nchw_f32(
     int32_t shortcut,
     float* y)
 {
-    size_t cv1_bytes = (size_t)n * (size_t)cv1_c_out * (size_t)h * (size_t)w * sizeof(float);
+    bottleneck_nchw_f32_strided(x, c * h * w, n, c, h, w,
+                                cv1_w, cv1_scale, cv1_is_int8, cv1_c_out, cv1_bias,
+                                cv2_w, cv2_scale, cv2_is_int8, cv2_c_out, cv2_bias,
+                                shortcut, y, cv2_c_out * h * w);
+}
+
+void bottleneck_nchw_f32_strided(
+    const float* x, int32_t x_n_stride, int32_t n, int32_t c, int32_t h, int32_t w,
+    const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
+    const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
+    int32_t shortcut,
+    float* y, int32_t y_n_stride)
+{
+    /* cv1_out은 halo 레이아웃 (3x3 pad 1 cv2가 경계 분기 없이 읽도록) */
+    const int32_t halo = FMAP_HALO;
+    size_t cv1_bytes = HALO_BYTES(n, cv1_c_out, h, w, halo);
     size_t cv2_bytes = (size_t)n * (size_t)cv2_c_out * (size_t)h * (size_t)w * sizeof(float);
-    float* cv1_out = (float*)feature_pool_alloc(cv1_bytes);
+    float* cv1_buf = (float*)feature_pool_alloc(cv1_bytes);
     float* cv2_out = (float*)feature_pool_alloc(cv2_bytes);
-    if (!cv1_out || !cv2_out) {
+    if (!cv1_buf || !cv2_out) {
         if (cv2_out) feature_pool_free(cv2_out);
-        if (cv1_out) feature_pool_free(cv1_out);
+        if (cv1_buf) feature_pool_free(cv1_buf);
         return;
     }
+    halo_clear_border(cv1_buf, n * cv1_c_out, h, w, halo);
+    float* cv1_out = halo_interior(cv1_buf, w, halo);
 
+#ifdef YOLO_FIXED_POINT
+    /* 정수 경로: 버퍼는 Q int32 워드 (operations/qformat.h), 가중치는 INT8 */
+    (void)cv1_is_int8;
+    (void)cv2_is_int8;
+    /* x 이미지 간격이 c 채널보다 크면 (C3 concat 안 구간) cv1이 간격 그대로 읽음 */
+    conv2d_nchw_q_w8_halo((const int32_t*)x, 0, x_n_stride, n, c, h, w,
+                          (const int8_t*)cv1_w, cv1_scale, cv1_c_out, 1, 1,
+                          cv1_bias, 1, 1, 0, 0,
+                          (int32_t*)cv1_out, halo, 0, h, w);
+    silu_nchw_q((const int32_t*)cv1_buf, n, cv1_c_out, h + 2 * halo, w + 2 * halo, (int32_t*)cv1_buf);
+    conv2d_nchw_q_w8_halo((const int32_t*)cv1_out, halo, 0, n, cv1_c_out, h, w,
+                          (const int8_t*)cv2_w, cv2_scale, cv2_c_out, 3, 3,
+                          cv2_bias, 1, 1, 1, 1,
+                          (int32_t*)cv2_out, 0, 0, h, w);
+    silu_nchw_q((const int32_t*)cv2_out, n, cv2_c_out, h, w, (int32_t*)cv2_out);
+    {
+        const int32_t add = shortcut && c == cv2_c_out;
+        const int32_t size = cv2_c_out * h * w;
+        for (int32_t ni = 0; ni < n; ni++) {
+            const int32_t* xq = (const int32_t*)x + ni * x_n_stride;
+            const int32_t* cq = (const int32_t*)cv2_out + ni * size;
+            int32_t* yq = (int32_t*)y + ni * y_n_stride;
+            for (int32_t i = 0; i < size; i++) {
+                yq[i] = add ? q_sat((int64_t)xq[i] + cq[i]) : cq[i];
+            }
+        }
+    }
+#else
+    /* x 이미지 간격이 c 채널보다 크면 (C3 concat 안 구간) cv1이 간격 그대로 읽음 */
     if (cv1_is_int8) {
-        conv2d_nchw_f32_w8(x, n, c, h, w,
-                           (const int8_t*)cv1_w, cv1_scale, cv1_c_out, 1, 1,
-                           cv1_bias, 1, 1, 0, 0, 1,
-                           cv1_out, h, w);
+        conv2d_nchw_f32_w8_halo(x, 0, x_n_stride, n, c, h, w,
+                                (const int8_t*)cv1_w, cv1_scale, cv1_c_out, 1, 1,
+                                cv1_bias, 1, 1, 0, 0, 1,
+                                cv1_out, halo, 0, h, w);
     } else {
-        conv2d_nchw_f32(x, n, c, h, w,
-                        (const float*)cv1_w, cv1_c_out, 1, 1,
-                        cv1_bias, 1, 1, 0, 0, 1,
-                        cv1_out, h, w);
+        conv2d_nchw_f32_halo(x, 0, x_n_stride, n, c, h, w,
+                             (const float*)cv1_w, cv1_c_out, 1, 1,
+                             cv1_bias, 1, 1, 0, 0, 1,
+                             cv1_out, halo, 0, h, w);
     }
-    silu_nchw_f32(cv1_out, n, cv1_c_out, h, w, cv1_out);
+    silu_nchw_f32(cv1_buf, n, cv1_c_out, h + 2 * halo, w + 2 * halo, cv1_buf);  /* SiLU(0)=0: 테두리 유지 */
     /* cv2 */
     if (cv2_is_int8) {
-        conv2d_nchw_f32_w8(cv1_out, n, cv1_c_out, h, w,
-                           (const int8_t*)cv2_w, cv2_scale, cv2_c_out, 3, 3,
-                           cv2_bias, 1, 1, 1, 1, 1,
-                           cv2_out, h, w);
+        conv2d_nchw_f32_w8_halo(cv1_out, halo, 0, n, cv1_c_out, h, w,
+                                (const int8_t*)cv2_w, cv2_scale, cv2_c_out, 3, 3,
+                                cv2_bias, 1, 1, 1, 1, 1,
+                                cv2_out, 0, 0, h, w);
     } else {
-        conv2d_nchw_f32(cv1_out, n, cv1_c_out, h, w,
-                        (const float*)cv2_w, cv2_c_out, 3, 3,
-                        cv2_bias, 1, 1, 1, 1, 1,
-                        cv2_out, h, w);
+        conv2d_nchw_f32_halo(cv1_out, halo, 0, n, cv1_c_out, h, w,
+                             (const float*)cv2_w, cv2_c_out, 3, 3,
+                             cv2_bias, 1, 1, 1, 1, 1,
+                             cv2_out, 0, 0, h, w);
     }
     silu_nchw_f32(cv2_out, n, cv2_c_out, h, w, cv2_out);
-    // Shortcut
-    if (shortcut && c == cv2_c_out) {
-        int32_t size = n * c * h * w;
-        for (int32_t i = 0; i < size; i++) {
-            y[i] = x[i] + cv2_out[i];
-        }
-    } else {
-        int32_t size = n * cv2_c_out * h * w;
-        for (int32_t i = 0; i < size; i++) {
-            y[i] = cv2_out[i];
+    // Shortcut (y == x 제자리 가능: 원소별)
+    const int32_t size = cv2_c_out * h * w;
+    for (int32_t ni = 0; ni < n; ni++) {
+        const float* x_img = x + ni * x_n_stride;
+        const float* c_img = cv2_out + ni * size;
+        float* y_img = y + ni * y_n_stride;
+        if (shortcut && c == cv2_c_out) {
+            for (int32_t i = 0; i < size; i++) {
+                y_img[i] = x_img[i] + c_img[i];
+            }
+        } else {
+            for (int32_t i = 0; i < size; i++) {
+                y_img[i] = c_img[i];
+            }
         }
     }
+#endif
 
     feature_pool_free(cv2_out);
-    feature_pool_free(cv1_out);
+    feature_pool_free(cv1_buf);
 }
@@ -11,4 +11,13 @@ void bottleneck_nchw_f32(
     int32_t shortcut,  // 1=add residual, 0=no shortcut
     float* y);
 
+/* x/y 이미지 간격 지정 (C3 concat 버퍼 안 cv1 구간을 읽고 씀, y == x 제자리 가능).
+ * 1x1 cv1은 x 간격 그대로 배치 블록으로 읽음 (conv2d x_n_stride) → 가중치 블록은 배치 블록마다 한 번 */
+void bottleneck_nchw_f32_strided(
+    const float* x, int32_t x_n_stride, int32_t n, int32_t c, int32_t h, int32_t w,
+    const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
+    const void* cv2_w, float cv2_scale, int cv2_is_int8, int32_t cv2_c_out, const float* cv2_bias,
+    int32_t shortcut,
+    float* y, int32_t y_n_stride);
+
 #endif // BOTTLENECK_H
@@ -1,4 +1,5 @@
 #include "concat.h"
+#include "halo.h"
 
 void concat_nchw_f32(
     const float* x1, int32_t c1,
@@ -28,6 +29,40 @@ void concat_nchw_f32(
     }
 }
 
+/* 채널 plane 하나를 행 단위로 복사 (halo 0이면 연속 복사) */
+static void copy_plane(const float* src, int32_t src_halo, int32_t h, int32_t w, float* dst)
+{
+    if (src_halo == 0) {
+        const int32_t hw = h * w;
+        for (int32_t i = 0; i < hw; i++) dst[i] = src[i];
+        return;
+    }
+    const int32_t pitch = HALO_PITCH(w, src_halo);
+    for (int32_t r = 0; r < h; r++) {
+        const float* s = src + r * pitch;
+        for (int32_t i = 0; i < w; i++) *dst++ = s[i];
+    }
+}
+
+void concat_nchw_f32_halo(
+    const float* x1, int32_t c1, int32_t x1_halo,
+    const float* x2, int32_t c2, int32_t x2_halo,
+    int32_t n, int32_t h, int32_t w,
+    float* y)
+{
+    const int32_t hw = h * w;
+    const int32_t plane1 = HALO_PLANE(h, w, x1_halo);
+    const int32_t plane2 = HALO_PLANE(h, w, x2_halo);
+    for (int32_t ni = 0; ni < n; ni++) {
+        for (int32_t ci = 0; ci < c1; ci++) {
+            copy_plane(x1 + (ni * c1 + ci) * plane1, x1_halo, h, w, y + (ni * (c1 + c2) + ci) * hw);
+        }
+        for (int32_t ci = 0; ci < c2; ci++) {
+            copy_plane(x2 + (ni * c2 + ci) * plane2, x2_halo, h, w, y + (ni * (c1 + c2) + c1 + ci) * hw);
+        }
+    }
+}
+
 void concat4_nchw_f32(
     const float* x0, int32_t c0,
     const float* x1, int32_t c1,
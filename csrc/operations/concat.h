@@ -9,6 +9,12 @@ void concat_nchw_f32(
     int32_t n, int32_t h, int32_t w,
     float* y);
 
+/* x1/x2가 halo 레이아웃(operations/halo.h 내부 포인터)일 수 있는 버전. y는 조밀 */
+void concat_nchw_f32_halo(
+    const float* x1, int32_t c1, int32_t x1_halo,
+    const float* x2, int32_t c2, int32_t x2_halo,
+    int32_t n, int32_t h, int32_t w,
+    float* y);
 
 void concat4_nchw_f32(
     const float* x0, int32_t c0,
@@ -1,10 +1,22 @@
 #include "conv2d.h"
+#include <stddef.h>
+#include "../utils/thread_local.h"
+#include "../utils/cache_sim.h"
+#ifdef CONV2D_SPM
+#include "conv2d_spm.h"
+#endif
 
 /* 최적화 요약 (MicroBlaze V / D-Cache 친화):
  * 1. 가중치 재사용: 루프 순서 ic→b→dh→dw→kh→kw. 필터 하나를 한 번 로드해 8x8 타일(64픽셀)에 64회 재사용.
  * 2. Strength reduction: kw 루프에서 x_row++/w_row++ 포인터 증감만 사용.
  * 3. 타일 단위 safe: 타일 전체가 안전 영역인지 한 번만 체크 → 64회 분기 → 1회로 축소.
- * 4. acc_ptr: (dh,dw)마다 base=&acc_buf[dh][dw][0], acc_ptr[b]+=contrib 로 다차원 인덱싱 오버헤드 감소. */
+ * 4. acc_ptr: (dh,dw)마다 base=&acc_buf[dh][dw][0], acc_ptr[b]+=contrib 로 다차원 인덱싱 오버헤드 감소.
+ * 5. Halo 입력(x_halo >= pad): 패딩 위치가 실제 0 메모리 → 모든 타일이 safe, 경계 경로 없음.
+ *    x/y 포인터는 내부 (0,0), 행 pitch = w + 2*halo, 채널 stride = plane (operations/halo.h).
+ * 6. 배치 블록(n > 1): 이미지 nb장이 같은 (ic, b) 필터를 이어서 사용 → 가중치 대역폭 1/nb.
+ *    출력 하나의 누적 순서는 n=1과 같아 결과 비트 동일.
+ * 7. -DCONV2D_SPM: 타일을 스크래치패드에 DMA로 명시 적재하는 경로(conv2d_spm.c)를 먼저 시도, 안 맞으면 아래 경로.
+ * CSIM_*: -DYOLO_CACHE_SIM 빌드에서 접근을 캐시 모델(utils/cache_sim.h)에 기록, 그 외 빌드는 빈 매크로. */
 #ifndef CONV2D_TILE_H
 #define CONV2D_TILE_H 8
 #endif
@@ -15,9 +27,33 @@
 #ifndef CONV2D_OC_BLOCK
 #define CONV2D_OC_BLOCK 32
 #endif
+/* 배치 블록: 필터 하나를 이미지 nb장에 연속 적용 → 가중치 로드 횟수 1/nb (n=1이면 기존과 동일).
+ * 보드(BARE_METAL)는 n=1만 돌리므로 1: 누적 버퍼 8KB (16KB D-cache에 32KB BSS를 두지 않음) */
+#ifndef CONV2D_BATCH_BLOCK
+#ifdef BARE_METAL
+#define CONV2D_BATCH_BLOCK 1
+#else
+#define CONV2D_BATCH_BLOCK 4
+#endif
+#endif
+
+/* 누적 버퍼: 스택 대신 BSS 사용 (bare-metal 스택 제한). BATCH/TILE/OC_BLOCK 매크로와 동일하게.
+ * 호스트는 스레드별 (여러 컨텍스트 동시 추론) */
+static YOLO_THREAD_LOCAL float conv2d_acc_buf[CONV2D_BATCH_BLOCK][CONV2D_TILE_H][CONV2D_TILE_W][CONV2D_OC_BLOCK];
+
+static YOLO_THREAD_LOCAL uint64_t conv2d_border_tiles;
+
+uint64_t conv2d_get_border_tiles(void) { return conv2d_border_tiles; }
+void conv2d_reset_border_tiles(void) { conv2d_border_tiles = 0; }
 
-/* 누적 버퍼: 스택 대신 BSS 사용 (bare-metal 스택 제한). TILE/OC_BLOCK 매크로와 동일하게. */
-static float conv2d_acc_buf[CONV2D_TILE_H][CONV2D_TILE_W][CONV2D_OC_BLOCK];
+/* 패딩 없이 읽을 수 있는 출력 구간 [min, max). halo만큼은 0 메모리라 읽어도 됨 */
+static inline int32_t safe_min(int32_t pad, int32_t halo, int32_t stride) {
+    return pad > halo ? (pad - halo + stride - 1) / stride : 0;
+}
+static inline int32_t safe_max(int32_t in, int32_t k, int32_t pad, int32_t halo, int32_t stride) {
+    const int32_t room = in + halo + pad - k;  /* 마지막 창 시작 위치 */
+    return room < 0 ? 0 : room / stride + 1;
+}
 
 void conv2d_nchw_f32(
     const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
@@ -27,28 +63,52 @@ void conv2d_nchw_f32(
     int32_t pad_h, int32_t pad_w,
     int32_t groups,
     float* y, int32_t h_out, int32_t w_out)
+{
+    conv2d_nchw_f32_halo(x, 0, 0, n, c_in, h_in, w_in, w, c_out, k_h, k_w, bias_or_null,
+                         stride_h, stride_w, pad_h, pad_w, groups, y, 0, 0, h_out, w_out);
+}
+
+void conv2d_nchw_f32_halo(
+    const float* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out)
 {
     if (groups != 1) {
         return;
     }
+#ifdef CONV2D_SPM
+    if (conv2d_spm_nchw_f32(x, x_halo, x_n_stride, n, c_in, h_in, w_in, w, 0.0f, 0, c_out, k_h, k_w, bias_or_null,
+                            stride_h, stride_w, pad_h, pad_w, groups, y, y_halo, y_n_stride, h_out, w_out) == 0)
+        return;
+#endif
 
     const int32_t tile_h = CONV2D_TILE_H;
     const int32_t tile_w = CONV2D_TILE_W;
     const int32_t oc_block = CONV2D_OC_BLOCK;
+    const int32_t batch_block = CONV2D_BATCH_BLOCK;
 
     /* 패딩이 필요 없는 안전 영역: 가장 안쪽 루프에서 분기 제거 */
-    const int32_t safe_oh_min = (pad_h + stride_h - 1) / stride_h;
-    const int32_t safe_oh_max = (h_in - k_h + pad_h) / stride_h;
-    const int32_t safe_ow_min = (pad_w + stride_w - 1) / stride_w;
-    const int32_t safe_ow_max = (w_in - k_w + pad_w) / stride_w;
+    const int32_t safe_oh_min = safe_min(pad_h, x_halo, stride_h);
+    const int32_t safe_oh_max = safe_max(h_in, k_h, pad_h, x_halo, stride_h);
+    const int32_t safe_ow_min = safe_min(pad_w, x_halo, stride_w);
+    const int32_t safe_ow_max = safe_max(w_in, k_w, pad_w, x_halo, stride_w);
 
-    const int32_t x_h_stride = w_in;
-    const int32_t x_c_stride = h_in * w_in;
+    const int32_t x_h_stride = w_in + 2 * x_halo;
+    const int32_t x_c_stride = (h_in + 2 * x_halo) * x_h_stride;
+    const int32_t y_h_stride = w_out + 2 * y_halo;
+    const int32_t y_c_stride = (h_out + 2 * y_halo) * y_h_stride;
+    const int32_t x_n = x_n_stride ? x_n_stride : c_in * x_c_stride;
+    const int32_t y_n = y_n_stride ? y_n_stride : c_out * y_c_stride;
     const int32_t w_k_stride = k_w;
     const int32_t w_ic_stride = k_h * k_w;
     const int32_t w_oc_stride = c_in * k_h * k_w;
 
-    for (int32_t ni = 0; ni < n; ni++) {
+    for (int32_t n0 = 0; n0 < n; n0 += batch_block) {
+        const int32_t nb = n0 + batch_block <= n ? batch_block : n - n0;
         for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
             const int32_t oh_end = oh0 + tile_h < h_out ? oh0 + tile_h : h_out;
             const int32_t th = oh_end - oh0;
@@ -59,11 +119,15 @@ void conv2d_nchw_f32(
                 for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
                     const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
 
-                    /* 누적 버퍼 초기화: bias 또는 0 */
-                    for (int32_t dh = 0; dh < th; dh++) {
-                        for (int32_t dw = 0; dw < tw; dw++) {
-                            for (int32_t b = 0; b < n_oc; b++) {
-                                conv2d_acc_buf[dh][dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
+                    /* 누적 버퍼 초기화: bias 또는 0 (배치 블록의 이미지마다) */
+                    for (int32_t bi = 0; bi < nb; bi++) {
+                        for (int32_t dh = 0; dh < th; dh++) {
+                            for (int32_t dw = 0; dw < tw; dw++) {
+                                for (int32_t b = 0; b < n_oc; b++) {
+                                    conv2d_acc_buf[bi][dh][dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
+                                }
+                                if (bias_or_null) CSIM_READ(CSIM_WEIGHT, bias_or_null + oc0, (size_t)n_oc * sizeof(float));
+                                CSIM_WRITE(CSIM_ACC, &conv2d_acc_buf[bi][dh][dw][0], (size_t)n_oc * sizeof(float));
                             }
                         }
                     }
@@ -71,71 +135,81 @@ void conv2d_nchw_f32(
                     /* 타일 전체가 안전 영역인지 한 번만 체크 → 64회 분기를 1회로 축소 */
                     const int32_t tile_is_safe = (oh0 >= safe_oh_min && oh_end <= safe_oh_max &&
                                                   ow0 >= safe_ow_min && ow_end <= safe_ow_max);
+                    if (!tile_is_safe) conv2d_border_tiles++;
+                    CSIM_MACS((uint64_t)nb * th * tw * n_oc * c_in * k_h * k_w);
 
-                    /* ic → b → dh → dw 순서: 필터(w) 하나를 한 번 로드해 타일 전체(64픽셀)에 재사용 */
+                    /* ic → b → bi → dh → dw: 필터(w) 하나를 한 번 로드해 nb장 × 타일(64픽셀)에 재사용 */
                     for (int32_t ic = 0; ic < c_in; ic++) {
                         for (int32_t b = 0; b < n_oc; b++) {
                             const float* w_base = w + (oc0 + b) * w_oc_stride + ic * w_ic_stride;
+                            for (int32_t bi = 0; bi < nb; bi++) {
+                                const float* x_img = x + (n0 + bi) * x_n + ic * x_c_stride;
 
-                            if (tile_is_safe) {
-                                /* Fast path: 타일 전체가 safe → per-pixel 분기 없음 */
-                                for (int32_t dh = 0; dh < th; dh++) {
-                                    const int32_t oh = oh0 + dh;
-                                    const int32_t ih0 = oh * stride_h - pad_h;
-                                    for (int32_t dw = 0; dw < tw; dw++) {
-                                        const int32_t ow = ow0 + dw;
-                                        const int32_t iw0 = ow * stride_w - pad_w;
-                                        const float* x_base = x + (ni * c_in + ic) * x_c_stride + ih0 * x_h_stride + iw0;
-                                        float contrib = 0.0f;
-                                        for (int32_t kh = 0; kh < k_h; kh++) {
-                                            const float* x_row = x_base + kh * x_h_stride;
-                                            const float* w_row = w_base + kh * w_k_stride;
-                                            for (int32_t kw = 0; kw < k_w; kw++) {
-                                                contrib += (*x_row++) * (*w_row++);
-                                            }
-                                        }
-                                        float* acc_ptr = &conv2d_acc_buf[dh][dw][0];
-                                        acc_ptr[b] += contrib;
-                                    }
-                                }
-                            } else {
-                                /* 경계 경로: (dh,dw)마다 in_safe 체크 */
-                                for (int32_t dh = 0; dh < th; dh++) {
-                                    const int32_t oh = oh0 + dh;
-                                    for (int32_t dw = 0; dw < tw; dw++) {
-                                        const int32_t ow = ow0 + dw;
-                                        const int32_t in_safe = (oh >= safe_oh_min && oh < safe_oh_max &&
-                                                                ow >= safe_ow_min && ow < safe_ow_max);
-                                        float contrib;
-                                        if (in_safe) {
-                                            const int32_t ih0 = oh * stride_h - pad_h;
+                                if (tile_is_safe) {
+                                    /* Fast path: 타일 전체가 safe → per-pixel 분기 없음 */
+                                    for (int32_t dh = 0; dh < th; dh++) {
+                                        const int32_t oh = oh0 + dh;
+                                        const int32_t ih0 = oh * stride_h - pad_h;
+                                        for (int32_t dw = 0; dw < tw; dw++) {
+                                            const int32_t ow = ow0 + dw;
                                             const int32_t iw0 = ow * stride_w - pad_w;
-                                            const float* x_base = x + (ni * c_in + ic) * x_c_stride + ih0 * x_h_stride + iw0;
-                                            contrib = 0.0f;
+                                            const float* x_base = x_img + ih0 * x_h_stride + iw0;
+                                            float contrib = 0.0f;
                                             for (int32_t kh = 0; kh < k_h; kh++) {
                                                 const float* x_row = x_base + kh * x_h_stride;
                                                 const float* w_row = w_base + kh * w_k_stride;
+                                                CSIM_READ(CSIM_INPUT, x_row, (size_t)k_w * sizeof(float));
+                                                CSIM_READ(CSIM_WEIGHT, w_row, (size_t)k_w * sizeof(*w_row));
                                                 for (int32_t kw = 0; kw < k_w; kw++) {
                                                     contrib += (*x_row++) * (*w_row++);
                                                 }
                                             }
-                                        } else {
-                                            const int32_t oc = oc0 + b;
-                                            contrib = 0.0f;
-                                            for (int32_t kh = 0; kh < k_h; kh++) {
-                                                const int32_t ih = oh * stride_h - pad_h + kh;
-                                                if ((uint32_t)ih >= (uint32_t)h_in) continue;
-                                                for (int32_t kw = 0; kw < k_w; kw++) {
-                                                    const int32_t iw = ow * stride_w - pad_w + kw;
-                                                    if ((uint32_t)iw >= (uint32_t)w_in) continue;
-                                                    const float* x_ptr = x + (ni * c_in + ic) * x_c_stride + ih * x_h_stride + iw;
-                                                    const float* w_ptr = w + oc * w_oc_stride + ic * w_ic_stride + kh * w_k_stride + kw;
-                                                    contrib += (*x_ptr) * (*w_ptr);
+                                            float* acc_ptr = &conv2d_acc_buf[bi][dh][dw][0];
+                                            CSIM_READ(CSIM_ACC, acc_ptr + b, sizeof(float));
+                                            acc_ptr[b] += contrib;
+                                            CSIM_WRITE(CSIM_ACC, acc_ptr + b, sizeof(float));
+                                        }
+                                    }
+                                } else {
+                                    /* 경계 경로: (dh,dw)마다 in_safe 체크 */
+                                    for (int32_t dh = 0; dh < th; dh++) {
+                                        const int32_t oh = oh0 + dh;
+                                        for (int32_t dw = 0; dw < tw; dw++) {
+                                            const int32_t ow = ow0 + dw;
+                                            const int32_t in_safe = (oh >= safe_oh_min && oh < safe_oh_max &&
+                                                                    ow >= safe_ow_min && ow < safe_ow_max);
+                                            float contrib = 0.0f;
+                                            if (in_safe) {
+                                                const int32_t ih0 = oh * stride_h - pad_h;
+                                                const int32_t iw0 = ow * stride_w - pad_w;
+                                                const float* x_base = x_img + ih0 * x_h_stride + iw0;
+                                                for (int32_t kh = 0; kh < k_h; kh++) {
+                                                    const float* x_row = x_base + kh * x_h_stride;
+                                                    const float* w_row = w_base + kh * w_k_stride;
+                                                    CSIM_READ(CSIM_INPUT, x_row, (size_t)k_w * sizeof(float));
+                                                    CSIM_READ(CSIM_WEIGHT, w_row, (size_t)k_w * sizeof(*w_row));
+                                                    for (int32_t kw = 0; kw < k_w; kw++) {
+                                                        contrib += (*x_row++) * (*w_row++);
+                                                    }
+                                                }
+                                            } else {
+                                                for (int32_t kh = 0; kh < k_h; kh++) {
+                                                    const int32_t ih = oh * stride_h - pad_h + kh;
+                                                    if ((uint32_t)ih >= (uint32_t)h_in) continue;
+                                                    for (int32_t kw = 0; kw < k_w; kw++) {
+                                                        const int32_t iw = ow * stride_w - pad_w + kw;
+                                                        if ((uint32_t)iw >= (uint32_t)w_in) continue;
+                                                        CSIM_READ(CSIM_INPUT, &x_img[ih * x_h_stride + iw], sizeof(float));
+                                                        CSIM_READ(CSIM_WEIGHT, &w_base[kh * w_k_stride + kw], sizeof(*w_base));
+                                                        contrib += x_img[ih * x_h_stride + iw] * w_base[kh * w_k_stride + kw];
+                                                    }
                                                 }
                                             }
+                                            float* acc_ptr = &conv2d_acc_buf[bi][dh][dw][0];
+                                            CSIM_READ(CSIM_ACC, acc_ptr + b, sizeof(float));
+                                            acc_ptr[b] += contrib;
+                                            CSIM_WRITE(CSIM_ACC, acc_ptr + b, sizeof(float));
                                         }
-                                        float* acc_ptr = &conv2d_acc_buf[dh][dw][0];
-                                        acc_ptr[b] += contrib;
                                     }
                                 }
                             }
@@ -143,13 +217,17 @@ void conv2d_nchw_f32(
                     }
 
                     /* 누적 버퍼 → y 쓰기 */
-                    for (int32_t dh = 0; dh < th; dh++) {
-                        const int32_t oh = oh0 + dh;
-                        for (int32_t dw = 0; dw < tw; dw++) {
-                            const int32_t ow = ow0 + dw;
-                            const int32_t y_row_off = (ni * c_out + oc0) * h_out * w_out + oh * w_out + ow;
-                            for (int32_t b = 0; b < n_oc; b++) {
-                                y[y_row_off + b * h_out * w_out] = conv2d_acc_buf[dh][dw][b];
+                    for (int32_t bi = 0; bi < nb; bi++) {
+                        for (int32_t dh = 0; dh < th; dh++) {
+                            const int32_t oh = oh0 + dh;
+                            for (int32_t dw = 0; dw < tw; dw++) {
+                                const int32_t ow = ow0 + dw;
+                                const int32_t y_row_off = (n0 + bi) * y_n + oc0 * y_c_stride + oh * y_h_stride + ow;
+                                CSIM_READ(CSIM_ACC, &conv2d_acc_buf[bi][dh][dw][0], (size_t)n_oc * sizeof(float));
+                                for (int32_t b = 0; b < n_oc; b++) {
+                                    y[y_row_off + b * y_c_stride] = conv2d_acc_buf[bi][dh][dw][b];
+                                    CSIM_WRITE(CSIM_OUTPUT, &y[y_row_off + b * y_c_stride], sizeof(float));
+                                }
                             }
                         }
                     }
@@ -169,24 +247,41 @@ void conv2d_nchw_f32_w8(
     int32_t groups,
     float* y, int32_t h_out, int32_t w_out)
 {
-    if (groups != 1) return;
+    conv2d_nchw_f32_w8_halo(x, 0, 0, n, c_in, h_in, w_in, w, scale, c_out, k_h, k_w, bias_or_null,
+                            stride_h, stride_w, pad_h, pad_w, groups, y, 0, 0, h_out, w_out);
+}
 
+/* oc_scale != NULL이면 출력 채널마다 scale (합친 가중치), NULL이면 텐서 scale 하나 */
+static void conv2d_w8_impl(
+    const float* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, const float* oc_scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    float* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out)
+{
     const int32_t tile_h = CONV2D_TILE_H;
     const int32_t tile_w = CONV2D_TILE_W;
     const int32_t oc_block = CONV2D_OC_BLOCK;
+    const int32_t batch_block = CONV2D_BATCH_BLOCK;
 
-    const int32_t safe_oh_min = (pad_h + stride_h - 1) / stride_h;
-    const int32_t safe_oh_max = (h_in - k_h + pad_h) / stride_h;
-    const int32_t safe_ow_min = (pad_w + stride_w - 1) / stride_w;
-    const int32_t safe_ow_max = (w_in - k_w + pad_w) / stride_w;
+    const int32_t safe_oh_min = safe_min(pad_h, x_halo, stride_h);
+    const int32_t safe_oh_max = safe_max(h_in, k_h, pad_h, x_halo, stride_h);
+    const int32_t safe_ow_min = safe_min(pad_w, x_halo, stride_w);
+    const int32_t safe_ow_max = safe_max(w_in, k_w, pad_w, x_halo, stride_w);
 
-    const int32_t x_h_stride = w_in;
-    const int32_t x_c_stride = h_in * w_in;
+    const int32_t x_h_stride = w_in + 2 * x_halo;
+    const int32_t x_c_stride = (h_in + 2 * x_halo) * x_h_stride;
+    const int32_t y_h_stride = w_out + 2 * y_halo;
+    const int32_t y_c_stride = (h_out + 2 * y_halo) * y_h_stride;
+    const int32_t x_n = x_n_stride ? x_n_stride : c_in * x_c_stride;
+    const int32_t y_n = y_n_stride ? y_n_stride : c_out * y_c_stride;
     const int32_t w_k_stride = k_w;
     const int32_t w_ic_stride = k_h * k_w;
     const int32_t w_oc_stride = c_in * k_h * k_w;
 
-    for (int32_t ni = 0; ni < n; ni++) {
+    for (int32_t n0 = 0; n0 < n; n0 += batch_block) {
+        const int32_t nb = n0 + batch_block <= n ? batch_block : n - n0;
         for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
             const int32_t oh_end = oh0 + tile_h < h_out ? oh0 + tile_h : h_out;
             const int32_t th = oh_end - oh0;
@@ -197,90 +292,116 @@ void conv2d_nchw_f32_w8(
                 for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
                     const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
 
-                    for (int32_t dh = 0; dh < th; dh++) {
-                        for (int32_t dw = 0; dw < tw; dw++) {
-                            for (int32_t b = 0; b < n_oc; b++) {
-                                conv2d_acc_buf[dh][dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
+                    /* 누적 버퍼 초기화: bias 또는 0 (배치 블록의 이미지마다) */
+                    for (int32_t bi = 0; bi < nb; bi++) {
+                        for (int32_t dh = 0; dh < th; dh++) {
+                            for (int32_t dw = 0; dw < tw; dw++) {
+                                for (int32_t b = 0; b < n_oc; b++) {
+                                    conv2d_acc_buf[bi][dh][dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
+                                }
+                                if (bias_or_null) CSIM_READ(CSIM_WEIGHT, bias_or_null + oc0, (size_t)n_oc * sizeof(float));
+                                CSIM_WRITE(CSIM_ACC, &conv2d_acc_buf[bi][dh][dw][0], (size_t)n_oc * sizeof(float));
                             }
                         }
                     }
 
+                    /* 타일 전체가 안전 영역인지 한 번만 체크 → 64회 분기를 1회로 축소 */
                     const int32_t tile_is_safe = (oh0 >= safe_oh_min && oh_end <= safe_oh_max &&
                                                   ow0 >= safe_ow_min && ow_end <= safe_ow_max);
+                    if (!tile_is_safe) conv2d_border_tiles++;
+                    CSIM_MACS((uint64_t)nb * th * tw * n_oc * c_in * k_h * k_w);
 
+                    /* ic → b → bi → dh → dw: 필터(w) 하나를 한 번 로드해 nb장 × 타일(64픽셀)에 재사용 */
                     for (int32_t ic = 0; ic < c_in; ic++) {
                         for (int32_t b = 0; b < n_oc; b++) {
                             const int8_t* w_base = w + (oc0 + b) * w_oc_stride + ic * w_ic_stride;
+                            const float sc = oc_scale ? oc_scale[oc0 + b] : scale;
+                            for (int32_t bi = 0; bi < nb; bi++) {
+                                const float* x_img = x + (n0 + bi) * x_n + ic * x_c_stride;
 
-                            if (tile_is_safe) {
-                                for (int32_t dh = 0; dh < th; dh++) {
-                                    const int32_t oh = oh0 + dh;
-                                    const int32_t ih0 = oh * stride_h - pad_h;
-                                    for (int32_t dw = 0; dw < tw; dw++) {
-                                        const int32_t ow = ow0 + dw;
-                                        const int32_t iw0 = ow * stride_w - pad_w;
-                                        const float* x_base = x + (ni * c_in + ic) * x_c_stride + ih0 * x_h_stride + iw0;
-                                        float contrib = 0.0f;
-                                        for (int32_t kh = 0; kh < k_h; kh++) {
-                                            const float* x_row = x_base + kh * x_h_stride;
-                                            const int8_t* w_row = w_base + kh * w_k_stride;
-                                            for (int32_t kw = 0; kw < k_w; kw++) {
-                                                contrib += (*x_row++) * ((float)(*w_row++) * scale);
-                                            }
-                                        }
-                                        float* acc_ptr = &conv2d_acc_buf[dh][dw][0];
-                                        acc_ptr[b] += contrib;
-                                    }
-                                }
-                            } else {
-                                for (int32_t dh = 0; dh < th; dh++) {
-                                    const int32_t oh = oh0 + dh;
-                                    for (int32_t dw = 0; dw < tw; dw++) {
-                                        const int32_t ow = ow0 + dw;
-                                        const int32_t in_safe = (oh >= safe_oh_min && oh < safe_oh_max &&
-                                                                ow >= safe_ow_min && ow < safe_ow_max);
-                                        float contrib;
-                                        if (in_safe) {
-                                            const int32_t ih0 = oh * stride_h - pad_h;
+                                if (tile_is_safe) {
+                                    /* Fast path: 타일 전체가 safe → per-pixel 분기 없음 */
+                                    for (int32_t dh = 0; dh < th; dh++) {
+                                        const int32_t oh = oh0 + dh;
+                                        const int32_t ih0 = oh * stride_h - pad_h;
+                                        for (int32_t dw = 0; dw < tw; dw++) {
+                                            const int32_t ow = ow0 + dw;
                                             const int32_t iw0 = ow * stride_w - pad_w;
-                                            const float* x_base = x + (ni * c_in + ic) * x_c_stride + ih0 * x_h_stride + iw0;
-                                            contrib = 0.0f;
+                                            const float* x_base = x_img + ih0 * x_h_stride + iw0;
+                                            float contrib = 0.0f;
                                             for (int32_t kh = 0; kh < k_h; kh++) {
                                                 const float* x_row = x_base + kh * x_h_stride;
                                                 const int8_t* w_row = w_base + kh * w_k_stride;
+                                                CSIM_READ(CSIM_INPUT, x_row, (size_t)k_w * sizeof(float));
+                                                CSIM_READ(CSIM_WEIGHT, w_row, (size_t)k_w * sizeof(*w_row));
                                                 for (int32_t kw = 0; kw < k_w; kw++) {
-                                                    contrib += (*x_row++) * ((float)(*w_row++) * scale);
+                                                    contrib += (*x_row++) * ((float)(*w_row++) * sc);
                                                 }
                                             }
-                                        } else {
-                                            contrib = 0.0f;
-                                            for (int32_t kh = 0; kh < k_h; kh++) {
-                                                const int32_t ih = oh * stride_h - pad_h + kh;
-                                                if ((uint32_t)ih >= (uint32_t)h_in) continue;
-                                                for (int32_t kw = 0; kw < k_w; kw++) {
-                                                    const int32_t iw = ow * stride_w - pad_w + kw;
-                                                    if ((uint32_t)iw >= (uint32_t)w_in) continue;
-                                                    const float* x_ptr = x + (ni * c_in + ic) * x_c_stride + ih * x_h_stride + iw;
-                                                    const int8_t* w_ptr = w + (oc0 + b) * w_oc_stride + ic * w_ic_stride + kh * w_k_stride + kw;
-                                                    contrib += (*x_ptr) * ((float)(*w_ptr) * scale);
+                                            float* acc_ptr = &conv2d_acc_buf[bi][dh][dw][0];
+                                            CSIM_READ(CSIM_ACC, acc_ptr + b, sizeof(float));
+                                            acc_ptr[b] += contrib;
+                                            CSIM_WRITE(CSIM_ACC, acc_ptr + b, sizeof(float));
+                                        }
+                                    }
+                                } else {
+                                    /* 경계 경로: (dh,dw)마다 in_safe 체크 */
+                                    for (int32_t dh = 0; dh < th; dh++) {
+                                        const int32_t oh = oh0 + dh;
+                                        for (int32_t dw = 0; dw < tw; dw++) {
+                                            const int32_t ow = ow0 + dw;
+                                            const int32_t in_safe = (oh >= safe_oh_min && oh < safe_oh_max &&
+                                                                    ow >= safe_ow_min && ow < safe_ow_max);
+                                            float contrib = 0.0f;
+                                            if (in_safe) {
+                                                const int32_t ih0 = oh * stride_h - pad_h;
+                                                const int32_t iw0 = ow * stride_w - pad_w;
+                                                const float* x_base = x_img + ih0 * x_h_stride + iw0;
+                                                for (int32_t kh = 0; kh < k_h; kh++) {
+                                                    const float* x_row = x_base + kh * x_h_stride;
+                                                    const int8_t* w_row = w_base + kh * w_k_stride;
+                                                    CSIM_READ(CSIM_INPUT, x_row, (size_t)k_w * sizeof(float));
+                                                    CSIM_READ(CSIM_WEIGHT, w_row, (size_t)k_w * sizeof(*w_row));
+                                                    for (int32_t kw = 0; kw < k_w; kw++) {
+                                                        contrib += (*x_row++) * ((float)(*w_row++) * sc);
+                                                    }
+                                                }
+                                            } else {
+                                                for (int32_t kh = 0; kh < k_h; kh++) {
+                                                    const int32_t ih = oh * stride_h - pad_h + kh;
+                                                    if ((uint32_t)ih >= (uint32_t)h_in) continue;
+                                                    for (int32_t kw = 0; kw < k_w; kw++) {
+                                                        const int32_t iw = ow * stride_w - pad_w + kw;
+                                                        if ((uint32_t)iw >= (uint32_t)w_in) continue;
+                                                        CSIM_READ(CSIM_INPUT, &x_img[ih * x_h_stride + iw], sizeof(float));
+                                                        CSIM_READ(CSIM_WEIGHT, &w_base[kh * w_k_stride + kw], sizeof(*w_base));
+                                                        contrib += x_img[ih * x_h_stride + iw] * ((float)w_base[kh * w_k_stride + kw] * sc);
+                                                    }
                                                 }
                                             }
+                                            float* acc_ptr = &conv2d_acc_buf[bi][dh][dw][0];
+                                            CSIM_READ(CSIM_ACC, acc_ptr + b, sizeof(float));
+                                            acc_ptr[b] += contrib;
+                                            CSIM_WRITE(CSIM_ACC, acc_ptr + b, sizeof(float));
                                         }
-                                        float* acc_ptr = &conv2d_acc_buf[dh][dw][0];
-                                        acc_ptr[b] += contrib;
                                     }
                                 }
                             }
                         }
                     }
 
-                    for (int32_t dh = 0; dh < th; dh++) {
-                        const int32_t oh = oh0 + dh;
-                        for (int32_t dw = 0; dw < tw; dw++) {
-                            const int32_t ow = ow0 + dw;
-                            const int32_t y_row_off = (ni * c_out + oc0) * h_out * w_out + oh * w_out + ow;
-                            for (int32_t b = 0; b < n_oc; b++) {
-                                y[y_row_off + b * h_out * w_out] = conv2d_acc_buf[dh][dw][b];
+                    /* 누적 버퍼 → y 쓰기 */
+                    for (int32_t bi = 0; bi < nb; bi++) {
+                        for (int32_t dh = 0; dh < th; dh++) {
+                            const int32_t oh = oh0 + dh;
+                            for (int32_t dw = 0; dw < tw; dw++) {
+                                const int32_t ow = ow0 + dw;
+                                const int32_t y_row_off = (n0 + bi) * y_n + oc0 * y_c_stride + oh * y_h_stride + ow;
+                                CSIM_READ(CSIM_ACC, &conv2d_acc_buf[bi][dh][dw][0], (size_t)n_oc * sizeof(float));
+                                for (int32_t b = 0; b < n_oc; b++) {
+                                    y[y_row_off + b * y_c_stride] = conv2d_acc_buf[bi][dh][dw][b];
+                                    CSIM_WRITE(CSIM_OUTPUT, &y[y_row_off + b * y_c_stride], sizeof(float));
+                                }
                             }
                         }
                     }
@@ -289,3 +410,113 @@ void conv2d_nchw_f32_w8(
         }
     }
 }
+
+void conv2d_nchw_f32_w8_halo(
+    const float* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out)
+{
+    if (groups != 1) return;
+#ifdef CONV2D_SPM
+    if (conv2d_spm_nchw_f32(x, x_halo, x_n_stride, n, c_in, h_in, w_in, w, scale, 1, c_out, k_h, k_w, bias_or_null,
+                            stride_h, stride_w, pad_h, pad_w, groups, y, y_halo, y_n_stride, h_out, w_out) == 0)
+        return;
+#endif
+    conv2d_w8_impl(x, x_halo, x_n_stride, n, c_in, h_in, w_in, w, scale, NULL, c_out, k_h, k_w, bias_or_null,
+                   stride_h, stride_w, pad_h, pad_w, y, y_halo, y_n_stride, h_out, w_out);
+}
+
+/* SPM 경로는 텐서 scale 하나만 받으므로 항상 일반 경로 */
+void conv2d_nchw_f32_w8oc_halo(
+    const float* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, const float* oc_scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    float* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out)
+{
+    conv2d_w8_impl(x, x_halo, x_n_stride, n, c_in, h_in, w_in, w, 0.0f, oc_scale, c_out, k_h, k_w, bias_or_null,
+                   stride_h, stride_w, pad_h, pad_w, y, y_halo, y_n_stride, h_out, w_out);
+}
+
+void conv2d_fold_u8_weights(
+    const void* w, float w_scale, int w_is_int8,
+    int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w,
+    float* w_t)
+{
+    for (int32_t oc = 0; oc < c_out; oc++) {
+        for (int32_t ic = 0; ic < c_in; ic++) {
+            for (int32_t kh = 0; kh < k_h; kh++) {
+                for (int32_t kw = 0; kw < k_w; kw++) {
+                    const int32_t src = ((oc * c_in + ic) * k_h + kh) * k_w + kw;
+                    const float v = w_is_int8 ? (float)((const int8_t*)w)[src] * w_scale : ((const float*)w)[src];
+                    w_t[((ic * k_h + kh) * k_w + kw) * c_out + oc] = v / 255.0f;
+                }
+            }
+        }
+    }
+}
+
+/* uint8 입력 stem: 픽셀 하나를 float로 한 번 바꿔 oc 블록 전체에 곱함 (w_t가 oc 연속 → 안쪽 루프 연속 접근).
+ * 입력 stride로 CHW/HWC 모두 처리. 입력은 halo 없음 → 경계 픽셀만 범위 체크 */
+void conv2d_u8_f32_halo(
+    const uint8_t* x, int32_t x_c_stride, int32_t x_h_stride, int32_t x_w_stride,
+    int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w_t, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    float* y, int32_t y_halo, int32_t h_out, int32_t w_out)
+{
+    const int32_t oc_block = CONV2D_OC_BLOCK;
+    const int32_t safe_oh_min = safe_min(pad_h, 0, stride_h);
+    const int32_t safe_oh_max = safe_max(h_in, k_h, pad_h, 0, stride_h);
+    const int32_t safe_ow_min = safe_min(pad_w, 0, stride_w);
+    const int32_t safe_ow_max = safe_max(w_in, k_w, pad_w, 0, stride_w);
+    const int32_t y_h_stride = w_out + 2 * y_halo;
+    const int32_t y_c_stride = (h_out + 2 * y_halo) * y_h_stride;
+    float acc[CONV2D_OC_BLOCK];
+
+    for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
+        const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
+        for (int32_t oh = 0; oh < h_out; oh++) {
+            const int32_t ih0 = oh * stride_h - pad_h;
+            const int32_t row_safe = oh >= safe_oh_min && oh < safe_oh_max;
+            for (int32_t ow = 0; ow < w_out; ow++) {
+                const int32_t iw0 = ow * stride_w - pad_w;
+                const int32_t in_safe = row_safe && ow >= safe_ow_min && ow < safe_ow_max;
+                for (int32_t b = 0; b < n_oc; b++) acc[b] = bias_or_null ? bias_or_null[oc0 + b] : 0.0f;
+                if (bias_or_null) CSIM_READ(CSIM_WEIGHT, bias_or_null + oc0, (size_t)n_oc * sizeof(float));
+                CSIM_MACS((uint64_t)n_oc * c_in * k_h * k_w);
+
+                for (int32_t ic = 0; ic < c_in; ic++) {
+                    for (int32_t kh = 0; kh < k_h; kh++) {
+                        const int32_t ih = ih0 + kh;
+                        if (!in_safe && (uint32_t)ih >= (uint32_t)h_in) continue;
+                        const uint8_t* x_row = x + ic * x_c_stride + ih * x_h_stride;
+                        const float* w_row = w_t + (ic * k_h + kh) * k_w * c_out + oc0;
+                        for (int32_t kw = 0; kw < k_w; kw++) {
+                            const int32_t iw = iw0 + kw;
+                            if (!in_safe && (uint32_t)iw >= (uint32_t)w_in) continue;
+                            const float v = (float)x_row[iw * x_w_stride];
+                            const float* w_px = w_row + kw * c_out;
+                            CSIM_READ(CSIM_INPUT, &x_row[iw * x_w_stride], 1);
+                            CSIM_READ(CSIM_WEIGHT, w_px, (size_t)n_oc * sizeof(float));
+                            for (int32_t b = 0; b < n_oc; b++) acc[b] += v * w_px[b];
+                        }
+                    }
+                }
+
+                float* y_px = y + oc0 * y_c_stride + oh * y_h_stride + ow;
+                for (int32_t b = 0; b < n_oc; b++) {
+                    y_px[b * y_c_stride] = acc[b];
+                    CSIM_WRITE(CSIM_OUTPUT, &y_px[b * y_c_stride], sizeof(float));
+                }
+            }
+        }
+    }
+}
@@ -29,4 +29,56 @@ void conv2d_nchw_f32_w8(
     int32_t groups,
     float* y, int32_t h_out, int32_t w_out);
 
+/* Halo 레이아웃 입출력 (operations/halo.h): x/y는 내부 (0,0) 포인터, x_halo/y_halo는 테두리 폭.
+ * x_halo >= pad이면 경계 경로 없이 전부 fast path. y 테두리는 건드리지 않음 (호출자가 0으로 유지).
+ * x_n_stride/y_n_stride: 이미지 간격 (원소), 0 = 연속 (채널 수 × halo 평면). 큰 버퍼의 채널 구간(C3/SPPF concat)을
+ * 배치 그대로 읽고 씀 → 가중치 블록은 배치 블록마다 한 번 */
+void conv2d_nchw_f32_halo(
+    const float* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out);
+
+void conv2d_nchw_f32_w8_halo(
+    const float* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out);
+
+/* 출력 채널별 scale (oc_scale[c_out]): 텐서 여러 개를 출력 채널 방향으로 합친 INT8 가중치 (C3 cv1+cv2). groups 1만 */
+void conv2d_nchw_f32_w8oc_halo(
+    const float* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, const float* oc_scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    float* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out);
+
+/* uint8 입력 stem용 가중치 접기: w (OIHW, float 또는 int8 + scale) / 255 → w_t[ic][kh][kw][oc] (c_out*c_in*k_h*k_w개) */
+void conv2d_fold_u8_weights(
+    const void* w, float w_scale, int w_is_int8,
+    int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w,
+    float* w_t);
+
+/* uint8 이미지 1장 입력 conv (픽셀 0..255, /255는 w_t에 접혀 있음). 픽셀 (c, h, w) = x[c*x_c_stride + h*x_h_stride + w*x_w_stride]
+ * → CHW (H*W, W, 1) / HWC (1, W*C, C). y는 NCHW halo 내부 포인터 */
+void conv2d_u8_f32_halo(
+    const uint8_t* x, int32_t x_c_stride, int32_t x_h_stride, int32_t x_w_stride,
+    int32_t c_in, int32_t h_in, int32_t w_in,
+    const float* w_t, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    float* y, int32_t y_halo, int32_t h_out, int32_t w_out);
+
+/* 경계 경로(bounds-checked)를 탄 (배치 블록, 타일, oc 블록) 수 누적. 프로파일/테스트용 */
+uint64_t conv2d_get_border_tiles(void);
+void conv2d_reset_border_tiles(void);
+
 #endif // CONV2D_H
@@ -0,0 +1,215 @@
+#include "conv2d_q.h"
+#include "../utils/thread_local.h"
+
+/* 정수 conv: conv2d_nchw_f32_w8_halo와 같은 타일/oc 블록/루프 순서 (ic→b→dh→dw→kh→kw), 누적만 int64.
+ * x_q × w_int8 곱은 int32 (|x_q| ≤ YOLO_Q_MAX), 탭 합과 채널 누적은 int64 → 오버플로 없음.
+ * 배치는 이미지 단위 (누적 버퍼가 int64라 배치 블록 없이 FP32와 같은 크기). */
+#ifndef CONV2D_TILE_H
+#define CONV2D_TILE_H 8
+#endif
+#ifndef CONV2D_TILE_W
+#define CONV2D_TILE_W 8
+#endif
+#ifndef CONV2D_OC_BLOCK
+#define CONV2D_OC_BLOCK 32
+#endif
+
+static YOLO_THREAD_LOCAL int64_t conv2d_q_acc_buf[CONV2D_TILE_H][CONV2D_TILE_W][CONV2D_OC_BLOCK];
+
+static inline int32_t safe_min(int32_t pad, int32_t halo, int32_t stride) {
+    return pad > halo ? (pad - halo + stride - 1) / stride : 0;
+}
+static inline int32_t safe_max(int32_t in, int32_t k, int32_t pad, int32_t halo, int32_t stride) {
+    const int32_t room = in + halo + pad - k;
+    return room < 0 ? 0 : room / stride + 1;
+}
+
+/* oc 블록 bias → Q */
+static void bias_to_q(const float* bias_or_null, int32_t oc0, int32_t n_oc, int32_t* bias_q) {
+    for (int32_t b = 0; b < n_oc; b++)
+        bias_q[b] = bias_or_null ? q_sat(q_from_f32(bias_or_null[oc0 + b], YOLO_Q_FRAC)) : 0;
+}
+
+/* oc_scale != NULL이면 출력 채널마다 재양자화 (합친 가중치), NULL이면 텐서 scale 하나 */
+static void conv2d_q_impl(
+    const int32_t* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, const float* oc_scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out)
+{
+    const int32_t tile_h = CONV2D_TILE_H;
+    const int32_t tile_w = CONV2D_TILE_W;
+    const int32_t oc_block = CONV2D_OC_BLOCK;
+    const q_requant_t rq = q_requant_from_f32(scale, 0);
+    q_requant_t rq_oc[CONV2D_OC_BLOCK];
+
+    const int32_t safe_oh_min = safe_min(pad_h, x_halo, stride_h);
+    const int32_t safe_oh_max = safe_max(h_in, k_h, pad_h, x_halo, stride_h);
+    const int32_t safe_ow_min = safe_min(pad_w, x_halo, stride_w);
+    const int32_t safe_ow_max = safe_max(w_in, k_w, pad_w, x_halo, stride_w);
+
+    const int32_t x_h_stride = w_in + 2 * x_halo;
+    const int32_t x_c_stride = (h_in + 2 * x_halo) * x_h_stride;
+    const int32_t y_h_stride = w_out + 2 * y_halo;
+    const int32_t y_c_stride = (h_out + 2 * y_halo) * y_h_stride;
+    const int32_t x_n = x_n_stride ? x_n_stride : c_in * x_c_stride;
+    const int32_t y_n = y_n_stride ? y_n_stride : c_out * y_c_stride;
+    const int32_t w_ic_stride = k_h * k_w;
+    const int32_t w_oc_stride = c_in * k_h * k_w;
+    int32_t bias_q[CONV2D_OC_BLOCK];
+
+    for (int32_t ni = 0; ni < n; ni++) {
+        for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
+            const int32_t oh_end = oh0 + tile_h < h_out ? oh0 + tile_h : h_out;
+            const int32_t th = oh_end - oh0;
+            for (int32_t ow0 = 0; ow0 < w_out; ow0 += tile_w) {
+                const int32_t ow_end = ow0 + tile_w < w_out ? ow0 + tile_w : w_out;
+                const int32_t tw = ow_end - ow0;
+
+                for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
+                    const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
+                    for (int32_t dh = 0; dh < th; dh++)
+                        for (int32_t dw = 0; dw < tw; dw++)
+                            for (int32_t b = 0; b < n_oc; b++) conv2d_q_acc_buf[dh][dw][b] = 0;
+
+                    const int32_t tile_is_safe = (oh0 >= safe_oh_min && oh_end <= safe_oh_max &&
+                                                  ow0 >= safe_ow_min && ow_end <= safe_ow_max);
+
+                    for (int32_t ic = 0; ic < c_in; ic++) {
+                        const int32_t* x_img = x + ni * x_n + ic * x_c_stride;
+                        for (int32_t b = 0; b < n_oc; b++) {
+                            const int8_t* w_base = w + (oc0 + b) * w_oc_stride + ic * w_ic_stride;
+                            if (tile_is_safe) {
+                                /* Fast path: 분기 없음 */
+                                for (int32_t dh = 0; dh < th; dh++) {
+                                    const int32_t* x_oh = x_img + ((oh0 + dh) * stride_h - pad_h) * x_h_stride;
+                                    for (int32_t dw = 0; dw < tw; dw++) {
+                                        const int32_t* x_base = x_oh + (ow0 + dw) * stride_w - pad_w;
+                                        int64_t contrib = 0;
+                                        for (int32_t kh = 0; kh < k_h; kh++) {
+                                            const int32_t* x_row = x_base + kh * x_h_stride;
+                                            const int8_t* w_row = w_base + kh * k_w;
+                                            for (int32_t kw = 0; kw < k_w; kw++)
+                                                contrib += (*x_row++) * (int32_t)(*w_row++);
+                                        }
+                                        conv2d_q_acc_buf[dh][dw][b] += contrib;
+                                    }
+                                }
+                                continue;
+                            }
+                            /* 경계 경로: 패딩 위치 건너뜀 */
+                            for (int32_t dh = 0; dh < th; dh++) {
+                                const int32_t oh = oh0 + dh;
+                                for (int32_t dw = 0; dw < tw; dw++) {
+                                    const int32_t ow = ow0 + dw;
+                                    int64_t contrib = 0;
+                                    for (int32_t kh = 0; kh < k_h; kh++) {
+                                        const int32_t ih = oh * stride_h - pad_h + kh;
+                                        if ((uint32_t)ih >= (uint32_t)h_in) continue;
+                                        for (int32_t kw = 0; kw < k_w; kw++) {
+                                            const int32_t iw = ow * stride_w - pad_w + kw;
+                                            if ((uint32_t)iw >= (uint32_t)w_in) continue;
+                                            contrib += x_img[ih * x_h_stride + iw] * (int32_t)w_base[kh * k_w + kw];
+                                        }
+                                    }
+                                    conv2d_q_acc_buf[dh][dw][b] += contrib;
+                                }
+                            }
+                        }
+                    }
+
+                    /* 누적 → 재양자화 + bias → y */
+                    bias_to_q(bias_or_null, oc0, n_oc, bias_q);
+                    for (int32_t b = 0; b < n_oc; b++)
+                        rq_oc[b] = oc_scale ? q_requant_from_f32(oc_scale[oc0 + b], 0) : rq;
+                    for (int32_t dh = 0; dh < th; dh++) {
+                        for (int32_t dw = 0; dw < tw; dw++) {
+                            int32_t* y_px = y + ni * y_n + oc0 * y_c_stride + (oh0 + dh) * y_h_stride + ow0 + dw;
+                            for (int32_t b = 0; b < n_oc; b++)
+                                y_px[b * y_c_stride] = q_sat(q_requant(conv2d_q_acc_buf[dh][dw][b], rq_oc[b]) + bias_q[b]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void conv2d_nchw_q_w8_halo(
+    const int32_t* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out)
+{
+    conv2d_q_impl(x, x_halo, x_n_stride, n, c_in, h_in, w_in, w, scale, NULL, c_out, k_h, k_w, bias_or_null,
+                  stride_h, stride_w, pad_h, pad_w, y, y_halo, y_n_stride, h_out, w_out);
+}
+
+void conv2d_nchw_q_w8oc_halo(
+    const int32_t* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, const float* oc_scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out)
+{
+    conv2d_q_impl(x, x_halo, x_n_stride, n, c_in, h_in, w_in, w, 1.0f, oc_scale, c_out, k_h, k_w, bias_or_null,
+                  stride_h, stride_w, pad_h, pad_w, y, y_halo, y_n_stride, h_out, w_out);
+}
+
+/* stem: 픽셀마다 Q로 한 번 바꿔 oc 블록 전체에 곱함. uint8은 /255 Q 표 (호출마다 256개), FP32는 비트 변환 */
+void conv2d_image_q_w8_halo(
+    const uint8_t* x_u8, const float* x_f32,
+    int32_t x_c_stride, int32_t x_h_stride, int32_t x_w_stride,
+    int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t* y, int32_t y_halo, int32_t h_out, int32_t w_out)
+{
+    const int32_t oc_block = CONV2D_OC_BLOCK;
+    const q_requant_t rq = q_requant_from_f32(scale, 0);
+    const int32_t y_h_stride = w_out + 2 * y_halo;
+    const int32_t y_c_stride = (h_out + 2 * y_halo) * y_h_stride;
+    const int32_t w_oc_stride = c_in * k_h * k_w;
+    int32_t u8_q[256];
+    int32_t bias_q[CONV2D_OC_BLOCK];
+    int64_t acc[CONV2D_OC_BLOCK];
+
+    if (x_u8)
+        for (int32_t p = 0; p < 256; p++) u8_q[p] = (2 * p * Q_ONE + 255) / 510;   /* round(p / 255 × 2^frac) */
+
+    for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
+        const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
+        bias_to_q(bias_or_null, oc0, n_oc, bias_q);
+        for (int32_t oh = 0; oh < h_out; oh++) {
+            const int32_t ih0 = oh * stride_h - pad_h;
+            for (int32_t ow = 0; ow < w_out; ow++) {
+                const int32_t iw0 = ow * stride_w - pad_w;
+                for (int32_t b = 0; b < n_oc; b++) acc[b] = 0;
+                for (int32_t ic = 0; ic < c_in; ic++) {
+                    for (int32_t kh = 0; kh < k_h; kh++) {
+                        const int32_t ih = ih0 + kh;
+                        if ((uint32_t)ih >= (uint32_t)h_in) continue;
+                        for (int32_t kw = 0; kw < k_w; kw++) {
+                            const int32_t iw = iw0 + kw;
+                            if ((uint32_t)iw >= (uint32_t)w_in) continue;
+                            const int32_t off = ic * x_c_stride + ih * x_h_stride + iw * x_w_stride;
+                            const int32_t v = x_u8 ? u8_q[x_u8[off]] : q_sat(q_from_f32(x_f32[off], YOLO_Q_FRAC));
+                            const int8_t* w_px = w + oc0 * w_oc_stride + (ic * k_h + kh) * k_w + kw;
+                            for (int32_t b = 0; b < n_oc; b++) acc[b] += v * (int32_t)w_px[b * w_oc_stride];
+                        }
+                    }
+                }
+                int32_t* y_px = y + oc0 * y_c_stride + oh * y_h_stride + ow;
+                for (int32_t b = 0; b < n_oc; b++)
+                    y_px[b * y_c_stride] = q_sat(q_requant(acc[b], rq) + bias_q[b]);
+            }
+        }
+    }
+}
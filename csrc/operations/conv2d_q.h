@@ -0,0 +1,38 @@
+#ifndef CONV2D_Q_H
+#define CONV2D_Q_H
+
+#include <stdint.h>
+#include "qformat.h"
+
+/* 정수 conv (활성값 Q(YOLO_Q_FRAC) int32, 가중치 INT8 + 텐서 scale). 누적 int64, 출력 = 재양자화 + bias → ±YOLO_Q_MAX 포화.
+ * 레이아웃·인자는 conv2d_nchw_f32_w8_halo와 같음 (groups 1만, x_n_stride/y_n_stride 0 = 연속). scale/bias는 float 비트를 정수로 풀어 사용 */
+void conv2d_nchw_q_w8_halo(
+    const int32_t* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out);
+
+/* 출력 채널별 scale (oc_scale[c_out], 재양자화 계수를 oc 블록마다 계산): 출력 채널 방향으로 합친 INT8 가중치 (C3 cv1+cv2) */
+void conv2d_nchw_q_w8oc_halo(
+    const int32_t* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, const float* oc_scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out);
+
+/* 이미지 1장 입력 stem: x_u8 (픽셀 0..255 → /255 Q) 또는 x_f32 (0..1, 비트 → Q) 중 NULL 아닌 쪽.
+ * 픽셀 (c, h, w) = x[c*x_c_stride + h*x_h_stride + w*x_w_stride] (conv2d_u8_f32_halo와 같음). 입력 halo 없음 */
+void conv2d_image_q_w8_halo(
+    const uint8_t* x_u8, const float* x_f32,
+    int32_t x_c_stride, int32_t x_h_stride, int32_t x_w_stride,
+    int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, float scale, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t* y, int32_t y_halo, int32_t h_out, int32_t w_out);
+
+#endif // CONV2D_Q_H
@@ -0,0 +1,270 @@
+#include "conv2d_spm.h"
+#include "../utils/dma.h"
+#include "../utils/thread_local.h"
+
+#include <string.h>
+
+#ifdef BARE_METAL
+#include "platform_config.h"
+#endif
+
+/* 실행 순서 (step): 이미지 → 출력 타일 (행, 열) → oc 블록 → ic 묶음. step s의 입력/가중치는 버퍼 s & 1,
+ * 출력 타일(oc 블록 하나, job)은 출력 버퍼 job & 1.
+ *   step s 연산 전에 step s+1 적재를 요청 → 연산과 복사가 겹침. 같은 데이터가 이미 그 버퍼에 있으면 생략
+ *   (ic 묶음 1개면 가중치는 버퍼마다 한 번, oc 블록끼리는 입력 타일 재사용).
+ *   job의 마지막 ic 묶음 뒤 출력 타일 저장 요청 → 다음 job 연산과 겹침, job+2 시작 전에 완료 대기.
+ * 출력 하나의 누적 순서 (bias → ic 오름차순, ic마다 kh/kw 합) = 캐시 경로 → 비트 동일. */
+
+#define SPM_ALIGN 64u
+
+static size_t align_up(size_t v) {
+    return (v + SPM_ALIGN - 1u) & ~(size_t)(SPM_ALIGN - 1u);
+}
+
+/* SPM 영역: BARE_METAL은 CONV2D_SPM_BASE(BRAM 등)가 있으면 그 주소, 없으면 .bss. 호스트는 스레드별 */
+#if defined(BARE_METAL) && defined(CONV2D_SPM_BASE)
+static uint8_t* spm_base(void) { return (uint8_t*)(uintptr_t)CONV2D_SPM_BASE; }
+#else
+static YOLO_THREAD_LOCAL float conv2d_spm_buf[(CONV2D_SPM_BYTES + SPM_ALIGN) / sizeof(float)];
+static uint8_t* spm_base(void) {
+    return (uint8_t*)align_up((uintptr_t)conv2d_spm_buf);
+}
+#endif
+
+int conv2d_spm_plan(int32_t c_in, int32_t k_h, int32_t k_w, int32_t stride_h, int32_t stride_w, int w_is_int8,
+                    conv2d_spm_plan_t* plan) {
+    const size_t esize = w_is_int8 ? 1u : sizeof(float);
+    memset(plan, 0, sizeof(*plan));
+    if (c_in <= 0 || k_h <= 0 || k_w <= 0 || stride_h <= 0 || stride_w <= 0) return -1;
+    plan->in_rows = (CONV2D_SPM_TILE_H - 1) * stride_h + k_h;
+    plan->in_cols = (CONV2D_SPM_TILE_W - 1) * stride_w + k_w;
+    plan->out_bytes = align_up((size_t)CONV2D_SPM_OC_BLOCK * CONV2D_SPM_TILE_H * CONV2D_SPM_TILE_W * sizeof(float));
+    const size_t per_ic_in = (size_t)plan->in_rows * plan->in_cols * sizeof(float);
+    const size_t per_ic_w = (size_t)CONV2D_SPM_OC_BLOCK * k_h * k_w * esize;
+    if (2u * plan->out_bytes >= CONV2D_SPM_BYTES) return -1;
+    const size_t avail = CONV2D_SPM_BYTES - 2u * plan->out_bytes;
+    /* 묶음 크기: 버퍼 2쌍이 남은 영역에 맞는 최대 → 묶음 수를 유지하며 고르게 */
+    int32_t icb = c_in;
+    while (icb > 0 && 2u * (align_up((size_t)icb * per_ic_in) + align_up((size_t)icb * per_ic_w)) > avail) icb--;
+    if (icb < 1) return -1;
+    const int32_t chunks = (c_in + icb - 1) / icb;
+    plan->ic_chunk = (c_in + chunks - 1) / chunks;
+    plan->in_bytes = align_up((size_t)plan->ic_chunk * per_ic_in);
+    plan->w_bytes = align_up((size_t)plan->ic_chunk * per_ic_w);
+    plan->spm_bytes = 2u * (plan->out_bytes + plan->in_bytes + plan->w_bytes);
+    return 0;
+}
+
+/* 공통 인자 (step 적재·연산이 같이 씀) */
+typedef struct {
+    const float* x;
+    int32_t x_halo, c_in, h_in, w_in, x_h_stride, x_c_stride, x_n_stride;
+    const uint8_t* w;
+    size_t esize;
+    int32_t c_out, k_h, k_w, stride_h, stride_w, pad_h, pad_w;
+    int32_t h_out, w_out;
+    int32_t n_th, n_tw, n_ocb, n_icc;
+    conv2d_spm_plan_t pl;
+    float* in_buf[2];
+    uint8_t* w_buf[2];
+    int64_t in_key[2], w_key[2];   /* 버퍼에 있는 데이터 (-1: 없음) */
+    dma_ticket_t ld_ticket[2];
+} spm_job_t;
+
+typedef struct {
+    int32_t img, oh0, ow0, th, tw, oc0, n_oc, ic0, n_ic, icc, ob;
+} spm_step_t;
+
+static void decode_step(const spm_job_t* j, int64_t s, spm_step_t* st) {
+    st->icc = (int32_t)(s % j->n_icc);  s /= j->n_icc;
+    st->ob = (int32_t)(s % j->n_ocb);   s /= j->n_ocb;
+    const int32_t tx = (int32_t)(s % j->n_tw);  s /= j->n_tw;
+    const int32_t ty = (int32_t)(s % j->n_th);  s /= j->n_th;
+    st->img = (int32_t)s;
+    st->oh0 = ty * CONV2D_SPM_TILE_H;
+    st->ow0 = tx * CONV2D_SPM_TILE_W;
+    st->th = st->oh0 + CONV2D_SPM_TILE_H <= j->h_out ? CONV2D_SPM_TILE_H : j->h_out - st->oh0;
+    st->tw = st->ow0 + CONV2D_SPM_TILE_W <= j->w_out ? CONV2D_SPM_TILE_W : j->w_out - st->ow0;
+    st->oc0 = st->ob * CONV2D_SPM_OC_BLOCK;
+    st->n_oc = st->oc0 + CONV2D_SPM_OC_BLOCK <= j->c_out ? CONV2D_SPM_OC_BLOCK : j->c_out - st->oc0;
+    st->ic0 = st->icc * j->pl.ic_chunk;
+    st->n_ic = st->ic0 + j->pl.ic_chunk <= j->c_in ? j->pl.ic_chunk : j->c_in - st->ic0;
+}
+
+/* step s의 입력 타일(패딩 0 포함)·가중치 블록 → 버퍼 buf (비동기) */
+static void stage_step(spm_job_t* j, int64_t s, int buf) {
+    spm_step_t st;
+    decode_step(j, s, &st);
+    const int64_t in_key = s / j->n_icc / j->n_ocb * j->n_icc + st.icc;  /* (이미지, 타일, ic 묶음) */
+    const int64_t w_key = (int64_t)st.ob * j->n_icc + st.icc;
+    dma_desc_t d;
+    if (j->in_key[buf] != in_key) {
+        const int32_t rows = (st.th - 1) * j->stride_h + j->k_h;
+        const int32_t cols = (st.tw - 1) * j->stride_w + j->k_w;
+        const int32_t ih0 = st.oh0 * j->stride_h - j->pad_h;
+        const int32_t iw0 = st.ow0 * j->stride_w - j->pad_w;
+        const int32_t r0 = ih0 < 0 ? 0 : ih0, r1 = ih0 + rows > j->h_in ? j->h_in : ih0 + rows;
+        const int32_t c0 = iw0 < 0 ? 0 : iw0, c1 = iw0 + cols > j->w_in ? j->w_in : iw0 + cols;
+        float* dst = j->in_buf[buf];
+        /* 입력 밖(패딩)은 0: 이 버퍼의 이전 적재는 이미 끝났고(연산 전에 대기) 지금은 연산에 안 쓰임 */
+        if (r0 != ih0 || r1 != ih0 + rows || c0 != iw0 || c1 != iw0 + cols)
+            memset(dst, 0, (size_t)st.n_ic * j->pl.in_rows * j->pl.in_cols * sizeof(float));
+        if (r1 > r0 && c1 > c0) {
+            d.src = j->x + (size_t)st.img * j->x_n_stride + (size_t)st.ic0 * j->x_c_stride + (size_t)r0 * j->x_h_stride + c0;
+            d.dst = dst + (size_t)(r0 - ih0) * j->pl.in_cols + (c0 - iw0);
+            d.row_bytes = (size_t)(c1 - c0) * sizeof(float);
+            d.rows = r1 - r0;
+            d.planes = st.n_ic;
+            d.src_row_pitch = (size_t)j->x_h_stride * sizeof(float);
+            d.src_plane_pitch = (size_t)j->x_c_stride * sizeof(float);
+            d.dst_row_pitch = (size_t)j->pl.in_cols * sizeof(float);
+            d.dst_plane_pitch = (size_t)j->pl.in_rows * j->pl.in_cols * sizeof(float);
+            j->ld_ticket[buf] = dma_submit(&d);
+        }
+        j->in_key[buf] = in_key;
+    }
+    if (j->w_key[buf] != w_key) {
+        const size_t kk = (size_t)j->k_h * j->k_w * j->esize;
+        d.src = j->w + ((size_t)st.oc0 * j->c_in + st.ic0) * kk;
+        d.dst = j->w_buf[buf];
+        d.row_bytes = (size_t)st.n_ic * kk;
+        d.rows = 1;
+        d.planes = st.n_oc;
+        d.src_row_pitch = d.dst_row_pitch = 0;
+        d.src_plane_pitch = (size_t)j->c_in * kk;
+        d.dst_plane_pitch = (size_t)j->pl.ic_chunk * kk;
+        j->ld_ticket[buf] = dma_submit(&d);
+        j->w_key[buf] = w_key;
+    }
+}
+
+/* SPM 안에서만: out[b][dh][dw] += Σ_ic Σ_kh,kw in[ic][..] * w[b][ic][kh][kw] (ic마다 contrib를 따로 더함) */
+static void compute_step(const spm_job_t* j, const spm_step_t* st, const float* in, const uint8_t* wb,
+                         float w_scale, int w_is_int8, float* out) {
+    const int32_t in_rows = j->pl.in_rows, in_cols = j->pl.in_cols;
+    const int32_t k_h = j->k_h, k_w = j->k_w, kk = k_h * k_w;
+    const int32_t sh = j->stride_h, sw = j->stride_w;
+    for (int32_t b = 0; b < st->n_oc; b++) {
+        float* out_b = out + b * CONV2D_SPM_TILE_H * CONV2D_SPM_TILE_W;
+        for (int32_t ic = 0; ic < st->n_ic; ic++) {
+            const float* x_ch = in + (size_t)ic * in_rows * in_cols;
+            const int32_t w_off = (b * j->pl.ic_chunk + ic) * kk;
+            for (int32_t dh = 0; dh < st->th; dh++) {
+                for (int32_t dw = 0; dw < st->tw; dw++) {
+                    const float* x_base = x_ch + dh * sh * in_cols + dw * sw;
+                    float contrib = 0.0f;
+                    if (w_is_int8) {
+                        const int8_t* w_base = (const int8_t*)wb + w_off;
+                        for (int32_t kh = 0; kh < k_h; kh++) {
+                            const float* x_row = x_base + kh * in_cols;
+                            const int8_t* w_row = w_base + kh * k_w;
+                            for (int32_t kw = 0; kw < k_w; kw++)
+                                contrib += (*x_row++) * ((float)(*w_row++) * w_scale);
+                        }
+                    } else {
+                        const float* w_base = (const float*)wb + w_off;
+                        for (int32_t kh = 0; kh < k_h; kh++) {
+                            const float* x_row = x_base + kh * in_cols;
+                            const float* w_row = w_base + kh * k_w;
+                            for (int32_t kw = 0; kw < k_w; kw++)
+                                contrib += (*x_row++) * (*w_row++);
+                        }
+                    }
+                    out_b[dh * CONV2D_SPM_TILE_W + dw] += contrib;
+                }
+            }
+        }
+    }
+}
+
+int conv2d_spm_nchw_f32(
+    const float* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float w_scale, int w_is_int8, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out)
+{
+    static YOLO_THREAD_LOCAL spm_job_t job;  /* 스택 절약 (bare-metal) */
+    spm_job_t* j = &job;
+    if (groups != 1 || n <= 0 || c_out <= 0 || h_out <= 0 || w_out <= 0 ||
+        conv2d_spm_plan(c_in, k_h, k_w, stride_h, stride_w, w_is_int8, &j->pl) != 0)
+        return -1;
+
+    j->x = x;
+    j->x_halo = x_halo;
+    j->c_in = c_in;
+    j->h_in = h_in;
+    j->w_in = w_in;
+    j->x_h_stride = w_in + 2 * x_halo;
+    j->x_c_stride = (h_in + 2 * x_halo) * j->x_h_stride;
+    j->x_n_stride = x_n_stride ? x_n_stride : c_in * j->x_c_stride;
+    j->w = (const uint8_t*)w;
+    j->esize = w_is_int8 ? 1u : sizeof(float);
+    j->c_out = c_out;
+    j->k_h = k_h;
+    j->k_w = k_w;
+    j->stride_h = stride_h;
+    j->stride_w = stride_w;
+    j->pad_h = pad_h;
+    j->pad_w = pad_w;
+    j->h_out = h_out;
+    j->w_out = w_out;
+    j->n_th = (h_out + CONV2D_SPM_TILE_H - 1) / CONV2D_SPM_TILE_H;
+    j->n_tw = (w_out + CONV2D_SPM_TILE_W - 1) / CONV2D_SPM_TILE_W;
+    j->n_ocb = (c_out + CONV2D_SPM_OC_BLOCK - 1) / CONV2D_SPM_OC_BLOCK;
+    j->n_icc = (c_in + j->pl.ic_chunk - 1) / j->pl.ic_chunk;
+
+    /* SPM 배치: [출력 ×2][입력 ×2][가중치 ×2], 각 64B 정렬 */
+    uint8_t* p = spm_base();
+    float* out_buf[2];
+    for (int k = 0; k < 2; k++, p += j->pl.out_bytes) out_buf[k] = (float*)p;
+    for (int k = 0; k < 2; k++, p += j->pl.in_bytes) j->in_buf[k] = (float*)p;
+    for (int k = 0; k < 2; k++, p += j->pl.w_bytes) j->w_buf[k] = p;
+    j->in_key[0] = j->in_key[1] = j->w_key[0] = j->w_key[1] = -1;
+    j->ld_ticket[0] = j->ld_ticket[1] = 0;
+
+    const int32_t y_h_stride = w_out + 2 * y_halo;
+    const int32_t y_c_stride = (h_out + 2 * y_halo) * y_h_stride;
+    const int32_t y_n = y_n_stride ? y_n_stride : c_out * y_c_stride;
+    const int64_t steps = (int64_t)n * j->n_th * j->n_tw * j->n_ocb * j->n_icc;
+    dma_ticket_t out_ticket[2] = {0, 0};
+    int64_t jobs = 0;
+
+    stage_step(j, 0, 0);
+    for (int64_t s = 0; s < steps; s++) {
+        const int buf = (int)(s & 1);
+        spm_step_t st;
+        if (s + 1 < steps) stage_step(j, s + 1, buf ^ 1);
+        decode_step(j, s, &st);
+        float* out = out_buf[jobs & 1];
+        if (st.icc == 0) {
+            /* 이 출력 버퍼의 이전 저장(job - 2)이 끝난 뒤 bias로 초기화 */
+            dma_wait(out_ticket[jobs & 1]);
+            for (int32_t b = 0; b < st.n_oc; b++) {
+                const float v = bias_or_null ? bias_or_null[st.oc0 + b] : 0.0f;
+                float* ob = out + b * CONV2D_SPM_TILE_H * CONV2D_SPM_TILE_W;
+                for (int32_t i = 0; i < CONV2D_SPM_TILE_H * CONV2D_SPM_TILE_W; i++) ob[i] = v;
+            }
+        }
+        dma_wait(j->ld_ticket[buf]);
+        compute_step(j, &st, j->in_buf[buf], j->w_buf[buf], w_scale, w_is_int8, out);
+        if (st.icc == j->n_icc - 1) {
+            dma_desc_t d;
+            d.src = out;
+            d.dst = y + (size_t)st.img * y_n + (size_t)st.oc0 * y_c_stride + (size_t)st.oh0 * y_h_stride + st.ow0;
+            d.row_bytes = (size_t)st.tw * sizeof(float);
+            d.rows = st.th;
+            d.planes = st.n_oc;
+            d.src_row_pitch = CONV2D_SPM_TILE_W * sizeof(float);
+            d.src_plane_pitch = CONV2D_SPM_TILE_H * CONV2D_SPM_TILE_W * sizeof(float);
+            d.dst_row_pitch = (size_t)y_h_stride * sizeof(float);
+            d.dst_plane_pitch = (size_t)y_c_stride * sizeof(float);
+            out_ticket[jobs & 1] = dma_submit(&d);
+            jobs++;
+        }
+    }
+    dma_wait(out_ticket[0] > out_ticket[1] ? out_ticket[0] : out_ticket[1]);
+    return 0;
+}
@@ -0,0 +1,50 @@
+#ifndef CONV2D_SPM_H
+#define CONV2D_SPM_H
+
+/* 스크래치패드 타일 conv: 입력 타일·가중치 블록·출력 타일을 작은 빠른 메모리(SPM)에 DMA(utils/dma.h)로 명시 적재,
+ * 버퍼 2개씩(더블 버퍼)이라 다음 (타일, oc 블록, ic 묶음)의 적재·이전 출력 저장이 현재 연산과 겹침.
+ * 입력 타일의 패딩 위치는 SPM에서 0으로 채움 → 연산에 경계 분기 없음. 결과는 conv2d_nchw_f32(_w8)_halo와 비트 동일.
+ * -DCONV2D_SPM이면 conv2d_nchw_f32(_w8)_halo가 이 경로를 먼저 시도 (SPM에 안 맞으면 캐시 경로). */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef CONV2D_SPM_BYTES
+#define CONV2D_SPM_BYTES (32u * 1024u)   /* BRAM 스크래치패드 크기 (BARE_METAL은 CONV2D_SPM_BASE로 위치 지정) */
+#endif
+#ifndef CONV2D_SPM_TILE_H
+#define CONV2D_SPM_TILE_H 8
+#endif
+#ifndef CONV2D_SPM_TILE_W
+#define CONV2D_SPM_TILE_W 8
+#endif
+#ifndef CONV2D_SPM_OC_BLOCK
+#define CONV2D_SPM_OC_BLOCK 16
+#endif
+
+/** 한 conv의 SPM 배치 (입력 채널 묶음 크기 등). conv2d_spm_plan이 채움 */
+typedef struct {
+    int32_t ic_chunk;        /* 적재 1회의 입력 채널 수 */
+    int32_t in_rows, in_cols;
+    size_t in_bytes, w_bytes, out_bytes;  /* 버퍼 1개 크기 (각각 2개) */
+    size_t spm_bytes;        /* 합계 (<= CONV2D_SPM_BYTES) */
+} conv2d_spm_plan_t;
+
+/** SPM 배치 계산. 0 성공, -1 SPM에 안 맞음 (입력 채널 1개 묶음도 불가) */
+int conv2d_spm_plan(int32_t c_in, int32_t k_h, int32_t k_w, int32_t stride_h, int32_t stride_w, int w_is_int8,
+                    conv2d_spm_plan_t* plan);
+
+/**
+ * conv2d_nchw_f32(_w8)_halo와 같은 인자 (w: float* 또는 int8_t* + w_scale). groups == 1만.
+ * 0 성공, -1 SPM에 안 맞음/미지원 (y는 건드리지 않음 → 호출자가 캐시 경로로)
+ */
+int conv2d_spm_nchw_f32(
+    const float* x, int32_t x_halo, int32_t x_n_stride, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const void* w, float w_scale, int w_is_int8, int32_t c_out, int32_t k_h, int32_t k_w,
+    const float* bias_or_null,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    float* y, int32_t y_halo, int32_t y_n_stride, int32_t h_out, int32_t w_out);
+
+#endif // CONV2D_SPM_H
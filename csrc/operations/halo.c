@@ -0,0 +1,24 @@
+#include "halo.h"
+
+void halo_clear_border(float* buf, int32_t planes, int32_t h, int32_t w, int32_t halo)
+{
+    if (halo <= 0) return;
+    const int32_t pitch = HALO_PITCH(w, halo);
+    const int32_t plane = HALO_PLANE(h, w, halo);
+    for (int32_t p = 0; p < planes; p++) {
+        float* base = buf + (ptrdiff_t)p * plane;
+        /* 위/아래 halo 행 */
+        for (int32_t i = 0; i < halo * pitch; i++) {
+            base[i] = 0.0f;
+            base[plane - 1 - i] = 0.0f;
+        }
+        /* 내부 행의 좌/우 halo */
+        for (int32_t r = 0; r < h; r++) {
+            float* row = base + (ptrdiff_t)(halo + r) * pitch;
+            for (int32_t i = 0; i < halo; i++) {
+                row[i] = 0.0f;
+                row[pitch - 1 - i] = 0.0f;
+            }
+        }
+    }
+}
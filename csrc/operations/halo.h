@@ -0,0 +1,30 @@
+#ifndef HALO_H
+#define HALO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Halo 레이아웃: 채널 plane마다 (h + 2*halo) x (w + 2*halo), 테두리는 0.
+ * 텐서 포인터 = 내부 (0,0) 위치 (버퍼 시작 + halo*pitch + halo). 배치/채널 stride = plane.
+ * 생산자는 내부만 쓰고, 패딩 conv(pad <= halo)는 경계 분기 없이 fast path만 탄다.
+ * -DYOLO_NO_HALO이면 FMAP_HALO 0 → 기존 조밀 레이아웃. */
+#ifndef YOLO_NO_HALO
+#define FMAP_HALO 1
+#else
+#define FMAP_HALO 0
+#endif
+
+#define HALO_PITCH(w, halo)        ((w) + 2 * (halo))
+#define HALO_PLANE(h, w, halo)     (((h) + 2 * (halo)) * HALO_PITCH(w, halo))
+#define HALO_BYTES(n, c, h, w, halo) \
+    ((size_t)(n) * (size_t)(c) * (size_t)HALO_PLANE(h, w, halo) * sizeof(float))
+
+/** 버퍼 시작 → 내부 (0,0) */
+static inline float* halo_interior(float* buf, int32_t w, int32_t halo) {
+    return buf + (ptrdiff_t)halo * HALO_PITCH(w, halo) + halo;
+}
+
+/** planes(= n*c)개 plane의 테두리만 0으로 (풀 재사용 버퍼이므로 alloc 직후 호출) */
+void halo_clear_border(float* buf, int32_t planes, int32_t h, int32_t w, int32_t halo);
+
+#endif // HALO_H
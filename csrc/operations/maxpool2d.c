@@ -31,3 +31,199 @@ void maxpool2d_nchw_f32(
         }
     }
 }
+
+void maxpool2d_nchw_q(
+    const int32_t* x, int32_t n, int32_t c, int32_t h, int32_t w,
+    int32_t k, int32_t stride, int32_t pad,
+    int32_t* y, int32_t out_h, int32_t out_w)
+{
+    for (int32_t ni = 0; ni < n; ni++) {
+        for (int32_t ci = 0; ci < c; ci++) {
+            for (int32_t oh = 0; oh < out_h; oh++) {
+                for (int32_t ow = 0; ow < out_w; ow++) {
+                    int32_t m = INT32_MIN;
+                    for (int32_t kh = 0; kh < k; kh++) {
+                        for (int32_t kw = 0; kw < k; kw++) {
+                            const int32_t ih = oh * stride - pad + kh;
+                            const int32_t iw = ow * stride - pad + kw;
+                            if ((uint32_t)ih >= (uint32_t)h || (uint32_t)iw >= (uint32_t)w) {
+                                continue;
+                            }
+                            const int32_t v = x[((ni * c + ci) * h + ih) * w + iw];
+                            if (v > m) m = v;
+                        }
+                    }
+                    y[((ni * c + ci) * out_h + oh) * out_w + ow] = m;
+                }
+            }
+        }
+    }
+}
+
+/* SPPF 풀링 (cascade 3단을 한 번에).
+ * k×k/stride 1/pad k/2 풀링을 r = k/2 로 세 번 겹치면 창 반경이 r, 2r, 3r (5/9/13)인 경계 잘린 max와 같음.
+ * 분리형: 세로 max(행 단위 원소별) → 가로 max(행마다). 반경 2r, 3r은 반경 r 결과 두세 개의 max
+ *   V_2r[y] = max(V_r[y-r], V_r[y+r]),  V_3r[y] = max(V_r[y-2r], V_r[y], V_r[y+2r]) (인덱스는 [0, h)로 자름)
+ * 가로도 같은 식. 채널 평면 하나를 끝낸 뒤 다음 채널 (평면이 캐시에 남음). */
+
+static inline int32_t clamp_idx(int32_t i, int32_t n) {
+    return i < 0 ? 0 : i >= n ? n - 1 : i;
+}
+
+/* dst 행 y = src 행 clamp(y + first + i*step), i < count 의 원소별 max (dst != src).
+ * 원소별 max는 조건 대입 대신 삼항식 → 분기 없이 벡터화 */
+static void vmax_rows_f32(const float* src, int32_t h, int32_t w,
+                          int32_t first, int32_t step, int32_t count, float* dst)
+{
+    for (int32_t y = 0; y < h; y++) {
+        float* d = dst + y * w;
+        for (int32_t i = 0; i < count; i++) {
+            const float* s = src + clamp_idx(y + first + i * step, h) * w;
+            if (i == 0) {
+                for (int32_t x = 0; x < w; x++) d[x] = s[x];
+            } else {
+                for (int32_t x = 0; x < w; x++)
+                    d[x] = s[x] > d[x] ? s[x] : d[x];
+            }
+        }
+    }
+}
+
+/* dst[x] = max src[clamp(x + first + i*step)], i < count (dst != src) */
+static void hmax_row_f32(const float* src, int32_t w, int32_t first, int32_t step, int32_t count, float* dst)
+{
+    /* 안쪽 [x0, x1): 모든 탭이 행 안 → 탭마다 연속 구간 max (벡터화). 양 끝만 clamp */
+    const int32_t span = (count - 1) * step;
+    const int32_t x0 = first >= 0 ? 0 : -first < w ? -first : w;
+    int32_t x1 = w - first - span;
+    if (x1 > w) x1 = w;
+    if (x1 < x0) x1 = x0;
+    for (int32_t x = x0; x < x1; x++) dst[x] = src[x + first];
+    for (int32_t i = 1; i < count; i++) {
+        const float* s = src + first + i * step;
+        for (int32_t x = x0; x < x1; x++)
+            dst[x] = s[x] > dst[x] ? s[x] : dst[x];
+    }
+    for (int32_t x = 0; x < w; x++) {
+        if (x == x0) x = x1;
+        if (x >= w) break;
+        float m = src[clamp_idx(x + first, w)];
+        for (int32_t i = 1; i < count; i++) {
+            const float v = src[clamp_idx(x + first + i * step, w)];
+            if (v > m) m = v;
+        }
+        dst[x] = m;
+    }
+}
+
+void maxpool2d_sppf_nchw_f32(
+    const float* x, int32_t n, int32_t c, int32_t h, int32_t w, int32_t k, int32_t n_stride,
+    float* y1, float* y2, float* y3, float* row_tmp)
+{
+    const int32_t r = k / 2;
+    const int32_t plane = h * w;
+    float* t0 = row_tmp;
+    float* t1 = row_tmp + w;
+    for (int32_t ni = 0; ni < n; ni++) {
+        for (int32_t ci = 0; ci < c; ci++) {
+            const int32_t off = ni * n_stride + ci * plane;
+            float* p1 = y1 + off;
+            float* p2 = y2 + off;
+            float* p3 = y3 + off;
+            vmax_rows_f32(x + off, h, w, -r, 1, 2 * r + 1, p1);   /* V_r */
+            vmax_rows_f32(p1, h, w, -r, 2 * r, 2, p2);            /* V_2r */
+            vmax_rows_f32(p1, h, w, -2 * r, 2 * r, 3, p3);        /* V_3r */
+            for (int32_t y = 0; y < h; y++) {
+                float* q1 = p1 + y * w;
+                float* q2 = p2 + y * w;
+                float* q3 = p3 + y * w;
+                for (int32_t i = 0; i < w; i++) t0[i] = q1[i];
+                hmax_row_f32(t0, w, -r, 1, 2 * r + 1, q1);
+                for (int32_t i = 0; i < w; i++) t0[i] = q2[i];
+                hmax_row_f32(t0, w, -r, 1, 2 * r + 1, t1);
+                hmax_row_f32(t1, w, -r, 2 * r, 2, q2);
+                for (int32_t i = 0; i < w; i++) t0[i] = q3[i];
+                hmax_row_f32(t0, w, -r, 1, 2 * r + 1, t1);
+                hmax_row_f32(t1, w, -2 * r, 2 * r, 3, q3);
+            }
+        }
+    }
+}
+
+/* 정수 경로: 위와 같은 순서, int32 비교 */
+static void vmax_rows_q(const int32_t* src, int32_t h, int32_t w,
+                        int32_t first, int32_t step, int32_t count, int32_t* dst)
+{
+    for (int32_t y = 0; y < h; y++) {
+        int32_t* d = dst + y * w;
+        for (int32_t i = 0; i < count; i++) {
+            const int32_t* s = src + clamp_idx(y + first + i * step, h) * w;
+            if (i == 0) {
+                for (int32_t x = 0; x < w; x++) d[x] = s[x];
+            } else {
+                for (int32_t x = 0; x < w; x++)
+                    d[x] = s[x] > d[x] ? s[x] : d[x];
+            }
+        }
+    }
+}
+
+static void hmax_row_q(const int32_t* src, int32_t w, int32_t first, int32_t step, int32_t count, int32_t* dst)
+{
+    /* 안쪽 [x0, x1): 모든 탭이 행 안 → 탭마다 연속 구간 max (벡터화). 양 끝만 clamp */
+    const int32_t span = (count - 1) * step;
+    const int32_t x0 = first >= 0 ? 0 : -first < w ? -first : w;
+    int32_t x1 = w - first - span;
+    if (x1 > w) x1 = w;
+    if (x1 < x0) x1 = x0;
+    for (int32_t x = x0; x < x1; x++) dst[x] = src[x + first];
+    for (int32_t i = 1; i < count; i++) {
+        const int32_t* s = src + first + i * step;
+        for (int32_t x = x0; x < x1; x++)
+            dst[x] = s[x] > dst[x] ? s[x] : dst[x];
+    }
+    for (int32_t x = 0; x < w; x++) {
+        if (x == x0) x = x1;
+        if (x >= w) break;
+        int32_t m = src[clamp_idx(x + first, w)];
+        for (int32_t i = 1; i < count; i++) {
+            const int32_t v = src[clamp_idx(x + first + i * step, w)];
+            if (v > m) m = v;
+        }
+        dst[x] = m;
+    }
+}
+
+void maxpool2d_sppf_nchw_q(
+    const int32_t* x, int32_t n, int32_t c, int32_t h, int32_t w, int32_t k, int32_t n_stride,
+    int32_t* y1, int32_t* y2, int32_t* y3, int32_t* row_tmp)
+{
+    const int32_t r = k / 2;
+    const int32_t plane = h * w;
+    int32_t* t0 = row_tmp;
+    int32_t* t1 = row_tmp + w;
+    for (int32_t ni = 0; ni < n; ni++) {
+        for (int32_t ci = 0; ci < c; ci++) {
+            const int32_t off = ni * n_stride + ci * plane;
+            int32_t* p1 = y1 + off;
+            int32_t* p2 = y2 + off;
+            int32_t* p3 = y3 + off;
+            vmax_rows_q(x + off, h, w, -r, 1, 2 * r + 1, p1);
+            vmax_rows_q(p1, h, w, -r, 2 * r, 2, p2);
+            vmax_rows_q(p1, h, w, -2 * r, 2 * r, 3, p3);
+            for (int32_t y = 0; y < h; y++) {
+                int32_t* q1 = p1 + y * w;
+                int32_t* q2 = p2 + y * w;
+                int32_t* q3 = p3 + y * w;
+                for (int32_t i = 0; i < w; i++) t0[i] = q1[i];
+                hmax_row_q(t0, w, -r, 1, 2 * r + 1, q1);
+                for (int32_t i = 0; i < w; i++) t0[i] = q2[i];
+                hmax_row_q(t0, w, -r, 1, 2 * r + 1, t1);
+                hmax_row_q(t1, w, -r, 2 * r, 2, q2);
+                for (int32_t i = 0; i < w; i++) t0[i] = q3[i];
+                hmax_row_q(t0, w, -r, 1, 2 * r + 1, t1);
+                hmax_row_q(t1, w, -2 * r, 2 * r, 3, q3);
+            }
+        }
+    }
+}
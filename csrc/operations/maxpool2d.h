@@ -8,4 +8,22 @@ void maxpool2d_nchw_f32(
     int32_t k, int32_t stride, int32_t pad,
     float* y, int32_t out_h, int32_t out_w);
 
+/* 정수 경로: Q int32 (operations/qformat.h) */
+void maxpool2d_nchw_q(
+    const int32_t* x, int32_t n, int32_t c, int32_t h, int32_t w,
+    int32_t k, int32_t stride, int32_t pad,
+    int32_t* y, int32_t out_h, int32_t out_w);
+
+/* SPPF 풀링: k×k/stride 1/pad k/2 풀링 3단 cascade (x → y1 → y2 → y3)를 분리형 running max 한 번으로.
+ * 결과는 cascade와 비트 동일 (창 반경 k/2, 2·(k/2), 3·(k/2)의 경계 잘린 max). k는 홀수.
+ * x, y1..y3은 이미지마다 n_stride 원소 간격 (SPPF는 cv2 입력 concat 버퍼의 채널 구간 → concat 복사 없음).
+ * row_tmp: 2 × w 원소 */
+void maxpool2d_sppf_nchw_f32(
+    const float* x, int32_t n, int32_t c, int32_t h, int32_t w, int32_t k, int32_t n_stride,
+    float* y1, float* y2, float* y3, float* row_tmp);
+
+void maxpool2d_sppf_nchw_q(
+    const int32_t* x, int32_t n, int32_t c, int32_t h, int32_t w, int32_t k, int32_t n_stride,
+    int32_t* y1, int32_t* y2, int32_t* y3, int32_t* row_tmp);
+
 #endif // MAXPOOL2D_H
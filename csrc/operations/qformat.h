@@ -0,0 +1,82 @@
+/**
+ * 고정소수점(Q 형식) 활성값 공용 정의 — FPU 없는 소프트 코어용 정수 추론 경로 (-DYOLO_FIXED_POINT).
+ * 활성값: int32 Q(YOLO_Q_FRAC) = 실수 × 2^YOLO_Q_FRAC, ±YOLO_Q_MAX로 포화.
+ *   피처맵 버퍼는 FP32 경로와 같은 4바이트 슬롯(같은 풀/메모리 계획/halo)에 int32 워드로 담김.
+ *   concat/upsample/halo 테두리는 비트 복사(연산 없음)라 Q 워드를 그대로 옮김, halo 0.0f = Q 0.
+ * 가중치: INT8 + 텐서별 scale (W8 파일). scale/bias/임계값의 float는 IEEE 비트를 정수 연산으로 풀어서
+ *   (q_from_f32, q_requant_from_f32) 부동소수 명령 없이 사용.
+ * |활성값| < 2^23 (Q12에서 ±2048.0) → x_q × w_int8 곱이 int32 안, 누적만 int64.
+ */
+#ifndef QFORMAT_H
+#define QFORMAT_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(YOLO_FIXED_POINT) && !defined(USE_WEIGHTS_W8)
+#error "YOLO_FIXED_POINT needs INT8 weights: build with -DUSE_WEIGHTS_W8"
+#endif
+
+#ifndef YOLO_Q_FRAC
+#define YOLO_Q_FRAC 12
+#endif
+#if YOLO_Q_FRAC < 4 || YOLO_Q_FRAC > 12
+#error "YOLO_Q_FRAC must be 4..12 (sigmoid LUT step 1/16, SiLU product in int32)"
+#endif
+
+#define Q_ONE (1 << YOLO_Q_FRAC)
+#define YOLO_Q_MAX ((1 << 23) - 1)
+#define Q15_ONE 32768
+
+/** 재양자화: y = (acc × mult) >> shift (반올림). mult 15비트 정규화 */
+typedef struct {
+    int32_t mult;
+    int32_t shift;
+} q_requant_t;
+
+static inline uint32_t q_f32_bits(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static inline int32_t q_sat(int64_t v) {
+    return v > YOLO_Q_MAX ? YOLO_Q_MAX : v < -YOLO_Q_MAX ? -YOLO_Q_MAX : (int32_t)v;
+}
+
+/** float → round(f × 2^frac), 정수 연산만 (비정규수 0, 범위 밖/inf/NaN은 ±INT32_MAX 포화) */
+static inline int32_t q_from_f32(float f, int32_t frac) {
+    const uint32_t u = q_f32_bits(f);
+    const int32_t e = (int32_t)((u >> 23) & 0xFFu);
+    if (e == 0) return 0;
+    const int32_t m = (int32_t)((u & 0x7FFFFFu) | 0x800000u);
+    const int32_t sh = e - 150 + frac;   /* f × 2^frac = m × 2^sh */
+    int32_t v;
+    if (e == 255 || sh > 7) v = INT32_MAX;
+    else if (sh >= 0) v = m << sh;
+    else if (sh < -24) v = 0;
+    else v = (m + (1 << (-sh - 1))) >> -sh;
+    return (u >> 31) ? -v : v;
+}
+
+/** acc × scale × 2^exp_adj 를 위한 (mult, shift). scale > 0 (W8 텐서 scale) */
+static inline q_requant_t q_requant_from_f32(float scale, int32_t exp_adj) {
+    q_requant_t r;
+    const uint32_t u = q_f32_bits(scale);
+    int32_t e = (int32_t)((u >> 23) & 0xFFu);
+    int32_t m = (int32_t)((((u & 0x7FFFFFu) | 0x800000u) + (1u << 8)) >> 9);   /* 24 → 15비트 */
+    if (m >= (1 << 15)) { m >>= 1; e++; }
+    r.mult = e == 0 ? 0 : m;
+    r.shift = 141 - e - exp_adj;   /* scale = m × 2^(e - 141) */
+    return r;
+}
+
+/** int64 누적 → Q (반올림, 포화 없음: 호출자가 q_sat) */
+static inline int64_t q_requant(int64_t acc, q_requant_t r) {
+    const int64_t p = acc * r.mult;
+    if (r.shift <= 0) return p << -r.shift;
+    if (r.shift > 62) return 0;
+    return (p + ((int64_t)1 << (r.shift - 1))) >> r.shift;
+}
+
+#endif /* QFORMAT_H */
@@ -7,4 +7,12 @@ void silu_nchw_f32(
     const float* x, int32_t n, int32_t c, int32_t h, int32_t w,
     float* y);
 
+/* 정수 경로 (operations/qformat.h): x, y는 Q(YOLO_Q_FRAC) int32.
+ * sigmoid는 [-8, 8) 1/16 간격 Q15 표 + 선형 보간 (밖은 표 끝값), SiLU는 |x| >= 8에서 x / 0 */
+int32_t sigmoid_q15(int32_t x_q);
+
+void silu_nchw_q(
+    const int32_t* x, int32_t n, int32_t c, int32_t h, int32_t w,
+    int32_t* y);
+
 #endif // SILU_H
@@ -50,7 +50,8 @@
 #define IMAGE_DDR_BASE    IMAGE_AND_FEATURE_BASE
 #endif
 #define IMAGE_HEADER_SIZE 24u
-#define IMAGE_DATA_SIZE   (3u * 640u * 640u * sizeof(float))
+#define IMAGE_DATA_SIZE   (3u * 640u * 640u * sizeof(float))  /* 최대 (직사각형 입력은 이보다 작음) */
+#define IMAGE_DATA_SIZE_U8 (3u * 640u * 640u)                 /* uint8 형식 (헤더 size 필드 형식 1/2) */
 #define IMAGE_DDR_SIZE    (IMAGE_HEADER_SIZE + IMAGE_DATA_SIZE)
 
 #ifndef FEATURE_POOL_BASE
@@ -0,0 +1,211 @@
+#include "cache_sim.h"
+
+#include <stdlib.h>
+#include <string.h>
+#ifndef BARE_METAL
+#include <stdio.h>
+#endif
+
+typedef struct {
+    uintptr_t line;                   /* 라인 번호 (주소 >> line_shift) = 태그 */
+    uint32_t stamp;                   /* LRU: 마지막 사용 시각 */
+    uint8_t valid, dirty, cls;
+} csim_line_t;
+
+static cache_sim_config_t s_cfg;
+static int s_configured;
+static int s_enabled = 1;
+static csim_line_t* s_lines;          /* sets × ways */
+static uint32_t s_sets;
+static uint32_t s_line_shift;
+static uint32_t s_clock;
+static csim_line_t* s_mru;            /* 직전 접근 라인 (같은 라인 연속 접근 → 바로 히트) */
+static int s_layer;
+static cache_sim_layer_t s_stats[CACHE_SIM_LAYERS];
+
+static int is_pow2(uint32_t v) { return v != 0 && (v & (v - 1u)) == 0; }
+
+void cache_sim_default_config(cache_sim_config_t* cfg) {
+    cfg->size_bytes = CACHE_SIM_SIZE;
+    cfg->line_bytes = CACHE_SIM_LINE;
+    cfg->ways = CACHE_SIM_WAYS;
+    cfg->write_back = CACHE_SIM_WRITE_BACK;
+    cfg->ddr_latency = CACHE_SIM_DDR_LATENCY;
+    cfg->ddr_bytes_per_cycle = CACHE_SIM_DDR_BYTES_PER_CYCLE;
+    cfg->mac_cycles = CACHE_SIM_MAC_CYCLES;
+#ifdef CPU_MHZ
+    cfg->cpu_mhz = CPU_MHZ;
+#else
+    cfg->cpu_mhz = 100;
+#endif
+}
+
+int cache_sim_configure(const cache_sim_config_t* cfg) {
+    if (!is_pow2(cfg->size_bytes) || !is_pow2(cfg->line_bytes) || cfg->ways == 0 ||
+        cfg->ddr_bytes_per_cycle == 0 || cfg->cpu_mhz == 0 ||
+        cfg->size_bytes < cfg->line_bytes * cfg->ways ||
+        !is_pow2(cfg->size_bytes / (cfg->line_bytes * cfg->ways)))
+        return -1;
+    const uint32_t sets = cfg->size_bytes / (cfg->line_bytes * cfg->ways);
+    csim_line_t* lines = (csim_line_t*)calloc((size_t)sets * cfg->ways, sizeof(csim_line_t));
+    if (!lines) return -1;
+    free(s_lines);
+    s_lines = lines;
+    s_cfg = *cfg;
+    s_sets = sets;
+    s_line_shift = 0;
+    while ((1u << s_line_shift) < cfg->line_bytes) s_line_shift++;
+    s_configured = 1;
+    cache_sim_reset();
+    return 0;
+}
+
+static void ensure_configured(void) {
+    if (!s_configured) {
+        cache_sim_config_t cfg;
+        cache_sim_default_config(&cfg);
+        cache_sim_configure(&cfg);
+    }
+}
+
+void cache_sim_reset(void) {
+    if (s_lines) memset(s_lines, 0, (size_t)s_sets * s_cfg.ways * sizeof(csim_line_t));
+    s_mru = NULL;
+    s_clock = 0;
+    s_layer = 0;
+    memset(s_stats, 0, sizeof(s_stats));
+}
+
+void cache_sim_enable(int on) { s_enabled = on; }
+
+void cache_sim_set_layer(int layer_id) {
+    s_layer = (layer_id >= 0 && layer_id < CACHE_SIM_LAYERS) ? layer_id : 0;
+}
+
+void cache_sim_add_macs(uint64_t macs) {
+    if (s_enabled) s_stats[s_layer].macs += macs;
+}
+
+/* 라인 하나 접근. bytes: 이 라인 안에서 쓰는 바이트 (write-through 비용) */
+static void access_line(cache_sim_layer_t* st, int cls, uintptr_t line, uint32_t bytes, int is_write) {
+    st->access[cls]++;
+    if (s_mru && s_mru->line == line) {
+        s_mru->stamp = ++s_clock;
+        if (is_write) {
+            if (s_cfg.write_back) { s_mru->dirty = 1; s_mru->cls = (uint8_t)cls; }
+            else st->ddr_write_bytes += bytes;
+        }
+        return;
+    }
+    csim_line_t* set = s_lines + (size_t)(line & (s_sets - 1u)) * s_cfg.ways;
+    csim_line_t* victim = set;
+    for (uint32_t w = 0; w < s_cfg.ways; w++) {
+        csim_line_t* l = set + w;
+        if (l->valid && l->line == line) {
+            l->stamp = ++s_clock;
+            if (is_write) {
+                if (s_cfg.write_back) { l->dirty = 1; l->cls = (uint8_t)cls; }
+                else st->ddr_write_bytes += bytes;
+            }
+            s_mru = l;
+            return;
+        }
+        if (victim->valid && (!l->valid || l->stamp < victim->stamp)) victim = l;
+    }
+    /* 미스 */
+    if (is_write && !s_cfg.write_back) {
+        /* write-through no-allocate: DDR에 바로 쓰고 캐시는 그대로 */
+        st->ddr_write_bytes += bytes;
+        return;
+    }
+    st->miss[cls]++;
+    if (victim->valid && victim->dirty) {
+        st->writeback[victim->cls]++;
+        st->ddr_write_bytes += s_cfg.line_bytes;
+    }
+    victim->line = line;
+    victim->valid = 1;
+    victim->dirty = (uint8_t)(is_write != 0);
+    victim->cls = (uint8_t)cls;
+    victim->stamp = ++s_clock;
+    s_mru = victim;
+}
+
+void cache_sim_access(cache_sim_class_t cls, const void* p, size_t bytes, int is_write) {
+    if (!s_enabled || bytes == 0) return;
+    ensure_configured();
+    cache_sim_layer_t* st = &s_stats[s_layer];
+    const uintptr_t a = (uintptr_t)p;
+    const uintptr_t first = a >> s_line_shift, last = (a + bytes - 1u) >> s_line_shift;
+    if (first == last) {
+        access_line(st, (int)cls, first, (uint32_t)bytes, is_write);
+        return;
+    }
+    for (uintptr_t line = first; line <= last; line++) {
+        const uintptr_t lo = line == first ? a : line << s_line_shift;
+        const uintptr_t hi = line == last ? a + bytes : (line + 1u) << s_line_shift;
+        access_line(st, (int)cls, line, (uint32_t)(hi - lo), is_write);
+    }
+}
+
+void cache_sim_get_layer(int layer_id, cache_sim_layer_t* out) {
+    if (layer_id >= 0 && layer_id < CACHE_SIM_LAYERS) {
+        *out = s_stats[layer_id];
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+    for (int i = 0; i < CACHE_SIM_LAYERS; i++) {
+        for (int c = 0; c < CSIM_NCLASS; c++) {
+            out->access[c] += s_stats[i].access[c];
+            out->miss[c] += s_stats[i].miss[c];
+            out->writeback[c] += s_stats[i].writeback[c];
+        }
+        out->ddr_write_bytes += s_stats[i].ddr_write_bytes;
+        out->macs += s_stats[i].macs;
+    }
+}
+
+void cache_sim_estimate(const cache_sim_layer_t* l, cache_sim_estimate_t* est) {
+    ensure_configured();
+    const uint64_t fill = s_cfg.ddr_latency + (s_cfg.line_bytes + s_cfg.ddr_bytes_per_cycle - 1u) / s_cfg.ddr_bytes_per_cycle;
+    uint64_t misses = 0;
+    for (int c = 0; c < CSIM_NCLASS; c++) misses += l->miss[c];
+    est->compute_cycles = l->macs * s_cfg.mac_cycles;
+    est->stall_cycles = misses * fill + (l->ddr_write_bytes + s_cfg.ddr_bytes_per_cycle - 1u) / s_cfg.ddr_bytes_per_cycle;
+    est->ms = (double)(est->compute_cycles + est->stall_cycles) / (s_cfg.cpu_mhz * 1000.0);
+}
+
+#ifndef BARE_METAL
+static double pct(uint64_t a, uint64_t b) { return b ? 100.0 * (double)a / (double)b : 0.0; }
+
+static void print_row(const char* name, const cache_sim_layer_t* l) {
+    cache_sim_estimate_t e;
+    uint64_t wb = 0;
+    cache_sim_estimate(l, &e);
+    for (int c = 0; c < CSIM_NCLASS; c++) wb += l->writeback[c];
+    printf(" %-5s | %8.1f | %5.1f%% %5.1f%% %5.1f%% %5.1f%% | %8llu | %9.1f %9.1f | %5.0f%% | %9.1f\n", name,
+           l->macs / 1e6, pct(l->miss[CSIM_INPUT], l->access[CSIM_INPUT]), pct(l->miss[CSIM_WEIGHT], l->access[CSIM_WEIGHT]),
+           pct(l->miss[CSIM_ACC], l->access[CSIM_ACC]), pct(l->miss[CSIM_OUTPUT], l->access[CSIM_OUTPUT]),
+           (unsigned long long)wb, e.compute_cycles / 1e6, e.stall_cycles / 1e6,
+           pct(e.stall_cycles, e.compute_cycles + e.stall_cycles), e.ms);
+}
+
+void cache_sim_print(void) {
+    ensure_configured();
+    printf("[cache sim] %u KB, %u B line, %u-way, %s | DDR %u cyc + %u B/cyc | MAC %u cyc | %u MHz\n",
+           s_cfg.size_bytes / 1024u, s_cfg.line_bytes, s_cfg.ways, s_cfg.write_back ? "write-back" : "write-through",
+           s_cfg.ddr_latency, s_cfg.ddr_bytes_per_cycle, s_cfg.mac_cycles, s_cfg.cpu_mhz);
+    printf(" layer |   MMACs  |  miss: in     w   acc   out |  wb lines | compute Mc  stall Mc | stall |   est ms\n");
+    for (int i = 0; i < CACHE_SIM_LAYERS; i++) {
+        char name[8];
+        if (s_stats[i].macs == 0) continue;
+        snprintf(name, sizeof(name), "L%d", i);
+        print_row(name, &s_stats[i]);
+    }
+    cache_sim_layer_t total;
+    cache_sim_get_layer(-1, &total);
+    print_row("total", &total);
+}
+#else
+void cache_sim_print(void) {}
+#endif
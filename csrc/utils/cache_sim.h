@@ -0,0 +1,112 @@
+/**
+ * 호스트용 D-cache + DDR 시간 모델 (보드 커널 튜닝용).
+ * -DYOLO_CACHE_SIM 빌드에서 conv 커널의 메모리 접근(입력·가중치·누적 버퍼·출력)을 CSIM_* 매크로로 받아
+ * set-associative 캐시(LRU, write-back/through)에 흘리고, 레이어별 미스·write-back을 센다.
+ * 추정 사이클 = MAC × mac_cycles (히트 포함 연산) + 미스 × (DDR 지연 + 라인/대역폭) + DDR 쓰기 바이트/대역폭.
+ * 기본값은 보드 MicroBlaze V (16KB direct-mapped, 32B 라인, write-back). 지연·MAC 사이클은 보드 mcycle 로그로 맞춤.
+ * 플래그 없는 빌드에서 CSIM_*는 빈 매크로 (비용 0). 상태는 전역 1개 (추론 스레드 1개 전제).
+ */
+#ifndef CACHE_SIM_H
+#define CACHE_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(YOLO_CACHE_SIM) && defined(BARE_METAL)
+#error "YOLO_CACHE_SIM is a host-only build (board has the real cache)"
+#endif
+
+#ifndef CACHE_SIM_SIZE
+#define CACHE_SIM_SIZE (16u * 1024u)
+#endif
+#ifndef CACHE_SIM_LINE
+#define CACHE_SIM_LINE 32u
+#endif
+#ifndef CACHE_SIM_WAYS
+#define CACHE_SIM_WAYS 1u
+#endif
+#ifndef CACHE_SIM_WRITE_BACK
+#define CACHE_SIM_WRITE_BACK 1
+#endif
+#ifndef CACHE_SIM_DDR_LATENCY
+#define CACHE_SIM_DDR_LATENCY 30u     /* 라인 채움 첫 워드까지 (CPU 사이클) */
+#endif
+#ifndef CACHE_SIM_DDR_BYTES_PER_CYCLE
+#define CACHE_SIM_DDR_BYTES_PER_CYCLE 4u
+#endif
+#ifndef CACHE_SIM_MAC_CYCLES
+#define CACHE_SIM_MAC_CYCLES 5u       /* MAC 1개 (load 2 + fmadd, 히트 기준) */
+#endif
+
+#define CACHE_SIM_LAYERS 27           /* yolo_timing_set_layer와 같은 번호 (0..23, 24 det, 25 dec, 26 nms) */
+
+typedef enum {
+    CSIM_INPUT = 0,
+    CSIM_WEIGHT,                      /* 가중치 + bias */
+    CSIM_ACC,                         /* 누적 버퍼 (conv2d_acc_buf) */
+    CSIM_OUTPUT,
+    CSIM_NCLASS
+} cache_sim_class_t;
+
+typedef struct {
+    uint32_t size_bytes;              /* 2의 거듭제곱 */
+    uint32_t line_bytes;              /* 2의 거듭제곱 */
+    uint32_t ways;                    /* size / (line × ways)도 2의 거듭제곱 */
+    int write_back;                   /* 1: write-back + write-allocate, 0: write-through + no-allocate */
+    uint32_t ddr_latency;
+    uint32_t ddr_bytes_per_cycle;
+    uint32_t mac_cycles;
+    uint32_t cpu_mhz;                 /* 사이클 → ms */
+} cache_sim_config_t;
+
+/** 레이어 하나 누적 (접근 = 건드린 라인 수) */
+typedef struct {
+    uint64_t access[CSIM_NCLASS];
+    uint64_t miss[CSIM_NCLASS];
+    uint64_t writeback[CSIM_NCLASS];  /* 쫓겨난 dirty 라인 (그 라인을 쓴 종류) */
+    uint64_t ddr_write_bytes;         /* write-back 라인 + write-through 저장 */
+    uint64_t macs;
+} cache_sim_layer_t;
+
+typedef struct {
+    uint64_t compute_cycles;
+    uint64_t stall_cycles;            /* 읽기 미스 + DDR 쓰기 */
+    double ms;                        /* (compute + stall) @ cpu_mhz */
+} cache_sim_estimate_t;
+
+/** 기본 설정 (위 CACHE_SIM_* 매크로) */
+void cache_sim_default_config(cache_sim_config_t* cfg);
+
+/** 설정 적용 + 캐시 비움 + 통계 0. 0 성공, -1 잘못된 형상 */
+int cache_sim_configure(const cache_sim_config_t* cfg);
+
+/** 캐시 비움 (cold) + 통계 0, 설정 유지 */
+void cache_sim_reset(void);
+
+/** 0이면 접근을 무시 (예: 첫 프레임만 기록) */
+void cache_sim_enable(int on);
+
+void cache_sim_set_layer(int layer_id);
+void cache_sim_access(cache_sim_class_t cls, const void* p, size_t bytes, int is_write);
+void cache_sim_add_macs(uint64_t macs);
+
+/** layer_id < 0: 전체 합 */
+void cache_sim_get_layer(int layer_id, cache_sim_layer_t* out);
+void cache_sim_estimate(const cache_sim_layer_t* l, cache_sim_estimate_t* est);
+
+/** 레이어별 표 (MAC·종류별 미스율·write-back·추정 compute/stall·ms). 호스트 전용 */
+void cache_sim_print(void);
+
+#ifdef YOLO_CACHE_SIM
+#define CSIM_READ(cls, p, bytes)  cache_sim_access((cls), (p), (bytes), 0)
+#define CSIM_WRITE(cls, p, bytes) cache_sim_access((cls), (p), (bytes), 1)
+#define CSIM_MACS(cnt)            cache_sim_add_macs((uint64_t)(cnt))
+#define CSIM_LAYER(id)            cache_sim_set_layer(id)
+#else
+#define CSIM_READ(cls, p, bytes)  ((void)0)
+#define CSIM_WRITE(cls, p, bytes) ((void)0)
+#define CSIM_MACS(cnt)            ((void)0)
+#define CSIM_LAYER(id)            ((void)0)
+#endif
+
+#endif /* CACHE_SIM_H */
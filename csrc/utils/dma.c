@@ -0,0 +1,169 @@
+#include "dma.h"
+#include "mcycle.h"
+
+#include <string.h>
+
+#if !defined(BARE_METAL) && !defined(DMA_NO_THREAD)
+#define DMA_THREAD 1
+#include <pthread.h>
+#endif
+
+/* 기술자 1개 복사 (planes × rows 행). 실제 DMA 엔진 백엔드는 여기를 교체 */
+static void backend_copy(const dma_desc_t* d) {
+    const uint8_t* sp = (const uint8_t*)d->src;
+    uint8_t* dp = (uint8_t*)d->dst;
+    for (int32_t p = 0; p < d->planes; p++) {
+        const uint8_t* s = sp + (size_t)p * d->src_plane_pitch;
+        uint8_t* t = dp + (size_t)p * d->dst_plane_pitch;
+        for (int32_t r = 0; r < d->rows; r++) {
+            memcpy(t, s, d->row_bytes);
+            s += d->src_row_pitch;
+            t += d->dst_row_pitch;
+        }
+    }
+}
+
+static size_t desc_bytes(const dma_desc_t* d) {
+    return d->row_bytes * (size_t)d->rows * (size_t)d->planes;
+}
+
+static dma_stats_t s_stats;
+static dma_ticket_t s_submitted;   /* 마지막으로 받은 티켓 */
+static dma_ticket_t s_done;        /* 이 티켓까지 완료 */
+
+#ifdef DMA_THREAD
+static pthread_mutex_t s_mu = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_cv = PTHREAD_COND_INITIALIZER;
+static pthread_t s_thread;
+static int s_running;
+static int s_quit;
+static dma_desc_t s_queue[DMA_QUEUE_DEPTH];
+static uint32_t s_head;            /* 다음에 처리할 기술자 */
+static uint32_t s_count;
+
+static void* dma_thread_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&s_mu);
+    for (;;) {
+        while (s_count == 0 && !s_quit) pthread_cond_wait(&s_cv, &s_mu);
+        if (s_count == 0) break;
+        const dma_desc_t d = s_queue[s_head];
+        pthread_mutex_unlock(&s_mu);
+        const uint64_t t0 = timer_read64();
+        backend_copy(&d);
+        const uint64_t dt = timer_delta64(t0, timer_read64());
+        pthread_mutex_lock(&s_mu);
+        s_head = (s_head + 1u) % DMA_QUEUE_DEPTH;
+        s_count--;
+        s_done++;
+        s_stats.descs++;
+        s_stats.bytes += desc_bytes(&d);
+        s_stats.busy_time += dt;
+        pthread_cond_broadcast(&s_cv);
+    }
+    pthread_mutex_unlock(&s_mu);
+    return NULL;
+}
+
+dma_ticket_t dma_submit(const dma_desc_t* d) {
+    pthread_mutex_lock(&s_mu);
+    if (!s_running) {
+        s_quit = 0;
+        if (pthread_create(&s_thread, NULL, dma_thread_main, NULL) != 0) {
+            /* 스레드를 못 만들면 동기 복사 (결과는 같음) */
+            const uint64_t t0 = timer_read64();
+            backend_copy(d);
+            s_stats.busy_time += timer_delta64(t0, timer_read64());
+            s_stats.descs++;
+            s_stats.bytes += desc_bytes(d);
+            const dma_ticket_t t = ++s_submitted;
+            s_done = t;
+            pthread_mutex_unlock(&s_mu);
+            return t;
+        }
+        s_running = 1;
+    }
+    while (s_count == DMA_QUEUE_DEPTH) pthread_cond_wait(&s_cv, &s_mu);
+    s_queue[(s_head + s_count) % DMA_QUEUE_DEPTH] = *d;
+    s_count++;
+    const dma_ticket_t t = ++s_submitted;
+    pthread_cond_broadcast(&s_cv);
+    pthread_mutex_unlock(&s_mu);
+    return t;
+}
+
+void dma_wait(dma_ticket_t t) {
+    pthread_mutex_lock(&s_mu);
+    if (s_done < t) {
+        const uint64_t t0 = timer_read64();
+        while (s_done < t) pthread_cond_wait(&s_cv, &s_mu);
+        s_stats.wait_time += timer_delta64(t0, timer_read64());
+    }
+    pthread_mutex_unlock(&s_mu);
+}
+
+void dma_wait_all(void) {
+    pthread_mutex_lock(&s_mu);
+    const dma_ticket_t t = s_submitted;
+    pthread_mutex_unlock(&s_mu);
+    dma_wait(t);
+}
+
+void dma_get_stats(dma_stats_t* st) {
+    pthread_mutex_lock(&s_mu);
+    *st = s_stats;
+    pthread_mutex_unlock(&s_mu);
+}
+
+void dma_reset_stats(void) {
+    pthread_mutex_lock(&s_mu);
+    memset(&s_stats, 0, sizeof(s_stats));
+    pthread_mutex_unlock(&s_mu);
+}
+
+void dma_shutdown(void) {
+    pthread_mutex_lock(&s_mu);
+    if (!s_running) {
+        pthread_mutex_unlock(&s_mu);
+        return;
+    }
+    s_quit = 1;  /* 스레드는 큐를 비운 뒤 종료 */
+    pthread_cond_broadcast(&s_cv);
+    pthread_mutex_unlock(&s_mu);
+    pthread_join(s_thread, NULL);
+    pthread_mutex_lock(&s_mu);
+    s_running = 0;
+    s_quit = 0;
+    pthread_mutex_unlock(&s_mu);
+}
+
+#else /* 동기: submit 안에서 복사 */
+
+dma_ticket_t dma_submit(const dma_desc_t* d) {
+    const uint64_t t0 = timer_read64();
+    backend_copy(d);
+    s_stats.busy_time += timer_delta64(t0, timer_read64());
+    s_stats.descs++;
+    s_stats.bytes += desc_bytes(d);
+    s_done = ++s_submitted;
+    return s_done;
+}
+
+void dma_wait(dma_ticket_t t) { (void)t; }
+void dma_wait_all(void) {}
+void dma_get_stats(dma_stats_t* st) { *st = s_stats; }
+void dma_reset_stats(void) { memset(&s_stats, 0, sizeof(s_stats)); }
+void dma_shutdown(void) {}
+
+#endif
+
+dma_ticket_t dma_submit_1d(void* dst, const void* src, size_t bytes) {
+    dma_desc_t d;
+    memset(&d, 0, sizeof(d));
+    d.dst = dst;
+    d.src = src;
+    d.row_bytes = bytes;
+    d.rows = 1;
+    d.planes = 1;
+    return dma_submit(&d);
+}
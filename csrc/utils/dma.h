@@ -0,0 +1,58 @@
+/**
+ * DMA식 비동기 복사 (스크래치패드 타일 적재/저장용).
+ * 기술자 하나 = 3차원 블록: planes × rows × row_bytes, src/dst 각각 row/plane pitch (바이트).
+ * dma_submit은 바로 반환하고 티켓(단조 증가)을 줌 → dma_wait(t)가 t까지(FIFO 순서) 완료를 기다림.
+ * - 호스트: memcpy + 도우미 스레드 1개 (첫 submit 때 시작, pthread, 오래된 glibc는 -pthread).
+ *   -DDMA_NO_THREAD면 submit 안에서 바로 복사 (겹침 없음, 스케줄 확인용).
+ * - BARE_METAL: 지금은 submit 안에서 memcpy (AXI CDMA 등 실제 엔진은 dma.c의 backend_copy 자리).
+ * 엔진 하나를 모든 스레드가 공유 (티켓은 전역 순서 → 다른 스레드 요청까지 기다릴 수 있으나 결과는 같음).
+ */
+#ifndef DMA_H
+#define DMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef DMA_QUEUE_DEPTH
+#define DMA_QUEUE_DEPTH 16   /* 대기 기술자 수 (가득 차면 submit이 기다림) */
+#endif
+
+typedef struct {
+    void* dst;
+    const void* src;
+    size_t row_bytes;
+    int32_t rows;            /* 1 이상 */
+    int32_t planes;          /* 1 이상 */
+    size_t src_row_pitch, src_plane_pitch;
+    size_t dst_row_pitch, dst_plane_pitch;
+} dma_desc_t;
+
+typedef uint64_t dma_ticket_t;
+
+/** 누적 통계 (시간: 호스트 us, BARE_METAL mcycle) */
+typedef struct {
+    uint64_t descs;          /* 처리한 기술자 수 */
+    uint64_t bytes;
+    uint64_t busy_time;      /* 엔진이 복사한 시간 */
+    uint64_t wait_time;      /* dma_wait에서 호출자가 기다린 시간 */
+} dma_stats_t;
+
+/** 비동기 복사 요청. 반환: 티켓 (0은 "없음"으로 예약, dma_wait(0)은 즉시 반환) */
+dma_ticket_t dma_submit(const dma_desc_t* d);
+
+/** 1차원 복사 (planes = rows = 1) */
+dma_ticket_t dma_submit_1d(void* dst, const void* src, size_t bytes);
+
+/** 티켓 t와 그 앞 요청이 모두 끝날 때까지 대기 */
+void dma_wait(dma_ticket_t t);
+
+/** 지금까지 submit한 요청 모두 대기 */
+void dma_wait_all(void);
+
+void dma_get_stats(dma_stats_t* st);
+void dma_reset_stats(void);
+
+/** 도우미 스레드 종료 (다음 submit에서 다시 시작). 대기 중 요청은 먼저 끝냄 */
+void dma_shutdown(void);
+
+#endif /* DMA_H */
@@ -1,185 +1,360 @@
 /**
- * 피처맵 풀: First-fit 할당자 (버퍼 재사용)
+ * 피처맵 풀: 영역 관리 + 할당 백엔드 선택 + 정적 계획 재생
+ * 기본 백엔드 TLSF (O(1) alloc/free), -DFEATURE_POOL_FIRST_FIT이면 기존 first-fit.
  */
 #include "feature_pool.h"
+#include "mem_plan.h"
+#include "thread_local.h"
 #include <stddef.h>
 #include <stdint.h>
 
 #ifdef BARE_METAL
 #include "platform_config.h"
 #endif
-#ifndef BARE_METAL
 #include <stdlib.h>
+#ifndef BARE_METAL
+#include <stdio.h>
 #endif
 
-#define ALIGN 8
-#ifdef BARE_METAL
-#define HEADER_SIZE 8u
+#ifdef FEATURE_POOL_FIRST_FIT
+#include "pool_first_fit.h"
+typedef pool_ff_t pool_backend_t;
+#define backend_init          pool_ff_init
+#define backend_alloc         pool_ff_alloc
+#define backend_free          pool_ff_free
+#define backend_largest_free  pool_ff_largest_free
+#define backend_free_stats    pool_ff_free_stats
 #else
-#define HEADER_SIZE (2u * (size_t)sizeof(size_t))
+#include "pool_tlsf.h"
+typedef pool_tlsf_t pool_backend_t;
+#define backend_init          pool_tlsf_init
+#define backend_alloc         pool_tlsf_alloc
+#define backend_free          pool_tlsf_free
+#define backend_largest_free  pool_tlsf_largest_free
+#define backend_free_stats    pool_tlsf_free_stats
 #endif
-#define MIN_SPLIT (HEADER_SIZE * 2)
-#define NIL ((size_t)-1)
 
-static uint8_t* pool_base;
-static size_t pool_size;
-#ifndef BARE_METAL
-static uint8_t* host_pool;
+/* 풀 1개의 전체 상태. 블록들은 feature_pool_alloc()만 부르므로 "현재 풀"(스레드별 바인딩)에 적용 */
+struct feature_pool {
+    uint8_t* pool_base;
+    size_t pool_size;
+    uint8_t* owned;          /* create/init이 malloc한 영역 (호스트), 아니면 NULL */
+    pool_backend_t backend;
+
+    /* 정적 계획 모드 (NULL: 동적 할당) */
+    const mem_plan_t* active_plan;
+    int32_t plan_cursor;
+
+    /* 계측 상태 */
+#ifndef FEATURE_POOL_NO_STATS
+    feature_pool_record_t records[FEATURE_POOL_MAX_RECORDS];
+    feature_pool_stats_t stats;
+    int32_t event_count;
+    int32_t live_records[FEATURE_POOL_MAX_RECORDS];  /* 아직 free 안 된 기록 인덱스 */
+    int32_t num_live_records;
 #endif
+    int32_t current_layer;
+};
 
-static size_t free_head;
+/* feature_pool_init/reset 등 기존 단일 풀 API가 쓰는 기본 풀 */
+static feature_pool_t default_pool = { .current_layer = -1 };
+static YOLO_THREAD_LOCAL feature_pool_t* cur_pool = &default_pool;
 
-static inline size_t align_up(size_t x, size_t a) {
-    return (x + a - 1) & ~(a - 1);
+static void free_space(const feature_pool_t* p, size_t* free_blocks, size_t* largest, size_t* total) {
+    if (!p->pool_base) {
+        *free_blocks = *largest = *total = 0;
+    } else if (p->active_plan) {
+        *free_blocks = 1;
+        *largest = *total = p->pool_size - p->active_plan->peak;
+    } else {
+        backend_free_stats(&p->backend, free_blocks, total);
+        *largest = backend_largest_free(&p->backend);
+    }
+}
+
+static float frag_ratio(size_t largest, size_t total) {
+    return total ? 1.0f - (float)largest / (float)total : 0.0f;
+}
+
+#ifndef FEATURE_POOL_NO_STATS
+static void stats_on_alloc(feature_pool_t* p, const void* ptr, size_t size) {
+    feature_pool_stats_t* st = &p->stats;
+    p->event_count++;
+    if (!ptr) {
+        st->failed_allocs++;
+        return;
+    }
+    st->num_allocs++;
+    st->live_bytes += size;
+    if (st->live_bytes > st->peak_live_bytes) {
+        st->peak_live_bytes = st->live_bytes;
+        st->peak_layer = p->current_layer;
+    }
+    if (st->num_records >= FEATURE_POOL_MAX_RECORDS) return;
+    p->live_records[p->num_live_records++] = st->num_records;
+    feature_pool_record_t* r = &p->records[st->num_records++];
+    r->layer = p->current_layer;
+    r->free_layer = -1;
+    r->alloc_event = p->event_count - 1;
+    r->free_event = -1;
+    r->size = size;
+    r->offset = (size_t)((const uint8_t*)ptr - p->pool_base);
+    r->live_bytes = st->live_bytes;
+    free_space(p, &r->free_blocks, &r->largest_free, &r->total_free);
+    const float frag = frag_ratio(r->largest_free, r->total_free);
+    if (frag > st->peak_fragmentation) st->peak_fragmentation = frag;
+}
+
+/* 살아있는 기록 중 같은 오프셋을 찾음: O(live 개수). 기록 밖 alloc이면 live_bytes 갱신 불가 */
+static void stats_on_free(feature_pool_t* p, const void* ptr) {
+    const size_t off = (size_t)((const uint8_t*)ptr - p->pool_base);
+    p->event_count++;
+    p->stats.num_frees++;
+    for (int32_t i = p->num_live_records - 1; i >= 0; i--) {
+        feature_pool_record_t* r = &p->records[p->live_records[i]];
+        if (r->offset != off) continue;
+        r->free_event = p->event_count - 1;
+        r->free_layer = p->current_layer;
+        p->stats.live_bytes -= r->size;
+        p->live_records[i] = p->live_records[--p->num_live_records];
+        return;
+    }
+}
+#endif
+
+static void stats_reset(feature_pool_t* p) {
+#ifndef FEATURE_POOL_NO_STATS
+    const feature_pool_stats_t zero = {0};
+    p->stats = zero;
+    p->stats.peak_layer = -1;
+    p->event_count = 0;
+    p->num_live_records = 0;
+#else
+    (void)p;
+#endif
+}
+
+/* 풀 전체를 free 블록 하나로 */
+static void pool_format(feature_pool_t* p) {
+    backend_init(&p->backend, p->pool_base, p->pool_size);
+    stats_reset(p);
+}
+
+/* 영역 연결: 계획 오프셋(MEM_PLAN_ALIGN 배수)이 그대로 64B 정렬 주소가 되도록 base 정렬.
+ * slack: 영역 뒤에 FEATURE_POOL_ALIGN 여유가 있으면(직접 malloc) 정렬분을 size에서 빼지 않음 */
+static void pool_attach(feature_pool_t* p, uint8_t* base, size_t size, int slack) {
+    p->pool_base = base;
+    p->pool_size = base ? size : 0;
+    if (base) {
+        const size_t pad = (size_t)(-(uintptr_t)base & (FEATURE_POOL_ALIGN - 1u));
+        if (!slack) p->pool_size = size > pad ? size - pad : 0;
+        p->pool_base += pad;
+    }
+    p->active_plan = NULL;
+    p->plan_cursor = 0;
+    p->current_layer = -1;
+    pool_format(p);
 }
 
 void feature_pool_init(void) {
+    feature_pool_t* p = &default_pool;
 #ifdef BARE_METAL
-    pool_base = (uint8_t*)FEATURE_POOL_BASE;
-    pool_size = FEATURE_POOL_SIZE;
+    pool_attach(p, (uint8_t*)FEATURE_POOL_BASE, FEATURE_POOL_SIZE, 0);
 #else
-    pool_size = 22u * 1024u * 1024u;  /* 호스트: 22MB */
-    host_pool = (uint8_t*)malloc(pool_size);
-    pool_base = host_pool;
-    if (!pool_base) pool_size = 0;
+    const size_t size = FEATURE_POOL_HOST_SIZE;
+    p->owned = (uint8_t*)malloc(size + FEATURE_POOL_ALIGN);
+    pool_attach(p, p->owned, size, 1);
 #endif
-    free_head = NIL;
-    if (pool_base && pool_size >= HEADER_SIZE * 2) {
-        size_t* hdr = (size_t*)(pool_base + 0);
-        hdr[0] = pool_size;
-        hdr[1] = NIL;
-        free_head = 0;
-    }
 }
 
-void* feature_pool_alloc(size_t size) {
-    if (!pool_base || size == 0) return NULL;
-    size_t need = align_up(size, ALIGN) + HEADER_SIZE;
-    if (need > pool_size) return NULL;
-
-    size_t prev = NIL;
-    size_t curr = free_head;
-    while (curr != NIL) {
-        size_t* blk = (size_t*)(pool_base + curr);
-        size_t blk_size = blk[0];
-        size_t next = blk[1];
-        if (blk_size >= need) {
-            if (blk_size >= need + MIN_SPLIT) {
-                size_t rest = blk_size - need;
-                blk[0] = need;
-                size_t* rest_blk = (size_t*)(pool_base + curr + need);
-                rest_blk[0] = rest;
-                rest_blk[1] = next;
-                if (prev == NIL)
-                    free_head = curr + need;
-                else
-                    ((size_t*)(pool_base + prev))[1] = curr + need;
-            } else {
-                if (prev == NIL)
-                    free_head = next;
-                else
-                    ((size_t*)(pool_base + prev))[1] = next;
-            }
-            return (void*)(pool_base + curr + HEADER_SIZE);
+feature_pool_t* feature_pool_create(void* region, size_t size) {
+#ifdef BARE_METAL
+    if (!region || !size) return NULL;  /* DDR 영역은 호출자가 지정 */
+#endif
+    feature_pool_t* p = (feature_pool_t*)calloc(1, sizeof(feature_pool_t));
+    if (!p) return NULL;
+    if (!size) size = FEATURE_POOL_HOST_SIZE;
+    if (!region) {
+        p->owned = (uint8_t*)malloc(size + FEATURE_POOL_ALIGN);
+        if (!p->owned) {
+            free(p);
+            return NULL;
         }
-        prev = curr;
-        curr = next;
     }
-    return NULL;
+    pool_attach(p, region ? (uint8_t*)region : p->owned, size, region == NULL);
+    return p;
 }
 
-static void unlink_free_block(size_t target, size_t prev_of_target) {
-    size_t next = ((size_t*)(pool_base + target))[1];
-    if (prev_of_target == NIL)
-        free_head = next;
-    else
-        ((size_t*)(pool_base + prev_of_target))[1] = next;
+void feature_pool_destroy(feature_pool_t* p) {
+    if (!p || p == &default_pool) return;
+    if (cur_pool == p) cur_pool = &default_pool;
+    free(p->owned);
+    free(p);
 }
 
-static void insert_free_by_address(size_t curr, size_t curr_size) {
-    size_t* blk = (size_t*)(pool_base + curr);
-    blk[0] = curr_size;
-    size_t prev_link = NIL;
-    size_t w = free_head;
-    while (w != NIL && w < curr) {
-        prev_link = w;
-        w = ((size_t*)(pool_base + w))[1];
-    }
-    blk[1] = w;
-    if (prev_link == NIL)
-        free_head = curr;
-    else
-        ((size_t*)(pool_base + prev_link))[1] = curr;
+feature_pool_t* feature_pool_bind(feature_pool_t* p) {
+    feature_pool_t* prev = cur_pool;
+    cur_pool = p ? p : &default_pool;
+    return prev;
 }
 
-void feature_pool_free(void* ptr) {
-    if (!ptr || !pool_base) return;
-    uint8_t* p = (uint8_t*)ptr;
-    if (p < pool_base + HEADER_SIZE || p >= pool_base + pool_size) return;
-    size_t curr = (size_t)(p - pool_base - HEADER_SIZE);
-    size_t* blk = (size_t*)(pool_base + curr);
-    size_t curr_size = blk[0];
-
-    insert_free_by_address(curr, curr_size);
-    size_t prev_link = NIL;
-    size_t w = free_head;
-    while (w != NIL && w != curr) {
-        prev_link = w;
-        w = ((size_t*)(pool_base + w))[1];
-    }
-    size_t base = curr;
-    size_t base_size = curr_size;
-    size_t* base_blk = blk;
-    if (prev_link != NIL) {
-        size_t* pl = (size_t*)(pool_base + prev_link);
-        if (prev_link + pl[0] == curr) {
-            pl[0] += curr_size;
-            unlink_free_block(curr, prev_link);
-            base = prev_link;
-            base_size = pl[0];
-            base_blk = pl;
+void* feature_pool_alloc(size_t size) {
+    feature_pool_t* p = cur_pool;
+    if (!p->pool_base || size == 0) return NULL;
+    if (p->active_plan) {
+        if (p->plan_cursor >= p->active_plan->num_tensors) return NULL;
+        const mem_plan_tensor_t* t = &p->active_plan->tensors[p->plan_cursor];
+        void* ptr = NULL;
+        if (t->size == size) {  /* 다르면 그래프가 계획과 다르게 실행됨 */
+            p->plan_cursor++;
+            ptr = (void*)(p->pool_base + t->offset);
         }
+#ifndef FEATURE_POOL_NO_STATS
+        stats_on_alloc(p, ptr, size);
+#endif
+        return ptr;
     }
+    void* ptr = backend_alloc(&p->backend, size);
+#ifndef FEATURE_POOL_NO_STATS
+    stats_on_alloc(p, ptr, size);
+#endif
+    return ptr;
+}
 
-    size_t next_in_list = base_blk[1];
-    if (next_in_list != NIL) {
-        size_t* nl = (size_t*)(pool_base + next_in_list);
-        if (base + base_size == next_in_list) {
-            base_blk[0] = base_size + nl[0];
-            unlink_free_block(next_in_list, base);
-        }
-    }
+void feature_pool_free(void* ptr) {
+    feature_pool_t* p = cur_pool;
+    if (!ptr || !p->pool_base) return;
+#ifndef FEATURE_POOL_NO_STATS
+    stats_on_free(p, ptr);
+#endif
+    if (!p->active_plan) backend_free(&p->backend, ptr);
 }
 
 void feature_pool_reset(void) {
+    feature_pool_t* p = cur_pool;
 #ifndef BARE_METAL
-    if (host_pool) {
-        free(host_pool);
-        host_pool = NULL;
-        pool_base = NULL;
-        pool_size = 0;
-        free_head = NIL;
+    if (p->owned) {
+        free(p->owned);
+        p->owned = NULL;
+        pool_attach(p, NULL, 0, 0);
         return;
     }
 #endif
-    free_head = NIL;
-    if (pool_base && pool_size >= 16) {
-        size_t* hdr = (size_t*)(pool_base + 0);
-        hdr[0] = pool_size;
-        hdr[1] = NIL;
-        free_head = 0;
-    }
+    p->active_plan = NULL;
+    pool_format(p);
+}
+
+void feature_pool_clear(void) {
+    feature_pool_t* p = cur_pool;
+    if (!p->active_plan) pool_format(p);
+    p->plan_cursor = 0;
+    stats_reset(p);
 }
 
 size_t feature_pool_get_largest_free(void) {
-    size_t max_free = 0;
-    if (!pool_base) return 0;
-    size_t curr = free_head;
-    while (curr != NIL) {
-        size_t* blk = (size_t*)(pool_base + curr);
-        size_t blk_size = blk[0];
-        if (blk_size > max_free) max_free = blk_size;
-        curr = blk[1];
+    const feature_pool_t* p = cur_pool;
+    if (!p->pool_base) return 0;
+    if (p->active_plan) return p->pool_size - p->active_plan->peak;  /* 계획 peak 뒤 연속 영역 */
+    return backend_largest_free(&p->backend);
+}
+
+size_t feature_pool_get_high_water(void) {
+    const feature_pool_t* p = cur_pool;
+    return p->active_plan ? p->active_plan->peak : p->backend.high_water;
+}
+
+size_t feature_pool_dry_run(const mem_plan_t* plan) {
+    feature_pool_t* p = cur_pool;
+    if (!plan || !p->pool_base || p->active_plan) return 0;
+    void* ptrs[MEM_PLAN_MAX_TENSORS];
+    int ok = 1;
+    pool_format(p);
+    for (int32_t e = 0; e < plan->num_events && ok; e++) {
+        const int32_t ev = plan->events[e];
+        if (ev >= 0) {
+            ptrs[ev] = feature_pool_alloc(plan->tensors[ev].size);
+            if (!ptrs[ev]) ok = 0;
+        } else {
+            feature_pool_free(ptrs[~ev]);
+        }
     }
-    return max_free;
+    const size_t hw = p->backend.high_water;
+    pool_format(p);
+    return ok ? hw : 0;
+}
+
+int feature_pool_use_plan(const mem_plan_t* plan) {
+    feature_pool_t* p = cur_pool;
+    if (plan && (plan->error || plan->peak > p->pool_size)) return -1;
+    if (!plan && p->active_plan) pool_format(p);
+    p->active_plan = plan;
+    p->plan_cursor = 0;
+    return 0;
+}
+
+void feature_pool_plan_rewind(void) {
+    cur_pool->plan_cursor = 0;
+    stats_reset(cur_pool);
 }
+
+void feature_pool_set_layer(int32_t layer) {
+    cur_pool->current_layer = layer;
+}
+
+void feature_pool_stats_reset(void) {
+    stats_reset(cur_pool);
+}
+
+void feature_pool_get_stats(feature_pool_stats_t* out) {
+    const feature_pool_t* p = cur_pool;
+    if (!out) return;
+#ifndef FEATURE_POOL_NO_STATS
+    *out = p->stats;
+#else
+    const feature_pool_stats_t zero = {0};
+    *out = zero;
+    out->peak_layer = -1;
+#endif
+    /* 현재 상태는 계측 없이도 조회 가능 */
+    out->high_water = feature_pool_get_high_water();
+    free_space(p, &out->free_blocks, &out->largest_free, &out->total_free);
+    out->fragmentation = frag_ratio(out->largest_free, out->total_free);
+}
+
+const feature_pool_record_t* feature_pool_get_records(int32_t* count) {
+#ifndef FEATURE_POOL_NO_STATS
+    if (count) *count = cur_pool->stats.num_records;
+    return cur_pool->records;
+#else
+    if (count) *count = 0;
+    return NULL;
+#endif
+}
+
+#ifndef BARE_METAL
+int feature_pool_export_timeline(const char* path) {
+    feature_pool_stats_t st;
+    int32_t n = 0;
+    const feature_pool_record_t* rec = feature_pool_get_records(&n);
+    feature_pool_get_stats(&st);
+    FILE* f = path ? fopen(path, "w") : NULL;
+    if (!f) return -1;
+    fprintf(f, "# pool_size=%lu mode=%s\n", (unsigned long)cur_pool->pool_size, cur_pool->active_plan ? "plan" : "allocator");
+    fprintf(f, "# allocs=%d frees=%d failed=%d records=%d\n", (int)st.num_allocs, (int)st.num_frees,
+            (int)st.failed_allocs, (int)st.num_records);
+    fprintf(f, "# live=%lu peak_live=%lu peak_layer=%d high_water=%lu\n", (unsigned long)st.live_bytes,
+            (unsigned long)st.peak_live_bytes, (int)st.peak_layer, (unsigned long)st.high_water);
+    fprintf(f, "# free_blocks=%lu largest_free=%lu total_free=%lu fragmentation=%.4f peak_fragmentation=%.4f\n",
+            (unsigned long)st.free_blocks, (unsigned long)st.largest_free, (unsigned long)st.total_free,
+            st.fragmentation, st.peak_fragmentation);
+    fprintf(f, "id,layer,free_layer,alloc_event,free_event,size,offset,end,live_bytes,free_blocks,largest_free,total_free\n");
+    for (int32_t i = 0; i < n; i++) {
+        const feature_pool_record_t* r = &rec[i];
+        fprintf(f, "%d,%d,%d,%d,%d,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", (int)i, (int)r->layer, (int)r->free_layer,
+                (int)r->alloc_event, (int)r->free_event, (unsigned long)r->size, (unsigned long)r->offset,
+                (unsigned long)(r->offset + r->size), (unsigned long)r->live_bytes,
+                (unsigned long)r->free_blocks, (unsigned long)r->largest_free, (unsigned long)r->total_free);
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+#endif
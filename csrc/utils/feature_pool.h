@@ -1,23 +1,124 @@
 /**
- * 피처맵 풀 할당 (first-fit, 버퍼 재사용).
+ * 피처맵 풀 할당 (버퍼 재사용). 기본 TLSF(O(1) alloc/free, 즉시 병합),
+ * -DFEATURE_POOL_FIRST_FIT이면 기존 first-fit.
  * BARE_METAL: DDR FEATURE_POOL_BASE/SIZE. 호스트: malloc 한 번.
+ * 정적 계획(mem_plan) 적용 시: k번째 alloc = base + plan offset (O(1)), free는 no-op.
+ * 반환 포인터는 모든 모드에서 FEATURE_POOL_ALIGN(64B, 캐시 라인) 정렬 → 커널이 정렬 로드 가정 가능.
+ * 계측: live/peak 바이트, free 블록 수·단편화, alloc별 기록(레이어, 크기, 오프셋, 수명).
+ * -DFEATURE_POOL_NO_STATS이면 계측 전부 생략 (stats 조회는 0).
+ * 풀 여러 개: feature_pool_create()로 만들고 feature_pool_bind()로 "현재 풀" 지정 (스레드별).
+ * 아래 함수들은 모두 현재 풀에 적용, 바인딩 전 기본값은 feature_pool_init()이 쓰는 기본 풀.
  */
 #ifndef FEATURE_POOL_H
 #define FEATURE_POOL_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define FEATURE_POOL_ALIGN 64u
+#define FEATURE_POOL_HOST_SIZE (22u * 1024u * 1024u)  /* 호스트 기본 풀 크기 */
+
+typedef struct feature_pool feature_pool_t;
+
+/** 기본 풀 초기화 (BARE_METAL: FEATURE_POOL_BASE/SIZE, 호스트: FEATURE_POOL_HOST_SIZE malloc) */
 void feature_pool_init(void);
+
+/**
+ * 풀 생성. region이 있으면 호출자 영역(DDR 등) 사용, NULL이면 size(0: FEATURE_POOL_HOST_SIZE)만큼 malloc
+ * (BARE_METAL은 region 필수). 실패 NULL
+ */
+feature_pool_t* feature_pool_create(void* region, size_t size);
+void feature_pool_destroy(feature_pool_t* pool);
+
+/** 현재 스레드의 풀 지정 (NULL: 기본 풀). 반환: 이전 풀 (호출 끝에 되돌릴 때) */
+feature_pool_t* feature_pool_bind(feature_pool_t* pool);
+
 void* feature_pool_alloc(size_t size);
 void feature_pool_free(void* ptr);
 void feature_pool_reset(void);
 
+/** 모든 블록 반환 (영역·계획 유지, 계획 커서 처음으로). 중간에 실패한 프레임 정리용 */
+void feature_pool_clear(void);
+
 size_t feature_pool_get_largest_free(void);
 
+/** 풀 base 기준 최대 사용 끝 주소 (동적 할당: 실측 high-water, 계획 모드: 계획 peak) */
+size_t feature_pool_get_high_water(void);
+
+struct mem_plan;
+
+/**
+ * 계획의 alloc/free 이벤트를 동적 할당자로 그대로 재생해 high-water 측정 (피처맵 내용은 건드리지 않음).
+ * 계획 모드가 아닐 때만. 반환: high-water 바이트 (풀 부족 시 0). 끝나면 풀은 빈 상태로 복구.
+ */
+size_t feature_pool_dry_run(const struct mem_plan* plan);
+
+/**
+ * 정적 계획 적용 (NULL이면 동적 할당으로 복귀). plan은 사용 중 유지되어야 함.
+ * 이후 alloc은 계획 순서·크기와 같아야 하며, 다르면 NULL. 반환 0 성공, -1 (peak > 풀 크기)
+ */
+int feature_pool_use_plan(const struct mem_plan* plan);
+
+/** 계획 재생 커서를 처음으로 (프레임 시작마다) */
+void feature_pool_plan_rewind(void);
+
+/* ===== 계측 ===== */
+
+#define FEATURE_POOL_MAX_RECORDS 256
+
+/** alloc 1건. 수명 = [alloc_event, free_event) (이벤트 = 풀 alloc/free 호출 순번) */
+typedef struct {
+    int32_t layer;        /* alloc 시점 레이어 (feature_pool_set_layer) */
+    int32_t free_layer;   /* free 시점 레이어, 아직 살아있으면 -1 */
+    int32_t alloc_event;
+    int32_t free_event;   /* 아직 살아있으면 -1 */
+    size_t size;          /* 요청 바이트 */
+    size_t offset;        /* 풀 base 기준 */
+    size_t live_bytes;    /* 이 alloc 직후 live 합 */
+    size_t free_blocks;   /* 이 alloc 직후 free 블록 수 */
+    size_t largest_free;  /* 이 alloc 직후 가장 큰 free 블록 */
+    size_t total_free;    /* 이 alloc 직후 free 합 */
+} feature_pool_record_t;
+
+typedef struct {
+    size_t live_bytes;       /* 현재 살아있는 요청 바이트 합 */
+    size_t peak_live_bytes;
+    int32_t peak_layer;      /* peak_live_bytes를 찍은 레이어 */
+    size_t high_water;       /* feature_pool_get_high_water()와 동일 */
+    size_t free_blocks;      /* 현재 free 블록 수 (계획 모드: peak 뒤 꼬리 1개) */
+    size_t largest_free;
+    size_t total_free;
+    float fragmentation;     /* 1 - largest_free / total_free (0: 단편화 없음) */
+    float peak_fragmentation;  /* alloc 직후 값 중 최대 */
+    int32_t num_allocs;
+    int32_t num_frees;
+    int32_t failed_allocs;
+    int32_t num_records;     /* FEATURE_POOL_MAX_RECORDS 초과분은 기록 생략 (카운트만) */
+} feature_pool_stats_t;
+
+/** 이후 alloc/free 기록에 붙일 레이어 번호 (main.c: yolo_timing_set_layer와 같은 번호) */
+void feature_pool_set_layer(int32_t layer);
+
+/** 기록·카운터 초기화 (프레임 시작, live 버퍼가 없을 때). plan_rewind/reset에서도 호출됨 */
+void feature_pool_stats_reset(void);
+
+void feature_pool_get_stats(feature_pool_stats_t* stats);
+
+/** 기록 배열 (alloc 순서). count에 개수 */
+const feature_pool_record_t* feature_pool_get_records(int32_t* count);
+
+#ifndef BARE_METAL
+/**
+ * 요약(# 주석 줄) + alloc 기록을 CSV로 저장 (레이어별 peak/수명 분석, FEATURE_POOL_SIZE 산정용).
+ * 반환 0 성공, -1 실패
+ */
+int feature_pool_export_timeline(const char* path);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
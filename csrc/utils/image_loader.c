@@ -6,93 +6,101 @@
 #include <stdio.h>
 #endif
 
+#define IMAGE_HEADER_BYTES 24
+
 static inline void safe_read(void* dest, const uint8_t** src, size_t size) {
     memcpy(dest, *src, size);
     *src += size;
 }
 
-static int parse_image_data(const uint8_t* ptr, size_t data_len, preprocessed_image_t* img, int zero_copy) {
-    const uint8_t* curr = ptr;
-    const uint8_t* end = ptr + data_len;
-
-    if (curr + 24 > end) return -1;
-    // 헤더 24B
+/* 헤더 24B: original_w, original_h, scale, pad_x, pad_y, size
+ * size: 비트 0-15 W, 16-27 H (0이면 정사각형 H = W), 28-31 픽셀 형식 (IMAGE_FMT_*) */
+static int parse_header(const uint8_t* curr, preprocessed_image_t* img) {
     uint32_t original_w, original_h, size;
     float scale;
     uint32_t pad_x, pad_y;
-    
+
     safe_read(&original_w, &curr, 4);
     safe_read(&original_h, &curr, 4);
     safe_read(&scale, &curr, 4);
     safe_read(&pad_x, &curr, 4);
     safe_read(&pad_y, &curr, 4);
     safe_read(&size, &curr, 4);
-    
+
     img->original_w = (int32_t)original_w;
     img->original_h = (int32_t)original_h;
     img->scale = scale;
     img->pad_x = (int32_t)pad_x;
     img->pad_y = (int32_t)pad_y;
     img->c = 3;
-    img->h = (int32_t)size;
-    img->w = (int32_t)size;
-    
-    size_t data_bytes = 3 * (size_t)size * (size_t)size * sizeof(float);
-    if (curr + data_bytes > end) return -1;
-
-    if (zero_copy) {
-        img->data = (float*)curr;
-        img->data_owned = 0;
-    } else {
-        img->data = (float*)malloc(data_bytes);
-        if (!img->data) return -1;
-        safe_read(img->data, &curr, data_bytes);
-        img->data_owned = 1;
-    }
+    img->w = (int32_t)(size & 0xFFFFu);
+    img->h = ((size >> 16) & 0x0FFFu) ? (int32_t)((size >> 16) & 0x0FFFu) : img->w;
+    img->format = size >> 28;
+    img->data = NULL;
+    img->data_u8 = NULL;
+    img->data_owned = 0;
+    if (img->format > IMAGE_FMT_U8_HWC || img->w <= 0) return -1;
     return 0;
 }
 
+size_t image_data_bytes(const preprocessed_image_t* img) {
+    const size_t px = (size_t)img->c * (size_t)img->h * (size_t)img->w;
+    return img->format == IMAGE_FMT_F32_CHW ? px * sizeof(float) : px;
+}
+
 int image_init_from_memory(uintptr_t base_addr, size_t size, preprocessed_image_t* img) {
-    if (!img || size < 24) return -1;
-    return parse_image_data((const uint8_t*)base_addr, size, img, 1);
+    if (!img || size < IMAGE_HEADER_BYTES) return -1;
+    const uint8_t* ptr = (const uint8_t*)base_addr;
+    if (parse_header(ptr, img) != 0) return -1;
+    if (image_data_bytes(img) > size - IMAGE_HEADER_BYTES) return -1;
+    /* zero-copy: 헤더 바로 다음 픽셀을 그대로 사용 */
+    if (img->format == IMAGE_FMT_F32_CHW) img->data = (float*)(ptr + IMAGE_HEADER_BYTES);
+    else img->data_u8 = ptr + IMAGE_HEADER_BYTES;
+    return 0;
 }
 
 #ifndef BARE_METAL
 int image_load_from_bin(const char* bin_path, preprocessed_image_t* img) {
+    if (!img) return -1;
     FILE* f = fopen(bin_path, "rb");
     if (!f) {
         fprintf(stderr, "Error: Cannot open image file: %s\n", bin_path);
         return -1;
     }
-    
-    fseek(f, 0, SEEK_END);
-    size_t file_size = ftell(f);
-    fseek(f, 0, SEEK_SET);
-    
-    uint8_t* buffer = (uint8_t*)malloc(file_size);
-    if (!buffer) {
+
+    uint8_t header[IMAGE_HEADER_BYTES];
+    if (fread(header, 1, sizeof(header), f) != sizeof(header) || parse_header(header, img) != 0) {
+        fclose(f);
+        return -1;
+    }
+
+    /* 픽셀은 최종 버퍼로 바로 읽음 (파일 전체 버퍼 → 복사 없음) */
+    const size_t data_bytes = image_data_bytes(img);
+    void* buf = malloc(data_bytes);
+    if (!buf) {
         fclose(f);
         return -1;
     }
-    
-    if (fread(buffer, 1, file_size, f) != file_size) {
-        free(buffer);
+    if (fread(buf, 1, data_bytes, f) != data_bytes) {
+        free(buf);
         fclose(f);
         return -1;
     }
     fclose(f);
-    
-    int ret = parse_image_data(buffer, file_size, img, 0);
-    free(buffer);
-    
-    return ret;
+
+    if (img->format == IMAGE_FMT_F32_CHW) img->data = (float*)buf;
+    else img->data_u8 = (const uint8_t*)buf;
+    img->data_owned = 1;
+    return 0;
 }
 #endif
 
 void image_free(preprocessed_image_t* img) {
     if (!img) return;
-    if (img->data_owned && img->data) {
+    if (img->data_owned) {
         free(img->data);
-        img->data = NULL;
+        free((void*)img->data_u8);
     }
+    img->data = NULL;
+    img->data_u8 = NULL;
 }
@@ -4,8 +4,15 @@
 #include <stdint.h>
 #include <stddef.h>
 
+/* 픽셀 형식: 헤더 size 필드 상위 4비트 (0 = 기존 FP32 파일) */
+#define IMAGE_FMT_F32_CHW 0u  /* float 0..1, C x H x W */
+#define IMAGE_FMT_U8_CHW  1u  /* uint8 0..255, C x H x W */
+#define IMAGE_FMT_U8_HWC  2u  /* uint8 0..255, H x W x C (RGB 인터리브) */
+
 typedef struct {
-    float* data;         // 이미지 데이터 (C, H, W) - NCHW 형식
+    float* data;         // 이미지 데이터 (C, H, W) - NCHW 형식. uint8 형식이면 NULL
+    const uint8_t* data_u8;  // uint8 형식 픽셀 (format에 따라 CHW/HWC), FP32면 NULL
+    uint32_t format;     // IMAGE_FMT_*
     int32_t c, h, w;     // 채널, 높이, 너비
     int32_t original_w, original_h;  // 원본 이미지 크기
     float scale;         // 리사이즈 스케일
@@ -13,12 +20,16 @@ typedef struct {
     unsigned char data_owned; // 1 = loader가 할당(해제 시 free), 0 = 외부(DDR) 참조
 } preprocessed_image_t;
 
+/* 헤더 + 픽셀을 제자리 참조 (복사 없음, FP32/uint8 공통) */
 int image_init_from_memory(uintptr_t base_addr, size_t size, preprocessed_image_t* img);
 
 // ===== 개발/테스트용: 파일 시스템에서 로드 =====
-// 반환값: 0 성공, -1 실패
+// 헤더 24B를 읽은 뒤 픽셀만 버퍼 하나로 바로 읽음. 반환값: 0 성공, -1 실패
 int image_load_from_bin(const char* bin_path, preprocessed_image_t* img);
 
+/* 픽셀 바이트 수 (헤더 제외) */
+size_t image_data_bytes(const preprocessed_image_t* img);
+
 void image_free(preprocessed_image_t* img);
 
 #endif // IMAGE_LOADER_H
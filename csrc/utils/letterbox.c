@@ -0,0 +1,272 @@
+#include "letterbox.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifndef BARE_METAL
+#include <stdio.h>
+#endif
+
+/* PIL Resample.c와 같은 고정소수점: 32 - 8(픽셀) - 2(부호/여유) */
+#define LB_PRECISION_BITS 22
+#define LB_PAD_VALUE      114
+
+static inline uint8_t clip8(int32_t v) {
+    if (v >= (1 << LB_PRECISION_BITS << 8)) return 255;
+    if (v <= 0) return 0;
+    return (uint8_t)(v >> LB_PRECISION_BITS);
+}
+
+static double bilinear_filter(double x) {
+    if (x < 0.0) x = -x;
+    return x < 1.0 ? 1.0 - x : 0.0;
+}
+
+static int32_t filter_ksize(int32_t in_size, int32_t out_size) {
+    double filterscale = (double)in_size / out_size;
+    if (filterscale < 1.0) filterscale = 1.0;
+    return (int32_t)ceil(filterscale) * 2 + 1;  /* bilinear support 1.0 */
+}
+
+/* 출력 픽셀 xx의 탭 [xmin, xmin+cnt)와 계수: 중심 (xx+0.5)*scale, 축소 시 필터 폭 scale배.
+ * 계수 합으로 정규화 후 22비트 반올림 (PIL precompute_coeffs + normalize_coeffs_8bpc) */
+static void precompute_coeffs(int32_t in_size, int32_t out_size, int32_t ksize, int32_t* bounds, int32_t* kk) {
+    const double scale = (double)in_size / out_size;
+    const double filterscale = scale < 1.0 ? 1.0 : scale;
+    const double support = 1.0 * filterscale;
+    const double ss = 1.0 / filterscale;
+    double k[64];
+    for (int32_t xx = 0; xx < out_size; xx++) {
+        const double center = (xx + 0.5) * scale;
+        int32_t xmin = (int32_t)(center - support + 0.5);
+        if (xmin < 0) xmin = 0;
+        int32_t xmax = (int32_t)(center + support + 0.5);
+        if (xmax > in_size) xmax = in_size;
+        xmax -= xmin;
+        if (xmax > ksize) xmax = ksize;
+        double ww = 0.0;
+        for (int32_t x = 0; x < xmax; x++) {
+            k[x] = bilinear_filter((x + xmin - center + 0.5) * ss);
+            ww += k[x];
+        }
+        int32_t* kq = kk + (size_t)xx * ksize;
+        for (int32_t x = 0; x < ksize; x++) {
+            const double v = x < xmax && ww != 0.0 ? k[x] / ww : 0.0;
+            kq[x] = v < 0.0 ? (int32_t)(-0.5 + v * (1 << LB_PRECISION_BITS))
+                            : (int32_t)(0.5 + v * (1 << LB_PRECISION_BITS));
+        }
+        bounds[2 * xx] = xmin;
+        bounds[2 * xx + 1] = xmax;
+    }
+}
+
+int letterbox_init(letterbox_t* lb, int32_t src_w, int32_t src_h, int32_t size, int rect) {
+    if (!lb) return -1;
+    memset(lb, 0, sizeof(*lb));
+    if (src_w <= 0 || src_h <= 0 || src_w > 0xFFFF || src_h > 0xFFFF || size < 32 || size > 0x0FFF) return -1;
+
+    /* Python 도구와 같은 double 연산: scale = min(size/w, size/h), new = int(src * scale) */
+    const double sw = (double)size / src_w, sh = (double)size / src_h;
+    const double scale = sw < sh ? sw : sh;
+    lb->src_w = src_w;
+    lb->src_h = src_h;
+    lb->new_w = (int32_t)(src_w * scale);
+    lb->new_h = (int32_t)(src_h * scale);
+    if (lb->new_w <= 0 || lb->new_h <= 0) return -1;
+    if (rect) {
+        lb->out_w = (lb->new_w + 31) / 32 * 32;
+        lb->out_h = (lb->new_h + 31) / 32 * 32;
+    } else {
+        lb->out_w = lb->out_h = size;
+    }
+    lb->pad_x = (lb->out_w - lb->new_w) / 2;
+    lb->pad_y = (lb->out_h - lb->new_h) / 2;
+    lb->scale = (float)scale;
+    lb->ksize_x = filter_ksize(src_w, lb->new_w);
+    lb->ksize_y = filter_ksize(src_h, lb->new_h);
+    if (lb->ksize_x > 64 || lb->ksize_y > 64) return -1;  /* 31배 넘는 축소는 미지원 */
+
+    const size_t row_bytes = (size_t)lb->new_w * 3;
+    lb->bounds_x = (int32_t*)malloc((size_t)2 * lb->new_w * sizeof(int32_t));
+    lb->bounds_y = (int32_t*)malloc((size_t)2 * lb->new_h * sizeof(int32_t));
+    lb->kk_x = (int32_t*)malloc((size_t)lb->new_w * lb->ksize_x * sizeof(int32_t));
+    lb->kk_y = (int32_t*)malloc((size_t)lb->new_h * lb->ksize_y * sizeof(int32_t));
+    lb->ring = (uint8_t*)malloc((size_t)lb->ksize_y * row_bytes);
+    lb->ring_row = (int32_t*)malloc((size_t)lb->ksize_y * sizeof(int32_t));
+    lb->acc = (int32_t*)malloc(row_bytes * sizeof(int32_t));
+    if (!lb->bounds_x || !lb->bounds_y || !lb->kk_x || !lb->kk_y || !lb->ring || !lb->ring_row || !lb->acc) {
+        letterbox_free(lb);
+        return -1;
+    }
+    precompute_coeffs(src_w, lb->new_w, lb->ksize_x, lb->bounds_x, lb->kk_x);
+    precompute_coeffs(src_h, lb->new_h, lb->ksize_y, lb->bounds_y, lb->kk_y);
+    return 0;
+}
+
+size_t letterbox_out_bytes(const letterbox_t* lb, uint32_t format) {
+    const size_t px = (size_t)3 * lb->out_h * lb->out_w;
+    return format == IMAGE_FMT_F32_CHW ? px * sizeof(float) : px;
+}
+
+void letterbox_free(letterbox_t* lb) {
+    if (!lb) return;
+    free(lb->bounds_x);
+    free(lb->bounds_y);
+    free(lb->kk_x);
+    free(lb->kk_y);
+    free(lb->ring);
+    free(lb->ring_row);
+    free(lb->acc);
+    memset(lb, 0, sizeof(*lb));
+}
+
+/* 가로 패스: 원본 행 1개 → new_w x 3 (uint8 반올림) */
+static void hpass_row(const letterbox_t* lb, const uint8_t* src, uint8_t* out) {
+    for (int32_t xx = 0; xx < lb->new_w; xx++) {
+        const int32_t cnt = lb->bounds_x[2 * xx + 1];
+        const int32_t* k = lb->kk_x + (size_t)xx * lb->ksize_x;
+        const uint8_t* p = src + (size_t)lb->bounds_x[2 * xx] * 3;
+        int32_t s0 = 1 << (LB_PRECISION_BITS - 1), s1 = s0, s2 = s0;
+        for (int32_t x = 0; x < cnt; x++, p += 3) {
+            s0 += p[0] * k[x];
+            s1 += p[1] * k[x];
+            s2 += p[2] * k[x];
+        }
+        out[3 * xx + 0] = clip8(s0);
+        out[3 * xx + 1] = clip8(s1);
+        out[3 * xx + 2] = clip8(s2);
+    }
+}
+
+/* 패딩 영역만 114로 (리사이즈 영역은 run이 덮어씀) */
+static void fill_pad(const letterbox_t* lb, uint32_t format, void* dst) {
+    const int32_t ow = lb->out_w, oh = lb->out_h;
+    const int32_t x1 = lb->pad_x + lb->new_w, y1 = lb->pad_y + lb->new_h;
+    const int32_t planes = format == IMAGE_FMT_U8_HWC ? 1 : 3;
+    const int32_t px_w = format == IMAGE_FMT_U8_HWC ? 3 : 1;  /* 행 안 한 픽셀의 원소 수 */
+    const float pad_f = (float)LB_PAD_VALUE / 255.0f;
+    for (int32_t c = 0; c < planes; c++) {
+        for (int32_t y = 0; y < oh; y++) {
+            const int32_t full = y < lb->pad_y || y >= y1;
+            const size_t row = ((size_t)c * oh + y) * ow * px_w;
+            /* 구간 [a, b) (원소 단위) */
+            const int32_t seg[2][2] = {{0, full ? ow * px_w : lb->pad_x * px_w}, {full ? 0 : x1 * px_w, full ? 0 : ow * px_w}};
+            for (int32_t s = 0; s < 2; s++) {
+                if (format == IMAGE_FMT_F32_CHW) {
+                    float* d = (float*)dst + row;
+                    for (int32_t i = seg[s][0]; i < seg[s][1]; i++) d[i] = pad_f;
+                } else {
+                    memset((uint8_t*)dst + row + seg[s][0], LB_PAD_VALUE, (size_t)(seg[s][1] - seg[s][0]));
+                }
+            }
+        }
+    }
+}
+
+int letterbox_run(letterbox_t* lb, const uint8_t* rgb, int32_t rgb_stride, uint32_t format,
+                  void* dst, preprocessed_image_t* img) {
+    if (!lb || !lb->acc || !rgb || !dst || !img || format > IMAGE_FMT_U8_HWC) return -1;
+    if (rgb_stride <= 0) rgb_stride = lb->src_w * 3;
+    const int32_t nw3 = lb->new_w * 3, ks = lb->ksize_y;
+    const size_t plane = (size_t)lb->out_h * lb->out_w;
+
+    fill_pad(lb, format, dst);
+    for (int32_t s = 0; s < ks; s++) lb->ring_row[s] = -1;
+
+    for (int32_t yy = 0; yy < lb->new_h; yy++) {
+        const int32_t ymin = lb->bounds_y[2 * yy], cnt = lb->bounds_y[2 * yy + 1];
+        const int32_t* k = lb->kk_y + (size_t)yy * ks;
+        int32_t* acc = lb->acc;
+        for (int32_t i = 0; i < nw3; i++) acc[i] = 1 << (LB_PRECISION_BITS - 1);
+        /* 세로 탭 행: 링 버퍼에 없으면 가로 패스 (ymin은 단조 증가 → 원본 행마다 가로 패스 1회) */
+        for (int32_t t = 0; t < cnt; t++) {
+            const int32_t r = ymin + t, slot = r % ks;
+            uint8_t* row = lb->ring + (size_t)slot * nw3;
+            if (lb->ring_row[slot] != r) {
+                hpass_row(lb, rgb + (size_t)r * rgb_stride, row);
+                lb->ring_row[slot] = r;
+            }
+            const int32_t kt = k[t];
+            for (int32_t i = 0; i < nw3; i++) acc[i] += row[i] * kt;
+        }
+        /* 세로 패스 결과 → dst (형식별 배치/정규화) */
+        const int32_t oy = lb->pad_y + yy, ox = lb->pad_x;
+        if (format == IMAGE_FMT_U8_HWC) {
+            uint8_t* d = (uint8_t*)dst + ((size_t)oy * lb->out_w + ox) * 3;
+            for (int32_t i = 0; i < nw3; i++) d[i] = clip8(acc[i]);
+        } else if (format == IMAGE_FMT_U8_CHW) {
+            for (int32_t c = 0; c < 3; c++) {
+                uint8_t* d = (uint8_t*)dst + c * plane + (size_t)oy * lb->out_w + ox;
+                for (int32_t x = 0; x < lb->new_w; x++) d[x] = clip8(acc[3 * x + c]);
+            }
+        } else {
+            /* Python: float32(u8) / 255.0 */
+            for (int32_t c = 0; c < 3; c++) {
+                float* d = (float*)dst + c * plane + (size_t)oy * lb->out_w + ox;
+                for (int32_t x = 0; x < lb->new_w; x++) d[x] = (float)clip8(acc[3 * x + c]) / 255.0f;
+            }
+        }
+    }
+
+    memset(img, 0, sizeof(*img));
+    img->c = 3;
+    img->h = lb->out_h;
+    img->w = lb->out_w;
+    img->original_w = lb->src_w;
+    img->original_h = lb->src_h;
+    img->scale = lb->scale;
+    img->pad_x = lb->pad_x;
+    img->pad_y = lb->pad_y;
+    img->format = format;
+    if (format == IMAGE_FMT_F32_CHW) img->data = (float*)dst;
+    else img->data_u8 = (const uint8_t*)dst;
+    img->data_owned = 0;
+    return 0;
+}
+
+#ifndef BARE_METAL
+/* PPM 헤더 정수 1개 (공백/주석 건너뜀) */
+static int ppm_read_int(FILE* f, int32_t* v) {
+    int ch = fgetc(f);
+    for (;;) {
+        while (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') ch = fgetc(f);
+        if (ch != '#') break;
+        while (ch != '\n' && ch != EOF) ch = fgetc(f);
+    }
+    if (ch < '0' || ch > '9') return -1;
+    int32_t x = 0;
+    while (ch >= '0' && ch <= '9') {
+        if (x > 0xFFFFF) return -1;
+        x = x * 10 + (ch - '0');
+        ch = fgetc(f);
+    }
+    *v = x;  /* 숫자 뒤 공백 1개는 이미 읽음 */
+    return 0;
+}
+
+int letterbox_load_ppm(const char* path, uint8_t** rgb, int32_t* w, int32_t* h) {
+    if (!path || !rgb || !w || !h) return -1;
+    *rgb = NULL;
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "Error: Cannot open PPM file: %s\n", path);
+        return -1;
+    }
+    int32_t maxval = 0;
+    if (fgetc(f) != 'P' || fgetc(f) != '6' || ppm_read_int(f, w) != 0 || ppm_read_int(f, h) != 0 ||
+        ppm_read_int(f, &maxval) != 0 || maxval != 255 || *w <= 0 || *h <= 0) {
+        fprintf(stderr, "Error: Not a binary 8-bit PPM (P6): %s\n", path);
+        fclose(f);
+        return -1;
+    }
+    const size_t bytes = (size_t)*w * (size_t)*h * 3;
+    *rgb = (uint8_t*)malloc(bytes);
+    if (!*rgb || fread(*rgb, 1, bytes, f) != bytes) {
+        free(*rgb);
+        *rgb = NULL;
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+    return 0;
+}
+#endif
@@ -0,0 +1,56 @@
+/**
+ * Letterbox 전처리 (C): 인터리브 RGB 프레임 → 비율 유지 bilinear 리사이즈 + 114 패딩 → L0 입력 (image_loader 형식).
+ * tools/preprocess_image_to_bin.py (PIL Image.resize BILINEAR)와 같은 알고리즘:
+ *   축소 시 필터 폭을 scale배로 넓힌 삼각 필터, 22비트 고정소수점 계수, 가로 → 세로 2패스 (패스마다 uint8 반올림).
+ *   → 정수 연산이라 출력 픽셀이 PIL과 비트 동일.
+ * 계수/경계는 init에서 프레임 크기별 1회. run은 힙 할당 없음:
+ *   가로 패스 결과는 세로 탭 수만큼의 링 버퍼 행, 세로 패스는 행 전체 int32 누적 (연속 접근 → 자동 벡터화).
+ * 출력은 dst에 바로 (FP32 CHW는 /255 정규화까지, uint8 CHW/HWC는 L0가 /255를 접어 읽음).
+ */
+#ifndef LETTERBOX_H
+#define LETTERBOX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "image_loader.h"
+
+typedef struct {
+    int32_t src_w, src_h;        /* 입력 프레임 */
+    int32_t new_w, new_h;        /* 리사이즈 크기 (비율 유지) */
+    int32_t out_w, out_h;        /* 출력 (정사각형 size, rect면 각 변 32의 배수) */
+    int32_t pad_x, pad_y;        /* 리사이즈 영역 위치 */
+    float scale;
+    int32_t ksize_x, ksize_y;    /* 출력 픽셀당 최대 탭 수 */
+    int32_t* bounds_x;           /* [2*new_w]: 시작 열, 탭 수 */
+    int32_t* bounds_y;           /* [2*new_h]: 시작 행, 탭 수 */
+    int32_t* kk_x;               /* [new_w * ksize_x] 고정소수점 계수 */
+    int32_t* kk_y;               /* [new_h * ksize_y] */
+    uint8_t* ring;               /* 가로 패스 행 ksize_y개 (new_w x 3) */
+    int32_t* ring_row;           /* 슬롯별 원본 행 번호 (-1: 비어 있음) */
+    int32_t* acc;                /* 세로 패스 누적 new_w x 3 */
+} letterbox_t;
+
+/**
+ * src_w x src_h 프레임 → size (긴 변) letterbox 준비. rect=0: size x size, rect=1: 각 변 32의 배수로만 패딩.
+ * 0 성공, -1 실패 (크기 0/65535 초과, 메모리)
+ */
+int letterbox_init(letterbox_t* lb, int32_t src_w, int32_t src_h, int32_t size, int rect);
+
+/** format(IMAGE_FMT_*) 출력 바이트 수 (out_h x out_w x 3 x 1 또는 4) */
+size_t letterbox_out_bytes(const letterbox_t* lb, uint32_t format);
+
+/**
+ * rgb: 인터리브 RGB, 행 간격 rgb_stride 바이트 (0이면 src_w*3). dst: letterbox_out_bytes 이상.
+ * img: dst를 참조하는 preprocessed_image_t (data_owned 0, 헤더 필드는 Python 도구와 같음). 0 성공, -1 실패
+ */
+int letterbox_run(letterbox_t* lb, const uint8_t* rgb, int32_t rgb_stride, uint32_t format,
+                  void* dst, preprocessed_image_t* img);
+
+void letterbox_free(letterbox_t* lb);
+
+#ifndef BARE_METAL
+/** 바이너리 PPM (P6, maxval 255) → 인터리브 RGB (malloc, free로 해제). 0 성공, -1 실패 */
+int letterbox_load_ppm(const char* path, uint8_t** rgb, int32_t* w, int32_t* h);
+#endif
+
+#endif /* LETTERBOX_H */
@@ -62,6 +62,7 @@ static inline uint64_t host_time_us(void) {
     return (uint64_t)((double)c.QuadPart * 1000000.0 / (double)freq.QuadPart);
 }
 #else
+#include <stddef.h>
 #include <sys/time.h>
 static inline uint64_t host_time_us(void) {
     struct timeval tv;
@@ -0,0 +1,238 @@
+/**
+ * 피처맵 정적 메모리 계획: 이벤트 기록 + greedy-by-size 오프셋 배치
+ */
+#include "mem_plan.h"
+#include "../operations/halo.h"
+
+static inline size_t plan_align(size_t x) {
+    return (x + MEM_PLAN_ALIGN - 1u) & ~(size_t)(MEM_PLAN_ALIGN - 1u);
+}
+
+void mem_plan_init(mem_plan_t* plan) {
+    if (!plan) return;
+    plan->num_tensors = 0;
+    plan->num_events = 0;
+    plan->peak = 0;
+    plan->live_peak = 0;
+    plan->error = 0;
+}
+
+int32_t mem_plan_alloc(mem_plan_t* plan, size_t size) {
+    if (!plan) return -1;
+    if (plan->num_tensors >= MEM_PLAN_MAX_TENSORS || plan->num_events >= MEM_PLAN_MAX_EVENTS || size == 0) {
+        plan->error = 1;
+        return -1;
+    }
+    const int32_t id = plan->num_tensors++;
+    mem_plan_tensor_t* t = &plan->tensors[id];
+    t->size = size;
+    t->offset = 0;
+    t->first = plan->num_events;
+    t->last = -1;
+    plan->events[plan->num_events++] = id;
+    return id;
+}
+
+void mem_plan_free(mem_plan_t* plan, int32_t id) {
+    if (!plan) return;
+    if (id < 0 || id >= plan->num_tensors || plan->tensors[id].last >= 0 ||
+        plan->num_events >= MEM_PLAN_MAX_EVENTS) {
+        plan->error = 1;
+        return;
+    }
+    plan->tensors[id].last = plan->num_events;
+    plan->events[plan->num_events++] = ~id;
+}
+
+static inline int lifetimes_overlap(const mem_plan_tensor_t* a, const mem_plan_tensor_t* b) {
+    return a->first <= b->last && b->first <= a->last;
+}
+
+int mem_plan_assign(mem_plan_t* plan) {
+    if (!plan || plan->error) return -1;
+    const int32_t nt = plan->num_tensors;
+    mem_plan_tensor_t* t = plan->tensors;
+    for (int32_t i = 0; i < nt; i++) {
+        if (t[i].last < 0) t[i].last = plan->num_events;  /* 끝까지 살아있음 */
+    }
+
+    /* 배치 순서: 크기 내림차순 (동률은 먼저 할당된 것부터) */
+    int32_t order[MEM_PLAN_MAX_TENSORS];
+    for (int32_t i = 0; i < nt; i++) {
+        int32_t j = i;
+        while (j > 0 && (t[order[j - 1]].size < t[i].size ||
+                         (t[order[j - 1]].size == t[i].size && t[order[j - 1]].first > t[i].first))) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    /* 이미 배치된 텐서 중 수명이 겹치는 것들을 offset 순으로 훑어 가장 낮은 빈틈에 배치 */
+    int32_t conflict[MEM_PLAN_MAX_TENSORS];
+    size_t peak = 0;
+    for (int32_t k = 0; k < nt; k++) {
+        mem_plan_tensor_t* cur = &t[order[k]];
+        const size_t need = plan_align(cur->size);
+        int32_t nc = 0;
+        for (int32_t p = 0; p < k; p++) {
+            const mem_plan_tensor_t* o = &t[order[p]];
+            if (!lifetimes_overlap(cur, o)) continue;
+            int32_t j = nc++;
+            while (j > 0 && t[conflict[j - 1]].offset > o->offset) {
+                conflict[j] = conflict[j - 1];
+                j--;
+            }
+            conflict[j] = order[p];
+        }
+        size_t off = 0;
+        for (int32_t c = 0; c < nc; c++) {
+            const mem_plan_tensor_t* o = &t[conflict[c]];
+            if (off + need <= o->offset) break;
+            const size_t end = o->offset + plan_align(o->size);
+            if (end > off) off = end;
+        }
+        cur->offset = off;
+        if (off + need > peak) peak = off + need;
+    }
+    plan->peak = peak;
+
+    size_t live = 0, live_peak = 0;
+    for (int32_t e = 0; e < plan->num_events; e++) {
+        const int32_t ev = plan->events[e];
+        if (ev >= 0) {
+            live += plan_align(t[ev].size);
+            if (live > live_peak) live_peak = live;
+        } else {
+            live -= plan_align(t[~ev].size);
+        }
+    }
+    plan->live_peak = live_peak;
+    return 0;
+}
+
+/* ===== YOLOv5n 그래프 (alloc/free 순서는 main.c 및 각 블록 구현과 동일해야 함) ===== */
+
+static size_t fmap_bytes(int32_t n, int32_t c, int32_t h, int32_t w) {
+    return (size_t)n * (size_t)c * (size_t)h * (size_t)w * sizeof(float);
+}
+
+/* halo 레이아웃 피처맵 (main.c l0/l2/l4/l6/l17/l20, bottleneck cv1_out) */
+static size_t halo_bytes(int32_t n, int32_t c, int32_t h, int32_t w) {
+    return HALO_BYTES(n, c, h, w, FMAP_HALO);
+}
+
+/* bottleneck_nchw_f32: cv1_out(halo), cv2_out */
+static void plan_bottleneck(mem_plan_t* p, int32_t n, int32_t c1, int32_t c2, int32_t h, int32_t w) {
+    const int32_t a = mem_plan_alloc(p, halo_bytes(n, c1, h, w));
+    const int32_t b = mem_plan_alloc(p, fmap_bytes(n, c2, h, w));
+    mem_plan_free(p, b);
+    mem_plan_free(p, a);
+}
+
+/* c3_nchw_f32(_merged): concat (cv1/cv2 출력과 마지막 bottleneck 출력이 채널 구간으로 들어감),
+ * 중간 bottleneck 출력 bn_a (nb > 1), bn_b (nb > 2) + bottleneck × nb (cv1_c_out == cv2_c_out == c_) */
+static void plan_c3(mem_plan_t* p, int32_t n, int32_t c_, int32_t h, int32_t w, int32_t nb) {
+    const int32_t cat = mem_plan_alloc(p, fmap_bytes(n, 2 * c_, h, w));
+    const int32_t bn_a = nb > 1 ? mem_plan_alloc(p, fmap_bytes(n, c_, h, w)) : -1;
+    const int32_t bn_b = nb > 2 ? mem_plan_alloc(p, fmap_bytes(n, c_, h, w)) : -1;
+    for (int32_t i = 0; i < nb; i++) plan_bottleneck(p, n, c_, c_, h, w);
+    if (bn_b >= 0) mem_plan_free(p, bn_b);
+    if (bn_a >= 0) mem_plan_free(p, bn_a);
+    mem_plan_free(p, cat);
+}
+
+/* sppf_nchw_f32: cat (cv1·풀링 출력이 채널 구간으로 들어감), 풀링 행 scratch */
+static void plan_sppf(mem_plan_t* p, int32_t n, int32_t c_, int32_t h, int32_t w) {
+    const int32_t cat = mem_plan_alloc(p, fmap_bytes(n, 4 * c_, h, w));
+    const int32_t tmp = mem_plan_alloc(p, (size_t)(2 * w) * sizeof(float));
+    mem_plan_free(p, tmp);
+    mem_plan_free(p, cat);
+}
+
+int mem_plan_build_yolov5n(mem_plan_t* p, int32_t n, int head_in_pool) {
+    return mem_plan_build_yolov5n_shape(p, n, 640, 640, head_in_pool);
+}
+
+int mem_plan_build_yolov5n_shape(mem_plan_t* p, int32_t n, int32_t in_h, int32_t in_w, int head_in_pool) {
+    if (!p || n <= 0 || in_h <= 0 || in_w <= 0 || in_h % 32 != 0 || in_w % 32 != 0) return -1;
+    mem_plan_init(p);
+    /* stride 2/4/8/16/32 출력 크기 */
+    const int32_t h2 = in_h / 2, w2 = in_w / 2, h4 = in_h / 4, w4 = in_w / 4, h8 = in_h / 8, w8 = in_w / 8;
+    const int32_t h16 = in_h / 16, w16 = in_w / 16, h32 = in_h / 32, w32 = in_w / 32;
+
+    /* Backbone */
+    const int32_t l0 = mem_plan_alloc(p, halo_bytes(n, 16, h2, w2));
+    const int32_t l1 = mem_plan_alloc(p, fmap_bytes(n, 32, h4, w4));
+    mem_plan_free(p, l0);
+    const int32_t l2 = mem_plan_alloc(p, halo_bytes(n, 32, h4, w4));
+    plan_c3(p, n, 16, h4, w4, 1);
+    mem_plan_free(p, l1);
+    const int32_t l3 = mem_plan_alloc(p, fmap_bytes(n, 64, h8, w8));
+    mem_plan_free(p, l2);
+    const int32_t l4 = mem_plan_alloc(p, halo_bytes(n, 64, h8, w8));
+    plan_c3(p, n, 32, h8, w8, 2);
+    mem_plan_free(p, l3);
+    const int32_t l5 = mem_plan_alloc(p, fmap_bytes(n, 128, h16, w16));
+    const int32_t l6 = mem_plan_alloc(p, halo_bytes(n, 128, h16, w16));
+    plan_c3(p, n, 64, h16, w16, 3);
+    mem_plan_free(p, l5);
+    const int32_t l7 = mem_plan_alloc(p, fmap_bytes(n, 256, h32, w32));
+    const int32_t l8 = mem_plan_alloc(p, fmap_bytes(n, 256, h32, w32));
+    plan_c3(p, n, 128, h32, w32, 1);
+    mem_plan_free(p, l7);
+    const int32_t l9 = mem_plan_alloc(p, fmap_bytes(n, 256, h32, w32));
+    plan_sppf(p, n, 128, h32, w32);
+    mem_plan_free(p, l8);
+
+    /* Neck */
+    const int32_t l10 = mem_plan_alloc(p, fmap_bytes(n, 128, h32, w32));
+    mem_plan_free(p, l9);
+    const int32_t l11 = mem_plan_alloc(p, fmap_bytes(n, 128, h16, w16));
+    const int32_t l12 = mem_plan_alloc(p, fmap_bytes(n, 256, h16, w16));
+    mem_plan_free(p, l11);
+    mem_plan_free(p, l6);
+    const int32_t l13 = mem_plan_alloc(p, fmap_bytes(n, 128, h16, w16));
+    plan_c3(p, n, 64, h16, w16, 1);
+    mem_plan_free(p, l12);
+    const int32_t l14 = mem_plan_alloc(p, fmap_bytes(n, 64, h16, w16));
+    mem_plan_free(p, l13);
+    const int32_t l15 = mem_plan_alloc(p, fmap_bytes(n, 64, h8, w8));
+    const int32_t l16 = mem_plan_alloc(p, fmap_bytes(n, 128, h8, w8));
+    mem_plan_free(p, l15);
+    mem_plan_free(p, l4);
+    const int32_t l17 = mem_plan_alloc(p, halo_bytes(n, 64, h8, w8));
+    plan_c3(p, n, 32, h8, w8, 1);
+    mem_plan_free(p, l16);
+    const int32_t l18 = mem_plan_alloc(p, fmap_bytes(n, 64, h16, w16));
+    const int32_t l19 = mem_plan_alloc(p, fmap_bytes(n, 128, h16, w16));
+    mem_plan_free(p, l18);
+    mem_plan_free(p, l14);
+    const int32_t l20 = mem_plan_alloc(p, halo_bytes(n, 128, h16, w16));
+    plan_c3(p, n, 64, h16, w16, 1);
+    mem_plan_free(p, l19);
+    const int32_t l21 = mem_plan_alloc(p, fmap_bytes(n, 128, h32, w32));
+    const int32_t l22 = mem_plan_alloc(p, fmap_bytes(n, 256, h32, w32));
+    mem_plan_free(p, l21);
+    mem_plan_free(p, l10);
+    const int32_t l23 = mem_plan_alloc(p, fmap_bytes(n, 256, h32, w32));
+    plan_c3(p, n, 128, h32, w32, 1);
+    mem_plan_free(p, l22);
+
+    /* Detect head */
+    int32_t p3 = -1, p4 = -1, p5 = -1;
+    if (head_in_pool) {
+        p3 = mem_plan_alloc(p, fmap_bytes(n, 255, h8, w8));
+        p4 = mem_plan_alloc(p, fmap_bytes(n, 255, h16, w16));
+        p5 = mem_plan_alloc(p, fmap_bytes(n, 255, h32, w32));
+    }
+    mem_plan_free(p, l17);
+    mem_plan_free(p, l20);
+    mem_plan_free(p, l23);
+    if (head_in_pool) {
+        mem_plan_free(p, p3);
+        mem_plan_free(p, p4);
+        mem_plan_free(p, p5);
+    }
+    return mem_plan_assign(p);
+}
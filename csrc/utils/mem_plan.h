@@ -0,0 +1,55 @@
+/**
+ * 피처맵 정적 메모리 계획 (liveness 기반 오프셋 할당).
+ * 그래프의 alloc/free 순서(블록 내부 임시 버퍼 포함)를 이벤트 열로 기록 →
+ * 텐서별 수명 [first, last] 계산 → 크기 큰 순 greedy로 오프셋 배치해 peak 최소화.
+ * feature_pool_use_plan()으로 적용하면 실행 중 alloc은 O(1) (base + offset).
+ */
+#ifndef MEM_PLAN_H
+#define MEM_PLAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MEM_PLAN_MAX_TENSORS 128
+#define MEM_PLAN_MAX_EVENTS  (2 * MEM_PLAN_MAX_TENSORS)
+#define MEM_PLAN_ALIGN       64u   /* FEATURE_POOL_ALIGN과 동일 */
+
+typedef struct {
+    size_t size;      /* 요청 바이트 (재생 시 크기 검증용, 정렬 전) */
+    size_t offset;    /* 풀 base 기준 (MEM_PLAN_ALIGN 정렬) */
+    int32_t first;    /* alloc 이벤트 번호 */
+    int32_t last;     /* free 이벤트 번호 (해제 안 되면 num_events) */
+} mem_plan_tensor_t;
+
+/* 텐서 id = alloc 순서 = 실행 시 feature_pool_alloc 호출 순서 */
+typedef struct mem_plan {
+    mem_plan_tensor_t tensors[MEM_PLAN_MAX_TENSORS];
+    int32_t events[MEM_PLAN_MAX_EVENTS];  /* id >= 0: alloc, ~id (< 0): free */
+    int32_t num_tensors;
+    int32_t num_events;
+    size_t peak;       /* 계획된 풀 사용량 (max offset + size) */
+    size_t live_peak;  /* 동시에 살아있는 바이트 최대 (peak 하한) */
+    int error;         /* 기록 중 용량 초과/잘못된 free → 1 */
+} mem_plan_t;
+
+void mem_plan_init(mem_plan_t* plan);
+
+/** alloc 이벤트 기록. 반환: 텐서 id (실패 -1) */
+int32_t mem_plan_alloc(mem_plan_t* plan, size_t size);
+
+/** free 이벤트 기록 */
+void mem_plan_free(mem_plan_t* plan, int32_t id);
+
+/** 수명 겹치는 텐서끼리 주소가 겹치지 않게 오프셋 배치 (greedy by size). 0 성공, -1 실패 */
+int mem_plan_assign(mem_plan_t* plan);
+
+/**
+ * YOLOv5n 그래프(main.c 레이어 순서, C3/SPPF/Bottleneck 내부 임시 버퍼 포함) 기록 + 배치.
+ * head_in_pool: Detect 출력 p3/p4/p5도 풀에서 할당하면 1 (호스트), DETECT_HEAD_BASE 쓰면 0.
+ */
+int mem_plan_build_yolov5n(mem_plan_t* plan, int32_t n, int head_in_pool);
+
+/** 입력 in_h x in_w (32의 배수) 그래프. mem_plan_build_yolov5n은 640x640 */
+int mem_plan_build_yolov5n_shape(mem_plan_t* plan, int32_t n, int32_t in_h, int32_t in_w, int head_in_pool);
+
+#endif /* MEM_PLAN_H */
@@ -0,0 +1,158 @@
+/**
+ * First-fit 할당자 (기존 feature_pool 구현을 영역 파라미터화)
+ * 블록 오프셋·크기는 ALIGN 배수, base + HEADER_SIZE가 ALIGN 정렬 → payload 64B 정렬.
+ */
+#include "pool_first_fit.h"
+
+#define ALIGN ((size_t)POOL_FF_ALIGN)
+#ifdef BARE_METAL
+#define HEADER_SIZE 8u
+#else
+#define HEADER_SIZE (2u * (size_t)sizeof(size_t))
+#endif
+#define MIN_SPLIT ALIGN
+#define NIL ((size_t)-1)
+
+static inline size_t align_up(size_t x, size_t a) {
+    return (x + a - 1) & ~(a - 1);
+}
+
+void pool_ff_init(pool_ff_t* p, void* base, size_t size) {
+    const size_t pad = base ? (ALIGN - (((uintptr_t)base + HEADER_SIZE) & (ALIGN - 1u))) & (ALIGN - 1u) : 0;
+    p->base = (uint8_t*)base;
+    p->size = (base && size >= pad + ALIGN) ? (size - pad) & ~(ALIGN - 1u) : 0;
+    p->free_head = NIL;
+    p->high_water = 0;
+    if (p->size) {
+        p->base += pad;
+        size_t* hdr = (size_t*)(p->base + 0);
+        hdr[0] = p->size;
+        hdr[1] = NIL;
+        p->free_head = 0;
+    }
+}
+
+void* pool_ff_alloc(pool_ff_t* p, size_t size) {
+    uint8_t* const pool_base = p->base;
+    if (!pool_base || size == 0) return NULL;
+    size_t need = align_up(size + HEADER_SIZE, ALIGN);
+    if (need > p->size) return NULL;
+
+    size_t prev = NIL;
+    size_t curr = p->free_head;
+    while (curr != NIL) {
+        size_t* blk = (size_t*)(pool_base + curr);
+        size_t blk_size = blk[0];
+        size_t next = blk[1];
+        if (blk_size >= need) {
+            if (blk_size >= need + MIN_SPLIT) {
+                size_t rest = blk_size - need;
+                blk[0] = need;
+                size_t* rest_blk = (size_t*)(pool_base + curr + need);
+                rest_blk[0] = rest;
+                rest_blk[1] = next;
+                if (prev == NIL)
+                    p->free_head = curr + need;
+                else
+                    ((size_t*)(pool_base + prev))[1] = curr + need;
+            } else {
+                if (prev == NIL)
+                    p->free_head = next;
+                else
+                    ((size_t*)(pool_base + prev))[1] = next;
+            }
+            if (curr + blk[0] > p->high_water) p->high_water = curr + blk[0];
+            return (void*)(pool_base + curr + HEADER_SIZE);
+        }
+        prev = curr;
+        curr = next;
+    }
+    return NULL;
+}
+
+static void unlink_free_block(pool_ff_t* p, size_t target, size_t prev_of_target) {
+    size_t next = ((size_t*)(p->base + target))[1];
+    if (prev_of_target == NIL)
+        p->free_head = next;
+    else
+        ((size_t*)(p->base + prev_of_target))[1] = next;
+}
+
+static void insert_free_by_address(pool_ff_t* p, size_t curr, size_t curr_size) {
+    size_t* blk = (size_t*)(p->base + curr);
+    blk[0] = curr_size;
+    size_t prev_link = NIL;
+    size_t w = p->free_head;
+    while (w != NIL && w < curr) {
+        prev_link = w;
+        w = ((size_t*)(p->base + w))[1];
+    }
+    blk[1] = w;
+    if (prev_link == NIL)
+        p->free_head = curr;
+    else
+        ((size_t*)(p->base + prev_link))[1] = curr;
+}
+
+void pool_ff_free(pool_ff_t* p, void* ptr) {
+    uint8_t* const pool_base = p->base;
+    if (!ptr || !pool_base) return;
+    uint8_t* q = (uint8_t*)ptr;
+    if (q < pool_base + HEADER_SIZE || q >= pool_base + p->size) return;
+    size_t curr = (size_t)(q - pool_base - HEADER_SIZE);
+    size_t* blk = (size_t*)(pool_base + curr);
+    size_t curr_size = blk[0];
+
+    insert_free_by_address(p, curr, curr_size);
+    size_t prev_link = NIL;
+    size_t w = p->free_head;
+    while (w != NIL && w != curr) {
+        prev_link = w;
+        w = ((size_t*)(pool_base + w))[1];
+    }
+    size_t base = curr;
+    size_t base_size = curr_size;
+    size_t* base_blk = blk;
+    if (prev_link != NIL) {
+        size_t* pl = (size_t*)(pool_base + prev_link);
+        if (prev_link + pl[0] == curr) {
+            pl[0] += curr_size;
+            unlink_free_block(p, curr, prev_link);
+            base = prev_link;
+            base_size = pl[0];
+            base_blk = pl;
+        }
+    }
+
+    size_t next_in_list = base_blk[1];
+    if (next_in_list != NIL) {
+        size_t* nl = (size_t*)(pool_base + next_in_list);
+        if (base + base_size == next_in_list) {
+            base_blk[0] = base_size + nl[0];
+            unlink_free_block(p, next_in_list, base);
+        }
+    }
+}
+
+size_t pool_ff_largest_free(const pool_ff_t* p) {
+    size_t max_free = 0;
+    if (!p->base) return 0;
+    size_t curr = p->free_head;
+    while (curr != NIL) {
+        size_t* blk = (size_t*)(p->base + curr);
+        size_t blk_size = blk[0];
+        if (blk_size > max_free) max_free = blk_size;
+        curr = blk[1];
+    }
+    return max_free;
+}
+
+void pool_ff_free_stats(const pool_ff_t* p, size_t* free_blocks, size_t* total_free) {
+    size_t count = 0, total = 0;
+    for (size_t curr = p->base ? p->free_head : NIL; curr != NIL; curr = ((size_t*)(p->base + curr))[1]) {
+        count++;
+        total += ((size_t*)(p->base + curr))[0];
+    }
+    if (free_blocks) *free_blocks = count;
+    if (total_free) *total_free = total;
+}
@@ -0,0 +1,33 @@
+/**
+ * First-fit 풀 할당자 (주소순 free list, free 시 인접 블록 병합).
+ * 영역(base/size)은 호출자 소유: 호스트 malloc 버퍼, BARE_METAL DDR 영역 모두 가능.
+ * feature_pool의 FEATURE_POOL_FIRST_FIT 백엔드 + 할당자 비교 벤치마크 기준.
+ * 반환 포인터는 POOL_FF_ALIGN(64B) 정렬.
+ */
+#ifndef POOL_FIRST_FIT_H
+#define POOL_FIRST_FIT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef POOL_FF_ALIGN
+#define POOL_FF_ALIGN 64u
+#endif
+
+typedef struct {
+    uint8_t* base;       /* 블록 0 위치 (payload 정렬되도록 init에서 앞을 잘라냄) */
+    size_t size;
+    size_t free_head;    /* 첫 free 블록 오프셋 (없으면 (size_t)-1) */
+    size_t high_water;   /* base 기준 최대 사용 끝 오프셋 */
+} pool_ff_t;
+
+void pool_ff_init(pool_ff_t* p, void* base, size_t size);
+void* pool_ff_alloc(pool_ff_t* p, size_t size);
+void pool_ff_free(pool_ff_t* p, void* ptr);
+/** 가장 큰 free 블록 크기 (헤더 포함) */
+size_t pool_ff_largest_free(const pool_ff_t* p);
+
+/** 진단용: free 블록 수 / free 블록 크기 합 (헤더 포함, largest_free와 같은 기준. free list 순회) */
+void pool_ff_free_stats(const pool_ff_t* p, size_t* free_blocks, size_t* total_free);
+
+#endif /* POOL_FIRST_FIT_H */
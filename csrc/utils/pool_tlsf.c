@@ -0,0 +1,212 @@
+/**
+ * TLSF 풀 할당자 (오프셋 기반, O(1) alloc/free, 즉시 병합)
+ *
+ * 블록 = [prev_phys | size|FREE] + payload. free 블록 payload 앞부분에 next/prev free 오프셋.
+ * 블록 오프셋·크기는 ALIGN 배수, base + HDR가 ALIGN 정렬 → 모든 payload가 ALIGN 정렬.
+ * 영역 끝에는 크기 0의 사용 중 sentinel 헤더를 두어 다음 블록 병합 시 경계 검사 생략.
+ */
+#include "pool_tlsf.h"
+
+#define ALIGN ((size_t)POOL_TLSF_ALIGN)
+#define NIL ((size_t)-1)
+#define FLAG_FREE ((size_t)1)
+#define HDR (2u * (size_t)sizeof(size_t))
+#define MIN_BLOCK ALIGN  /* >= HDR + next/prev free */
+#define SMALL_BLOCK ((size_t)1 << POOL_TLSF_FL_SHIFT)
+
+typedef struct {
+    size_t prev_phys;   /* 물리적으로 이전 블록 오프셋 (첫 블록은 NIL) */
+    size_t size_flags;  /* 헤더 포함 블록 크기 | FLAG_FREE */
+    size_t next_free;   /* free일 때만 유효 (payload 영역) */
+    size_t prev_free;
+} tlsf_block_t;
+
+static inline size_t align_up(size_t x, size_t a) {
+    return (x + a - 1) & ~(a - 1);
+}
+
+static inline int tlsf_fls(size_t x) {
+#if defined(__GNUC__)
+    return (int)(sizeof(unsigned long) * 8u - 1u) - __builtin_clzl((unsigned long)x);
+#else
+    int r = -1;
+    while (x) { x >>= 1; r++; }
+    return r;
+#endif
+}
+
+static inline int tlsf_ffs(uint32_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    int r = 0;
+    while (!(x & 1u)) { x >>= 1; r++; }
+    return r;
+#endif
+}
+
+static inline tlsf_block_t* blk(const pool_tlsf_t* p, size_t off) {
+    return (tlsf_block_t*)(p->base + off);
+}
+
+static inline size_t blk_size(const tlsf_block_t* b) {
+    return b->size_flags & ~(ALIGN - 1u);
+}
+
+/* 블록 크기 → (fl, sl) */
+static inline void mapping(size_t size, int* fl, int* sl) {
+    if (size < SMALL_BLOCK) {
+        *fl = 0;
+        *sl = (int)(size / (SMALL_BLOCK / POOL_TLSF_SL_COUNT));
+    } else {
+        const int f = tlsf_fls(size);
+        *sl = (int)(size >> (f - POOL_TLSF_SL_LOG2)) - POOL_TLSF_SL_COUNT;
+        *fl = f - POOL_TLSF_FL_SHIFT + 1;
+    }
+}
+
+static void insert_free(pool_tlsf_t* p, size_t off) {
+    tlsf_block_t* b = blk(p, off);
+    int fl, sl;
+    mapping(blk_size(b), &fl, &sl);
+    const size_t head = p->heads[fl][sl];
+    b->next_free = head;
+    b->prev_free = NIL;
+    if (head != NIL) blk(p, head)->prev_free = off;
+    p->heads[fl][sl] = off;
+    p->fl_bitmap |= 1u << fl;
+    p->sl_bitmap[fl] |= 1u << sl;
+    p->free_blocks++;
+    p->free_bytes += blk_size(b) - HDR;
+}
+
+static void remove_free(pool_tlsf_t* p, size_t off) {
+    tlsf_block_t* b = blk(p, off);
+    int fl, sl;
+    mapping(blk_size(b), &fl, &sl);
+    if (b->prev_free != NIL) blk(p, b->prev_free)->next_free = b->next_free;
+    else p->heads[fl][sl] = b->next_free;
+    if (b->next_free != NIL) blk(p, b->next_free)->prev_free = b->prev_free;
+    if (p->heads[fl][sl] == NIL) {
+        p->sl_bitmap[fl] &= ~(1u << sl);
+        if (!p->sl_bitmap[fl]) p->fl_bitmap &= ~(1u << fl);
+    }
+    p->free_blocks--;
+    p->free_bytes -= blk_size(b) - HDR;
+}
+
+void pool_tlsf_init(pool_tlsf_t* p, void* base, size_t size) {
+    p->base = (uint8_t*)base;
+    p->fl_bitmap = 0;
+    p->high_water = 0;
+    p->free_blocks = 0;
+    p->free_bytes = 0;
+    for (int f = 0; f < POOL_TLSF_FL_COUNT; f++) {
+        p->sl_bitmap[f] = 0;
+        for (int s = 0; s < POOL_TLSF_SL_COUNT; s++) p->heads[f][s] = NIL;
+    }
+    p->size = 0;
+    if (!base) return;
+    /* 앞을 잘라 payload(base + HDR) 정렬, 블록 영역은 ALIGN 배수 + sentinel 헤더 */
+    const size_t pad = (ALIGN - (((uintptr_t)base + HDR) & (ALIGN - 1u))) & (ALIGN - 1u);
+    if (size < pad + MIN_BLOCK + HDR) return;
+    p->base += pad;
+    size -= pad;
+    const size_t max_size = (size_t)1 << POOL_TLSF_FL_MAX;
+    if (size > max_size - ALIGN) size = max_size - ALIGN;
+    const size_t sentinel = (size - HDR) & ~(ALIGN - 1u);
+    p->size = sentinel + HDR;
+
+    tlsf_block_t* first = blk(p, 0);
+    first->prev_phys = NIL;
+    first->size_flags = sentinel | FLAG_FREE;
+    tlsf_block_t* end = blk(p, sentinel);
+    end->prev_phys = 0;
+    end->size_flags = 0;  /* 크기 0, 사용 중 */
+    insert_free(p, 0);
+}
+
+void* pool_tlsf_alloc(pool_tlsf_t* p, size_t size) {
+    if (!p->size || size == 0 || size > p->size) return NULL;
+    const size_t need = align_up(size + HDR, ALIGN);
+
+    /* 리스트의 어느 블록이든 need 이상이 되도록 다음 2단 구간으로 올림 */
+    size_t search = need;
+    if (search >= SMALL_BLOCK) search += ((size_t)1 << (tlsf_fls(search) - POOL_TLSF_SL_LOG2)) - 1u;
+    int fl, sl;
+    mapping(search, &fl, &sl);
+    if (fl >= POOL_TLSF_FL_COUNT) return NULL;
+
+    uint32_t sl_map = p->sl_bitmap[fl] & (~0u << sl);
+    if (!sl_map) {
+        const uint32_t fl_map = (fl + 1 < 32) ? (p->fl_bitmap & (~0u << (fl + 1))) : 0u;
+        if (!fl_map) return NULL;
+        fl = tlsf_ffs(fl_map);
+        sl_map = p->sl_bitmap[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+
+    const size_t off = p->heads[fl][sl];
+    remove_free(p, off);
+    tlsf_block_t* b = blk(p, off);
+    const size_t bsize = blk_size(b);
+    if (bsize - need >= MIN_BLOCK) {
+        const size_t rest = off + need;
+        tlsf_block_t* r = blk(p, rest);
+        r->prev_phys = off;
+        r->size_flags = (bsize - need) | FLAG_FREE;
+        blk(p, rest + (bsize - need))->prev_phys = rest;
+        b->size_flags = need;
+        insert_free(p, rest);
+    } else {
+        b->size_flags = bsize;
+    }
+    if (off + blk_size(b) > p->high_water) p->high_water = off + blk_size(b);
+    return (void*)(p->base + off + HDR);
+}
+
+void pool_tlsf_free(pool_tlsf_t* p, void* ptr) {
+    if (!ptr || !p->size) return;
+    uint8_t* q = (uint8_t*)ptr;
+    if (q < p->base + HDR || q >= p->base + p->size) return;
+    size_t off = (size_t)(q - p->base) - HDR;
+    tlsf_block_t* b = blk(p, off);
+    if (b->size_flags & FLAG_FREE) return;  /* 이중 free 무시 */
+    size_t size = blk_size(b);
+
+    /* 이전/다음 물리 블록이 free면 리스트에서 빼고 합침 */
+    if (b->prev_phys != NIL) {
+        tlsf_block_t* prev = blk(p, b->prev_phys);
+        if (prev->size_flags & FLAG_FREE) {
+            remove_free(p, b->prev_phys);
+            off = b->prev_phys;
+            size += blk_size(prev);
+            b = prev;
+        }
+    }
+    tlsf_block_t* next = blk(p, off + size);
+    if (next->size_flags & FLAG_FREE) {
+        remove_free(p, off + size);
+        size += blk_size(next);
+    }
+    b->size_flags = size | FLAG_FREE;
+    blk(p, off + size)->prev_phys = off;
+    insert_free(p, off);
+}
+
+size_t pool_tlsf_largest_free(const pool_tlsf_t* p) {
+    if (!p->fl_bitmap) return 0;
+    const int fl = tlsf_fls(p->fl_bitmap);
+    const int sl = tlsf_fls(p->sl_bitmap[fl]);
+    size_t max_size = 0;
+    for (size_t off = p->heads[fl][sl]; off != NIL; off = blk(p, off)->next_free) {
+        const size_t s = blk_size(blk(p, off));
+        if (s > max_size) max_size = s;
+    }
+    return max_size - HDR;
+}
+
+void pool_tlsf_free_stats(const pool_tlsf_t* p, size_t* free_blocks, size_t* total_free) {
+    if (free_blocks) *free_blocks = p->free_blocks;
+    if (total_free) *total_free = p->free_bytes;
+}
@@ -0,0 +1,47 @@
+/**
+ * TLSF(Two-Level Segregated Fit) 풀 할당자.
+ * free 블록을 크기 구간별 리스트(1단: 2의 거듭제곱, 2단: 구간을 16등분)로 관리하고
+ * 비트맵 2개로 "요청 이상 크기의 비어있지 않은 리스트"를 찾으므로 alloc/free 모두 O(1).
+ * free 시 물리적으로 인접한 free 블록과 즉시 병합 (블록 헤더에 이전 블록 오프셋 보관).
+ * 영역(base/size)은 호출자 소유 (호스트 malloc 버퍼 / BARE_METAL FEATURE_POOL_BASE), 포인터 대신 오프셋 사용.
+ * 반환 포인터는 POOL_TLSF_ALIGN(64B, 캐시 라인/SIMD) 정렬: 블록 크기를 64 배수로, 헤더는 payload 바로 앞.
+ */
+#ifndef POOL_TLSF_H
+#define POOL_TLSF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef POOL_TLSF_ALIGN_LOG2
+#define POOL_TLSF_ALIGN_LOG2 6
+#endif
+#define POOL_TLSF_ALIGN     (1u << POOL_TLSF_ALIGN_LOG2)
+#define POOL_TLSF_SL_LOG2   4
+#define POOL_TLSF_SL_COUNT  (1 << POOL_TLSF_SL_LOG2)
+#define POOL_TLSF_FL_SHIFT  (POOL_TLSF_SL_LOG2 + POOL_TLSF_ALIGN_LOG2)
+#define POOL_TLSF_FL_MAX    31                        /* 영역 < 2GB */
+#define POOL_TLSF_FL_COUNT  (POOL_TLSF_FL_MAX - POOL_TLSF_FL_SHIFT + 2)
+
+typedef struct {
+    uint8_t* base;       /* 블록 0 위치 (payload가 정렬되도록 init에서 앞을 잘라냄) */
+    size_t size;         /* 관리 영역 크기 (끝 sentinel 헤더 포함) */
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[POOL_TLSF_FL_COUNT];
+    size_t heads[POOL_TLSF_FL_COUNT][POOL_TLSF_SL_COUNT];  /* free 리스트 헤드 오프셋 */
+    size_t high_water;   /* base 기준 최대 사용 끝 오프셋 */
+    size_t free_blocks;  /* free 리스트 삽입/제거 시 갱신 (계측용, O(1)) */
+    size_t free_bytes;   /* free 블록 payload 합 */
+} pool_tlsf_t;
+
+/** 영역 전체를 free 블록 하나로. 영역이 너무 작으면 이후 alloc은 NULL */
+void pool_tlsf_init(pool_tlsf_t* p, void* base, size_t size);
+void* pool_tlsf_alloc(pool_tlsf_t* p, size_t size);
+void pool_tlsf_free(pool_tlsf_t* p, void* ptr);
+
+/** 가장 큰 free 블록의 payload 바이트 (최상위 비어있지 않은 리스트만 훑음) */
+size_t pool_tlsf_largest_free(const pool_tlsf_t* p);
+
+/** free 블록 수 / free payload 합 (카운터 조회, O(1)) */
+void pool_tlsf_free_stats(const pool_tlsf_t* p, size_t* free_blocks, size_t* total_free);
+
+#endif /* POOL_TLSF_H */
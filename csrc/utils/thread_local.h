@@ -0,0 +1,18 @@
+/**
+ * 스레드별 전역 상태 지정자.
+ * 블록 내부 스크래치(conv2d 누적 버퍼), 연산 시간 기록, "현재 피처맵 풀" 바인딩을 스레드마다 따로 둬서
+ * 서로 다른 추론 컨텍스트를 여러 스레드에서 동시에 돌려도 섞이지 않게 함.
+ * BARE_METAL(단일 코어)·-DYOLO_SINGLE_THREAD면 일반 static.
+ */
+#ifndef THREAD_LOCAL_H
+#define THREAD_LOCAL_H
+
+#if defined(BARE_METAL) || defined(YOLO_SINGLE_THREAD)
+#define YOLO_THREAD_LOCAL
+#elif defined(_MSC_VER)
+#define YOLO_THREAD_LOCAL __declspec(thread)
+#else
+#define YOLO_THREAD_LOCAL __thread
+#endif
+
+#endif /* THREAD_LOCAL_H */
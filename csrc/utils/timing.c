@@ -4,6 +4,7 @@
  */
 #include "timing.h"
 #include "mcycle.h"
+#include "thread_local.h"
 #include <string.h>
 
 #ifdef BARE_METAL
@@ -24,12 +25,13 @@ typedef struct {
     uint64_t cycles;
 } timing_entry_t;
 
-static timing_entry_t s_entries[YOLO_TIMING_ENTRIES];
-static int            s_count;
-static int            s_cursor;
-static int            s_current_layer;
-static uint64_t       s_start;
-static char           s_current_op[YOLO_TIMING_OP_MAX];
+/* 스레드별 기록 (컨텍스트 여러 개를 스레드마다 돌려도 섞이지 않음) */
+static YOLO_THREAD_LOCAL timing_entry_t s_entries[YOLO_TIMING_ENTRIES];
+static YOLO_THREAD_LOCAL int            s_count;
+static YOLO_THREAD_LOCAL int            s_cursor;
+static YOLO_THREAD_LOCAL int            s_current_layer;
+static YOLO_THREAD_LOCAL uint64_t       s_start;
+static YOLO_THREAD_LOCAL char           s_current_op[YOLO_TIMING_OP_MAX];
 
 void yolo_timing_set_layer(int layer_id) {
     s_current_layer = layer_id;
@@ -49,8 +51,10 @@ void yolo_timing_end(void) {
     if (s_count >= YOLO_TIMING_ENTRIES) return;
     uint64_t delta = timer_delta64(s_start, timer_read64());
     s_entries[s_count].layer = s_current_layer;
-    (void)strncpy(s_entries[s_count].op, s_current_op, YOLO_TIMING_OP_MAX - 1);
-    s_entries[s_count].op[YOLO_TIMING_OP_MAX - 1] = '\0';
+    size_t len = strlen(s_current_op);
+    if (len > (size_t)(YOLO_TIMING_OP_MAX - 1)) len = (size_t)(YOLO_TIMING_OP_MAX - 1);
+    memcpy(s_entries[s_count].op, s_current_op, len);
+    s_entries[s_count].op[len] = '\0';
     s_entries[s_count].cycles = delta;
     s_count++;
 }
@@ -1,24 +1,196 @@
-/** UART로 검출 결과 전송 (BARE_METAL). 프로토콜: YOLO\\n, count hex, 12*count bytes hex */
-#ifdef BARE_METAL
-
+/** 검출 결과 이진 프레임 인코딩/디코딩 + 전송 (BARE_METAL: UART outbyte, 호스트: 파이프/pty/파일) */
 #include "uart_dump.h"
-#include "xil_printf.h"
 #include <stddef.h>
-#include <stdint.h>
+#include <string.h>
+
+#ifdef BARE_METAL
+#include "xil_printf.h"
+void outbyte(char c);   /* BSP stdout (UART) */
+#else
+#include <stdio.h>
+#endif
 
 #define HW_DETECTION_SIZE 12
 
-void yolo_uart_send_detections(const void* hw_detections, uint8_t count) {
-    if (!hw_detections) return;
-    xil_printf("YOLO\n");
-    xil_printf("%02X\n", (unsigned int)count);
-    const uint8_t* p = (const uint8_t*)hw_detections;
-    for (uint8_t i = 0; i < count; i++) {
-        for (int j = 0; j < HW_DETECTION_SIZE; j++) {
-            xil_printf("%02X", (unsigned int)p[j]);
+/* CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), 니블 표 */
+uint16_t yolo_crc16(const uint8_t* p, int32_t n) {
+    static const uint16_t T[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+    };
+    uint16_t crc = 0xFFFF;
+    for (int32_t i = 0; i < n; i++) {
+        crc = (uint16_t)((crc << 4) ^ T[(crc >> 12) ^ (p[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ T[(crc >> 12) ^ (p[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+static inline void put16(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+static inline void put32(uint8_t* p, uint32_t v) {
+    put16(p, v);
+    put16(p + 2, v >> 16);
+}
+static inline uint32_t get16(const uint8_t* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8); }
+static inline uint32_t get32(const uint8_t* p) { return get16(p) | (get16(p + 2) << 16); }
+
+static inline uint8_t* put_varint(uint8_t* p, uint32_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+/* 최대 3바이트 (u16 값, zigzag 17비트). 끝 넘거나 더 길면 NULL */
+static inline const uint8_t* get_varint(const uint8_t* p, const uint8_t* end, uint32_t* v) {
+    uint32_t r = 0;
+    for (int32_t s = 0; s < 21; s += 7) {
+        if (p >= end) return NULL;
+        const uint8_t b = *p++;
+        r |= (uint32_t)(b & 0x7F) << s;
+        if (!(b & 0x80)) {
+            *v = r;
+            return p;
+        }
+    }
+    return NULL;
+}
+static inline uint32_t zigzag(int32_t d) { return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31); }
+static inline int32_t unzigzag(uint32_t z) { return (int32_t)(z >> 1) ^ -(int32_t)(z & 1); }
+
+int32_t yolo_frame_encode(const void* hw_detections, int32_t count, uint32_t frame_id, uint32_t time,
+                          uint8_t flags, uint8_t* buf, int32_t cap) {
+    if (!buf || count < 0 || count > YOLO_FRAME_MAX_COUNT || (count > 0 && !hw_detections)) return -1;
+    const int32_t delta = (flags & YOLO_FRAME_FLAG_DELTA) != 0;
+    const int32_t per_det = delta ? YOLO_FRAME_MAX_DET_BYTES : YOLO_FRAME_RAW_DET_BYTES;
+    if (cap < YOLO_FRAME_HEAD_BYTES + count * per_det + YOLO_FRAME_CRC_BYTES) return -1;
+
+    buf[0] = YOLO_FRAME_SYNC0;
+    buf[1] = YOLO_FRAME_SYNC1;
+    buf[4] = YOLO_FRAME_VERSION;
+    buf[5] = flags;
+    put32(buf + 6, frame_id);
+    put32(buf + 10, time);
+    put16(buf + 14, (uint32_t)count);
+
+    const uint8_t* d = (const uint8_t*)hw_detections;
+    uint8_t* p = buf + YOLO_FRAME_HEAD_BYTES;
+    int32_t px = 0, py = 0;
+    for (int32_t i = 0; i < count; i++, d += HW_DETECTION_SIZE) {
+        if (delta) {
+            const int32_t x = (int32_t)get16(d), y = (int32_t)get16(d + 2);
+            p = put_varint(p, zigzag(x - px));
+            p = put_varint(p, zigzag(y - py));
+            p = put_varint(p, get16(d + 4));
+            p = put_varint(p, get16(d + 6));
+            px = x;
+            py = y;
+        } else {
+            memcpy(p, d, 8);
+            p += 8;
+        }
+        *p++ = d[8];   /* class_id */
+        *p++ = d[9];   /* confidence */
+    }
+    const int32_t len = (int32_t)(p - buf) - 4;
+    put16(buf + 2, (uint32_t)len);
+    put16(p, yolo_crc16(buf + 2, len + 2));
+    return len + 4 + YOLO_FRAME_CRC_BYTES;
+}
+
+int32_t yolo_frame_decode(const uint8_t* buf, int32_t len, yolo_frame_info_t* info,
+                          void* hw_detections, int32_t max_dets) {
+    if (!buf || len < 1) return 0;
+    if (buf[0] != YOLO_FRAME_SYNC0) return -1;
+    if (len < 2) return 0;
+    if (buf[1] != YOLO_FRAME_SYNC1) return -1;
+    if (len < 4) return 0;
+    const int32_t body = (int32_t)get16(buf + 2);
+    if (body < YOLO_FRAME_HEAD_BYTES - 4) return -1;
+    const int32_t total = 4 + body + YOLO_FRAME_CRC_BYTES;
+    if (len < total) return 0;
+    if (yolo_crc16(buf + 2, body + 2) != get16(buf + 4 + body)) return -1;
+    if (buf[4] != YOLO_FRAME_VERSION) return -1;
+
+    const uint8_t flags = buf[5];
+    const int32_t count = (int32_t)get16(buf + 14);
+    if (count > max_dets || (count > 0 && !hw_detections)) return -1;
+    const uint8_t* p = buf + YOLO_FRAME_HEAD_BYTES;
+    const uint8_t* end = buf + 4 + body;
+    uint8_t* d = (uint8_t*)hw_detections;
+    uint32_t x = 0, y = 0;
+    for (int32_t i = 0; i < count; i++, d += HW_DETECTION_SIZE) {
+        if (flags & YOLO_FRAME_FLAG_DELTA) {
+            uint32_t zx, zy, w, h;
+            if (!(p = get_varint(p, end, &zx)) || !(p = get_varint(p, end, &zy)) ||
+                !(p = get_varint(p, end, &w)) || !(p = get_varint(p, end, &h)))
+                return -1;
+            x = (uint32_t)((int32_t)x + unzigzag(zx));
+            y = (uint32_t)((int32_t)y + unzigzag(zy));
+            if (x > 0xFFFFu || y > 0xFFFFu || w > 0xFFFFu || h > 0xFFFFu) return -1;
+            put16(d, x);
+            put16(d + 2, y);
+            put16(d + 4, w);
+            put16(d + 6, h);
+        } else {
+            if (end - p < 8) return -1;
+            memcpy(d, p, 8);
+            p += 8;
         }
+        if (end - p < 2) return -1;
+        d[8] = *p++;
+        d[9] = *p++;
+        d[10] = 0;
+        d[11] = 0;
+    }
+    if (p != end) return -1;
+    if (info) {
+        info->flags = flags;
+        info->frame_id = get32(buf + 6);
+        info->time = get32(buf + 10);
+        info->count = (uint16_t)count;
     }
-    xil_printf("\n");
+    return total;
+}
+
+#ifdef BARE_METAL
+
+int32_t yolo_uart_send_frame(const void* hw_detections, int32_t count, uint32_t frame_id, uint32_t time,
+                             uint8_t flags, uint8_t* buf, int32_t cap) {
+    const int32_t n = yolo_frame_encode(hw_detections, count, frame_id, time,
+                                        (uint8_t)(flags | YOLO_FRAME_FLAG_KCYCLES), buf, cap);
+    for (int32_t i = 0; i < n; i++) outbyte((char)buf[i]);
+    return n;
+}
+
+#else
+
+static FILE* uart_host_fp = NULL;
+
+int yolo_uart_open(const char* path) {
+    yolo_uart_close();
+    if (!path) return -1;
+    uart_host_fp = fopen(path, "wb");
+    return uart_host_fp ? 0 : -1;
+}
+
+void yolo_uart_close(void) {
+    if (uart_host_fp) fclose(uart_host_fp);
+    uart_host_fp = NULL;
+}
+
+int32_t yolo_uart_send_frame(const void* hw_detections, int32_t count, uint32_t frame_id, uint32_t time,
+                             uint8_t flags, uint8_t* buf, int32_t cap) {
+    if (!uart_host_fp) return 0;
+    const int32_t n = yolo_frame_encode(hw_detections, count, frame_id, time,
+                                        (uint8_t)(flags & ~YOLO_FRAME_FLAG_KCYCLES), buf, cap);
+    if (n < 0) return -1;
+    if (fwrite(buf, 1, (size_t)n, uart_host_fp) != (size_t)n || fflush(uart_host_fp) != 0) return -1;
+    return n;
 }
 
 #endif /* BARE_METAL */
@@ -1,11 +1,73 @@
-/** UART 검출 결과 전송 (BARE_METAL). PC 스크립트로 시리얼 수신 → detections.bin */
+/**
+ * 검출 결과 이진 프레임 전송. PC 스크립트(tools/recv_detections_uart.py)로 수신 → detections.bin
+ *
+ * 프레임 (리틀 엔디언):
+ *   [0]  u8[2] sync A5 5A
+ *   [2]  u16   len   (version ~ 마지막 레코드 바이트 수)
+ *   [4]  u8    version (YOLO_FRAME_VERSION)
+ *   [5]  u8    flags (YOLO_FRAME_FLAG_*)
+ *   [6]  u32   frame_id
+ *   [10] u32   time  (추론 시간: 호스트 µs, BARE_METAL kcycles → FLAG_KCYCLES)
+ *   [14] u16   count
+ *   [16] 레코드 × count
+ *        원본: x, y, w, h (u16), class_id, confidence (u8) = 10바이트
+ *        FLAG_DELTA: zigzag varint(x - 이전 x), zigzag varint(y - 이전 y), varint w, varint h, class_id, confidence
+ *   [4+len] u16 CRC-16/CCITT-FALSE (len ~ 마지막 레코드)
+ * 로그 텍스트가 섞인 스트림에서도 sync + CRC로 프레임만 골라냄.
+ *
+ * 레코드 입출력은 hw_detection_t 배열 (12바이트, reserved 0) 그대로.
+ * 전송: BARE_METAL은 outbyte (UART), 호스트는 yolo_uart_open 경로(파이프/pty/파일)에 같은 바이트를 씀.
+ */
 #ifndef UART_DUMP_H
 #define UART_DUMP_H
 
 #include <stdint.h>
 
-struct hw_detection_t;
+#define YOLO_FRAME_SYNC0 0xA5
+#define YOLO_FRAME_SYNC1 0x5A
+#define YOLO_FRAME_VERSION 1
+#define YOLO_FRAME_FLAG_DELTA 0x01u
+#define YOLO_FRAME_FLAG_KCYCLES 0x02u
 
-void yolo_uart_send_detections(const void* hw_detections, uint8_t count);
+#define YOLO_FRAME_HEAD_BYTES 16   /* sync ~ count */
+#define YOLO_FRAME_CRC_BYTES 2
+#define YOLO_FRAME_RAW_DET_BYTES 10
+#define YOLO_FRAME_MAX_DET_BYTES 14   /* delta 최악: varint 3 × 4 + 2 */
+#define YOLO_FRAME_MAX_BYTES(n) (YOLO_FRAME_HEAD_BYTES + (n) * YOLO_FRAME_MAX_DET_BYTES + YOLO_FRAME_CRC_BYTES)
+#define YOLO_FRAME_MAX_COUNT ((65535 - (YOLO_FRAME_HEAD_BYTES - 4)) / YOLO_FRAME_MAX_DET_BYTES)
+
+typedef struct {
+    uint8_t flags;
+    uint32_t frame_id;
+    uint32_t time;
+    uint16_t count;
+} yolo_frame_info_t;
+
+uint16_t yolo_crc16(const uint8_t* p, int32_t n);
+
+/** hw_detection_t[count] → 프레임. 반환: 프레임 바이트 수, cap 부족/count 초과 → -1 */
+int32_t yolo_frame_encode(const void* hw_detections, int32_t count, uint32_t frame_id, uint32_t time,
+                          uint8_t flags, uint8_t* buf, int32_t cap);
+
+/**
+ * buf 시작의 프레임 → info + hw_detection_t[count].
+ * 반환: 소비 바이트 수 / 0 = 프레임이 아직 다 오지 않음 / -1 = 프레임 아님 (sync·version·CRC·길이·max_dets)
+ * → 호출자는 1바이트 건너뛰고 다시 시도.
+ */
+int32_t yolo_frame_decode(const uint8_t* buf, int32_t len, yolo_frame_info_t* info,
+                          void* hw_detections, int32_t max_dets);
+
+#ifndef BARE_METAL
+/** 호스트 백엔드: path(파이프·pty·파일)를 열어 이후 프레임을 씀. 실패 → -1 */
+int yolo_uart_open(const char* path);
+void yolo_uart_close(void);
+#endif
+
+/**
+ * 프레임 인코딩 + 전송 (buf는 YOLO_FRAME_MAX_BYTES(count) 이상). flags에 플랫폼 시간 단위가 더해짐.
+ * 호스트에서 yolo_uart_open 전이면 아무것도 안 함. 반환: 보낸 바이트 수, 실패 → -1
+ */
+int32_t yolo_uart_send_frame(const void* hw_detections, int32_t count, uint32_t frame_id, uint32_t time,
+                             uint8_t flags, uint8_t* buf, int32_t cap);
 
 #endif /* UART_DUMP_H */
@@ -0,0 +1,50 @@
+#ifndef WEIGHTS_CONTAINER_H
+#define WEIGHTS_CONTAINER_H
+
+/* 인덱스 모델 컨테이너 (.ymdl) 파일 형식. 생성: tools/pack_weights_container.py (struct 형식이 이 파일과 같아야 함)
+ *
+ *   [헤더 64B][디렉터리: 텐서당 64B][해시 u32 × index_slots][이름 (NUL 종료)][payload, 각 64B 정렬]
+ *
+ * 리틀 엔디언, 오프셋은 파일 처음 기준. 로더는 헤더만 확인하고 디렉터리/해시/payload를 제자리 참조
+ * (스트림 형식처럼 텐서를 차례로 읽거나 해시를 만들지 않음). FP32/W8 모두 같은 형식 (dtype은 텐서별). */
+
+#include <stdint.h>
+
+#define WEIGHTS_CONTAINER_MAGIC   "YMDL"
+#define WEIGHTS_CONTAINER_VERSION 1u
+#define WEIGHTS_CONTAINER_ALIGN   64u   /* payload 정렬 (캐시 라인 / DMA 버스트) */
+
+/* 가중치 배치 (header.layout). 커널이 읽는 배치와 다르면 로드 거부 → pre-pack 배치는 새 번호로 추가 */
+#define WEIGHTS_LAYOUT_OIHW       0u    /* PyTorch 그대로 [c_out][c_in][kh][kw] */
+
+typedef struct {
+    char magic[4];             /* WEIGHTS_CONTAINER_MAGIC */
+    uint16_t version;
+    uint16_t header_size;      /* sizeof(weights_container_header_t) */
+    uint32_t num_tensors;
+    uint32_t index_slots;      /* 2의 거듭제곱, 텐서 수의 2배 이상 */
+    uint32_t layout;           /* WEIGHTS_LAYOUT_* */
+    uint32_t entry_size;       /* sizeof(weights_container_entry_t) */
+    uint32_t dir_offset;
+    uint32_t index_offset;     /* 슬롯 = 텐서 번호 + 1, 0 = 빈 슬롯 (FNV-1a & (slots-1)부터 선형 탐색) */
+    uint32_t names_offset;
+    uint32_t data_offset;
+    uint32_t file_size;
+    uint32_t reserved[5];
+} weights_container_header_t;
+
+typedef struct {
+    uint32_t name_offset;      /* NUL 종료 이름 */
+    uint32_t name_hash;        /* FNV-1a(이름): 조회 시 strcmp 전에 비교 */
+    uint32_t data_offset;      /* WEIGHTS_CONTAINER_ALIGN 정렬 */
+    uint32_t data_bytes;
+    uint32_t num_elements;
+    float scale;               /* INT8 디양자화 scale (FP32는 0) */
+    uint8_t dtype;             /* WEIGHTS_DTYPE_* */
+    uint8_t ndim;
+    uint16_t reserved0;
+    int32_t shape[8];          /* MAX_TENSOR_DIMS */
+    uint32_t reserved1;
+} weights_container_entry_t;
+
+#endif // WEIGHTS_CONTAINER_H
@@ -1,8 +1,19 @@
+#if !defined(BARE_METAL) && (defined(__unix__) || defined(__APPLE__)) && !defined(WEIGHTS_NO_MMAP)
+#define _DEFAULT_SOURCE  /* -std=c99에서 mmap/madvise/MAP_POPULATE */
+#define WEIGHTS_HAVE_MMAP 1
+#endif
 #include "weights_loader.h"
+#include "weights_container.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdio.h>
+#ifdef WEIGHTS_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #ifndef WEIGHTS_WARN_MISSING
 #define WEIGHTS_WARN_MISSING 1
@@ -21,6 +32,55 @@ static inline uint32_t read_u32_unaligned(const uint8_t** src) {
     return v;
 }
 
+#define FNV_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+/* FNV-1a를 h에 이어서: 접두사 + 이름을 문자열로 합치지 않고 해시 */
+static uint32_t fnv1a(uint32_t h, const char* s) {
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+/* 이름 해시 인덱스 (파싱 끝에 1회). 같은 이름이 여럿이면 앞 텐서가 탐색 열의 앞 → 선형 탐색과 같은 결과 */
+static int build_index(weights_loader_t* loader) {
+    uint32_t cap = 16u;
+    while (cap < (uint32_t)loader->num_tensors * 2u) cap <<= 1;
+    int32_t* index = (int32_t*)calloc(cap, sizeof(int32_t));
+    if (!index) return -1;
+    loader->index = index;
+    loader->index_mask = cap - 1u;
+    for (int32_t i = 0; i < loader->num_tensors; i++) {
+        uint32_t s = fnv1a(FNV_BASIS, loader->tensors[i].name) & loader->index_mask;
+        while (index[s]) s = (s + 1u) & loader->index_mask;
+        index[s] = i + 1;
+    }
+    return 0;
+}
+
+/* 컨테이너 디렉터리 (스트림 형식이면 NULL) */
+static const weights_container_entry_t* container_dir(const weights_loader_t* loader) {
+    const weights_container_header_t* h = (const weights_container_header_t*)loader->container;
+    return h ? (const weights_container_entry_t*)((const uint8_t*)h + h->dir_offset) : NULL;
+}
+
+/* 이름이 prefix + name인 텐서 (prefix는 "" 또는 "model.") */
+static const tensor_info_t* index_lookup(const weights_loader_t* loader, const char* prefix, size_t prefix_len,
+                                         const char* name) {
+    const uint32_t hash = fnv1a(fnv1a(FNV_BASIS, prefix), name);
+    const weights_container_entry_t* dir = container_dir(loader);
+    uint32_t s = hash & loader->index_mask;
+    for (int32_t k; (k = loader->index[s]) != 0; s = (s + 1u) & loader->index_mask) {
+        if (dir && dir[k - 1].name_hash != hash) continue;  /* 컨테이너: 저장된 해시로 strcmp 생략 */
+        const char* tn = loader->tensors[k - 1].name;
+        if (strncmp(tn, prefix, prefix_len) == 0 && strcmp(tn + prefix_len, name) == 0)
+            return &loader->tensors[k - 1];
+    }
+    return NULL;
+}
+
 static int parse_weights_data(const uint8_t* ptr, size_t data_len, weights_loader_t* loader, int zero_copy) {
     const uint8_t* curr = ptr;
     const uint8_t* end = ptr + data_len;
@@ -32,9 +92,9 @@ static int parse_weights_data(const uint8_t* ptr, size_t data_len, weights_loade
     loader->num_tensors = (int32_t)num_tensors;
     loader->tensors = (tensor_info_t*)calloc(num_tensors, sizeof(tensor_info_t));
     if (!loader->tensors) return -1;
-    loader->dequant_pool_base = NULL;
-    loader->dequant_buf_cap = 0;
-    loader->dequant_pool_next = 0;
+    loader->dequant_bytes = 0;
+    loader->index = NULL;
+    loader->index_mask = 0;
 
     for (int i = 0; i < (int)num_tensors; i++) {
         tensor_info_t* t = &loader->tensors[i];
@@ -90,7 +150,7 @@ static int parse_weights_data(const uint8_t* ptr, size_t data_len, weights_loade
         }
     }
 
-    return 0;
+    return build_index(loader);
 }
 
 /* W8A32: weights_w8.bin 파싱. scale은 INT8 텐서 헤더에 포함 (A: 텐서별 매칭, 순서 독립). */
@@ -98,7 +158,6 @@ static int parse_weights_w8(const uint8_t* w8_ptr, size_t w8_len,
                             weights_loader_t* loader, int zero_copy) {
     const uint8_t* curr = w8_ptr;
     const uint8_t* end = w8_ptr + w8_len;
-    size_t max_int8_elems = 0;
 
     if (curr + 4 > end) return -1;
     uint32_t num_tensors;
@@ -107,9 +166,9 @@ static int parse_weights_w8(const uint8_t* w8_ptr, size_t w8_len,
     loader->num_tensors = (int32_t)num_tensors;
     loader->tensors = (tensor_info_t*)calloc(num_tensors, sizeof(tensor_info_t));
     if (!loader->tensors) return -1;
-    loader->dequant_pool_base = NULL;
-    loader->dequant_buf_cap = 0;
-    loader->dequant_pool_next = 0;
+    loader->dequant_bytes = 0;
+    loader->index = NULL;
+    loader->index_mask = 0;
 
     for (int i = 0; i < (int)num_tensors; i++) {
         tensor_info_t* t = &loader->tensors[i];
@@ -171,8 +230,6 @@ static int parse_weights_w8(const uint8_t* w8_ptr, size_t w8_len,
             }
             size_t data_bytes = t->num_elements * (size_t)1;
             if (curr + data_bytes > end) return -1;
-            if (t->num_elements > max_int8_elems)
-                max_int8_elems = t->num_elements;
             if (zero_copy) {
                 t->data_int8 = (int8_t*)curr;
                 curr += data_bytes;
@@ -187,102 +244,241 @@ static int parse_weights_w8(const uint8_t* w8_ptr, size_t w8_len,
             return -1;
     }
 
-    /* B: 버퍼 풀 — c3/detect 등에서 여러 가중치를 동시에 쓰므로 슬롯 여러 개 필요 */
-    if (max_int8_elems > 0) {
-        size_t pool_bytes = (size_t)WEIGHTS_DEQUANT_POOL_SIZE * max_int8_elems * sizeof(float);
-        loader->dequant_pool_base = (float*)malloc(pool_bytes);
-        if (!loader->dequant_pool_base) return -1;
-        loader->dequant_buf_cap = max_int8_elems;
+    return build_index(loader);
+}
+
+/* 스트림 형식의 첫 4바이트는 텐서 수 → 매직과 겹치지 않음 */
+static int is_container(const uint8_t* p, size_t size) {
+    return size >= sizeof(weights_container_header_t) && memcmp(p, WEIGHTS_CONTAINER_MAGIC, 4) == 0;
+}
+
+/* 컨테이너: 헤더·범위 확인 후 디렉터리 → tensor_info_t. 이름/payload/해시는 파일 안을 가리킴 (복사·해시 생성 없음).
+ * meta_only: base는 파일 앞부분 (헤더~이름, data_offset까지)만 → payload 포인터는 NULL (스트리밍 로더가 채움) */
+static int init_container(const uint8_t* base, size_t size, weights_loader_t* loader, int meta_only) {
+    const weights_container_header_t* h = (const weights_container_header_t*)base;
+    loader->tensors = NULL;
+    loader->num_tensors = 0;
+    loader->dequant_bytes = 0;
+    loader->index = NULL;
+    loader->index_mask = 0;
+    if ((uintptr_t)base % 4u != 0 || !is_container(base, size)) return -1;
+    const uint32_t n = h->num_tensors, slots = h->index_slots, fsize = h->file_size;
+    const uint32_t limit = meta_only ? h->data_offset : fsize;  /* 디렉터리/해시가 있어야 하는 범위 */
+    if (h->version != WEIGHTS_CONTAINER_VERSION || h->header_size != sizeof(*h) ||
+        h->entry_size != sizeof(weights_container_entry_t) || limit > size || h->data_offset > fsize ||
+        h->names_offset > h->data_offset || slots < 2u * n ||
+        (slots & (slots - 1u)) != 0 || h->dir_offset % 4u != 0 || h->index_offset % 4u != 0 ||
+        (uint64_t)h->dir_offset + (uint64_t)n * sizeof(weights_container_entry_t) > limit ||
+        (uint64_t)h->index_offset + (uint64_t)slots * 4u > limit)
+        return -1;
+    if (h->layout != WEIGHTS_LAYOUT_OIHW) {
+#ifndef BARE_METAL
+        fprintf(stderr, "Error: Unsupported weights layout %u\n", (unsigned)h->layout);
+#endif
+        return -1;
+    }
+
+    loader->tensors = (tensor_info_t*)calloc(n ? n : 1u, sizeof(tensor_info_t));
+    if (!loader->tensors) return -1;
+    loader->num_tensors = (int32_t)n;
+    loader->container = h;
+    loader->layout = h->layout;
+    loader->index = (const int32_t*)(base + h->index_offset);
+    loader->index_mask = slots - 1u;
+
+    const weights_container_entry_t* e = container_dir(loader);
+    for (uint32_t i = 0; i < n; i++, e++) {
+        tensor_info_t* t = &loader->tensors[i];
+        const size_t esize = e->dtype == WEIGHTS_DTYPE_INT8 ? 1u : sizeof(float);
+        if (e->dtype > WEIGHTS_DTYPE_INT8 || e->ndim > MAX_TENSOR_DIMS || e->name_offset >= h->data_offset ||
+            !memchr(base + e->name_offset, 0, h->data_offset - e->name_offset) ||
+            e->data_offset % WEIGHTS_CONTAINER_ALIGN != 0 || (size_t)e->num_elements * esize != e->data_bytes ||
+            (uint64_t)e->data_offset + e->data_bytes > fsize) {
+            free(loader->tensors);
+            loader->tensors = NULL;
+            loader->num_tensors = 0;
+            loader->container = NULL;
+            loader->index = NULL;
+            return -1;
+        }
+        t->name = (char*)(base + e->name_offset);
+        t->dtype = e->dtype;
+        t->scale = e->scale;
+        t->ndim = e->ndim;
+        memcpy(t->shape, e->shape, sizeof(t->shape));
+        t->num_elements = e->num_elements;
+        if (!meta_only) {
+            if (e->dtype == WEIGHTS_DTYPE_INT8)
+                t->data_int8 = (int8_t*)(base + e->data_offset);
+            else
+                t->data = (float*)(base + e->data_offset);
+        }
+        t->data_owned = 0;
     }
     return 0;
 }
 
+/* 매직으로 형식 선택: 컨테이너는 항상 제자리 (zero_copy 무관, COPY 방식은 호출자가 버퍼를 유지) */
+static int parse_any(const uint8_t* p, size_t size, weights_loader_t* loader, int zero_copy, int w8) {
+    loader->container = NULL;
+    loader->layout = WEIGHTS_LAYOUT_OIHW;
+    loader->embedded = 0;
+    if (is_container(p, size)) return init_container(p, size, loader, 0);
+    return w8 ? parse_weights_w8(p, size, loader, zero_copy) : parse_weights_data(p, size, loader, zero_copy);
+}
+
+int weights_init_container_meta(const void* meta, size_t meta_size, weights_loader_t* loader) {
+    if (!meta || !loader) return -1;
+    memset(loader, 0, sizeof(*loader));
+    return init_container((const uint8_t*)meta, meta_size, loader, 1);
+}
+
 int weights_init_from_memory(uintptr_t base_addr, size_t size, weights_loader_t* loader) {
     if (size == 0) return -1;
-    return parse_weights_data((const uint8_t*)base_addr, size, loader, 1);
+    loader->map_base = NULL;
+    loader->map_size = 0;
+    loader->blob = NULL;
+    return parse_any((const uint8_t*)base_addr, size, loader, 1, 0);
 }
 
 #ifdef BARE_METAL
 int weights_init_from_memory_w8(uintptr_t w8_base, size_t w8_size, weights_loader_t* loader) {
     if (w8_size == 0) return -1;
-    return parse_weights_w8((const uint8_t*)w8_base, w8_size, loader, 1);
+    loader->map_base = NULL;
+    loader->map_size = 0;
+    loader->blob = NULL;
+    return parse_any((const uint8_t*)w8_base, w8_size, loader, 1, 1);
+}
+#endif
+
+#ifdef YOLO_EMBEDDED_MODEL
+int weights_init_embedded(weights_loader_t* loader) {
+    if (!loader || yolo_embedded_weights.num_tensors <= 0) return -1;
+    *loader = yolo_embedded_weights;
+    loader->embedded = 1;
+    return 0;
 }
 #endif
 
 #ifndef BARE_METAL
-int weights_load_from_file(const char* bin_path, weights_loader_t* loader) {
-    FILE* f = fopen(bin_path, "rb");
+/* 파일 전체 → malloc 버퍼 (COPY 방식, mmap 없는 플랫폼) */
+static uint8_t* read_file(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
     if (!f) {
-        fprintf(stderr, "Error: Cannot open %s\n", bin_path);
-        return -1;
+        fprintf(stderr, "Error: Cannot open %s\n", path);
+        return NULL;
     }
-
     fseek(f, 0, SEEK_END);
-    size_t file_size = ftell(f);
+    long file_size = ftell(f);
     fseek(f, 0, SEEK_SET);
-
-    uint8_t* buffer = (uint8_t*)malloc(file_size);
-    if (!buffer) {
-        fclose(f);
-        return -1;
-    }
-
-    if (fread(buffer, 1, file_size, f) != file_size) {
+    if (file_size <= 0) { fclose(f); return NULL; }
+    uint8_t* buffer = (uint8_t*)malloc((size_t)file_size);
+    if (!buffer) { fclose(f); return NULL; }
+    if (fread(buffer, 1, (size_t)file_size, f) != (size_t)file_size) {
         free(buffer);
         fclose(f);
-        return -1;
+        return NULL;
     }
     fclose(f);
-
-    int ret = parse_weights_data(buffer, file_size, loader, 0);
-    free(buffer);
-    
-    if (ret != 0) {
-        weights_free(loader);
-    }
-    return ret;
+    *size = (size_t)file_size;
+    return buffer;
 }
 
-int weights_load_from_file_w8(const char* w8_path, weights_loader_t* loader) {
-    FILE* fw = fopen(w8_path, "rb");
-    if (!fw) {
-        fprintf(stderr, "Error: Cannot open %s\n", w8_path);
-        return -1;
+#ifdef WEIGHTS_HAVE_MMAP
+/* 읽기 전용 mmap (MAP_PRIVATE: 텐서는 읽기만, 페이지는 같은 파일을 연 프로세스끼리 공유) */
+static void* map_file(const char* path, size_t* size, unsigned flags) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open %s\n", path);
+        return NULL;
     }
-    fseek(fw, 0, SEEK_END);
-    long w8_size = ftell(fw);
-    fseek(fw, 0, SEEK_SET);
-    if (w8_size <= 0) { fclose(fw); return -1; }
-    uint8_t* w8_buf = (uint8_t*)malloc((size_t)w8_size);
-    if (!w8_buf) { fclose(fw); return -1; }
-    if (fread(w8_buf, 1, (size_t)w8_size, fw) != (size_t)w8_size) {
-        free(w8_buf); fclose(fw); return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
     }
-    fclose(fw);
+    int mflags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (flags & WEIGHTS_LOAD_POPULATE) mflags |= MAP_POPULATE;
+#endif
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, mflags, fd, 0);
+    close(fd);  /* 매핑은 fd 없이 유지 */
+    if (p == MAP_FAILED) return NULL;
+#ifdef MADV_WILLNEED
+    if (flags & WEIGHTS_LOAD_WILLNEED) madvise(p, (size_t)st.st_size, MADV_WILLNEED);
+#endif
+    *size = (size_t)st.st_size;
+    return p;
+}
+#endif
 
-    int ret = parse_weights_w8(w8_buf, (size_t)w8_size, loader, 0);
-    free(w8_buf);
-    if (ret != 0) {
-        weights_free(loader);
+/* mmap이면 제자리 파싱 (zero_copy, DDR 경로와 같음), 아니면 읽어서 텐서별 복사 후 버퍼 해제.
+ * 컨테이너는 COPY여도 버퍼 하나를 그대로 유지 (텐서별 malloc 없음) */
+static int load_file(const char* path, weights_loader_t* loader, unsigned flags, int w8) {
+    if (!path || !loader) return -1;
+    memset(loader, 0, sizeof(*loader));
+    int ret;
+#ifdef WEIGHTS_HAVE_MMAP
+    if (flags & (WEIGHTS_LOAD_MMAP | WEIGHTS_LOAD_POPULATE | WEIGHTS_LOAD_WILLNEED)) {
+        size_t size = 0;
+        void* p = map_file(path, &size, flags);
+        if (!p) return -1;
+        loader->map_base = p;
+        loader->map_size = size;
+        ret = parse_any((const uint8_t*)p, size, loader, 1, w8);
+        if (ret != 0) weights_free(loader);
         return ret;
     }
-    return 0;
+#else
+    (void)flags;
+#endif
+    size_t size = 0;
+    uint8_t* buffer = read_file(path, &size);
+    if (!buffer) return -1;
+    ret = parse_any(buffer, size, loader, 0, w8);
+    if (ret == 0 && loader->container) {
+        loader->blob = buffer;
+        return 0;
+    }
+    if (ret != 0) weights_free(loader);
+    free(buffer);
+    return ret;
+}
+
+int weights_load_from_file_ex(const char* bin_path, weights_loader_t* loader, unsigned flags) {
+    return load_file(bin_path, loader, flags, 0);
+}
+
+int weights_load_from_file_w8_ex(const char* w8_path, weights_loader_t* loader, unsigned flags) {
+    return load_file(w8_path, loader, flags, 1);
+}
+
+int weights_load_from_file(const char* bin_path, weights_loader_t* loader) {
+    return load_file(bin_path, loader, WEIGHTS_LOAD_DEFAULT, 0);
+}
+
+int weights_load_from_file_w8(const char* w8_path, weights_loader_t* loader) {
+    return load_file(w8_path, loader, WEIGHTS_LOAD_DEFAULT, 1);
 }
 #endif
 
 const tensor_info_t* weights_find_tensor(const weights_loader_t* loader, const char* name) {
-    char search_name[512];
-    
+    const int has_prefix = strncmp(name, "model.", 6) == 0;
+    if (loader->index) {
+        const tensor_info_t* t = index_lookup(loader, "", 0, name);
+        if (!t && has_prefix) t = index_lookup(loader, "model.", 6, name);
+        return t;
+    }
+    /* 인덱스 없음 (직접 구성한 로더): 선형 탐색 */
     for (int i = 0; i < loader->num_tensors; i++) {
         if (strcmp(loader->tensors[i].name, name) == 0) {
             return &loader->tensors[i];
         }
     }
-
-    if (strncmp(name, "model.", 6) == 0) {
-        snprintf(search_name, sizeof(search_name), "model.model.%s", name);
+    if (has_prefix) {
         for (int i = 0; i < loader->num_tensors; i++) {
-            if (strcmp(loader->tensors[i].name, search_name) == 0) {
+            const char* tn = loader->tensors[i].name;
+            if (strncmp(tn, "model.", 6) == 0 && strcmp(tn + 6, name) == 0) {
                 return &loader->tensors[i];
             }
         }
@@ -291,55 +487,78 @@ const tensor_info_t* weights_find_tensor(const weights_loader_t* loader, const c
     return NULL;
 }
 
-const float* weights_get_tensor_data(weights_loader_t* loader, const char* name) {
+int weights_bind(const weights_loader_t* loader, const char* name, weights_ref_t* ref) {
     const tensor_info_t* t = weights_find_tensor(loader, name);
+    memset(ref, 0, sizeof(*ref));
     if (!t) {
 #if WEIGHTS_WARN_MISSING && !defined(BARE_METAL)
         fprintf(stderr, "Warning: Weight not found: %s\n", name);
 #endif
-        return NULL;
+        return -1;
     }
-    if (t->dtype == WEIGHTS_DTYPE_INT8 && t->data_int8 && loader->dequant_pool_base && t->num_elements <= loader->dequant_buf_cap) {
-        /* 슬롯 하나 사용 (round-robin) — c3/detect에서 여러 W() 호출이 인자 평가 시 순차 실행되므로 서로 다른 슬롯에 채워짐 */
-        int slot = loader->dequant_pool_next;
-        loader->dequant_pool_next = (slot + 1) % WEIGHTS_DEQUANT_POOL_SIZE;
-        float* dst = loader->dequant_pool_base + (size_t)slot * loader->dequant_buf_cap;
+    if (t->dtype == WEIGHTS_DTYPE_INT8 && t->data_int8) {
+        ref->data = t->data_int8;
+        ref->scale = t->scale;
+        ref->is_int8 = 1;
+    } else {
+        ref->data = t->data;
+    }
+    ref->num_elements = t->num_elements;
+    ref->index = (int32_t)(t - loader->tensors);
+    return 0;
+}
+
+const float* weights_ref_data(weights_loader_t* loader, const weights_ref_t* ref) {
+    if (!ref->is_int8) return (const float*)ref->data;
+    /* 정적 테이블은 모든 loader가 공유 (const 링크 테이블) → 캐시를 달 곳이 없고 heap도 안 씀: 미지원 */
+    if (loader->embedded) return NULL;
+    tensor_info_t* t = &loader->tensors[ref->index];
+    if (!t->dequant) {
+        /* 텐서별 1회: 이후 호출은 복사 없이 같은 버퍼 (동시에 여러 텐서를 써도 서로 덮지 않음) */
+        float* dst = (float*)malloc(t->num_elements * sizeof(float));
+        if (!dst) return NULL;
         const int8_t* src = t->data_int8;
-        float s = t->scale;
-        size_t n = t->num_elements;
-        for (size_t i = 0; i < n; i++)
+        const float s = t->scale;
+        for (size_t i = 0; i < t->num_elements; i++)
             dst[i] = (float)src[i] * s;
-        return dst;
+        t->dequant = dst;
+        loader->dequant_bytes += t->num_elements * sizeof(float);
     }
-    return t->data;
+    return t->dequant;
+}
+
+const float* weights_get_tensor_data(weights_loader_t* loader, const char* name) {
+    weights_ref_t ref;
+    if (weights_bind(loader, name, &ref) != 0) return NULL;
+    return weights_ref_data(loader, &ref);
 }
 
 void* weights_get_tensor_for_conv(weights_loader_t* loader, const char* name, float* out_scale, int* out_is_int8) {
-    const tensor_info_t* t = weights_find_tensor(loader, name);
-    if (!t) {
-#if WEIGHTS_WARN_MISSING && !defined(BARE_METAL)
-        fprintf(stderr, "Warning: Weight not found: %s\n", name);
-#endif
-        if (out_scale) *out_scale = 0.f;
-        if (out_is_int8) *out_is_int8 = 0;
-        return NULL;
-    }
-    if (t->dtype == WEIGHTS_DTYPE_INT8 && t->data_int8) {
-        if (out_scale) *out_scale = t->scale;
-        if (out_is_int8) *out_is_int8 = 1;
-        return (void*)t->data_int8;
-    }
-    if (out_scale) *out_scale = 0.f;
-    if (out_is_int8) *out_is_int8 = 0;
-    return (void*)t->data;
+    weights_ref_t ref;
+    weights_bind(loader, name, &ref);  /* 없으면 NULL, scale 0, is_int8 0 */
+    if (out_scale) *out_scale = ref.scale;
+    if (out_is_int8) *out_is_int8 = ref.is_int8;
+    return (void*)ref.data;
 }
 
 void weights_free(weights_loader_t* loader) {
-    if (!loader || !loader->tensors) return;
+    if (!loader) return;
+#ifdef WEIGHTS_HAVE_MMAP
+    if (loader->map_base) munmap(loader->map_base, loader->map_size);
+#endif
+    loader->map_base = NULL;
+    loader->map_size = 0;
+    if (!loader->tensors) return;
+    if (loader->embedded) {
+        /* 정적 테이블: 해제할 것 없음 (다른 loader/컨텍스트가 같은 테이블을 계속 씀) */
+        memset(loader, 0, sizeof(*loader));
+        return;
+    }
 
     for (int i = 0; i < loader->num_tensors; i++) {
         tensor_info_t* t = &loader->tensors[i];
-        if (t->name) free(t->name);
+        if (t->name && !loader->container) free(t->name);
+        if (t->dequant) free(t->dequant);
         if (t->data_owned) {
             if (t->dtype == WEIGHTS_DTYPE_INT8 && t->data_int8)
                 free(t->data_int8);
@@ -347,11 +566,14 @@ void weights_free(weights_loader_t* loader) {
                 free(t->data);
         }
     }
-    if (loader->dequant_pool_base) free(loader->dequant_pool_base);
+    if (!loader->container) free((void*)loader->index);
+    free(loader->blob);
     free(loader->tensors);
     loader->tensors = NULL;
     loader->num_tensors = 0;
-    loader->dequant_pool_base = NULL;
-    loader->dequant_buf_cap = 0;
-    loader->dequant_pool_next = 0;
+    loader->dequant_bytes = 0;
+    loader->index = NULL;
+    loader->index_mask = 0;
+    loader->container = NULL;
+    loader->blob = NULL;
 }
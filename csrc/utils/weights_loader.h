@@ -19,39 +19,90 @@ typedef struct {
     int32_t shape[MAX_TENSOR_DIMS];
     size_t num_elements;
     unsigned char data_owned; // 1 = loader가 할당(해제 시 free), 0 = 외부(DDR) 참조
+    float* dequant;          // INT8 → FP32 캐시: FP32가 필요한 첫 조회 때 1회 생성 (weights_free에서 해제), 없으면 NULL
 } tensor_info_t;
 
-/* C3 등에서 동시에 쓰는 가중치 최대 개수 (cv1,cv2,cv3 + n×cv1w + n×cv2w, n=3 → 9) */
-#define WEIGHTS_DEQUANT_POOL_SIZE 10
-
 // 가중치 로더 구조체
 typedef struct {
     tensor_info_t* tensors;
     int32_t num_tensors;
-    float* dequant_pool_base;  /* INT8 → FP32 풀: pool_base[slot * dequant_buf_cap] */
-    size_t dequant_buf_cap;    /* 슬롯당 원소 개수 (max INT8 텐서 크기) */
-    int dequant_pool_next;     /* 다음에 쓸 슬롯 (round-robin) */
+    size_t dequant_bytes;      /* INT8 → FP32 캐시 합계 (추론 경로는 INT8을 직접 읽으므로 보통 0) */
+    void* map_base;            /* 호스트 mmap 영역 (텐서가 제자리 참조, weights_free에서 munmap). 없으면 NULL */
+    size_t map_size;
+    const int32_t* index;      /* 이름 해시 (FNV-1a, open addressing): 슬롯 = 텐서 번호 + 1, 0 = 빈 슬롯. 스트림은 파싱 시 생성, 컨테이너는 파일 안 */
+    uint32_t index_mask;       /* 슬롯 수 - 1 (2의 거듭제곱, 텐서 수의 2배 이상) */
+    const void* container;     /* 컨테이너(.ymdl)면 헤더 주소: 이름/해시/payload를 제자리 참조. 스트림 형식은 NULL */
+    void* blob;                /* COPY 방식 컨테이너의 파일 버퍼 (weights_free에서 해제) */
+    uint32_t layout;           /* WEIGHTS_LAYOUT_* (weights_container.h, 스트림 형식은 OIHW) */
+    unsigned char embedded;    /* 1 = 컴파일 시 생성된 정적 테이블 (공유, weights_free는 loader만 비움) */
 } weights_loader_t;
 
+/* 이름 조회 결과를 init 시 1회 저장해 두고 프레임 경로에서 문자열 처리 없이 사용 */
+typedef struct {
+    const void* data;          /* FP32: float*, INT8: int8_t* */
+    float scale;               /* INT8 디양자화 scale (FP32는 0) */
+    int is_int8;
+    size_t num_elements;
+    int32_t index;             /* loader->tensors 안 번호 (디양자화 캐시용) */
+} weights_ref_t;
+
+/* 호스트 파일 로드 방식 (*_ex의 flags). mmap이 없는 플랫폼(Windows 등)·-DWEIGHTS_NO_MMAP은 항상 COPY */
+#define WEIGHTS_LOAD_COPY     0x0u  /* fread + 텐서별 malloc/복사 */
+#define WEIGHTS_LOAD_MMAP     0x1u  /* 읽기 전용 mmap + 제자리 파싱 (DDR과 같은 zero-copy). 프로세스끼리 페이지 캐시 공유 */
+#define WEIGHTS_LOAD_POPULATE 0x2u  /* MMAP + MAP_POPULATE (Linux): 로드 시 전부 적재 → 첫 프레임 page fault 없음 */
+#define WEIGHTS_LOAD_WILLNEED 0x4u  /* MMAP + madvise(MADV_WILLNEED): 비동기 readahead */
+#ifndef WEIGHTS_LOAD_DEFAULT
+#define WEIGHTS_LOAD_DEFAULT  WEIGHTS_LOAD_MMAP
+#endif
+
+/* weights.bin 스트림 또는 컨테이너(.ymdl, 매직으로 구분). 컨테이너는 파싱 없이 헤더 확인 + 디렉터리 복사만 (O(텐서 수) 대입) */
 int weights_init_from_memory(uintptr_t base_addr, size_t size, weights_loader_t* loader);
 
+#ifndef BARE_METAL
+/* WEIGHTS_LOAD_DEFAULT로 로드 */
 int weights_load_from_file(const char* bin_path, weights_loader_t* loader);
 
-/* W8A32: weights_w8.bin 로드 (scale은 w8 내부 텐서 헤더에 포함). INT8 텐서는 get 시 디양자화해 float* 반환. */
+/* W8A32: weights_w8.bin 로드 (scale은 w8 내부 텐서 헤더에 포함). INT8 텐서를 float*로 get하면 디양자화 캐시 반환. */
 int weights_load_from_file_w8(const char* w8_path, weights_loader_t* loader);
 
+/* flags: WEIGHTS_LOAD_*. 0 성공, -1 실패. 두 함수 모두 컨테이너(.ymdl) 파일도 받음 */
+int weights_load_from_file_ex(const char* bin_path, weights_loader_t* loader, unsigned flags);
+int weights_load_from_file_w8_ex(const char* w8_path, weights_loader_t* loader, unsigned flags);
+#endif
+
 #ifdef BARE_METAL
 int weights_init_from_memory_w8(uintptr_t w8_base, size_t w8_size, weights_loader_t* loader);
 #endif
 
-// 특정 이름의 텐서 찾기
+/* 컨테이너 앞부분 (헤더~이름, header.data_offset 바이트)만으로 로더 구성: 이름/shape/scale/해시는 meta를 참조,
+ * payload 포인터는 NULL (weights_stream이 레이어 버퍼 안으로 채움). meta는 loader보다 오래 유지. 0 성공, -1 실패 */
+int weights_init_container_meta(const void* meta, size_t meta_size, weights_loader_t* loader);
+
+#ifdef YOLO_EMBEDDED_MODEL
+/* tools/gen_embedded_model.py가 생성 (yolo_model_embedded.c + .incbin 어셈블리): 텐서·해시 테이블이 정적 초기화된 로더 */
+extern const weights_loader_t yolo_embedded_weights;
+
+/* 정적 테이블 대입만 (파싱·heap 없음). 테이블은 모든 loader가 공유하므로 INT8 텐서의 FP32 조회
+ * (weights_ref_data/weights_get_tensor_data)는 NULL — 추론은 바인딩으로 INT8을 직접 읽음. 0 성공, -1 빈 테이블 */
+int weights_init_embedded(weights_loader_t* loader);
+#endif
+
+// 특정 이름의 텐서 찾기 (해시 조회, "model.X"는 "model.model.X"로도 찾음)
 // 반환값: 텐서 포인터, 없으면 NULL
 const tensor_info_t* weights_find_tensor(const weights_loader_t* loader, const char* name);
 
-/* INT8 시 풀 슬롯을 채우므로 loader는 non-const */
+/* name → ref (포인터, scale, dtype). 0 성공, -1 없음 (ref는 0으로) */
+int weights_bind(const weights_loader_t* loader, const char* name, weights_ref_t* ref);
+
+/* ref의 FP32 데이터: FP32는 그대로, INT8은 텐서별 디양자화 캐시 (첫 호출에 malloc + 복원, 이후 같은 포인터).
+ * 캐시는 loader를 고치므로 한 loader를 여러 스레드가 동시에 부르면 안 됨. 메모리 부족이면 NULL.
+ * 정적 테이블(embedded)의 INT8은 미지원 → NULL */
+const float* weights_ref_data(weights_loader_t* loader, const weights_ref_t* ref);
+
+/* FP32 포인터 (INT8은 weights_ref_data와 같은 캐시). 추론 경로는 weights_get_tensor_for_conv/바인딩으로 INT8 직접 사용 */
 const float* weights_get_tensor_data(weights_loader_t* loader, const char* name);
 
-/* W8A32 즉시 복원용: (ptr, scale, is_int8) 반환. conv_block/c3/detect에서 사용. */
+/* W8A32 즉시 복원용: (ptr, scale, is_int8) 반환. conv_block/c3/sppf/detect에서 사용. */
 void* weights_get_tensor_for_conv(weights_loader_t* loader, const char* name, float* out_scale, int* out_is_int8);
 
 void weights_free(weights_loader_t* loader);
@@ -0,0 +1,341 @@
+#include "weights_stream.h"
+#include "weights_container.h"
+#include "mcycle.h"
+
+#include <stdlib.h>
+#include <string.h>
+#ifndef BARE_METAL
+#include <stdio.h>
+#endif
+
+#if !defined(BARE_METAL) && !defined(WEIGHTS_STREAM_NO_THREAD)
+#define WEIGHTS_STREAM_THREAD 1
+#include <pthread.h>
+#endif
+
+/* 레이어 하나의 payload 범위 (파일 안 연속: 첫 텐서 시작 ~ 마지막 텐서 끝) */
+typedef struct {
+    uint32_t offset;
+    uint32_t bytes;
+} stream_group_t;
+
+struct weights_stream {
+    weights_loader_t* loader;
+#ifndef BARE_METAL
+    FILE* file;                  /* 파일 원본 (reader만 사용) */
+#endif
+    const uint8_t* src;          /* 메모리 원본 (플래시 대용) */
+    size_t meta_bytes;
+    uint8_t* slot_raw;
+    uint8_t* slot[2];            /* WEIGHTS_CONTAINER_ALIGN 정렬 */
+    size_t slot_bytes;
+    stream_group_t group[WEIGHTS_STREAM_MAX_LAYERS];
+    int32_t num_groups;
+    int8_t layer_group[WEIGHTS_STREAM_MAX_LAYERS];  /* 레이어 → 그룹, -1 = 가중치 없음 */
+    int32_t cur;                 /* 마지막으로 확보한 그룹 (-1: 없음) */
+    int32_t slot_group[2];       /* 슬롯에 다 읽힌 그룹, -1 = 비었거나 읽는 중 */
+    int32_t want;                /* reader에 요청한 그룹 (-1: 없음) */
+    int32_t loading;             /* reader가 읽는 중인 그룹 (-1: 없음) */
+    int error;
+    weights_stream_stats_t stats;
+#ifdef WEIGHTS_STREAM_THREAD
+    pthread_t reader;
+    pthread_mutex_t mu;
+    pthread_cond_t cv;
+    int quit;
+#endif
+};
+
+/* "model.<K>." / "model.model.<K>." → K, 아니면 -1 */
+static int32_t layer_of(const char* name) {
+    int32_t k = 0;
+    if (strncmp(name, "model.", 6) != 0) return -1;
+    name += 6;
+    if (strncmp(name, "model.", 6) == 0) name += 6;
+    if (*name < '0' || *name > '9') return -1;
+    while (*name >= '0' && *name <= '9' && k < WEIGHTS_STREAM_MAX_LAYERS) k = k * 10 + (*name++ - '0');
+    return *name == '.' && k < WEIGHTS_STREAM_MAX_LAYERS ? k : -1;
+}
+
+/* 디렉터리 → 레이어 그룹. 텐서는 레이어 순서로 연속 (pack_weights_container.py가 export 순서 유지) */
+static int build_groups(weights_stream_t* s, const uint8_t* meta) {
+    const weights_container_header_t* h = (const weights_container_header_t*)meta;
+    const weights_container_entry_t* e = (const weights_container_entry_t*)(meta + h->dir_offset);
+    const weights_loader_t* wl = s->loader;
+    int32_t prev = -1;
+    uint32_t end = 0;
+    memset(s->layer_group, -1, sizeof(s->layer_group));
+    s->num_groups = 0;
+    for (int32_t i = 0; i < wl->num_tensors; i++) {
+        const int32_t k = layer_of(wl->tensors[i].name);
+        if (k < 0 || k < prev || e[i].data_offset < end) return -1;
+        if (k != prev) {
+            stream_group_t* g = &s->group[s->num_groups];
+            s->layer_group[k] = (int8_t)s->num_groups++;
+            g->offset = e[i].data_offset;
+            prev = k;
+        }
+        end = e[i].data_offset + e[i].data_bytes;
+        s->group[s->num_groups - 1].bytes = end - s->group[s->num_groups - 1].offset;
+    }
+    s->stats.groups = s->num_groups;
+    return s->num_groups > 0 ? 0 : -1;
+}
+
+/* 슬롯 2개 할당 + 텐서 포인터를 자기 그룹의 슬롯 안으로 고정 */
+static int setup_slots(weights_stream_t* s, const uint8_t* meta) {
+    const weights_container_header_t* h = (const weights_container_header_t*)meta;
+    const weights_container_entry_t* e = (const weights_container_entry_t*)(meta + h->dir_offset);
+    weights_loader_t* wl = s->loader;
+    size_t total = 0;
+    s->slot_bytes = 0;
+    for (int32_t g = 0; g < s->num_groups; g++) {
+        if (s->group[g].bytes > s->slot_bytes) s->slot_bytes = s->group[g].bytes;
+        total += s->group[g].bytes;
+    }
+    s->slot_raw = (uint8_t*)malloc(2u * s->slot_bytes + WEIGHTS_CONTAINER_ALIGN);
+    if (!s->slot_raw) return -1;
+    s->slot[0] = (uint8_t*)(((uintptr_t)s->slot_raw + WEIGHTS_CONTAINER_ALIGN - 1u) & ~(uintptr_t)(WEIGHTS_CONTAINER_ALIGN - 1u));
+    s->slot[1] = s->slot[0] + ((s->slot_bytes + WEIGHTS_CONTAINER_ALIGN - 1u) & ~(size_t)(WEIGHTS_CONTAINER_ALIGN - 1u));
+    for (int32_t i = 0; i < wl->num_tensors; i++) {
+        const int32_t g = s->layer_group[layer_of(wl->tensors[i].name)];
+        uint8_t* p = s->slot[g & 1] + (e[i].data_offset - s->group[g].offset);
+        if (wl->tensors[i].dtype == WEIGHTS_DTYPE_INT8)
+            wl->tensors[i].data_int8 = (int8_t*)p;
+        else
+            wl->tensors[i].data = (float*)p;
+    }
+    s->slot_group[0] = s->slot_group[1] = -1;
+    s->stats.slot_bytes = s->slot_bytes;
+    s->stats.resident_bytes = 2u * s->slot_bytes + s->meta_bytes;
+    s->stats.total_bytes = total;
+    return 0;
+}
+
+/* 그룹 g → 슬롯 g & 1 (reader 또는 동기 경로에서만) */
+static int read_group(weights_stream_t* s, int32_t g) {
+    const stream_group_t* gr = &s->group[g];
+    uint8_t* dst = s->slot[g & 1];
+#ifndef BARE_METAL
+    if (s->file)
+        return fseek(s->file, (long)gr->offset, SEEK_SET) == 0 && fread(dst, 1, gr->bytes, s->file) == gr->bytes ? 0 : -1;
+#endif
+    memcpy(dst, s->src + gr->offset, gr->bytes);
+    return 0;
+}
+
+/* 읽기 1회 + 통계 (reader 스레드는 mu 밖에서 부르고 결과만 잠근 채 반영) */
+static int timed_read(weights_stream_t* s, int32_t g, uint64_t* dt) {
+    const uint64_t t0 = timer_read64();
+    const int rc = read_group(s, g);
+    *dt = timer_delta64(t0, timer_read64());
+    return rc;
+}
+
+static void account(weights_stream_t* s, int32_t g, int rc, uint64_t dt) {
+    s->stats.read_time += dt;
+    if (rc != 0) {
+        s->error = 1;
+        return;
+    }
+    s->slot_group[g & 1] = g;
+    s->stats.loads++;
+    s->stats.bytes += s->group[g].bytes;
+}
+
+#ifdef WEIGHTS_STREAM_THREAD
+static void* reader_main(void* arg) {
+    weights_stream_t* s = (weights_stream_t*)arg;
+    pthread_mutex_lock(&s->mu);
+    while (!s->quit) {
+        if (s->want < 0) {
+            pthread_cond_wait(&s->cv, &s->mu);
+            continue;
+        }
+        const int32_t g = s->want;
+        uint64_t dt;
+        s->want = -1;
+        s->loading = g;
+        s->slot_group[g & 1] = -1;
+        pthread_mutex_unlock(&s->mu);
+        const int rc = timed_read(s, g, &dt);
+        pthread_mutex_lock(&s->mu);
+        s->loading = -1;
+        account(s, g, rc, dt);
+        pthread_cond_broadcast(&s->cv);
+    }
+    pthread_mutex_unlock(&s->mu);
+    return NULL;
+}
+
+/* mu 잠근 상태: g가 슬롯에 없고 읽는 중도 아니면 reader에 요청 (대기 중 요청은 덮어씀) */
+static void request(weights_stream_t* s, int32_t g) {
+    if (s->slot_group[g & 1] == g || s->loading == g || s->want == g) return;
+    s->want = g;
+    pthread_cond_broadcast(&s->cv);
+}
+#endif
+
+int weights_stream_layer(weights_stream_t* s, int32_t layer) {
+    if (!s) return -1;
+    const int32_t g = layer >= 0 && layer < WEIGHTS_STREAM_MAX_LAYERS ? s->layer_group[layer] : -1;
+    int rc = 0;
+#ifdef WEIGHTS_STREAM_THREAD
+    pthread_mutex_lock(&s->mu);
+    if (g >= 0) {
+        if (s->slot_group[g & 1] == g) {
+            s->stats.hits++;
+        } else {
+            const uint64_t t0 = timer_read64();
+            while (s->slot_group[g & 1] != g && !s->error) {
+                request(s, g);
+                pthread_cond_wait(&s->cv, &s->mu);
+            }
+            s->stats.stall_time += timer_delta64(t0, timer_read64());
+        }
+        s->cur = g;
+    }
+    /* 다음 그룹 미리 읽기: 다른 슬롯이면 바로, 같은 슬롯(그룹 수 홀수의 프레임 경계)이면 현재 그룹이 끝난 뒤
+     * (가중치 없는 레이어 진입 = 앞 레이어 연산 끝) */
+    if (s->cur >= 0 && !s->error) {
+        const int32_t next = (s->cur + 1) % s->num_groups;
+        if ((next & 1) != (s->cur & 1) || g < 0) request(s, next);
+    }
+    rc = s->error ? -1 : 0;
+    pthread_mutex_unlock(&s->mu);
+#else
+    if (g >= 0) {
+        if (s->slot_group[g & 1] == g) {
+            s->stats.hits++;
+        } else {
+            uint64_t dt;
+            s->slot_group[g & 1] = -1;
+            const int r = timed_read(s, g, &dt);
+            account(s, g, r, dt);
+            s->stats.stall_time += dt;
+        }
+        s->cur = g;
+    }
+    rc = s->error ? -1 : 0;
+#endif
+    return rc;
+}
+
+void weights_stream_get_stats(const weights_stream_t* s, weights_stream_stats_t* st) {
+    if (!st) return;
+    memset(st, 0, sizeof(*st));
+    if (!s) return;
+#ifdef WEIGHTS_STREAM_THREAD
+    pthread_mutex_lock((pthread_mutex_t*)&s->mu);
+#endif
+    *st = s->stats;
+#ifdef WEIGHTS_STREAM_THREAD
+    pthread_mutex_unlock((pthread_mutex_t*)&s->mu);
+#endif
+    st->overlap = st->read_time > 0 && st->stall_time < st->read_time
+                      ? 1.0f - (float)st->stall_time / (float)st->read_time : 0.0f;
+}
+
+void weights_stream_close(weights_stream_t* s) {
+    if (!s) return;
+#ifdef WEIGHTS_STREAM_THREAD
+    pthread_mutex_lock(&s->mu);
+    s->quit = 1;
+    pthread_cond_broadcast(&s->cv);
+    pthread_mutex_unlock(&s->mu);
+    pthread_join(s->reader, NULL);
+    pthread_cond_destroy(&s->cv);
+    pthread_mutex_destroy(&s->mu);
+#endif
+#ifndef BARE_METAL
+    if (s->file) fclose(s->file);
+#endif
+    free(s->slot_raw);
+    free(s);
+}
+
+/* 메타데이터(헤더~이름)로 loader 구성 → 그룹/슬롯 → reader 시작. meta는 loader->blob (weights_free가 해제) */
+static weights_stream_t* stream_start(weights_stream_t* s, uint8_t* meta, size_t meta_bytes, weights_loader_t* loader) {
+    s->loader = loader;
+    s->meta_bytes = meta_bytes;
+    s->cur = -1;
+    s->want = -1;
+    s->loading = -1;
+    if (weights_init_container_meta(meta, meta_bytes, loader) != 0) {
+        free(meta);
+        free(s);
+        return NULL;
+    }
+    loader->blob = meta;
+    if (build_groups(s, meta) != 0 || setup_slots(s, meta) != 0) {
+        weights_free(loader);
+        free(s->slot_raw);
+        free(s);
+        return NULL;
+    }
+#ifdef WEIGHTS_STREAM_THREAD
+    pthread_mutex_init(&s->mu, NULL);
+    pthread_cond_init(&s->cv, NULL);
+    if (pthread_create(&s->reader, NULL, reader_main, s) != 0) {
+        pthread_cond_destroy(&s->cv);
+        pthread_mutex_destroy(&s->mu);
+        weights_free(loader);
+        free(s->slot_raw);
+        free(s);
+        return NULL;
+    }
+#endif
+    return s;
+}
+
+/* 헤더만 보고 메타데이터 크기 (data_offset). 컨테이너 아니면 0 */
+static size_t meta_size(const weights_container_header_t* h, size_t avail) {
+    if (avail < sizeof(*h) || memcmp(h->magic, WEIGHTS_CONTAINER_MAGIC, 4) != 0 || h->data_offset < sizeof(*h) ||
+        h->data_offset > h->file_size)
+        return 0;
+    return h->data_offset;
+}
+
+weights_stream_t* weights_stream_open_memory(const void* base, size_t size, weights_loader_t* loader) {
+    if (!base || !loader) return NULL;
+    const weights_container_header_t* h = (const weights_container_header_t*)base;
+    const size_t mb = meta_size(h, size);
+    if (mb == 0 || h->file_size > size) return NULL;
+    weights_stream_t* s = (weights_stream_t*)calloc(1, sizeof(*s));
+    uint8_t* meta = (uint8_t*)malloc(mb);
+    if (!s || !meta) {
+        free(s);
+        free(meta);
+        return NULL;
+    }
+    memcpy(meta, base, mb);
+    s->src = (const uint8_t*)base;
+    return stream_start(s, meta, mb, loader);
+}
+
+#ifndef BARE_METAL
+weights_stream_t* weights_stream_open_file(const char* path, weights_loader_t* loader) {
+    if (!path || !loader) return NULL;
+    weights_container_header_t h;
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "Error: Cannot open %s\n", path);
+        return NULL;
+    }
+    size_t mb = fread(&h, 1, sizeof(h), f) == sizeof(h) ? meta_size(&h, sizeof(h)) : 0;
+    if (mb && (fseek(f, 0, SEEK_END) != 0 || ftell(f) < (long)h.file_size)) mb = 0;  /* 잘린 파일 */
+    weights_stream_t* s = mb ? (weights_stream_t*)calloc(1, sizeof(*s)) : NULL;
+    uint8_t* meta = mb ? (uint8_t*)malloc(mb) : NULL;
+    if (!s || !meta || fseek(f, 0, SEEK_SET) != 0 || fread(meta, 1, mb, f) != mb) {
+        if (!mb) fprintf(stderr, "Error: %s is not a weights container (.ymdl)\n", path);
+        free(s);
+        free(meta);
+        fclose(f);
+        return NULL;
+    }
+    s->file = f;
+    s = stream_start(s, meta, mb, loader);
+    if (!s) fclose(f);
+    return s;
+}
+#endif
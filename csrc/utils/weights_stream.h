@@ -0,0 +1,52 @@
+/**
+ * 레이어 단위 가중치 스트리밍 (메모리 제약 타깃): 컨테이너(.ymdl)의 payload를 파일/플래시(메모리) 원본에서
+ * 레이어 그룹("model.<K>.") 단위로 슬롯 2개(더블 버퍼)에 읽어 옴 → 상주 가중치 = 가장 큰 그룹 × 2 + 메타데이터.
+ * - 그룹 g는 항상 슬롯 g & 1: 텐서 포인터는 open 시 고정 (바인딩 그대로, 프레임마다 다시 바인딩 없음).
+ * - weights_stream_layer(L): 레이어 L 진입 시 호출. L의 그룹이 슬롯에 없으면 기다림(stall),
+ *   이어서 다음 그룹을 다른 슬롯으로 미리 읽기 (레이어 N 연산 중 N+1 읽기).
+ * - 호스트: 백그라운드 reader 스레드 (pthread, 오래된 glibc는 -pthread 필요).
+ *   BARE_METAL·-DWEIGHTS_STREAM_NO_THREAD: 필요할 때 동기 읽기 (겹침 없음).
+ * 슬롯 안 가중치는 레이어마다 바뀜 → weights_ref_data/디양자화 캐시(weights_get_tensor_data)는 스트리밍 중 사용 불가.
+ */
+#ifndef WEIGHTS_STREAM_H
+#define WEIGHTS_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "weights_loader.h"
+
+#define WEIGHTS_STREAM_MAX_LAYERS 64   /* "model.<K>."의 K 상한 */
+
+typedef struct weights_stream weights_stream_t;
+
+/** 누적 통계 (시간: 호스트 us, BARE_METAL mcycle) */
+typedef struct {
+    int32_t groups;            /* 가중치 있는 레이어 수 */
+    uint32_t loads;            /* 슬롯 읽기 횟수 */
+    uint32_t hits;             /* 레이어 진입 시 이미 슬롯에 있던 횟수 (미리 읽기 성공) */
+    uint64_t bytes;            /* 읽은 payload 합계 */
+    uint64_t read_time;        /* reader가 읽는 데 쓴 시간 */
+    uint64_t stall_time;       /* 추론 스레드가 기다린 시간 */
+    float overlap;             /* 읽기 중 연산과 겹친 비율: 1 - stall/read (동기 모드 0) */
+    size_t slot_bytes;         /* 슬롯 1개 (가장 큰 그룹) */
+    size_t resident_bytes;     /* 슬롯 2개 + 메타데이터 (헤더~이름) */
+    size_t total_bytes;        /* 전체 payload (한 번에 올릴 때) */
+} weights_stream_stats_t;
+
+#ifndef BARE_METAL
+/** 호스트 파일(.ymdl)에서 스트리밍. loader는 메타데이터로 구성 (payload 포인터는 슬롯 안). 실패 NULL */
+weights_stream_t* weights_stream_open_file(const char* path, weights_loader_t* loader);
+#endif
+
+/** 메모리(플래시 대용) 안 컨테이너에서 스트리밍. base는 stream보다 오래 유지. 실패 NULL */
+weights_stream_t* weights_stream_open_memory(const void* base, size_t size, weights_loader_t* loader);
+
+/** 레이어 진입: 그룹 확보(필요하면 대기) + 다음 그룹 미리 읽기. 가중치 없는 레이어도 호출 (슬롯 반환 시점). 0 성공, -1 읽기 실패 */
+int weights_stream_layer(weights_stream_t* s, int32_t layer);
+
+void weights_stream_get_stats(const weights_stream_t* s, weights_stream_stats_t* st);
+
+/** reader 종료 + 슬롯 해제. 메타데이터는 loader->blob → weights_free(loader)가 해제 (close 다음에) */
+void weights_stream_close(weights_stream_t* s);
+
+#endif // WEIGHTS_STREAM_H
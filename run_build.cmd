@@ -9,9 +9,9 @@ if not exist "%GCC%" (
 echo Building main.exe with %GCC% ...
 call "%GCC%" -o main.exe ^
   csrc/main.c ^
-  csrc/blocks/conv.c csrc/blocks/c3.c csrc/blocks/decode.c csrc/blocks/detect.c csrc/blocks/nms.c csrc/blocks/sppf.c ^
-  csrc/operations/bottleneck.c csrc/operations/concat.c csrc/operations/conv2d.c csrc/operations/maxpool2d.c csrc/operations/silu.c csrc/operations/upsample.c ^
-  csrc/utils/feature_pool.c csrc/utils/image_loader.c csrc/utils/weights_loader.c csrc/utils/timing.c csrc/utils/uart_dump.c ^
+  csrc/blocks/conv.c csrc/blocks/c3.c csrc/blocks/decode.c csrc/blocks/detect.c csrc/blocks/nms.c csrc/blocks/sppf.c csrc/blocks/det_sort.c csrc/blocks/yolov5n.c ^
+  csrc/operations/bottleneck.c csrc/operations/concat.c csrc/operations/conv2d.c csrc/operations/maxpool2d.c csrc/operations/silu.c csrc/operations/upsample.c csrc/operations/halo.c csrc/operations/conv2d_spm.c csrc/operations/conv2d_q.c ^
+  csrc/utils/feature_pool.c csrc/utils/image_loader.c csrc/utils/weights_loader.c csrc/utils/timing.c csrc/utils/uart_dump.c csrc/utils/mem_plan.c csrc/utils/pool_first_fit.c csrc/utils/pool_tlsf.c csrc/utils/letterbox.c csrc/utils/weights_stream.c csrc/utils/dma.c csrc/utils/cache_sim.c ^
   -I. -Icsrc -std=c99 -O2 -lm ^
   1>gcc_out.txt 2>gcc_err.txt
 
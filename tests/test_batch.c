@@ -0,0 +1,157 @@
+/* 배치 추론 테스트: infer_batch(n장) 결과 == 이미지별 infer (비트 동일), 배치 블록 나머지, 풀 계획, 배치 크기별 처리량.
+ * ./test_batch [max_n]: max_n > 0이면 n = 1..max_n 처리량 측정 (기본: 정확성 + n=1/5만) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/blocks/yolov5n.h"
+#include "../csrc/utils/image_loader.h"
+#include "../csrc/utils/mcycle.h"
+
+#ifdef USE_WEIGHTS_W8
+#define WEIGHTS_PATH "assets/weights_w8.bin"
+#else
+#define WEIGHTS_PATH "assets/weights.bin"
+#endif
+
+#define NUM_VARIANTS 3
+#define MAX_BATCH    16
+
+static detection_t ref_dets[NUM_VARIANTS][YOLO_MAX_DETECTIONS];
+static int32_t ref_count[NUM_VARIANTS];
+static detection_t batch_dets[MAX_BATCH][YOLO_MAX_DETECTIONS];
+static int32_t batch_count[MAX_BATCH];
+
+/* 서로 다른 입력: 원본 / 좌우 반전 / 어둡게 (0.6배) */
+static int make_variant(const preprocessed_image_t* src, int v, preprocessed_image_t* dst) {
+    *dst = *src;
+    const size_t plane = (size_t)src->h * (size_t)src->w;
+    dst->data = (float*)malloc((size_t)src->c * plane * sizeof(float));
+    if (!dst->data) return -1;
+    dst->data_owned = 1;
+    for (int32_t c = 0; c < src->c; c++) {
+        for (int32_t y = 0; y < src->h; y++) {
+            const float* s = src->data + c * plane + (size_t)y * src->w;
+            float* d = dst->data + c * plane + (size_t)y * src->w;
+            for (int32_t x = 0; x < src->w; x++) {
+                if (v == 0) d[x] = s[x];
+                else if (v == 1) d[x] = s[src->w - 1 - x];
+                else d[x] = s[x] * 0.6f;
+            }
+        }
+    }
+    return 0;
+}
+
+static int pool_ok(yolo_ctx_t* ctx) {
+    feature_pool_t* prev = feature_pool_bind(ctx->pool);
+    feature_pool_stats_t st;
+    feature_pool_get_stats(&st);
+    feature_pool_bind(prev);
+    return ctx->plan_active && st.failed_allocs == 0 && st.num_allocs == ctx->plan.num_tensors &&
+           st.live_bytes == 0;
+}
+
+int main(int argc, char* argv[]) {
+    printf("=== Batched Inference Test ===\n\n");
+    int ok = 1;
+    int max_n = argc > 1 ? atoi(argv[1]) : 0;
+    if (max_n > MAX_BATCH) max_n = MAX_BATCH;
+    preprocessed_image_t src, var[NUM_VARIANTS];
+    static yolo_ctx_t ctx;
+
+    if (image_load_from_bin("data/input/preprocessed_image.bin", &src) != 0) {
+        fprintf(stderr, "Failed to load image\n");
+        return 1;
+    }
+    for (int v = 0; v < NUM_VARIANTS; v++) {
+        if (make_variant(&src, v, &var[v]) != 0) {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+    }
+    if (yolo_ctx_init_from_file(&ctx, WEIGHTS_PATH) != 0) {
+        fprintf(stderr, "Failed to init context (%s)\n", WEIGHTS_PATH);
+        return 1;
+    }
+    ctx.verbose = 0;
+
+    /* 1. 기준: 이미지별 yolo_infer */
+    uint64_t t_single = 0;
+    for (int v = 0; v < NUM_VARIANTS; v++) {
+        if (yolo_infer(&ctx, &var[v], ref_dets[v], YOLO_MAX_DETECTIONS, &ref_count[v]) != 0 || ref_count[v] <= 0) {
+            printf("ERROR: single inference %d (count=%d)\n", v, (int)ref_count[v]);
+            ok = 0;
+        }
+        t_single += ctx.profile.total;
+    }
+    printf("single: %d / %d / %d detections, %.2f ms/frame\n",
+           (int)ref_count[0], (int)ref_count[1], (int)ref_count[2], t_single / 1000.0 / NUM_VARIANTS);
+
+    /* 2. 배치 5장 (배치 블록 4 + 나머지 1, 순서 섞음) → 이미지별 결과와 비트 동일 */
+    {
+        static const int order[5] = {0, 1, 2, 1, 0};
+        const preprocessed_image_t* imgs[5];
+        for (int i = 0; i < 5; i++) imgs[i] = &var[order[i]];
+        if (yolo_ctx_set_batch(&ctx, 5) != 0 || ctx.batch != 5) { printf("ERROR: set_batch(5)\n"); ok = 0; }
+        if (yolo_infer_batch(&ctx, imgs, 5, &batch_dets[0][0], YOLO_MAX_DETECTIONS, batch_count) != 0) {
+            printf("ERROR: batch inference\n");
+            ok = 0;
+        }
+        for (int i = 0; i < 5 && ok; i++) {
+            const int v = order[i];
+            if (batch_count[i] != ref_count[v] ||
+                memcmp(batch_dets[i], ref_dets[v], (size_t)ref_count[v] * sizeof(detection_t)) != 0) {
+                printf("ERROR: batch image %d differs from single (%d vs %d)\n", i, (int)batch_count[i], (int)ref_count[v]);
+                ok = 0;
+            }
+        }
+        if (!pool_ok(&ctx)) { printf("ERROR: pool stats after batch\n"); ok = 0; }
+        printf("batch 5: identical to single, %.2f ms/frame, planned peak %u KB\n",
+               ctx.profile.total / 1000.0 / 5, (unsigned)(ctx.plan.peak / 1024u));
+    }
+
+    /* 3. 배치 크기가 바뀌면 계획 자동 재구성 (n=1로 복귀) */
+    {
+        int32_t cnt = -1;
+        if (yolo_infer(&ctx, &var[1], batch_dets[0], YOLO_MAX_DETECTIONS, &cnt) != 0 || ctx.batch != 1 ||
+            cnt != ref_count[1] || memcmp(batch_dets[0], ref_dets[1], (size_t)cnt * sizeof(detection_t)) != 0 ||
+            !pool_ok(&ctx)) {
+            printf("ERROR: back to batch 1\n");
+            ok = 0;
+        }
+        const preprocessed_image_t* bad[2] = {&var[0], NULL};
+        if (yolo_infer_batch(&ctx, bad, 2, &batch_dets[0][0], YOLO_MAX_DETECTIONS, batch_count) != -1 ||
+            yolo_infer_batch(&ctx, bad, 0, &batch_dets[0][0], YOLO_MAX_DETECTIONS, batch_count) != -1) {
+            printf("ERROR: bad arguments accepted\n");
+            ok = 0;
+        }
+    }
+
+    /* 4. 처리량: n = 1..max_n (set_batch로 계획 준비 후 1회 측정, 계획 비용 제외) */
+    if (max_n > 0) printf("\n batch | ms/batch | ms/frame | frames/s\n");
+    for (int n = 1; n <= max_n && ok; n++) {
+        const preprocessed_image_t* imgs[MAX_BATCH];
+        for (int i = 0; i < n; i++) imgs[i] = &var[i % NUM_VARIANTS];
+        if (yolo_ctx_set_batch(&ctx, n) != 0 ||
+            yolo_infer_batch(&ctx, imgs, n, &batch_dets[0][0], YOLO_MAX_DETECTIONS, batch_count) != 0) {
+            printf("ERROR: batch %d\n", n);
+            ok = 0;
+            break;
+        }
+        const double ms = ctx.profile.total / 1000.0;
+        printf(" %5d | %8.1f | %8.1f | %8.3f\n", n, ms, ms / n, 1000.0 * n / ms);
+    }
+
+    yolo_ctx_destroy(&ctx);
+    for (int v = 0; v < NUM_VARIANTS; v++) image_free(&var[v]);
+    image_free(&src);
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
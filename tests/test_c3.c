@@ -74,7 +74,7 @@ int main(void) {
         bn_cv1_w_arr, bn_cv1_scale, bn_cv1_is_int8, bn_cv1_b_arr,
         bn_cv2_w_arr, bn_cv2_scale, bn_cv2_is_int8, bn_cv2_b_arr,
         1,
-        y_out);
+        y_out, 0);
     
     const int elems = n * c_out * h * w;
     float diff = max_abs_diff(y_out, tv_c3_y, elems);
@@ -0,0 +1,249 @@
+/* C3 cv1+cv2 합친 1x1 테스트: 출력 채널별 scale conv (FP32 W8/Q) = 텐서별 conv 2번 (비트 동일),
+ * c3_nchw_f32_merged (합친 FP32/INT8 가중치, 합치지 않은 경로) = 예전 경로 (cv1, cv2, bottleneck, concat, cv3),
+ * 배치 2, bottleneck 1·3개, halo 출력. L8 크기 cv1+cv2 따로/합친 시간 출력.
+ * 플래그 없이 빌드. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/conv2d_q.h"
+#include "../csrc/operations/silu.h"
+#include "../csrc/operations/bottleneck.h"
+#include "../csrc/operations/concat.h"
+#include "../csrc/operations/halo.h"
+#include "../csrc/blocks/c3.h"
+#include "../csrc/utils/feature_pool.h"
+#include "../csrc/utils/mcycle.h"
+
+#define N 2
+#define CI 24
+#define C_ 16
+#define CO 32
+#define H 12
+#define W 10
+#define HW (H * W)
+#define NB_MAX 3
+#define BENCH_ITER 10
+
+static int check(int cond, const char* what) {
+    if (!cond) printf("ERROR: %s\n", what);
+    return cond;
+}
+
+static void rand_f(float* p, int32_t count, float scale) {
+    for (int32_t i = 0; i < count; i++) p[i] = ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) * scale;
+}
+
+static void rand_i8(int8_t* p, int32_t count) {
+    for (int32_t i = 0; i < count; i++) p[i] = (int8_t)(rand() % 255 - 127);
+}
+
+static float x[N * CI * HW];
+static float w1[C_ * CI], w2[C_ * CI], w12[2 * C_ * CI], w3[CO * 2 * C_], b1[C_], b2[C_], b12[2 * C_], b3[CO];
+static int8_t q1[C_ * CI], q2[C_ * CI], q12[2 * C_ * CI], q3[CO * 2 * C_];
+static float s12[2 * C_];
+static float m_w1[NB_MAX][C_ * C_], m_w2[NB_MAX][C_ * C_ * 9], m_b1[NB_MAX][C_], m_b2[NB_MAX][C_];
+static int8_t m_q1[NB_MAX][C_ * C_], m_q2[NB_MAX][C_ * C_ * 9];
+
+/* 예전 C3 경로: cv1, cv2 (배치 연속 버퍼) → bottleneck 체인 → concat → cv3 */
+static void c3_reference(int int8, int32_t nb, float* y) {
+    static float t1[N * C_ * HW], t2[N * C_ * HW], ba[N * C_ * HW], bb[N * C_ * HW], cat[N * 2 * C_ * HW];
+    const float s1 = 0.011f, s2 = 0.013f, s3 = 0.009f, sm = 0.017f;
+    if (int8) {
+        conv2d_nchw_f32_w8(x, N, CI, H, W, q1, s1, C_, 1, 1, b1, 1, 1, 0, 0, 1, t1, H, W);
+        conv2d_nchw_f32_w8(x, N, CI, H, W, q2, s2, C_, 1, 1, b2, 1, 1, 0, 0, 1, t2, H, W);
+    } else {
+        conv2d_nchw_f32(x, N, CI, H, W, w1, C_, 1, 1, b1, 1, 1, 0, 0, 1, t1, H, W);
+        conv2d_nchw_f32(x, N, CI, H, W, w2, C_, 1, 1, b2, 1, 1, 0, 0, 1, t2, H, W);
+    }
+    silu_nchw_f32(t1, N, C_, H, W, t1);
+    silu_nchw_f32(t2, N, C_, H, W, t2);
+    const float* in = t1;
+    float* out = ba;
+    for (int32_t i = 0; i < nb; i++) {
+        out = (i % 2 == 0) ? ba : bb;
+        bottleneck_nchw_f32(in, N, C_, H, W,
+                            int8 ? (const void*)m_q1[i] : (const void*)m_w1[i], sm, int8, C_, m_b1[i],
+                            int8 ? (const void*)m_q2[i] : (const void*)m_w2[i], sm, int8, C_, m_b2[i], 1, out);
+        in = out;
+    }
+    concat_nchw_f32(out, C_, t2, C_, N, H, W, cat);
+    if (int8)
+        conv2d_nchw_f32_w8(cat, N, 2 * C_, H, W, q3, s3, CO, 1, 1, b3, 1, 1, 0, 0, 1, y, H, W);
+    else
+        conv2d_nchw_f32(cat, N, 2 * C_, H, W, w3, CO, 1, 1, b3, 1, 1, 0, 0, 1, y, H, W);
+    silu_nchw_f32(y, N, CO, H, W, y);
+}
+
+/* merged: 0 = cv1/cv2 따로, 1 = 합친 가중치. y는 halo 1 버퍼 → 내부만 비교 */
+static int c3_case(int int8, int32_t nb, int merged) {
+    static float ref[N * CO * HW], ybuf[N * CO * (H + 2) * (W + 2)];
+    const float s1 = 0.011f, s2 = 0.013f, s3 = 0.009f;
+    const void* bw1[NB_MAX], * bw2[NB_MAX];
+    float bs[NB_MAX];
+    int bi[NB_MAX];
+    const float* bb1[NB_MAX], * bb2[NB_MAX];
+    for (int32_t i = 0; i < NB_MAX; i++) {
+        bw1[i] = int8 ? (const void*)m_q1[i] : (const void*)m_w1[i];
+        bw2[i] = int8 ? (const void*)m_q2[i] : (const void*)m_w2[i];
+        bs[i] = 0.017f;
+        bi[i] = int8;
+        bb1[i] = m_b1[i];
+        bb2[i] = m_b2[i];
+    }
+    feature_pool_init();
+    c3_reference(int8, nb, ref);
+
+    memset(ybuf, 0, sizeof(ybuf));
+    float* y = halo_interior(ybuf, W, 1);
+    c3_nchw_f32_merged(x, N, CI, H, W,
+                       int8 ? (const void*)q1 : (const void*)w1, s1, int8, C_, b1,
+                       int8 ? (const void*)q2 : (const void*)w2, s2, int8, C_, b2,
+                       merged ? (int8 ? (const void*)q12 : (const void*)w12) : NULL, int8 ? s12 : NULL, b12,
+                       int8 ? (const void*)q3 : (const void*)w3, s3, int8, CO, b3,
+                       nb, bw1, bs, bi, bb1, bw2, bs, bi, bb2, 1, y, 1);
+    feature_pool_stats_t st;
+    feature_pool_get_stats(&st);
+
+    int same = st.live_bytes == 0;
+    for (int32_t c = 0; c < N * CO && same; c++)
+        for (int32_t r = 0; r < H && same; r++)
+            same = memcmp(y + c * HALO_PLANE(H, W, 1) + r * HALO_PITCH(W, 1), ref + (c * H + r) * W,
+                          W * sizeof(float)) == 0;
+    if (!same) printf("  mismatch int8=%d nb=%d merged=%d\n", int8, (int)nb, merged);
+    return same;
+}
+
+int main(void) {
+    printf("=== C3 Merged cv1+cv2 Test ===\n\n");
+    int ok = 1;
+    srand(5);
+    rand_f(x, N * CI * HW, 2.0f);
+    rand_f(w1, C_ * CI, 0.3f);
+    rand_f(w2, C_ * CI, 0.3f);
+    rand_f(w3, CO * 2 * C_, 0.2f);
+    rand_f(b1, C_, 0.1f);
+    rand_f(b2, C_, 0.1f);
+    rand_f(b3, CO, 0.1f);
+    rand_i8(q1, C_ * CI);
+    rand_i8(q2, C_ * CI);
+    rand_i8(q3, CO * 2 * C_);
+    for (int32_t i = 0; i < NB_MAX; i++) {
+        rand_f(m_w1[i], C_ * C_, 0.3f);
+        rand_f(m_w2[i], C_ * C_ * 9, 0.1f);
+        rand_f(m_b1[i], C_, 0.1f);
+        rand_f(m_b2[i], C_, 0.1f);
+        rand_i8(m_q1[i], C_ * C_);
+        rand_i8(m_q2[i], C_ * C_ * 9);
+    }
+    /* 로더와 같은 합치기: OIHW 출력 채널 방향으로 [cv1 | cv2] */
+    memcpy(w12, w1, sizeof(w1));
+    memcpy(w12 + C_ * CI, w2, sizeof(w2));
+    memcpy(q12, q1, sizeof(q1));
+    memcpy(q12 + C_ * CI, q2, sizeof(q2));
+    memcpy(b12, b1, sizeof(b1));
+    memcpy(b12 + C_, b2, sizeof(b2));
+    for (int32_t i = 0; i < C_; i++) {
+        s12[i] = 0.011f;
+        s12[C_ + i] = 0.013f;
+    }
+
+    /* 1. 출력 채널별 scale conv = 텐서별 conv 2번 (FP32 W8, Q). oc 블록 경계를 가로지르도록 c_out 48 */
+    {
+        enum { OC1 = 20, OC2 = 28, OC = OC1 + OC2 };
+        static int8_t wq[OC * CI];
+        static float sc[OC], bias[OC], ya[N * OC * HW], yb[N * OC * HW];
+        static int32_t xq[N * CI * HW], za[N * OC * HW], zb[N * OC * HW];
+        rand_i8(wq, OC * CI);
+        rand_f(bias, OC, 0.2f);
+        for (int32_t i = 0; i < OC; i++) sc[i] = i < OC1 ? 0.0123f : 0.0071f;
+        for (int32_t i = 0; i < N * CI * HW; i++) xq[i] = (int32_t)(x[i] * 4096.0f);
+        conv2d_nchw_f32_w8oc_halo(x, 0, 0, N, CI, H, W, wq, sc, OC, 1, 1, bias, 1, 1, 0, 0, ya, 0, 0, H, W);
+        conv2d_nchw_q_w8oc_halo(xq, 0, 0, N, CI, H, W, wq, sc, OC, 1, 1, bias, 1, 1, 0, 0, za, 0, 0, H, W);
+        for (int32_t ni = 0; ni < N; ni++) {
+            conv2d_nchw_f32_w8_halo(x + ni * CI * HW, 0, 0, 1, CI, H, W, wq, 0.0123f, OC1, 1, 1, bias,
+                                    1, 1, 0, 0, 1, yb + ni * OC * HW, 0, 0, H, W);
+            conv2d_nchw_f32_w8_halo(x + ni * CI * HW, 0, 0, 1, CI, H, W, wq + OC1 * CI, 0.0071f, OC2, 1, 1, bias + OC1,
+                                    1, 1, 0, 0, 1, yb + ni * OC * HW + OC1 * HW, 0, 0, H, W);
+            conv2d_nchw_q_w8_halo(xq + ni * CI * HW, 0, 0, 1, CI, H, W, wq, 0.0123f, OC1, 1, 1, bias,
+                                  1, 1, 0, 0, zb + ni * OC * HW, 0, 0, H, W);
+            conv2d_nchw_q_w8_halo(xq + ni * CI * HW, 0, 0, 1, CI, H, W, wq + OC1 * CI, 0.0071f, OC2, 1, 1, bias + OC1,
+                                  1, 1, 0, 0, zb + ni * OC * HW + OC1 * HW, 0, 0, H, W);
+        }
+        ok &= check(memcmp(ya, yb, sizeof(ya)) == 0, "w8oc conv == two w8 convs");
+        ok &= check(memcmp(za, zb, sizeof(za)) == 0, "q w8oc conv == two q convs");
+        printf("per-channel scale conv == two tensor-scale convs (FP32 W8, Q): %s\n",
+               memcmp(ya, yb, sizeof(ya)) == 0 && memcmp(za, zb, sizeof(za)) == 0 ? "bit-identical" : "DIFFERS");
+
+        /* 이미지 간격 (y_n_stride): 배치 그대로 concat 채널 구간에 씀 = 이미지마다 n=1 */
+        memset(ya, 0, sizeof(ya));
+        memset(za, 0, sizeof(za));
+        conv2d_nchw_f32_w8_halo(x, 0, 0, N, CI, H, W, wq, 0.0123f, OC1, 1, 1, bias,
+                                1, 1, 0, 0, 1, ya, 0, OC * HW, H, W);
+        conv2d_nchw_f32_w8_halo(x, 0, 0, N, CI, H, W, wq + OC1 * CI, 0.0071f, OC2, 1, 1, bias + OC1,
+                                1, 1, 0, 0, 1, ya + OC1 * HW, 0, OC * HW, H, W);
+        conv2d_nchw_q_w8_halo(xq, 0, 0, N, CI, H, W, wq, 0.0123f, OC1, 1, 1, bias,
+                              1, 1, 0, 0, za, 0, OC * HW, H, W);
+        conv2d_nchw_q_w8_halo(xq, 0, 0, N, CI, H, W, wq + OC1 * CI, 0.0071f, OC2, 1, 1, bias + OC1,
+                              1, 1, 0, 0, za + OC1 * HW, 0, OC * HW, H, W);
+        ok &= check(memcmp(ya, yb, sizeof(ya)) == 0, "strided w8 conv == per-image convs");
+        ok &= check(memcmp(za, zb, sizeof(za)) == 0, "strided q conv == per-image convs");
+        printf("image-strided output conv == per-image convs (FP32 W8, Q): %s\n",
+               memcmp(ya, yb, sizeof(ya)) == 0 && memcmp(za, zb, sizeof(za)) == 0 ? "bit-identical" : "DIFFERS");
+    }
+
+    /* 2. C3: 합친/따로 × FP32/INT8 × bottleneck 1·3 = 예전 경로 */
+    {
+        int32_t cases = 0;
+        for (int int8 = 0; int8 <= 1; int8++)
+            for (int32_t nb = 1; nb <= NB_MAX; nb += 2)
+                for (int merged = 0; merged <= 1; merged++) {
+                    ok &= check(c3_case(int8, nb, merged), "c3 merged == previous pipeline");
+                    cases++;
+                }
+        printf("C3 (n=2, merged/separate, FP32/INT8, 1 and 3 bottlenecks) == previous pipeline: %d cases\n",
+               (int)cases);
+    }
+
+    /* 3. 시간: L8 크기 (256 → 128+128, 640 입력 20x20) cv1·cv2 따로 vs 합친 1x1 (INT8) */
+    {
+        const int32_t ci = 256, c = 128, h = 20, w = 20;
+        float* xi = (float*)malloc(sizeof(float) * (size_t)ci * h * w);
+        float* yo = (float*)malloc(sizeof(float) * (size_t)2 * c * h * w);
+        int8_t* wq = (int8_t*)malloc((size_t)2 * c * ci);
+        float* sc = (float*)malloc(sizeof(float) * 2 * (size_t)c);
+        float* bias = (float*)malloc(sizeof(float) * 2 * (size_t)c);
+        if (xi && yo && wq && sc && bias) {
+            rand_f(xi, ci * h * w, 1.0f);
+            rand_i8(wq, 2 * c * ci);
+            rand_f(bias, 2 * c, 0.1f);
+            for (int32_t i = 0; i < 2 * c; i++) sc[i] = i < c ? 0.01f : 0.02f;
+            uint64_t t0 = timer_read64();
+            for (int32_t it = 0; it < BENCH_ITER; it++) {
+                conv2d_nchw_f32_w8_halo(xi, 0, 0, 1, ci, h, w, wq, 0.01f, c, 1, 1, bias, 1, 1, 0, 0, 1, yo, 0, 0, h, w);
+                conv2d_nchw_f32_w8_halo(xi, 0, 0, 1, ci, h, w, wq + c * ci, 0.02f, c, 1, 1, bias + c, 1, 1, 0, 0, 1,
+                                        yo + c * h * w, 0, 0, h, w);
+            }
+            const double t_sep = timer_delta64(t0, timer_read64()) / 1000.0 / BENCH_ITER;
+            t0 = timer_read64();
+            for (int32_t it = 0; it < BENCH_ITER; it++)
+                conv2d_nchw_f32_w8oc_halo(xi, 0, 0, 1, ci, h, w, wq, sc, 2 * c, 1, 1, bias, 1, 1, 0, 0, yo, 0, 0, h, w);
+            const double t_merged = timer_delta64(t0, timer_read64()) / 1000.0 / BENCH_ITER;
+            printf("\n L8 cv1+cv2 (256 -> 128+128 @20x20, INT8): separate %.3f ms, merged %.3f ms\n", t_sep, t_merged);
+        }
+        free(xi);
+        free(yo);
+        free(wq);
+        free(sc);
+        free(bias);
+    }
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
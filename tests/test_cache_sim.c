@@ -0,0 +1,169 @@
+/* 캐시 시뮬레이터 테스트: direct-mapped 충돌 미스, 2-way LRU 교체, write-back dirty 축출 / write-through no-allocate,
+ * 여러 라인에 걸친 접근, 레이어별 누적·전체 합, 사이클 추정식, 잘못된 형상 → -1.
+ * -DYOLO_CACHE_SIM으로 빌드하면 YOLO 크기 conv 하나를 캐시 형상(크기·way)별로 돌려 미스·stall 표 출력
+ * (플래그 없이 빌드하면 conv 계측이 없어 그 부분은 건너뜀). */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/utils/cache_sim.h"
+#include "../csrc/operations/conv2d.h"
+
+#define A(addr) ((const void*)(uintptr_t)(addr))
+
+static int check(int cond, const char* what) {
+    if (!cond) printf("ERROR: %s\n", what);
+    return cond;
+}
+
+static void small_config(cache_sim_config_t* cfg, uint32_t ways, int write_back) {
+    cache_sim_default_config(cfg);
+    cfg->size_bytes = 1024;
+    cfg->line_bytes = 32;
+    cfg->ways = ways;
+    cfg->write_back = write_back;
+}
+
+int main(void) {
+    printf("=== Cache Simulator Test ===\n\n");
+    int ok = 1;
+    cache_sim_config_t cfg;
+    cache_sim_layer_t l;
+
+    /* 1. direct-mapped: 같은 set의 두 라인이 서로 밀어냄 / 2-way는 둘 다 남음 */
+    small_config(&cfg, 1, 1);
+    ok &= check(cache_sim_configure(&cfg) == 0, "configure 1KB direct-mapped");
+    cache_sim_access(CSIM_INPUT, A(0x10000), 4, 0);
+    cache_sim_access(CSIM_INPUT, A(0x10400), 4, 0);
+    cache_sim_access(CSIM_INPUT, A(0x10000), 4, 0);
+    cache_sim_access(CSIM_INPUT, A(0x10004), 4, 0);   /* 같은 라인 → 히트 */
+    cache_sim_get_layer(0, &l);
+    ok &= check(l.access[CSIM_INPUT] == 4 && l.miss[CSIM_INPUT] == 3, "direct-mapped conflict misses");
+
+    small_config(&cfg, 2, 1);
+    cache_sim_configure(&cfg);
+    cache_sim_access(CSIM_INPUT, A(0x10000), 4, 0);
+    cache_sim_access(CSIM_INPUT, A(0x10200), 4, 0);   /* 512B set 간격 = 같은 set (16 sets × 32B) */
+    cache_sim_access(CSIM_INPUT, A(0x10000), 4, 0);
+    cache_sim_get_layer(0, &l);
+    ok &= check(l.miss[CSIM_INPUT] == 2, "2-way keeps both lines");
+
+    /* 2. LRU: A B A C(B 축출) → A 히트, B 미스 */
+    cache_sim_reset();
+    cache_sim_access(CSIM_WEIGHT, A(0x20000), 4, 0);
+    cache_sim_access(CSIM_WEIGHT, A(0x20200), 4, 0);
+    cache_sim_access(CSIM_WEIGHT, A(0x20000), 4, 0);
+    cache_sim_access(CSIM_WEIGHT, A(0x20400), 4, 0);
+    cache_sim_access(CSIM_WEIGHT, A(0x20000), 4, 0);
+    cache_sim_get_layer(0, &l);
+    const uint64_t m_before = l.miss[CSIM_WEIGHT];
+    cache_sim_access(CSIM_WEIGHT, A(0x20200), 4, 0);
+    cache_sim_get_layer(0, &l);
+    ok &= check(m_before == 3 && l.miss[CSIM_WEIGHT] == 4, "LRU victim");
+
+    /* 3. write-back: dirty 라인이 밀려날 때만 DDR 쓰기 (쓴 종류로 집계) */
+    small_config(&cfg, 1, 1);
+    cache_sim_configure(&cfg);
+    cache_sim_access(CSIM_OUTPUT, A(0x30000), 4, 1);
+    cache_sim_access(CSIM_OUTPUT, A(0x30004), 4, 1);
+    cache_sim_access(CSIM_INPUT, A(0x30400), 4, 0);
+    cache_sim_get_layer(0, &l);
+    ok &= check(l.miss[CSIM_OUTPUT] == 1 && l.writeback[CSIM_OUTPUT] == 1 && l.ddr_write_bytes == 32,
+                "write-back eviction");
+
+    /* write-through no-allocate: 쓰기 미스는 캐시에 안 올림, 저장마다 DDR 쓰기 */
+    small_config(&cfg, 1, 0);
+    cache_sim_configure(&cfg);
+    cache_sim_access(CSIM_OUTPUT, A(0x30000), 4, 1);
+    cache_sim_access(CSIM_OUTPUT, A(0x30000), 4, 0);   /* 올라가 있지 않음 → 미스 */
+    cache_sim_access(CSIM_OUTPUT, A(0x30000), 4, 1);   /* 히트, DDR에도 씀 */
+    cache_sim_access(CSIM_INPUT, A(0x30400), 4, 0);
+    cache_sim_get_layer(0, &l);
+    ok &= check(l.miss[CSIM_OUTPUT] == 1 && l.writeback[CSIM_OUTPUT] == 0 && l.ddr_write_bytes == 8,
+                "write-through no-allocate");
+
+    /* 4. 여러 라인에 걸친 접근: 0x..10부터 100바이트 → 라인 4개 */
+    small_config(&cfg, 1, 1);
+    cache_sim_configure(&cfg);
+    cache_sim_access(CSIM_ACC, A(0x40010), 100, 0);
+    cache_sim_get_layer(0, &l);
+    ok &= check(l.access[CSIM_ACC] == 4 && l.miss[CSIM_ACC] == 4, "range spans 4 lines");
+
+    /* 5. 레이어별 누적, 전체 합, 추정식, enable(0) */
+    cache_sim_set_layer(3);
+    cache_sim_add_macs(1000);
+    cache_sim_access(CSIM_WEIGHT, A(0x50000), 4, 0);
+    cache_sim_enable(0);
+    cache_sim_add_macs(5000);
+    cache_sim_access(CSIM_WEIGHT, A(0x60000), 4, 0);
+    cache_sim_enable(1);
+    cache_sim_get_layer(3, &l);
+    cache_sim_estimate_t e;
+    cache_sim_estimate(&l, &e);
+    const uint64_t fill = cfg.ddr_latency + cfg.line_bytes / cfg.ddr_bytes_per_cycle;
+    ok &= check(l.macs == 1000 && l.miss[CSIM_WEIGHT] == 1, "layer 3 stats");
+    ok &= check(e.compute_cycles == 1000u * cfg.mac_cycles && e.stall_cycles == fill, "estimate");
+    cache_sim_get_layer(-1, &l);
+    ok &= check(l.macs == 1000 && l.miss[CSIM_ACC] == 4 && l.miss[CSIM_WEIGHT] == 1, "total = sum of layers");
+
+    /* 6. 잘못된 형상 */
+    small_config(&cfg, 1, 1);
+    cfg.size_bytes = 3000;
+    ok &= check(cache_sim_configure(&cfg) == -1, "size not pow2");
+    small_config(&cfg, 0, 1);
+    ok &= check(cache_sim_configure(&cfg) == -1, "0 ways");
+    small_config(&cfg, 64, 1);
+    ok &= check(cache_sim_configure(&cfg) == -1, "more ways than lines");
+    printf("cache model: direct-mapped / LRU / write-back / write-through / ranges / layers checked\n");
+
+    /* 7. conv 계측 (-DYOLO_CACHE_SIM): L2 크기 3x3 conv (32→32 @80, halo 입력)를 캐시 형상별로 */
+    {
+        const int32_t c = 32, hw = 80;
+        const size_t x_n = (size_t)c * (hw + 2) * (hw + 2), y_n = (size_t)c * hw * hw, w_n = (size_t)c * c * 9;
+        float* x = (float*)calloc(x_n, sizeof(float));
+        float* y = (float*)malloc(y_n * sizeof(float));
+        float* w = (float*)calloc(w_n, sizeof(float));
+        float* bias = (float*)calloc((size_t)c, sizeof(float));
+        static const uint32_t sizes[] = {8u * 1024u, 16u * 1024u, 32u * 1024u};
+        static const uint32_t ways[] = {1u, 2u, 4u};
+        int printed = 0;
+        if (x && y && w && bias) {
+            for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); si++) {
+                for (size_t wi = 0; wi < sizeof(ways) / sizeof(ways[0]); wi++) {
+                    cache_sim_default_config(&cfg);
+                    cfg.size_bytes = sizes[si];
+                    cfg.ways = ways[wi];
+                    cache_sim_configure(&cfg);
+                    cache_sim_set_layer(2);
+                    conv2d_nchw_f32_halo(x + (hw + 2) + 1, 1, 0, 1, c, hw, hw, w, c, 3, 3, bias, 1, 1, 1, 1, 1, y, 0, 0, hw, hw);
+                    cache_sim_get_layer(2, &l);
+                    if (l.macs == 0) break;
+                    if (!printed) {
+                        printf("\n conv 3x3 32->32 @80 (CONV2D_TILE_H/W, CONV2D_OC_BLOCK as built)\n");
+                        printf("   cache      | miss: in     w   acc   out | stall Mc | est ms\n");
+                        printed = 1;
+                    }
+                    cache_sim_estimate(&l, &e);
+                    printf("   %2u KB %u-way | %5.1f%% %5.1f%% %5.1f%% %5.1f%% | %8.2f | %6.1f\n", sizes[si] / 1024u,
+                           ways[wi], 100.0 * l.miss[CSIM_INPUT] / l.access[CSIM_INPUT],
+                           100.0 * l.miss[CSIM_WEIGHT] / l.access[CSIM_WEIGHT], 100.0 * l.miss[CSIM_ACC] / l.access[CSIM_ACC],
+                           100.0 * l.miss[CSIM_OUTPUT] / l.access[CSIM_OUTPUT], e.stall_cycles / 1e6, e.ms);
+                    ok &= check(l.macs == (uint64_t)c * c * 9 * hw * hw, "conv MAC count");
+                }
+            }
+            if (!printed) printf("(conv not instrumented: build with -DYOLO_CACHE_SIM for the cache-geometry table)\n");
+        }
+        free(x);
+        free(y);
+        free(w);
+        free(bias);
+    }
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
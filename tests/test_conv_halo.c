@@ -0,0 +1,149 @@
+/* Halo 레이아웃 conv 테스트: 조밀 레이아웃 결과와 비트 단위 동일 + 경계 경로 타일 0 + 3x3 conv 시간 비교. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/concat.h"
+#include "../csrc/operations/halo.h"
+#include "../csrc/blocks/conv.h"
+#include "../csrc/utils/mcycle.h"
+
+static uint32_t rng_state = 12345u;
+static float rand_f(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (float)(rng_state >> 8) / 16777216.0f * 2.0f - 1.0f;
+}
+
+/* 조밀 → halo 버퍼 (테두리 0) */
+static float* to_halo(const float* x, int32_t planes, int32_t h, int32_t w, int32_t halo) {
+    float* buf = (float*)malloc(HALO_BYTES(1, planes, h, w, halo));
+    for (int32_t i = 0; i < planes * HALO_PLANE(h, w, halo); i++) buf[i] = 12345.0f;  /* 쓰레기 */
+    halo_clear_border(buf, planes, h, w, halo);
+    float* in = halo_interior(buf, w, halo);
+    for (int32_t p = 0; p < planes; p++)
+        for (int32_t r = 0; r < h; r++)
+            memcpy(in + p * HALO_PLANE(h, w, halo) + r * HALO_PITCH(w, halo), x + (p * h + r) * w, (size_t)w * sizeof(float));
+    return buf;
+}
+
+/* halo 버퍼 내부가 조밀 y와 비트 동일하고 테두리가 0인지 */
+static int same_as_dense(const float* buf, const float* y, int32_t planes, int32_t h, int32_t w, int32_t halo) {
+    const int32_t pitch = HALO_PITCH(w, halo);
+    for (int32_t p = 0; p < planes; p++) {
+        const float* pl = buf + p * HALO_PLANE(h, w, halo);
+        for (int32_t r = -halo; r < h + halo; r++) {
+            for (int32_t c = -halo; c < w + halo; c++) {
+                const float v = pl[(r + halo) * pitch + c + halo];
+                const int inside = r >= 0 && r < h && c >= 0 && c < w;
+                if (inside ? memcmp(&v, &y[(p * h + r) * w + c], sizeof(float)) != 0 : v != 0.0f) return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+typedef struct {
+    const char* name;
+    int32_t c_in, c_out, h, w, k, stride, pad, x_halo, y_halo;
+    int w8;
+} conv_case_t;
+
+static int run_case(const conv_case_t* t) {
+    const int32_t h_out = (t->h + 2 * t->pad - t->k) / t->stride + 1;
+    const int32_t w_out = (t->w + 2 * t->pad - t->k) / t->stride + 1;
+    const int32_t nx = t->c_in * t->h * t->w, ny = t->c_out * h_out * w_out, nw = t->c_out * t->c_in * t->k * t->k;
+    float* x = (float*)malloc((size_t)nx * sizeof(float));
+    float* wf = (float*)malloc((size_t)nw * sizeof(float));
+    int8_t* w8 = (int8_t*)malloc((size_t)nw);
+    float* bias = (float*)malloc((size_t)t->c_out * sizeof(float));
+    float* y_ref = (float*)malloc((size_t)ny * sizeof(float));
+    for (int32_t i = 0; i < nx; i++) x[i] = rand_f();
+    for (int32_t i = 0; i < nw; i++) { wf[i] = rand_f() * 0.2f; w8[i] = (int8_t)(rand_f() * 127.0f); }
+    for (int32_t i = 0; i < t->c_out; i++) bias[i] = rand_f();
+    const void* wp = t->w8 ? (const void*)w8 : (const void*)wf;
+
+    conv_block_nchw_f32(x, 1, t->c_in, t->h, t->w, wp, 0.01f, t->w8, t->c_out, t->k, t->k,
+                        t->stride, t->stride, t->pad, t->pad, bias, y_ref, h_out, w_out);
+    float* x_buf = to_halo(x, t->c_in, t->h, t->w, t->x_halo);
+    float* y_buf = (float*)malloc(HALO_BYTES(1, t->c_out, h_out, w_out, t->y_halo));
+    halo_clear_border(y_buf, t->c_out, h_out, w_out, t->y_halo);
+    conv2d_reset_border_tiles();
+    conv_block_nchw_f32_halo(halo_interior(x_buf, t->w, t->x_halo), t->x_halo, 1, t->c_in, t->h, t->w,
+                             wp, 0.01f, t->w8, t->c_out, t->k, t->k, t->stride, t->stride, t->pad, t->pad, bias,
+                             halo_interior(y_buf, w_out, t->y_halo), t->y_halo, h_out, w_out);
+    const uint64_t border = conv2d_get_border_tiles();
+    const int ok = same_as_dense(y_buf, y_ref, t->c_out, h_out, w_out, t->y_halo) &&
+                   (t->x_halo < t->pad || border == 0);
+    printf("  %-22s %s (border tiles %llu)\n", t->name, ok ? "OK" : "NG", (unsigned long long)border);
+    free(x); free(wf); free(w8); free(bias); free(y_ref); free(x_buf); free(y_buf);
+    return ok;
+}
+
+int main(void) {
+    printf("=== Halo Conv Test ===\n\n");
+    int ok = 1;
+
+    /* 1. 조밀 vs halo: 출력 비트 동일, halo >= pad이면 경계 경로 타일 0 */
+    const conv_case_t cases[] = {
+        {"3x3 s1 p1",          16, 16, 37, 45, 3, 1, 1, 1, 0, 0},
+        {"3x3 s2 p1",          16, 32, 40, 40, 3, 2, 1, 1, 0, 0},
+        {"3x3 s2 p1 odd",       8, 16, 21, 19, 3, 2, 1, 1, 0, 0},
+        {"3x3 s1 p1 W8",       16, 16, 24, 24, 3, 1, 1, 1, 0, 1},
+        {"1x1 -> y halo",      16, 40, 20, 20, 1, 1, 0, 0, 1, 0},
+        {"1x1 halo in/out W8", 16, 24, 18, 22, 1, 1, 0, 1, 1, 1},
+        {"6x6 s2 p2 halo 2",    3, 16, 64, 64, 6, 2, 2, 2, 0, 0},
+        {"6x6 s2 p2 halo 1",    3, 16, 64, 64, 6, 2, 2, 1, 0, 0},  /* halo < pad: 경계 경로 일부 유지 */
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) ok &= run_case(&cases[i]);
+
+    /* 2. concat: halo 입력 → 조밀 출력 */
+    {
+        const int32_t h = 9, w = 11, c1 = 3, c2 = 5;
+        float a[3 * 9 * 11], b[5 * 9 * 11], ref[8 * 9 * 11], out[8 * 9 * 11];
+        for (int32_t i = 0; i < c1 * h * w; i++) a[i] = rand_f();
+        for (int32_t i = 0; i < c2 * h * w; i++) b[i] = rand_f();
+        concat_nchw_f32(a, c1, b, c2, 1, h, w, ref);
+        float* b_buf = to_halo(b, c2, h, w, 1);
+        concat_nchw_f32_halo(a, c1, 0, halo_interior(b_buf, w, 1), c2, 1, 1, h, w, out);
+        const int cat_ok = memcmp(ref, out, sizeof(ref)) == 0;
+        printf("  %-22s %s\n", "concat halo input", cat_ok ? "OK" : "NG");
+        ok &= cat_ok;
+        free(b_buf);
+    }
+
+    /* 3. 시간: 3x3 s1 p1, 32ch 80x80 (bottleneck cv2 크기) 조밀 vs halo */
+    {
+        const int32_t c = 32, h = 80, w = 80, reps = 5;
+        float* x = (float*)malloc((size_t)c * h * w * sizeof(float));
+        float* wt = (float*)malloc((size_t)c * c * 9 * sizeof(float));
+        float* y = (float*)malloc((size_t)c * h * w * sizeof(float));
+        for (int32_t i = 0; i < c * h * w; i++) x[i] = rand_f();
+        for (int32_t i = 0; i < c * c * 9; i++) wt[i] = rand_f() * 0.1f;
+        float* x_buf = to_halo(x, c, h, w, 1);
+        conv2d_reset_border_tiles();
+        uint64_t t0 = timer_read64();
+        for (int r = 0; r < reps; r++)
+            conv2d_nchw_f32(x, 1, c, h, w, wt, c, 3, 3, NULL, 1, 1, 1, 1, 1, y, h, w);
+        const uint64_t t_dense = timer_delta64(t0, timer_read64());
+        const uint64_t border_dense = conv2d_get_border_tiles() / reps;
+        conv2d_reset_border_tiles();
+        t0 = timer_read64();
+        for (int r = 0; r < reps; r++)
+            conv2d_nchw_f32_halo(halo_interior(x_buf, w, 1), 1, 0, 1, c, h, w, wt, c, 3, 3, NULL, 1, 1, 1, 1, 1, y, 0, 0, h, w);
+        const uint64_t t_halo = timer_delta64(t0, timer_read64());
+        printf("\n3x3 conv %dx%dx%d: dense %.2f ms (%llu border tiles), halo %.2f ms (%llu border tiles)\n",
+               (int)c, (int)h, (int)w, (double)t_dense / reps / 1000.0, (unsigned long long)border_dense,
+               (double)t_halo / reps / 1000.0, (unsigned long long)(conv2d_get_border_tiles() / reps));
+        free(x); free(wt); free(y); free(x_buf);
+    }
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
@@ -0,0 +1,194 @@
+/* 스크래치패드 타일 conv 테스트: DMA 3차원 복사 = 직접 복사 (큐 깊이 넘게 요청, 티켓 순서),
+ * SPM 경로 = 캐시 경로 비트 동일 (FP32/W8, 1x1·3x3·6x6 stem, stride 2, halo 입출력, 배치, oc/ic 나머지, 입력 채널 여러 묶음),
+ * SPM에 안 맞는 conv → -1 (y 그대로), 캐시 vs SPM 시간과 DMA 겹침(1 - 대기/복사) 출력.
+ * -DCONV2D_SPM 빌드는 캐시 경로도 SPM을 타므로 비교 의미 없음 → 이 테스트는 플래그 없이. -DDMA_NO_THREAD: 동기 복사 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/conv2d_spm.h"
+#include "../csrc/operations/halo.h"
+#include "../csrc/utils/dma.h"
+#include "../csrc/utils/mcycle.h"
+
+static uint32_t s_rng = 12345u;
+static float frand(void) {
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return (float)((s_rng >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+}
+
+typedef struct {
+    int32_t n, c_in, h, w, c_out, k, s, p, x_halo, y_halo;
+} case_t;
+
+/* 1 = 비트 동일. t_cache/t_spm: 누적 시간 (NULL이면 안 잼) */
+static int run_case(const case_t* c, int is_int8, uint64_t* t_cache, uint64_t* t_spm) {
+    const int32_t h_out = (c->h + 2 * c->p - c->k) / c->s + 1, w_out = (c->w + 2 * c->p - c->k) / c->s + 1;
+    const size_t x_n = (size_t)HALO_BYTES(c->n, c->c_in, c->h, c->w, c->x_halo) / sizeof(float);
+    const size_t y_n = (size_t)HALO_BYTES(c->n, c->c_out, h_out, w_out, c->y_halo) / sizeof(float);
+    const size_t w_n = (size_t)c->c_out * c->c_in * c->k * c->k;
+    float* xb = (float*)calloc(x_n, sizeof(float));
+    float* y0 = (float*)malloc(y_n * sizeof(float));
+    float* y1 = (float*)malloc(y_n * sizeof(float));
+    float* wf = (float*)malloc(w_n * sizeof(float));
+    int8_t* w8 = (int8_t*)malloc(w_n);
+    float* bias = (float*)malloc((size_t)c->c_out * sizeof(float));
+    int same = 0;
+    if (xb && y0 && y1 && wf && w8 && bias) {
+        const float scale = 0.0123f;
+        float* x = halo_interior(xb, c->w, c->x_halo);
+        for (int32_t i = 0; i < c->n * c->c_in; i++)
+            for (int32_t r = 0; r < c->h; r++)
+                for (int32_t q = 0; q < c->w; q++)
+                    x[(size_t)i * HALO_PLANE(c->h, c->w, c->x_halo) + (size_t)r * (c->w + 2 * c->x_halo) + q] = frand();
+        for (size_t i = 0; i < w_n; i++) {
+            wf[i] = frand() * 0.1f;
+            w8[i] = (int8_t)(frand() * 127.0f);
+        }
+        for (int32_t i = 0; i < c->c_out; i++) bias[i] = frand();
+        /* 테두리(halo)는 두 경로 모두 건드리지 않아야 함 → 같은 값으로 채워 두고 전체 비교 */
+        memset(y0, 0x5A, y_n * sizeof(float));
+        memset(y1, 0x5A, y_n * sizeof(float));
+        float* yi0 = halo_interior(y0, w_out, c->y_halo);
+        float* yi1 = halo_interior(y1, w_out, c->y_halo);
+
+        uint64_t t0 = timer_read64();
+        if (is_int8)
+            conv2d_nchw_f32_w8_halo(x, c->x_halo, 0, c->n, c->c_in, c->h, c->w, w8, scale, c->c_out, c->k, c->k, bias,
+                                    c->s, c->s, c->p, c->p, 1, yi0, c->y_halo, 0, h_out, w_out);
+        else
+            conv2d_nchw_f32_halo(x, c->x_halo, 0, c->n, c->c_in, c->h, c->w, wf, c->c_out, c->k, c->k, bias,
+                                 c->s, c->s, c->p, c->p, 1, yi0, c->y_halo, 0, h_out, w_out);
+        uint64_t t1 = timer_read64();
+        const int rc = conv2d_spm_nchw_f32(x, c->x_halo, 0, c->n, c->c_in, c->h, c->w, is_int8 ? (const void*)w8 : (const void*)wf,
+                                           scale, is_int8, c->c_out, c->k, c->k, bias, c->s, c->s, c->p, c->p, 1,
+                                           yi1, c->y_halo, 0, h_out, w_out);
+        uint64_t t2 = timer_read64();
+        if (t_cache) *t_cache += timer_delta64(t0, t1);
+        if (t_spm) *t_spm += timer_delta64(t1, t2);
+        same = rc == 0 && memcmp(y0, y1, y_n * sizeof(float)) == 0;
+    }
+    free(xb);
+    free(y0);
+    free(y1);
+    free(wf);
+    free(w8);
+    free(bias);
+    return same;
+}
+
+int main(void) {
+    printf("=== Conv Scratchpad (SPM/DMA) Test ===\n\n");
+    int ok = 1;
+
+    /* 1. DMA: 3차원 블록 복사 = 직접 복사, 큐 깊이보다 많은 요청, 티켓 증가 */
+    {
+        enum { P = 5, R = 7, C = 9, SP = 13, SPP = 13 * 11 };
+        static float src[P * SPP], dst[3 * DMA_QUEUE_DEPTH][P * R * C], ref[P * R * C];
+        for (int i = 0; i < P * SPP; i++) src[i] = (float)i;
+        for (int p = 0; p < P; p++)
+            for (int r = 0; r < R; r++)
+                for (int q = 0; q < C; q++) ref[(p * R + r) * C + q] = src[p * SPP + r * SP + 2 + q];
+        dma_desc_t d;
+        dma_ticket_t last = 0;
+        int ordered = 1;
+        d.src = src + 2;
+        d.row_bytes = C * sizeof(float);
+        d.rows = R;
+        d.planes = P;
+        d.src_row_pitch = SP * sizeof(float);
+        d.src_plane_pitch = SPP * sizeof(float);
+        d.dst_row_pitch = C * sizeof(float);
+        d.dst_plane_pitch = R * C * sizeof(float);
+        dma_reset_stats();
+        for (int k = 0; k < 3 * DMA_QUEUE_DEPTH; k++) {
+            d.dst = dst[k];
+            const dma_ticket_t t = dma_submit(&d);
+            ordered &= t > last;
+            last = t;
+        }
+        dma_wait(0);
+        dma_wait_all();
+        int copied = 1;
+        for (int k = 0; k < 3 * DMA_QUEUE_DEPTH; k++) copied &= memcmp(dst[k], ref, sizeof(ref)) == 0;
+        dma_stats_t st;
+        dma_get_stats(&st);
+        if (!ordered || !copied || st.descs != 3u * DMA_QUEUE_DEPTH || st.bytes != 3u * DMA_QUEUE_DEPTH * sizeof(ref)) {
+            printf("ERROR: dma copy (ordered %d, copied %d, descs %u)\n", ordered, copied, (unsigned)st.descs);
+            ok = 0;
+        }
+        printf("dma: %d x 3D blocks (%dx%dx%d floats) ok\n", 3 * DMA_QUEUE_DEPTH, P, R, C);
+    }
+
+    /* 2. SPM 경로 = 캐시 경로 (FP32/W8) */
+    {
+        static const case_t cases[] = {
+            {1, 3, 64, 64, 16, 6, 2, 2, 0, 1},      /* stem 6x6 s2, halo 출력 */
+            {1, 16, 40, 40, 32, 3, 2, 1, 1, 0},     /* 3x3 s2, halo 입력 */
+            {2, 32, 20, 20, 32, 1, 1, 0, 0, 0},     /* 1x1 배치 2 */
+            {1, 64, 20, 20, 48, 3, 1, 1, 1, 1},     /* oc 나머지 (48 = 16 × 3), halo 입출력 */
+            {1, 128, 13, 11, 20, 3, 1, 1, 0, 0},    /* 홀수 크기, 타일 나머지, ic 여러 묶음 */
+            {3, 256, 10, 10, 64, 1, 1, 0, 0, 0},    /* 1x1 넓은 ic, 배치 3 */
+            {1, 24, 9, 17, 5, 5, 1, 2, 0, 0},       /* 5x5 pad 2 */
+        };
+        int32_t pass = 0;
+        for (int32_t i = 0; i < (int32_t)(sizeof(cases) / sizeof(cases[0])); i++) {
+            for (int is_int8 = 0; is_int8 < 2; is_int8++) {
+                if (run_case(&cases[i], is_int8, NULL, NULL)) {
+                    pass++;
+                } else {
+                    printf("ERROR: case %d (%s) differs\n", (int)i, is_int8 ? "W8" : "FP32");
+                    ok = 0;
+                }
+            }
+        }
+        printf("spm = cache path: %d / %d cases bit-identical\n", (int)pass, (int)(2 * sizeof(cases) / sizeof(cases[0])));
+    }
+
+    /* 3. SPM에 안 맞는 conv → -1, y 그대로 */
+    {
+        conv2d_spm_plan_t pl;
+        float x[64] = {0}, wv[16] = {0}, y[4] = {7.0f, 7.0f, 7.0f, 7.0f};
+        if (conv2d_spm_plan(4, 41, 41, 1, 1, 0, &pl) != -1 ||
+            conv2d_spm_nchw_f32(x, 0, 0, 1, 1, 8, 8, wv, 0.0f, 0, 1, 41, 41, NULL, 1, 1, 20, 20, 1, y, 0, 0, 2, 2) != -1 ||
+            conv2d_spm_nchw_f32(x, 0, 0, 1, 1, 8, 8, wv, 0.0f, 0, 1, 1, 1, NULL, 1, 1, 0, 0, 2, y, 0, 0, 2, 2) != -1 ||
+            y[0] != 7.0f) {
+            printf("ERROR: oversized / grouped conv accepted\n");
+            ok = 0;
+        }
+        if (conv2d_spm_plan(128, 3, 3, 1, 1, 0, &pl) == 0)
+            printf("plan 3x3 c_in 128: ic chunk %d, SPM %u of %u bytes\n", (int)pl.ic_chunk, (unsigned)pl.spm_bytes,
+                   (unsigned)CONV2D_SPM_BYTES);
+    }
+
+    /* 4. 시간: YOLO 크기 레이어 (캐시 경로 vs SPM 경로) + DMA 겹침 */
+    {
+        static const struct { const char* name; case_t c; } bench[] = {
+            {"L1 3x3 s2 16->32 @320", {1, 16, 320, 320, 32, 3, 2, 1, 1, 0}},
+            {"L2 1x1 32->16 @160  ", {1, 32, 160, 160, 16, 1, 1, 0, 0, 0}},
+            {"L7 3x3 s2 128->256 @40", {1, 128, 40, 40, 256, 3, 2, 1, 1, 0}},
+        };
+        printf("\n layer                  | cache ms |  spm ms | dma MB | dma busy ms | wait ms | overlap\n");
+        for (int32_t i = 0; i < (int32_t)(sizeof(bench) / sizeof(bench[0])); i++) {
+            uint64_t tc = 0, ts = 0;
+            dma_stats_t st;
+            dma_reset_stats();
+            if (!run_case(&bench[i].c, 1, &tc, &ts)) { printf("ERROR: bench %s differs\n", bench[i].name); ok = 0; }
+            dma_get_stats(&st);
+            const double ovl = st.busy_time > 0 && st.wait_time < st.busy_time
+                                   ? 100.0 * (1.0 - (double)st.wait_time / (double)st.busy_time) : 0.0;
+            printf(" %-22s | %8.2f | %7.2f | %6.2f | %11.2f | %7.2f | %6.0f%%\n", bench[i].name, tc / 1000.0,
+                   ts / 1000.0, st.bytes / (1024.0 * 1024.0), st.busy_time / 1000.0, st.wait_time / 1000.0, ovl);
+        }
+    }
+    dma_shutdown();
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
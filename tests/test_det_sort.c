@@ -0,0 +1,135 @@
+/* detection 정렬 테스트 + 벤치마크 (기존 exchange sort 대비, 300 / 3k / 30k 후보). */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/blocks/det_sort.h"
+#include "../csrc/utils/mcycle.h"
+
+/* 기존 main.c 방식 (비교 기준) */
+static void exchange_sort(detection_t* d, int32_t num) {
+    for (int i = 0; i < num - 1; i++) {
+        for (int j = i + 1; j < num; j++) {
+            if (d[i].conf < d[j].conf) {
+                detection_t t = d[i]; d[i] = d[j]; d[j] = t;
+            }
+        }
+    }
+}
+
+static uint32_t rng_state = 12345u;
+static uint32_t rng_next(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+/* conf 0.05~1.0, 동점이 충분히 생기도록 1/1024 단위로 양자화 */
+static void fill_random(detection_t* d, int32_t num) {
+    for (int32_t i = 0; i < num; i++) {
+        d[i].x = (float)(rng_next() % 640) / 640.0f;
+        d[i].y = (float)(rng_next() % 640) / 640.0f;
+        d[i].w = (float)(rng_next() % 200 + 4) / 640.0f;
+        d[i].h = (float)(rng_next() % 200 + 4) / 640.0f;
+        d[i].conf = 0.05f + (float)(rng_next() % 973) / 1024.0f;
+        d[i].cls_id = (int32_t)(rng_next() % 80);
+    }
+}
+
+/* conf 다중집합이 같고 내림차순인지 */
+static int check_same_conf_order(const detection_t* got, const detection_t* ref, int32_t num) {
+    for (int32_t i = 0; i < num; i++) {
+        if (got[i].conf != ref[i].conf) return 0;
+        if (i > 0 && got[i - 1].conf < got[i].conf) return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    printf("=== Detection Sort Test ===\n\n");
+    int ok = 1;
+
+    /* 1. 경계 케이스: 0, 1, 2개, 전부 동점, 이미 정렬, 역순 */
+    {
+        detection_t d[64];
+        det_sort_by_conf(d, 0);
+        fill_random(d, 1);
+        det_sort_by_conf(d, 1);
+        fill_random(d, 2);
+        d[0].conf = 0.1f; d[1].conf = 0.9f;
+        det_sort_by_conf(d, 2);
+        if (d[0].conf != 0.9f) { printf("ERROR: n=2\n"); ok = 0; }
+
+        fill_random(d, 64);
+        for (int i = 0; i < 64; i++) d[i].conf = 0.5f;
+        det_sort_by_conf(d, 64);
+        for (int i = 1; i < 64; i++) {
+            if (d[i - 1].cls_id > d[i].cls_id) { printf("ERROR: tie-break by cls_id\n"); ok = 0; break; }
+        }
+
+        for (int i = 0; i < 64; i++) d[i].conf = (float)(64 - i) / 64.0f;
+        det_sort_by_conf(d, 64);
+        if (!det_is_sorted_by_conf(d, 64)) { printf("ERROR: presorted\n"); ok = 0; }
+        for (int i = 0; i < 64; i++) d[i].conf = (float)i / 64.0f;
+        det_sort_by_conf(d, 64);
+        if (!det_is_sorted_by_conf(d, 64)) { printf("ERROR: reversed\n"); ok = 0; }
+    }
+
+    /* 2. 결정성: 같은 집합을 다른 순서로 넣어도 결과 동일 */
+    {
+        enum { N = 500 };
+        static detection_t a[N], b[N];
+        fill_random(a, N);
+        for (int i = 0; i < N; i++) b[i] = a[N - 1 - i];
+        det_sort_by_conf(a, N);
+        det_sort_by_conf(b, N);
+        if (memcmp(a, b, sizeof(a)) != 0) { printf("ERROR: result depends on input order\n"); ok = 0; }
+        else printf("Deterministic tie order: OK\n");
+    }
+
+    /* 3. 정확도 + 벤치마크: exchange sort와 conf 순서 일치 */
+    printf("\n%8s %14s %14s %10s\n", "N", "exchange(ms)", "introsort(ms)", "speedup");
+    const int32_t sizes[3] = {300, 3000, 30000};
+    for (int s = 0; s < 3; s++) {
+        const int32_t num = sizes[s];
+        detection_t* src = (detection_t*)malloc((size_t)num * sizeof(detection_t));
+        detection_t* ref = (detection_t*)malloc((size_t)num * sizeof(detection_t));
+        detection_t* got = (detection_t*)malloc((size_t)num * sizeof(detection_t));
+        if (!src || !ref || !got) { free(src); free(ref); free(got); return 1; }
+        fill_random(src, num);
+
+        const int reps = num <= 3000 ? 20 : 1;
+        memcpy(ref, src, (size_t)num * sizeof(detection_t));
+        uint64_t t0 = timer_read64();
+        for (int r = 0; r < reps; r++) {
+            memcpy(ref, src, (size_t)num * sizeof(detection_t));
+            exchange_sort(ref, num);
+        }
+        uint64_t t_ref = timer_delta64(t0, timer_read64());
+
+        t0 = timer_read64();
+        for (int r = 0; r < reps; r++) {
+            memcpy(got, src, (size_t)num * sizeof(detection_t));
+            det_sort_by_conf(got, num);
+        }
+        uint64_t t_new = timer_delta64(t0, timer_read64());
+
+        double ms_ref = (double)t_ref / 1000.0 / reps;
+        double ms_new = (double)t_new / 1000.0 / reps;
+        printf("%8d %14.3f %14.3f %9.1fx\n", (int)num, ms_ref, ms_new,
+               ms_new > 0.0 ? ms_ref / ms_new : 0.0);
+
+        if (!check_same_conf_order(got, ref, num)) {
+            printf("ERROR: N=%d order mismatch vs exchange sort\n", (int)num);
+            ok = 0;
+        }
+        free(src); free(ref); free(got);
+    }
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
@@ -0,0 +1,146 @@
+/* 임베디드 모델 테스트 (-DYOLO_EMBEDDED_MODEL): 링크된 텐서 테이블 = 원본 컨테이너 (이름/shape/scale/데이터),
+ * payload 64B 정렬, 정적 해시로 전 텐서 조회, init 반복·weights_free가 공유 테이블을 건드리지 않음 (INT8 FP32 조회는 NULL, 캐시 없음),
+ * 컨텍스트 전 텐서 바인딩, 컨테이너 메모리 init 대비 init 시간.
+ * 준비: python tools/gen_embedded_model.py --in assets/weights_w8.ymdl
+ * 빌드: gcc ... -DYOLO_EMBEDDED_MODEL build/embedded/yolo_model_embedded.c build/embedded/yolo_model_blob.S
+ * (플래그 없이 빌드하면 건너뜀) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/blocks/yolov5n.h"
+#include "../csrc/utils/weights_loader.h"
+#include "../csrc/utils/mcycle.h"
+
+#ifndef EMBEDDED_SRC
+#define EMBEDDED_SRC "assets/weights_w8.ymdl"  /* gen_embedded_model.py --in 과 같은 파일 */
+#endif
+#define BENCH_ITER 200
+
+#ifdef YOLO_EMBEDDED_MODEL
+static int same_weights(const weights_loader_t* a, const weights_loader_t* b) {
+    if (a->num_tensors != b->num_tensors || a->num_tensors <= 0) return 0;
+    for (int i = 0; i < a->num_tensors; i++) {
+        const tensor_info_t* x = &a->tensors[i];
+        const tensor_info_t* y = &b->tensors[i];
+        if (strcmp(x->name, y->name) != 0 || x->dtype != y->dtype || x->num_elements != y->num_elements ||
+            x->scale != y->scale || x->ndim != y->ndim || memcmp(x->shape, y->shape, sizeof(x->shape)) != 0)
+            return 0;
+        if (x->dtype == WEIGHTS_DTYPE_INT8 ? memcmp(x->data_int8, y->data_int8, x->num_elements) != 0
+                                           : memcmp(x->data, y->data, x->num_elements * sizeof(float)) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    printf("=== Embedded Model Test ===\n\n");
+    int ok = 1;
+    weights_loader_t emb, ref;
+
+    if (weights_init_embedded(&emb) != 0 || weights_load_from_file_w8(EMBEDDED_SRC, &ref) != 0) {
+        fprintf(stderr, "Failed to init embedded model / load %s\n", EMBEDDED_SRC);
+        return 1;
+    }
+
+    /* 1. 링크된 테이블 = 원본 컨테이너, payload 64B 정렬·소유 없음 */
+    if (!same_weights(&emb, &ref)) { printf("ERROR: embedded tensors differ from %s\n", EMBEDDED_SRC); ok = 0; }
+    {
+        size_t bytes = 0;
+        int bad = !emb.embedded || emb.container || emb.map_base || emb.blob;
+        for (int32_t i = 0; i < emb.num_tensors; i++) {
+            const tensor_info_t* t = &emb.tensors[i];
+            const uintptr_t p = t->dtype == WEIGHTS_DTYPE_INT8 ? (uintptr_t)t->data_int8 : (uintptr_t)t->data;
+            if (p % 64u != 0 || t->data_owned) bad = 1;
+            bytes += t->num_elements * (t->dtype == WEIGHTS_DTYPE_INT8 ? 1u : sizeof(float));
+        }
+        if (bad) { printf("ERROR: embedded payload alignment / ownership\n"); ok = 0; }
+        printf("embedded: %d tensors, %u KB linked, index %u slots\n", (int)emb.num_tensors, (unsigned)(bytes / 1024u),
+               (unsigned)(emb.index_mask + 1u));
+    }
+
+    /* 2. 정적 해시로 전 텐서 조회, 없는 이름 NULL */
+    for (int32_t i = 0; i < emb.num_tensors; i++)
+        if (weights_find_tensor(&emb, emb.tensors[i].name) != &emb.tensors[i]) {
+            printf("ERROR: lookup %s\n", emb.tensors[i].name);
+            ok = 0;
+        }
+    if (weights_find_tensor(&emb, "model.99.conv.weight")) { printf("ERROR: missing name found\n"); ok = 0; }
+
+    /* 3. 공유 테이블: INT8 FP32 조회는 NULL (캐시·heap 없음), 두 loader 중 하나를 free해도 다른 쪽 그대로 → 다시 init 가능 */
+    {
+        const tensor_info_t* t = weights_find_tensor(&emb, "model.0.conv.weight");
+        const float* d = weights_get_tensor_data(&emb, "model.0.conv.weight");
+        const tensor_info_t* t0 = emb.tensors;
+        weights_loader_t other;
+        int bad = !t || (t->dtype == WEIGHTS_DTYPE_INT8 ? d != NULL : d != t->data) ||
+                  weights_init_embedded(&other) != 0;
+        weights_free(&other);
+        bad |= emb.tensors != t0 || !same_weights(&emb, &ref);
+        weights_free(&emb);
+        if (bad || emb.tensors || weights_init_embedded(&emb) != 0 || emb.tensors != t0 || emb.tensors[0].dequant ||
+            emb.dequant_bytes != 0 || !same_weights(&emb, &ref)) {
+            printf("ERROR: free / re-init of embedded table\n");
+            ok = 0;
+        }
+    }
+
+    /* 4. 컨텍스트: 임베디드 init → 전 텐서 바인딩 */
+    {
+        static yolo_ctx_t ctx;
+        if (yolo_ctx_init_embedded(&ctx) != 0 || !ctx.weights.embedded || ctx.bound_tensors != ctx.weights.num_tensors) {
+            printf("ERROR: embedded context\n");
+            ok = 0;
+        }
+        yolo_ctx_destroy(&ctx);
+    }
+
+    /* 5. init 시간: 정적 테이블 대입 vs 컨테이너 메모리 init (디렉터리 대입 + calloc) */
+    {
+        weights_loader_t w;
+        volatile int32_t sink = 0;
+        uint64_t t0 = timer_read64();
+        for (int it = 0; it < BENCH_ITER; it++) {
+            weights_init_embedded(&w);
+            sink += w.num_tensors;
+            weights_free(&w);
+        }
+        const double us_emb = timer_delta64(t0, timer_read64()) / (double)BENCH_ITER;
+        FILE* f = fopen(EMBEDDED_SRC, "rb");
+        uint8_t* buf = (uint8_t*)malloc(ref.map_size ? ref.map_size : 1u);
+        double us_ctr = -1.0;
+        if (f && buf && ref.map_size && fread(buf, 1, ref.map_size, f) == ref.map_size) {
+            t0 = timer_read64();
+            for (int it = 0; it < BENCH_ITER; it++) {
+                if (weights_init_from_memory((uintptr_t)buf, ref.map_size, &w) != 0) break;
+                sink += w.num_tensors;
+                weights_free(&w);
+            }
+            us_ctr = timer_delta64(t0, timer_read64()) / (double)BENCH_ITER;
+        }
+        if (f) fclose(f);
+        free(buf);
+        (void)sink;
+        printf("\n init              | us\n");
+        printf(" embedded (linked) | %8.3f\n", us_emb);
+        printf(" container (DDR)   | %8.3f\n", us_ctr);
+    }
+
+    weights_free(&emb);
+    weights_free(&ref);
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
+#else
+int main(void) {
+    printf("=== Embedded Model Test ===\n\nskipped: build with -DYOLO_EMBEDDED_MODEL and the generated sources "
+           "(tools/gen_embedded_model.py)\n");
+    return 0;
+}
+#endif
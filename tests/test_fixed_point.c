@@ -0,0 +1,365 @@
+/* 고정소수점(Q) 경로 테스트: float 비트 → Q 변환 (반올림·포화·비정규수), 재양자화 오차, sigmoid/SiLU 표 오차,
+ * 정수 conv vs W8 FP32 conv (1x1·3x3·stem 6x6 s2, halo 입출력, 배치, oc 나머지) 오차 한계 + 출력 테두리 보존,
+ * stem uint8 CHW/HWC·FP32 이미지, maxpool 정확 일치, 정수 decode+NMS vs FP32 decode+NMS 결과 일치.
+ * 연산 단위 비교 (플래그 없이 빌드). 전체 그래프는 -DUSE_WEIGHTS_W8 -DYOLO_FIXED_POINT main 빌드로 FP32/W8 검출과 비교 (TESTING.md) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../csrc/operations/qformat.h"
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/conv2d_q.h"
+#include "../csrc/operations/silu.h"
+#include "../csrc/operations/maxpool2d.h"
+#include "../csrc/operations/halo.h"
+#include "../csrc/blocks/decode.h"
+#include "../csrc/blocks/det_sort.h"
+#include "../csrc/blocks/nms.h"
+
+static uint32_t s_rng = 4242u;
+static float frand(void) {
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return (float)((s_rng >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+}
+
+static int check(int cond, const char* what) {
+    if (!cond) printf("ERROR: %s\n", what);
+    return cond;
+}
+
+typedef struct {
+    int32_t n, c_in, h, w, c_out, k, s, p, x_halo, y_halo;
+} case_t;
+
+/* 정수 conv vs W8 FP32 conv. 반환: 최대 오차 / (최대 |y| × 1e-3 + 4 LSB) (1 이하면 통과), 테두리 훼손 시 -1 */
+static double run_conv_case(const case_t* c) {
+    const int32_t h_out = (c->h + 2 * c->p - c->k) / c->s + 1, w_out = (c->w + 2 * c->p - c->k) / c->s + 1;
+    const size_t x_n = (size_t)HALO_BYTES(c->n, c->c_in, c->h, c->w, c->x_halo) / sizeof(float);
+    const size_t y_n = (size_t)HALO_BYTES(c->n, c->c_out, h_out, w_out, c->y_halo) / sizeof(float);
+    const size_t w_n = (size_t)c->c_out * c->c_in * c->k * c->k;
+    float* xf = (float*)calloc(x_n, sizeof(float));
+    int32_t* xq = (int32_t*)calloc(x_n, sizeof(int32_t));
+    float* yf = (float*)calloc(y_n, sizeof(float));
+    int32_t* yq = (int32_t*)malloc(y_n * sizeof(int32_t));
+    int8_t* w8 = (int8_t*)malloc(w_n);
+    float* bias = (float*)malloc((size_t)c->c_out * sizeof(float));
+    double ratio = -1.0;
+    if (xf && xq && yf && yq && w8 && bias) {
+        const float scale = 0.0123f;
+        float* xi = halo_interior(xf, c->w, c->x_halo);
+        int32_t* xqi = xq + (xi - xf);
+        for (int32_t i = 0; i < c->n * c->c_in; i++)
+            for (int32_t r = 0; r < c->h; r++)
+                for (int32_t q = 0; q < c->w; q++) {
+                    const size_t o = (size_t)i * HALO_PLANE(c->h, c->w, c->x_halo) + (size_t)r * (c->w + 2 * c->x_halo) + q;
+                    xqi[o] = q_from_f32(frand() * 2.0f, YOLO_Q_FRAC);
+                    xi[o] = (float)xqi[o] / Q_ONE;   /* 같은 입력 (Q 값 그대로) */
+                }
+        for (size_t i = 0; i < w_n; i++) w8[i] = (int8_t)(frand() * 127.0f);
+        for (int32_t i = 0; i < c->c_out; i++) bias[i] = frand();
+        for (size_t i = 0; i < y_n; i++) yq[i] = 0x5A5A5A5A;
+        float* yfi = halo_interior(yf, w_out, c->y_halo);
+        int32_t* yqi = yq + (yfi - yf);
+        conv2d_nchw_f32_w8_halo(xi, c->x_halo, 0, c->n, c->c_in, c->h, c->w, w8, scale, c->c_out, c->k, c->k, bias,
+                                c->s, c->s, c->p, c->p, 1, yfi, c->y_halo, 0, h_out, w_out);
+        conv2d_nchw_q_w8_halo(xqi, c->x_halo, 0, c->n, c->c_in, c->h, c->w, w8, scale, c->c_out, c->k, c->k, bias,
+                              c->s, c->s, c->p, c->p, yqi, c->y_halo, 0, h_out, w_out);
+        double max_err = 0.0, max_y = 0.0;
+        int border_ok = 1;
+        const int32_t pitch = w_out + 2 * c->y_halo, plane = HALO_PLANE(h_out, w_out, c->y_halo);
+        for (size_t i = 0; i < y_n; i++) {
+            const int32_t r = (int32_t)(i % (size_t)plane) / pitch - c->y_halo;
+            const int32_t q = (int32_t)(i % (size_t)plane) % pitch - c->y_halo;
+            if (r < 0 || r >= h_out || q < 0 || q >= w_out) {
+                border_ok &= yq[i] == 0x5A5A5A5A;
+                continue;
+            }
+            const double e = fabs((double)yq[i] / Q_ONE - yf[i]);
+            if (e > max_err) max_err = e;
+            if (fabs(yf[i]) > max_y) max_y = fabs(yf[i]);
+        }
+        ratio = border_ok ? max_err / (max_y * 1e-3 + 4.0 / Q_ONE) : -1.0;
+    }
+    free(xf);
+    free(xq);
+    free(yf);
+    free(yq);
+    free(w8);
+    free(bias);
+    return ratio;
+}
+
+/* stem: uint8 CHW/HWC, FP32 이미지 → 정수 stem vs FP32 stem (같은 W8 가중치) */
+static int run_stem(void) {
+    enum { C = 3, H = 32, W = 40, OC = 16, K = 6, S = 2, P = 2, HO = 16, WO = 20, HALO = 1 };
+    static uint8_t px_chw[C * H * W], px_hwc[H * W * C];
+    static float img[C * H * W], w_t[OC * C * K * K];
+    static int8_t w8[OC * C * K * K];
+    static float yf[OC * HALO_PLANE(HO, WO, HALO)];
+    static int32_t yq[OC * HALO_PLANE(HO, WO, HALO)];
+    float bias[OC];
+    const float scale = 0.02f;
+    int ok = 1;
+    for (int32_t c = 0; c < C; c++)
+        for (int32_t i = 0; i < H * W; i++) {
+            const uint8_t v = (uint8_t)((frand() + 1.0f) * 127.5f);
+            px_chw[c * H * W + i] = v;
+            px_hwc[i * C + c] = v;
+            img[c * H * W + i] = (float)v / 255.0f;
+        }
+    for (int32_t i = 0; i < OC * C * K * K; i++) w8[i] = (int8_t)(frand() * 127.0f);
+    for (int32_t i = 0; i < OC; i++) bias[i] = frand();
+    conv2d_fold_u8_weights(w8, scale, 1, OC, C, K, K, w_t);
+    float* yfi = halo_interior(yf, WO, HALO);
+    int32_t* yqi = yq + (yfi - yf);
+    for (int fmt = 0; fmt < 3; fmt++) {
+        if (fmt == 0) {
+            conv2d_u8_f32_halo(px_chw, H * W, W, 1, C, H, W, w_t, OC, K, K, bias, S, S, P, P, yfi, HALO, HO, WO);
+            conv2d_image_q_w8_halo(px_chw, NULL, H * W, W, 1, C, H, W, w8, scale, OC, K, K, bias, S, S, P, P, yqi, HALO, HO, WO);
+        } else if (fmt == 1) {
+            conv2d_u8_f32_halo(px_hwc, 1, W * C, C, C, H, W, w_t, OC, K, K, bias, S, S, P, P, yfi, HALO, HO, WO);
+            conv2d_image_q_w8_halo(px_hwc, NULL, 1, W * C, C, C, H, W, w8, scale, OC, K, K, bias, S, S, P, P, yqi, HALO, HO, WO);
+        } else {
+            conv2d_nchw_f32_w8_halo(img, 0, 0, 1, C, H, W, w8, scale, OC, K, K, bias, S, S, P, P, 1, yfi, HALO, 0, HO, WO);
+            conv2d_image_q_w8_halo(NULL, img, H * W, W, 1, C, H, W, w8, scale, OC, K, K, bias, S, S, P, P, yqi, HALO, HO, WO);
+        }
+        double max_err = 0.0;
+        for (int32_t o = 0; o < OC; o++)
+            for (int32_t r = 0; r < HO; r++)
+                for (int32_t q = 0; q < WO; q++) {
+                    const size_t i = (size_t)o * HALO_PLANE(HO, WO, HALO) + (size_t)r * HALO_PITCH(WO, HALO) + q;
+                    const double e = fabs((double)yqi[i] / Q_ONE - yfi[i]);
+                    if (e > max_err) max_err = e;
+                }
+        printf("stem %-8s max |q - f32| = %.5f\n", fmt == 0 ? "u8 CHW" : fmt == 1 ? "u8 HWC" : "f32 CHW", max_err);
+        ok &= check(max_err < 0.01, "stem error");
+    }
+    return ok;
+}
+
+/* 합성 Detect 출력 (배경 로짓 낮음 + 물체 몇 개, 일부 겹침) → FP32 decode/NMS vs 정수 decode/NMS */
+static int run_decode_nms(void) {
+    enum { IN = 128, NC = 80, NO = 85 };
+    static const float strides_f[3] = {8.0f, 16.0f, 32.0f};
+    static const int32_t strides_q[3] = {8, 16, 32};
+    static const float anchors_f[3][6] = {
+        {10.0f, 13.0f, 16.0f, 30.0f, 33.0f, 23.0f},
+        {30.0f, 61.0f, 62.0f, 45.0f, 59.0f, 119.0f},
+        {116.0f, 90.0f, 156.0f, 198.0f, 373.0f, 326.0f}};
+    static const int32_t anchors_q[3][6] = {
+        {10, 13, 16, 30, 33, 23}, {30, 61, 62, 45, 59, 119}, {116, 90, 156, 198, 373, 326}};
+    static const struct { int scale, a, gy, gx, cls; float obj, cl, bx, by; } objs[] = {
+        {0, 0, 5, 6, 0, 3.0f, 2.5f, 0.3f, -0.2f},
+        {0, 1, 5, 6, 0, 1.5f, 2.0f, 0.1f, 0.4f},    /* 같은 칸 다른 anchor → 겹침 */
+        {0, 0, 5, 7, 0, 0.8f, 1.0f, -1.0f, 0.0f},   /* 이웃 칸 같은 클래스 */
+        {0, 2, 12, 3, 17, 2.0f, 3.0f, 0.0f, 0.0f},
+        {1, 0, 2, 2, 56, 1.2f, 1.4f, 0.5f, 0.5f},
+        {2, 1, 1, 2, 0, 0.5f, 4.0f, -0.5f, 0.2f},
+    };
+    const int32_t gh[3] = {IN / 8, IN / 16, IN / 32};
+    float* pf[3];
+    int32_t* pq[3];
+    int ok = 1;
+    for (int s = 0; s < 3; s++) {
+        const int32_t nn = NO * 3 * gh[s] * gh[s];
+        pf[s] = (float*)malloc((size_t)nn * sizeof(float));
+        pq[s] = (int32_t*)malloc((size_t)nn * sizeof(int32_t));
+        if (!pf[s] || !pq[s]) return 0;
+        for (int32_t i = 0; i < nn; i++) pf[s][i] = -4.0f + frand();
+    }
+    for (size_t k = 0; k < sizeof(objs) / sizeof(objs[0]); k++) {
+        const int s = objs[k].scale, g = gh[s] * gh[s], sp = objs[k].gy * gh[s] + objs[k].gx;
+        float* f = pf[s] + (size_t)objs[k].a * NO * g + sp;
+        f[0] = objs[k].bx;
+        f[g] = objs[k].by;
+        f[2 * g] = 0.2f * frand();
+        f[3 * g] = 0.2f * frand();
+        f[4 * g] = objs[k].obj;
+        f[(5 + objs[k].cls) * g] = objs[k].cl;
+    }
+    for (int s = 0; s < 3; s++) {
+        const int32_t nn = NO * 3 * gh[s] * gh[s];
+        for (int32_t i = 0; i < nn; i++) {
+            pq[s][i] = q_from_f32(pf[s][i], YOLO_Q_FRAC);
+            pf[s][i] = (float)pq[s][i] / Q_ONE;
+        }
+    }
+
+    static detection_t df[300], of[300], oq_f[300];
+    static detection_q_t dq[300], oq[300];
+    static uint8_t ws_buf[NMS_WORKSPACE_BYTES(300, NC)];
+    nms_workspace_t ws;
+    int32_t nf = 0, nq = 0;
+    if (nms_workspace_init(&ws, ws_buf, sizeof(ws_buf), 300, NC) != 0) return 0;
+    const int32_t cf = decode_nchw_f32_hw(pf[0], gh[0], gh[0], pf[1], gh[1], gh[1], pf[2], gh[2], gh[2], NC, 0.20f,
+                                          IN, IN, strides_f, anchors_f, df, 300);
+    det_sort_by_conf(df, cf);
+    nms_bucketed(df, cf, &ws, 0.45f, 300, of, &nf);
+    const int32_t cq = decode_nchw_q_hw(pq[0], gh[0], gh[0], pq[1], gh[1], gh[1], pq[2], gh[2], gh[2], NC,
+                                        q_from_f32(0.20f, 15), strides_q, anchors_q, dq, 300);
+    nms_q(dq, cq, &ws, q_from_f32(0.45f, 15), 300, oq, &nq);
+    detection_q_to_f32(oq, nq, IN, IN, oq_f);
+    printf("decode: f32 %d / q %d candidates, NMS: f32 %d / q %d kept\n", (int)cf, (int)cq, (int)nf, (int)nq);
+    ok &= check(cf == cq && nf == nq && nf >= 3 && nf < cf, "candidate / kept counts");
+    for (int32_t i = 0; ok && i < nf; i++) {
+        const int same = of[i].cls_id == oq_f[i].cls_id && fabsf(of[i].conf - oq_f[i].conf) < 2e-3f &&
+                         fabsf(of[i].x - oq_f[i].x) < 1e-3f && fabsf(of[i].y - oq_f[i].y) < 1e-3f &&
+                         fabsf(of[i].w - oq_f[i].w) < 1e-3f && fabsf(of[i].h - oq_f[i].h) < 1e-3f;
+        if (!same)
+            printf("  [%d] f32 cls %d %.4f (%.4f %.4f %.4f %.4f) / q cls %d %.4f (%.4f %.4f %.4f %.4f)\n", (int)i,
+                   (int)of[i].cls_id, of[i].conf, of[i].x, of[i].y, of[i].w, of[i].h, (int)oq_f[i].cls_id,
+                   oq_f[i].conf, oq_f[i].x, oq_f[i].y, oq_f[i].w, oq_f[i].h);
+        ok &= check(same, "kept detection matches");
+    }
+    for (int s = 0; s < 3; s++) {
+        free(pf[s]);
+        free(pq[s]);
+    }
+    return ok;
+}
+
+/* conf 동점 (Q15 양자화로 흔함): 클래스마다 같은 conf 박스 3개 (x 30·34·38, 겹침 4px만 억제)를 34, 38, 30 순으로 넣음.
+ * 입력 순서 안정 정렬이면 34만 남고, det_sort 동점 순서 (x 오름차순)면 30·38 → FP32 nms_bucketed와 같아야 함 */
+static int run_nms_ties(void) {
+    enum { NC = 4, CAP = 32, IN = 128 };
+    static const int32_t xs[3] = {34, 38, 30};
+    static detection_q_t dq[CAP], oq[CAP];
+    static detection_t df[CAP], of[CAP], oq_f[CAP];
+    static uint8_t ws_buf[NMS_WORKSPACE_BYTES(CAP, NC)];
+    nms_workspace_t ws;
+    int32_t n = 0, nf = 0, nq = 0;
+    int ok = 1;
+    if (nms_workspace_init(&ws, ws_buf, sizeof(ws_buf), CAP, NC) != 0) return 0;
+    for (int32_t c = NC - 1; c >= 0; c--)
+        for (int32_t k = 0; k < 3; k++) {
+            detection_q_t* d = &dq[n++];
+            d->x = xs[k] << DET_Q_FRAC;
+            d->y = (50 + 20 * c) << DET_Q_FRAC;
+            d->w = 20 << DET_Q_FRAC;
+            d->h = 20 << DET_Q_FRAC;
+            d->conf = q_from_f32(0.5f, 15);
+            d->cls_id = c;
+        }
+    detection_q_to_f32(dq, n, IN, IN, df);
+    det_sort_by_conf(df, n);
+    nms_bucketed(df, n, &ws, 0.45f, CAP, of, &nf);
+    nms_q(dq, n, &ws, q_from_f32(0.45f, 15), CAP, oq, &nq);
+    detection_q_to_f32(oq, nq, IN, IN, oq_f);
+    printf("NMS tied conf: f32 %d / q %d kept\n", (int)nf, (int)nq);
+    ok &= check(nf == 2 * NC && nq == nf, "tied conf kept count");
+    for (int32_t i = 0; ok && i < nf; i++)
+        ok &= check(of[i].cls_id == oq_f[i].cls_id && of[i].x == oq_f[i].x && of[i].y == oq_f[i].y,
+                    "tied conf kept detection matches");
+    return ok;
+}
+
+int main(void) {
+    printf("=== Fixed-Point (Q%d) Path Test ===\n\n", YOLO_Q_FRAC);
+    int ok = 1;
+
+    /* 1. float 비트 → Q */
+    {
+        static const float v[] = {0.0f, 1.0f, -1.0f, 0.5f / Q_ONE, 1.5f / Q_ONE, -1.5f / Q_ONE, 3.14159f, -2047.9f,
+                                  1e-9f, 123.456f, -0.000244f};
+        int conv_ok = 1;
+        for (size_t i = 0; i < sizeof(v) / sizeof(v[0]); i++) {
+            const int32_t q = q_from_f32(v[i], YOLO_Q_FRAC);
+            const double ref = (double)v[i] * Q_ONE;
+            const long r = ref >= 0 ? (long)floor(ref + 0.5) : -(long)floor(-ref + 0.5);   /* 절댓값 반올림 */
+            if (q != r) { printf("  q_from_f32(%g) = %d, expected %ld\n", v[i], (int)q, r); conv_ok = 0; }
+        }
+        conv_ok &= q_from_f32(1e10f, YOLO_Q_FRAC) == INT32_MAX && q_from_f32(-1e10f, YOLO_Q_FRAC) == -INT32_MAX;
+        conv_ok &= q_from_f32(1e-40f, YOLO_Q_FRAC) == 0 && q_from_f32(INFINITY, 15) == INT32_MAX;
+        conv_ok &= q_from_f32(0.45f, 15) == 14746 && q_sat(q_from_f32(1e10f, YOLO_Q_FRAC)) == YOLO_Q_MAX;
+        ok &= check(conv_ok, "q_from_f32");
+        printf("q_from_f32: rounding / saturation / denormal checked\n");
+    }
+
+    /* 2. 재양자화: acc × scale */
+    {
+        static const float scales[] = {0.0123f, 1.7e-4f, 0.9f, 3.0f};
+        double worst = 0.0;
+        for (size_t si = 0; si < sizeof(scales) / sizeof(scales[0]); si++) {
+            const q_requant_t r = q_requant_from_f32(scales[si], 0);
+            for (int i = 0; i < 1000; i++) {
+                const int64_t acc = (int64_t)(frand() * 4.0e9);
+                const double ref = (double)acc * scales[si];
+                const double e = fabs((double)q_requant(acc, r) - ref) / (fabs(ref) * 3.1e-5 + 1.0);
+                if (e > worst) worst = e;
+            }
+        }
+        printf("requant: worst error %.3f of bound (|ref| x 2^-15 + 1 LSB)\n", worst);
+        ok &= check(worst <= 1.0, "requant error");
+    }
+
+    /* 3. sigmoid / SiLU 표 */
+    {
+        double e_sig = 0.0, e_silu = 0.0;
+        for (int32_t xq = -12 * Q_ONE; xq <= 12 * Q_ONE; xq += 7) {
+            const double x = (double)xq / Q_ONE, s = 1.0 / (1.0 + exp(-x));
+            int32_t yq;
+            const double es = fabs(sigmoid_q15(xq) / 32768.0 - s);
+            silu_nchw_q(&xq, 1, 1, 1, 1, &yq);
+            const double el = fabs((double)yq / Q_ONE - x * s);
+            if (es > e_sig) e_sig = es;
+            if (el > e_silu) e_silu = el;
+        }
+        printf("sigmoid_q15 max err %.2e, silu_q max err %.2e (x in [-12, 12])\n", e_sig, e_silu);
+        ok &= check(e_sig < 4e-4 && e_silu < 3e-3, "sigmoid / silu LUT error");
+    }
+
+    /* 4. 정수 conv vs W8 FP32 conv */
+    {
+        static const case_t cases[] = {
+            {1, 16, 40, 40, 32, 3, 2, 1, 1, 0},     /* 3x3 s2, halo 입력 */
+            {2, 32, 20, 20, 32, 1, 1, 0, 0, 1},     /* 1x1 배치 2, halo 출력 */
+            {1, 64, 20, 20, 48, 3, 1, 1, 1, 1},     /* oc 나머지, halo 입출력 */
+            {1, 24, 13, 11, 20, 3, 1, 1, 0, 0},     /* 경계 경로 (halo 없음), 타일 나머지 */
+            {1, 128, 10, 10, 255, 1, 1, 0, 1, 0},   /* Detect 헤드형 255 출력 */
+        };
+        double worst = 0.0;
+        for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+            const double r = run_conv_case(&cases[i]);
+            if (r < 0.0 || r > 1.0) {
+                printf("ERROR: conv case %d (ratio %.3f)\n", (int)i, r);
+                ok = 0;
+            }
+            if (r > worst) worst = r;
+        }
+        printf("conv q vs w8 f32: %d cases, worst error %.3f of bound (|y|max x 1e-3 + 4 LSB), borders kept\n",
+               (int)(sizeof(cases) / sizeof(cases[0])), worst);
+    }
+
+    /* 5. stem */
+    ok &= run_stem();
+
+    /* 6. maxpool: Q 값은 float에서 정확히 표현 → 결과 정확 일치 */
+    {
+        enum { C = 4, H = 9, W = 7 };
+        int32_t xq[C * H * W], yq[C * H * W];
+        float xf[C * H * W], yf[C * H * W];
+        int same = 1;
+        for (int32_t i = 0; i < C * H * W; i++) {
+            xq[i] = q_from_f32(frand() * 8.0f, YOLO_Q_FRAC);
+            xf[i] = (float)xq[i] / Q_ONE;
+        }
+        maxpool2d_nchw_q(xq, 1, C, H, W, 5, 1, 2, yq, H, W);
+        maxpool2d_nchw_f32(xf, 1, C, H, W, 5, 1, 2, yf, H, W);
+        for (int32_t i = 0; i < C * H * W; i++) same &= (float)yq[i] / Q_ONE == yf[i];
+        ok &= check(same, "maxpool q == f32");
+        printf("maxpool 5x5: q == f32\n");
+    }
+
+    /* 7. decode + NMS */
+    ok &= run_decode_nms();
+    ok &= run_nms_ties();
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
@@ -0,0 +1,167 @@
+/* uint8 이미지 형식 테스트: 헤더 형식 플래그 파싱, 메모리 zero-copy / 파일 로드,
+ * uint8 CHW/HWC 추론 == FP32 추론 (/255를 L0 가중치에 접음, 오차 범위), L0 지연·이미지 크기. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../csrc/blocks/yolov5n.h"
+#include "../csrc/utils/image_loader.h"
+
+#ifdef USE_WEIGHTS_W8
+#define WEIGHTS_PATH "assets/weights_w8.bin"
+#else
+#define WEIGHTS_PATH "assets/weights.bin"
+#endif
+
+#define HEADER_BYTES 24
+#define TMP_PATH     "data/output/test_image_u8.bin"
+#define BOX_TOL      1e-3f  /* normalized (640 기준 0.64px) */
+#define CONF_TOL     1e-3f
+
+static detection_t dets[3][YOLO_MAX_DETECTIONS];
+
+/* FP32 이미지 → 헤더 24B + uint8 픽셀 블롭 (FP32 파일은 u8/255라 반올림하면 원래 픽셀) */
+static uint8_t* make_u8_blob(const preprocessed_image_t* src, uint32_t fmt, size_t* bytes) {
+    const int32_t h = src->h, w = src->w;
+    *bytes = HEADER_BYTES + (size_t)3 * h * w;
+    uint8_t* blob = (uint8_t*)malloc(*bytes);
+    if (!blob) return NULL;
+    const uint32_t hdr[6] = {(uint32_t)src->original_w, (uint32_t)src->original_h, 0u, (uint32_t)src->pad_x,
+                             (uint32_t)src->pad_y, (fmt << 28) | (h == w ? 0u : (uint32_t)h << 16) | (uint32_t)w};
+    memcpy(blob, hdr, sizeof(hdr));
+    memcpy(blob + 8, &src->scale, 4);
+    uint8_t* px = blob + HEADER_BYTES;
+    for (int32_t c = 0; c < 3; c++)
+        for (int32_t y = 0; y < h; y++)
+            for (int32_t x = 0; x < w; x++) {
+                const float v = src->data[((size_t)c * h + y) * w + x] * 255.0f + 0.5f;
+                const uint8_t u = (uint8_t)(v < 0.0f ? 0.0f : v > 255.0f ? 255.0f : v);
+                if (fmt == IMAGE_FMT_U8_HWC) px[((size_t)y * w + x) * 3 + c] = u;
+                else px[((size_t)c * h + y) * w + x] = u;
+            }
+    return blob;
+}
+
+static int close_dets(const detection_t* a, int32_t na, const detection_t* b, int32_t nb) {
+    if (na != nb) return 0;
+    for (int32_t i = 0; i < na; i++) {
+        if (a[i].cls_id != b[i].cls_id || fabsf(a[i].conf - b[i].conf) > CONF_TOL || fabsf(a[i].x - b[i].x) > BOX_TOL ||
+            fabsf(a[i].y - b[i].y) > BOX_TOL || fabsf(a[i].w - b[i].w) > BOX_TOL || fabsf(a[i].h - b[i].h) > BOX_TOL)
+            return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    printf("=== uint8 Image Format Test ===\n\n");
+    int ok = 1;
+    preprocessed_image_t f32, chw, hwc, file;
+    static yolo_ctx_t ctx;
+    int32_t cnt[3] = {0, 0, 0};
+    size_t bytes = 0;
+
+    if (image_load_from_bin("data/input/preprocessed_image.bin", &f32) != 0) {
+        fprintf(stderr, "Failed to load image\n");
+        return 1;
+    }
+    if (f32.format != IMAGE_FMT_F32_CHW || !f32.data || f32.data_u8) { printf("ERROR: legacy header format\n"); ok = 0; }
+    uint8_t* blob_chw = make_u8_blob(&f32, IMAGE_FMT_U8_CHW, &bytes);
+    uint8_t* blob_hwc = make_u8_blob(&f32, IMAGE_FMT_U8_HWC, &bytes);
+    if (!blob_chw || !blob_hwc) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    /* 1. 메모리: 헤더 파싱 + 픽셀 제자리 참조 (복사 없음) */
+    if (image_init_from_memory((uintptr_t)blob_chw, bytes, &chw) != 0 || chw.format != IMAGE_FMT_U8_CHW ||
+        chw.data_u8 != blob_chw + HEADER_BYTES || chw.data || chw.data_owned || chw.w != f32.w || chw.h != f32.h ||
+        chw.pad_y != f32.pad_y || chw.scale != f32.scale || image_data_bytes(&chw) * 4 != image_data_bytes(&f32)) {
+        printf("ERROR: uint8 CHW from memory\n");
+        ok = 0;
+    }
+    if (image_init_from_memory((uintptr_t)blob_hwc, bytes, &hwc) != 0 || hwc.format != IMAGE_FMT_U8_HWC ||
+        hwc.data_u8 != blob_hwc + HEADER_BYTES) {
+        printf("ERROR: uint8 HWC from memory\n");
+        ok = 0;
+    }
+
+    /* 2. 파일: 픽셀 버퍼 하나로 직접 읽기 */
+    {
+        FILE* fp = fopen(TMP_PATH, "wb");
+        const int wrote = fp && fwrite(blob_hwc, 1, bytes, fp) == bytes;
+        if (fp) fclose(fp);
+        if (!wrote || image_load_from_bin(TMP_PATH, &file) != 0 || file.format != IMAGE_FMT_U8_HWC ||
+            !file.data_owned || memcmp(file.data_u8, blob_hwc + HEADER_BYTES, bytes - HEADER_BYTES) != 0) {
+            printf("ERROR: uint8 HWC from file\n");
+            ok = 0;
+        }
+        image_free(&file);
+        remove(TMP_PATH);
+    }
+
+    /* 3. 잘못된 형식 / 잘린 데이터 → -1 */
+    {
+        preprocessed_image_t bad;
+        uint8_t hdr[HEADER_BYTES];
+        memcpy(hdr, blob_chw, HEADER_BYTES);
+        hdr[23] = (uint8_t)((hdr[23] & 0x0Fu) | 0x30u);  /* 형식 3 */
+        if (image_init_from_memory((uintptr_t)hdr, sizeof(hdr), &bad) != -1 ||
+            image_init_from_memory((uintptr_t)blob_chw, bytes - 1, &bad) != -1) {
+            printf("ERROR: bad image accepted\n");
+            ok = 0;
+        }
+    }
+
+    /* 4. 추론: FP32 / uint8 CHW / uint8 HWC */
+    if (yolo_ctx_init_from_file(&ctx, WEIGHTS_PATH) != 0) {
+        fprintf(stderr, "Failed to init context (%s)\n", WEIGHTS_PATH);
+        return 1;
+    }
+    ctx.verbose = 0;
+    const preprocessed_image_t* imgs[3] = {&f32, &chw, &hwc};
+    uint64_t l0[3];
+    for (int i = 0; i < 3 && ok; i++) {
+        if (yolo_infer(&ctx, imgs[i], dets[i], YOLO_MAX_DETECTIONS, &cnt[i]) != 0 || cnt[i] <= 0) {
+            printf("ERROR: inference %d\n", i);
+            ok = 0;
+        }
+        l0[i] = ctx.profile.layer[0];
+    }
+    if (ok && !close_dets(dets[0], cnt[0], dets[1], cnt[1])) { printf("ERROR: uint8 CHW differs from FP32\n"); ok = 0; }
+    /* CHW/HWC는 누적 순서가 같아 비트 동일 */
+    if (ok && (cnt[1] != cnt[2] || memcmp(dets[1], dets[2], (size_t)cnt[1] * sizeof(detection_t)) != 0)) {
+        printf("ERROR: uint8 HWC differs from CHW\n");
+        ok = 0;
+    }
+    /* 배치 안에서 형식 섞기 */
+    if (ok) {
+        static detection_t bd[3][YOLO_MAX_DETECTIONS];
+        int32_t bc[3];
+        if (yolo_infer_batch(&ctx, imgs, 3, &bd[0][0], YOLO_MAX_DETECTIONS, bc) != 0 ||
+            memcmp(bd[0], dets[0], (size_t)cnt[0] * sizeof(detection_t)) != 0 ||
+            memcmp(bd[2], dets[2], (size_t)cnt[2] * sizeof(detection_t)) != 0) {
+            printf("ERROR: mixed-format batch\n");
+            ok = 0;
+        }
+    }
+    printf("image %u KB (FP32) -> %u KB (uint8)\n", (unsigned)(image_data_bytes(&f32) / 1024u),
+           (unsigned)(image_data_bytes(&chw) / 1024u));
+    printf("detections %d / %d / %d, L0 FP32 %.2f ms | uint8 CHW %.2f ms | uint8 HWC %.2f ms\n",
+           (int)cnt[0], (int)cnt[1], (int)cnt[2], l0[0] / 1000.0, l0[1] / 1000.0, l0[2] / 1000.0);
+
+    yolo_ctx_destroy(&ctx);
+    image_free(&chw);
+    image_free(&hwc);
+    image_free(&f32);
+    free(blob_chw);
+    free(blob_hwc);
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
@@ -0,0 +1,152 @@
+/* C letterbox 전처리 테스트: PPM 원본 → preprocessed_image.bin (Python PIL 도구)과 같은 헤더/픽셀 (±1/255),
+ * 형식(FP32/uint8 CHW/HWC)·rect 출력 일관성, 확대/같은 크기 입력, 잘못된 인자, 형식별 frames/s.
+ * 준비: python tools/preprocess_image_to_bin.py --img data/image/zidane.jpg \
+ *         --out data/input/preprocessed_image.bin --ppm data/input/zidane.ppm */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../csrc/utils/letterbox.h"
+#include "../csrc/utils/image_loader.h"
+#include "../csrc/utils/mcycle.h"
+
+#define PPM_PATH   "data/input/zidane.ppm"
+#define REF_PATH   "data/input/preprocessed_image.bin"
+#define PIX_TOL    (1.0f / 255.0f + 1e-6f)
+#define BENCH_ITER 20
+
+static int same_header(const preprocessed_image_t* a, const preprocessed_image_t* b) {
+    return a->w == b->w && a->h == b->h && a->original_w == b->original_w && a->original_h == b->original_h &&
+           a->scale == b->scale && a->pad_x == b->pad_x && a->pad_y == b->pad_y;
+}
+
+int main(void) {
+    printf("=== Letterbox Preprocessing Test ===\n\n");
+    int ok = 1;
+    uint8_t* rgb = NULL;
+    int32_t src_w = 0, src_h = 0;
+    preprocessed_image_t ref, f32, chw, hwc, rect;
+    letterbox_t lb, lb_rect;
+
+    if (letterbox_load_ppm(PPM_PATH, &rgb, &src_w, &src_h) != 0 || image_load_from_bin(REF_PATH, &ref) != 0) {
+        fprintf(stderr, "Failed to load %s / %s (preprocess_image_to_bin.py --ppm)\n", PPM_PATH, REF_PATH);
+        return 1;
+    }
+    if (letterbox_init(&lb, src_w, src_h, 640, 0) != 0 || letterbox_init(&lb_rect, src_w, src_h, 640, 1) != 0) {
+        fprintf(stderr, "letterbox_init failed\n");
+        return 1;
+    }
+    float* buf_f32 = (float*)malloc(letterbox_out_bytes(&lb, IMAGE_FMT_F32_CHW));
+    uint8_t* buf_chw = (uint8_t*)malloc(letterbox_out_bytes(&lb, IMAGE_FMT_U8_CHW));
+    uint8_t* buf_hwc = (uint8_t*)malloc(letterbox_out_bytes(&lb, IMAGE_FMT_U8_HWC));
+    uint8_t* buf_rect = (uint8_t*)malloc(letterbox_out_bytes(&lb_rect, IMAGE_FMT_U8_HWC));
+    if (!buf_f32 || !buf_chw || !buf_hwc || !buf_rect) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    /* 1. FP32 CHW vs Python 도구 출력: 헤더 동일, 픽셀 ±1/255 */
+    if (letterbox_run(&lb, rgb, 0, IMAGE_FMT_F32_CHW, buf_f32, &f32) != 0 || !same_header(&f32, &ref)) {
+        printf("ERROR: header differs from Python (%dx%d pad %d,%d)\n", (int)f32.w, (int)f32.h, (int)f32.pad_x, (int)f32.pad_y);
+        ok = 0;
+    } else {
+        const size_t n = (size_t)3 * ref.h * ref.w;
+        size_t exact = 0;
+        float max_diff = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            const float d = fabsf(f32.data[i] - ref.data[i]);
+            if (d == 0.0f) exact++;
+            if (d > max_diff) max_diff = d;
+        }
+        if (max_diff > PIX_TOL) { printf("ERROR: pixel diff %.6f > 1/255\n", max_diff); ok = 0; }
+        printf("vs Python: %dx%d -> %dx%d (resize %dx%d), %zu/%zu pixels exact, max diff %.6f\n",
+               (int)src_w, (int)src_h, (int)f32.w, (int)f32.h, (int)lb.new_w, (int)lb.new_h, exact, n, max_diff);
+    }
+
+    /* 2. uint8 CHW/HWC = FP32 * 255, rect 내용 = 정사각형 내용 (같은 리사이즈, 패딩만 다름) */
+    if (letterbox_run(&lb, rgb, 0, IMAGE_FMT_U8_CHW, buf_chw, &chw) != 0 ||
+        letterbox_run(&lb, rgb, 0, IMAGE_FMT_U8_HWC, buf_hwc, &hwc) != 0 ||
+        letterbox_run(&lb_rect, rgb, 0, IMAGE_FMT_U8_HWC, buf_rect, &rect) != 0 ||
+        chw.format != IMAGE_FMT_U8_CHW || hwc.data_u8 != buf_hwc || hwc.data || rect.h != 384 || rect.w != 640) {
+        printf("ERROR: uint8 / rect run\n");
+        ok = 0;
+    } else {
+        const size_t plane = (size_t)chw.h * chw.w;
+        int bad = 0;
+        for (int32_t c = 0; c < 3 && !bad; c++)
+            for (size_t i = 0; i < plane; i++) {
+                const uint8_t u = chw.data_u8[c * plane + i];
+                if (u != hwc.data_u8[i * 3 + c] || (float)u / 255.0f != f32.data[c * plane + i]) { bad = 1; break; }
+            }
+        const int32_t dy = chw.pad_y - rect.pad_y;
+        for (int32_t y = 0; y < rect.h && !bad; y++)
+            if (memcmp(rect.data_u8 + (size_t)y * rect.w * 3, hwc.data_u8 + (size_t)(y + dy) * hwc.w * 3, (size_t)rect.w * 3) != 0)
+                bad = 1;
+        if (bad) { printf("ERROR: formats / rect inconsistent\n"); ok = 0; }
+    }
+
+    /* 3. 같은 크기(640x360 → 배율 1)는 그대로 복사, 확대(100x60 → 640x384)도 동작 */
+    {
+        letterbox_t lb_id, lb_up;
+        preprocessed_image_t id, up;
+        static uint8_t small[60 * 100 * 3], out_id[640 * 640 * 3], out_up[640 * 640 * 3];
+        const uint8_t* src_id = hwc.data_u8 + (size_t)hwc.pad_y * hwc.w * 3;  /* 640x360 내용 */
+        for (size_t i = 0; i < sizeof(small); i++) small[i] = (uint8_t)(i * 7u);
+        if (letterbox_init(&lb_id, 640, 360, 640, 0) != 0 ||
+            letterbox_run(&lb_id, src_id, 640 * 3, IMAGE_FMT_U8_HWC, out_id, &id) != 0 ||
+            memcmp(out_id, hwc.data_u8, sizeof(out_id)) != 0) {
+            printf("ERROR: identity resize\n");
+            ok = 0;
+        }
+        if (letterbox_init(&lb_up, 100, 60, 640, 1) != 0 || lb_up.new_w != 640 || lb_up.new_h != 384 ||
+            letterbox_run(&lb_up, small, 0, IMAGE_FMT_U8_HWC, out_up, &up) != 0) {
+            printf("ERROR: upscale\n");
+            ok = 0;
+        }
+        letterbox_free(&lb_id);
+        letterbox_free(&lb_up);
+    }
+
+    /* 4. 잘못된 인자 → -1 */
+    {
+        letterbox_t bad;
+        if (letterbox_init(&bad, 0, 720, 640, 0) != -1 || letterbox_init(&bad, 1280, 720, 8, 0) != -1 ||
+            letterbox_run(&lb, rgb, 0, 7u, buf_hwc, &hwc) != -1 || letterbox_run(&lb, NULL, 0, 0u, buf_f32, &f32) != -1) {
+            printf("ERROR: bad arguments accepted\n");
+            ok = 0;
+        }
+    }
+
+    /* 5. frames/s (1280x720 → 640, 계수 준비 제외) */
+    {
+        static const uint32_t fmts[3] = {IMAGE_FMT_F32_CHW, IMAGE_FMT_U8_CHW, IMAGE_FMT_U8_HWC};
+        static const char* names[3] = {"FP32 CHW", "uint8 CHW", "uint8 HWC"};
+        void* bufs[3] = {buf_f32, buf_chw, buf_hwc};
+        preprocessed_image_t tmp;
+        printf("\n format    | ms/frame | frames/s\n");
+        for (int f = 0; f < 3; f++) {
+            const uint64_t t0 = timer_read64();
+            for (int it = 0; it < BENCH_ITER; it++) letterbox_run(&lb, rgb, 0, fmts[f], bufs[f], &tmp);
+            const double ms = timer_delta64(t0, timer_read64()) / 1000.0 / BENCH_ITER;
+            printf(" %-9s | %8.3f | %8.1f\n", names[f], ms, ms > 0.0 ? 1000.0 / ms : 0.0);
+        }
+    }
+
+    letterbox_free(&lb);
+    letterbox_free(&lb_rect);
+    free(buf_f32);
+    free(buf_chw);
+    free(buf_hwc);
+    free(buf_rect);
+    free(rgb);
+    image_free(&ref);
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
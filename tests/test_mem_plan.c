@@ -0,0 +1,164 @@
+/* 정적 메모리 계획 테스트: YOLOv5n 이벤트 열 → 오프셋 배치 검증, feature_pool 재생, 동적 할당자 대비 peak, 풀 계측. */
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../csrc/utils/mem_plan.h"
+#include "../csrc/utils/feature_pool.h"
+#include "../csrc/utils/mcycle.h"
+
+/* 수명이 겹치는 텐서끼리 주소 구간이 겹치지 않는지 + 정렬 + peak 범위 */
+static int check_plan(const mem_plan_t* p) {
+    for (int32_t i = 0; i < p->num_tensors; i++) {
+        const mem_plan_tensor_t* a = &p->tensors[i];
+        if (a->offset % MEM_PLAN_ALIGN != 0 || a->offset + a->size > p->peak) return 0;
+        for (int32_t j = i + 1; j < p->num_tensors; j++) {
+            const mem_plan_tensor_t* b = &p->tensors[j];
+            const int live = a->first <= b->last && b->first <= a->last;
+            const int mem = a->offset < b->offset + b->size && b->offset < a->offset + a->size;
+            if (live && mem) {
+                printf("ERROR: tensor %d and %d overlap\n", (int)i, (int)j);
+                return 0;
+            }
+        }
+    }
+    return p->peak >= p->live_peak;
+}
+
+int main(void) {
+    printf("=== Memory Plan Test ===\n\n");
+    int ok = 1;
+    static mem_plan_t plan;
+
+    /* 1. 작은 그래프: A,B 동시 생존 → C는 A 자리 재사용 (64B 정렬: 100→128, 40→64) */
+    mem_plan_init(&plan);
+    {
+        int32_t a = mem_plan_alloc(&plan, 100);
+        int32_t b = mem_plan_alloc(&plan, 40);
+        mem_plan_free(&plan, a);
+        int32_t c = mem_plan_alloc(&plan, 96);
+        mem_plan_free(&plan, b);
+        mem_plan_free(&plan, c);
+        if (mem_plan_assign(&plan) != 0 || !check_plan(&plan) ||
+            plan.tensors[c].offset != plan.tensors[a].offset || plan.peak != 128 + 64) {
+            printf("ERROR: small graph (peak=%u)\n", (unsigned)plan.peak);
+            ok = 0;
+        }
+        mem_plan_free(&plan, a);  /* 이중 free → error */
+        if (!plan.error || mem_plan_assign(&plan) == 0) { printf("ERROR: double free not detected\n"); ok = 0; }
+    }
+
+    /* 2. YOLOv5n 계획 (호스트: head 포함 / 보드: head 제외) */
+    for (int head = 1; head >= 0; head--) {
+        if (mem_plan_build_yolov5n(&plan, 1, head) != 0 || !check_plan(&plan)) {
+            printf("ERROR: yolov5n plan (head_in_pool=%d)\n", head);
+            ok = 0;
+            continue;
+        }
+        printf("head_in_pool=%d: %d tensors, planned peak %u KB, live lower bound %u KB\n",
+               head, (int)plan.num_tensors, (unsigned)(plan.peak / 1024u), (unsigned)(plan.live_peak / 1024u));
+    }
+
+    /* 3. feature_pool 재생: 동적 할당 high-water 측정 후 계획 모드에서 같은 순서로 alloc */
+    feature_pool_init();
+    mem_plan_build_yolov5n(&plan, 1, 1);
+    const size_t ff_high = feature_pool_dry_run(&plan);
+    printf("\nallocator high-water %u KB vs planned peak %u KB (%.1f%%)\n",
+           (unsigned)(ff_high / 1024u), (unsigned)(plan.peak / 1024u),
+           ff_high ? 100.0 * (double)plan.peak / (double)ff_high : 0.0);
+    if (ff_high == 0 || plan.peak > ff_high) { printf("ERROR: plan worse than allocator\n"); ok = 0; }
+
+    if (feature_pool_use_plan(&plan) != 0) { printf("ERROR: use_plan\n"); ok = 0; }
+    for (int pass = 0; pass < 2 && ok; pass++) {
+        feature_pool_plan_rewind();
+        uint8_t* first = NULL;
+        for (int32_t e = 0; e < plan.num_events; e++) {
+            const int32_t ev = plan.events[e];
+            if (ev < 0) { feature_pool_free(NULL); continue; }
+            uint8_t* ptr = (uint8_t*)feature_pool_alloc(plan.tensors[ev].size);
+            if (!first) first = ptr;
+            if (!ptr || (size_t)(ptr - first) != plan.tensors[ev].offset - plan.tensors[0].offset) {
+                printf("ERROR: replay address mismatch at tensor %d (pass %d)\n", (int)ev, pass);
+                ok = 0;
+                break;
+            }
+        }
+    }
+    feature_pool_plan_rewind();
+    if (feature_pool_alloc(plan.tensors[0].size + 4) != NULL) {
+        printf("ERROR: size mismatch must fail in plan mode\n");
+        ok = 0;
+    }
+    if (feature_pool_get_high_water() != plan.peak) { printf("ERROR: high-water in plan mode\n"); ok = 0; }
+
+    /* 4. alloc/free 비용: 전체 이벤트 열 1회 (동적 할당 vs 계획 O(1)) */
+    {
+        const int reps = 2000;
+        void* ptrs[MEM_PLAN_MAX_TENSORS];
+        feature_pool_use_plan(NULL);
+        uint64_t t0 = timer_read64();
+        for (int r = 0; r < reps; r++) {
+            for (int32_t e = 0; e < plan.num_events; e++) {
+                const int32_t ev = plan.events[e];
+                if (ev >= 0) ptrs[ev] = feature_pool_alloc(plan.tensors[ev].size);
+                else feature_pool_free(ptrs[~ev]);
+            }
+        }
+        const uint64_t t_ff = timer_delta64(t0, timer_read64());
+        feature_pool_use_plan(&plan);
+        t0 = timer_read64();
+        for (int r = 0; r < reps; r++) {
+            feature_pool_plan_rewind();
+            for (int32_t e = 0; e < plan.num_events; e++) {
+                const int32_t ev = plan.events[e];
+                if (ev >= 0) ptrs[ev] = feature_pool_alloc(plan.tensors[ev].size);
+                else feature_pool_free(ptrs[~ev]);
+            }
+        }
+        const uint64_t t_plan = timer_delta64(t0, timer_read64());
+        printf("per-frame pool ops (%d events): allocator %.2f us, planned %.2f us\n",
+               (int)plan.num_events, (double)t_ff / reps, (double)t_plan / reps);
+    }
+    /* 5. 풀 계측: 동적 할당으로 한 프레임 재생 → 기록/peak/수명/타임라인 */
+    {
+        void* ptrs[MEM_PLAN_MAX_TENSORS];
+        feature_pool_use_plan(NULL);
+        feature_pool_stats_reset();
+        for (int32_t e = 0; e < plan.num_events; e++) {
+            const int32_t ev = plan.events[e];
+            feature_pool_set_layer(e / 8);  /* 임의 레이어 번호 */
+            if (ev >= 0) ptrs[ev] = feature_pool_alloc(plan.tensors[ev].size);
+            else feature_pool_free(ptrs[~ev]);
+        }
+        feature_pool_stats_t st;
+        int32_t nrec = 0;
+        const feature_pool_record_t* rec = feature_pool_get_records(&nrec);
+        feature_pool_get_stats(&st);
+        int stats_ok = st.num_allocs == plan.num_tensors && st.num_frees == plan.num_tensors &&
+                       st.failed_allocs == 0 && nrec == plan.num_tensors && st.live_bytes == 0 &&
+                       st.peak_live_bytes == plan.live_peak && st.high_water == ff_high &&
+                       st.free_blocks == 1 && st.fragmentation == 0.0f;
+        for (int32_t i = 0; i < nrec && stats_ok; i++) {
+            const mem_plan_tensor_t* t = &plan.tensors[i];
+            stats_ok = rec[i].size == t->size && rec[i].alloc_event == t->first && rec[i].free_event == t->last &&
+                       rec[i].layer == t->first / 8 && rec[i].free_layer == t->last / 8 &&
+                       rec[i].offset == (size_t)((uint8_t*)ptrs[i] - (uint8_t*)ptrs[0]) + rec[0].offset;
+        }
+        if (!stats_ok) { printf("ERROR: pool stats/records\n"); ok = 0; }
+        printf("pool stats: peak live %u KB @ layer %d, peak fragmentation %.3f\n",
+               (unsigned)(st.peak_live_bytes / 1024u), (int)st.peak_layer, st.peak_fragmentation);
+        if (feature_pool_export_timeline("tests/pool_timeline_test.csv") != 0) {
+            printf("ERROR: timeline export\n");
+            ok = 0;
+        }
+        remove("tests/pool_timeline_test.csv");
+    }
+    feature_pool_reset();
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
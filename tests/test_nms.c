@@ -5,6 +5,8 @@
 
 #include "test_vectors_nms.h"
 #include "../csrc/blocks/nms.h"
+#include "../csrc/blocks/det_sort.h"
+#include "../csrc/utils/mcycle.h"
 
 static float max_abs_diff(const float* a, const float* b, int n) {
     float m = 0.0f;
@@ -15,16 +17,42 @@ static float max_abs_diff(const float* a, const float* b, int n) {
     return m;
 }
 
-static void sort_detections_by_conf(detection_t* detections, int32_t num) {
-    for (int i = 0; i < num - 1; i++) {
-        for (int j = 0; j < num - 1 - i; j++) {
-            if (detections[j].conf < detections[j + 1].conf) {
-                detection_t temp = detections[j];
-                detections[j] = detections[j + 1];
-                detections[j + 1] = temp;
-            }
-        }
+/* nms_bucketed 결과가 nms()와 비트 단위로 같은지 (동일 입력 사본 사용).
+ * grid_min: ws.grid_min_candidates (0: 항상 그리드, INT32_MAX: 전수 루프만, -1: nms_bitmask) */
+static int compare_bucketed_with_nms(const detection_t* src, int32_t num, int32_t num_classes,
+                                     float iou_thr, int32_t max_det, int32_t grid_min) {
+    const size_t ws_bytes = nms_workspace_size(num, num_classes);
+    uint8_t* scratch = (uint8_t*)malloc(ws_bytes);
+    detection_t* a = (detection_t*)malloc((size_t)num * sizeof(detection_t) + 1);
+    detection_t* b = (detection_t*)malloc((size_t)num * sizeof(detection_t) + 1);
+    detection_t* out_b = (detection_t*)malloc((size_t)num * sizeof(detection_t) + 1);
+    detection_t* out_a = NULL;
+    int32_t cnt_a = 0, cnt_b = 0;
+    int ok = scratch && a && b && out_b;
+    if (ok) {
+        memcpy(a, src, (size_t)num * sizeof(detection_t));
+        memcpy(b, src, (size_t)num * sizeof(detection_t));
+        ok = nms(a, num, &out_a, &cnt_a, iou_thr, max_det) == 0;
+    }
+    nms_workspace_t ws;
+    if (ok) {
+        ok = nms_workspace_init(&ws, scratch, ws_bytes, num, num_classes) == 0;
     }
+    if (ok) {
+        ws.grid_min_candidates = grid_min;
+        ok = (grid_min < 0 ? nms_bitmask(b, num, &ws, iou_thr, max_det, out_b, &cnt_b)
+                           : nms_bucketed(b, num, &ws, iou_thr, max_det, out_b, &cnt_b)) == 0 &&
+             cnt_a == cnt_b &&
+             (cnt_a == 0 || memcmp(out_a, out_b, (size_t)cnt_a * sizeof(detection_t)) == 0);
+    }
+    free(out_a); free(scratch); free(a); free(b); free(out_b);
+    return ok;
+}
+
+static uint32_t rng_state = 2024u;
+static uint32_t rng_next(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
 }
 
 int main(void) {
@@ -56,7 +84,7 @@ int main(void) {
     };
     
     // confidence로 정렬 (NMS 전 필수)
-    sort_detections_by_conf(input_detections, num_input);
+    det_sort_by_conf(input_detections, num_input);
     
     printf("\nInput detections (sorted by confidence):\n");
     for (int i = 0; i < num_input; i++) {
@@ -181,6 +209,196 @@ int main(void) {
         printf("⚠ WARNING: IoU seems low for overlapping boxes: %.4f\n", iou);
     }
     
+    // 6. 클래스 버킷 NMS (scratch 기반)가 nms()와 동일한지
+    printf("\n=== Bucketed NMS ===\n");
+    if (compare_bucketed_with_nms(input_detections, num_input, 3,
+                                  TV_NMS_IOU_THRESHOLD, TV_NMS_MAX_DETECTIONS, INT32_MAX)) {
+        printf("✓ nms_bucketed matches nms() on synthetic input\n");
+    } else {
+        printf("✗ ERROR: nms_bucketed differs from nms() on synthetic input\n");
+        verification_ok = 0;
+    }
+    {
+        /* 밀집 장면: 3000 후보, 좁은 영역에 몰린 박스, max_detections 절단 포함 */
+        static detection_t dense[3000];
+        for (int i = 0; i < 3000; i++) {
+            dense[i].x = 0.3f + (float)(rng_next() % 400) / 1000.0f;
+            dense[i].y = 0.3f + (float)(rng_next() % 400) / 1000.0f;
+            dense[i].w = 0.02f + (float)(rng_next() % 150) / 1000.0f;
+            dense[i].h = 0.02f + (float)(rng_next() % 150) / 1000.0f;
+            dense[i].conf = 0.05f + (float)(rng_next() % 950) / 1000.0f;
+            dense[i].cls_id = (int32_t)(rng_next() % 80);
+        }
+        int dense_ok = compare_bucketed_with_nms(dense, 3000, 80, 0.45f, 300, INT32_MAX) &&
+                       compare_bucketed_with_nms(dense, 3000, 80, 0.45f, 50, INT32_MAX) &&
+                       compare_bucketed_with_nms(dense, 3000, 80, 0.7f, 3000, INT32_MAX) &&
+                       compare_bucketed_with_nms(dense, 3000, 80, 0.45f, 300, -1) &&
+                       compare_bucketed_with_nms(dense, 3000, 80, 0.7f, 3000, -1);
+        if (dense_ok) {
+            printf("✓ nms_bucketed matches nms() on 3000 dense candidates\n");
+        } else {
+            printf("✗ ERROR: nms_bucketed differs from nms() on dense candidates\n");
+            verification_ok = 0;
+        }
+    }
+
+    // 7. 공간 그리드 경로: 모든 버킷에 강제 적용해 nms()와 동일한지 + 10k+ 후보 벤치마크
+    printf("\n=== Grid NMS ===\n");
+    {
+        int grid_ok = compare_bucketed_with_nms(input_detections, num_input, 3,
+                                                 TV_NMS_IOU_THRESHOLD, TV_NMS_MAX_DETECTIONS, 0);
+        /* 경계 케이스: 동일 박스, 모서리만 맞닿는 박스, 폭 0 박스, 임계값 0 */
+        detection_t edge[6] = {
+            {0.5f, 0.5f, 0.2f, 0.2f, 0.9f, 0}, {0.5f, 0.5f, 0.2f, 0.2f, 0.8f, 0},
+            {0.7f, 0.5f, 0.2f, 0.2f, 0.7f, 0}, {0.5f, 0.5f, 0.0f, 0.2f, 0.6f, 0},
+            {0.3f, 0.3f, 0.2f, 0.2f, 0.5f, 0}, {0.39f, 0.39f, 0.02f, 0.02f, 0.4f, 0},
+        };
+        grid_ok = grid_ok &&
+                   compare_bucketed_with_nms(edge, 6, 1, 0.45f, 100, 0) &&
+                   compare_bucketed_with_nms(edge, 6, 1, 0.0f, 100, 0) &&
+                   compare_bucketed_with_nms(edge, 6, 1, -0.1f, 100, 0);
+        if (grid_ok) {
+            printf("✓ grid matches nms() on synthetic/edge inputs\n");
+        } else {
+            printf("✗ ERROR: grid differs from nms() on synthetic/edge inputs\n");
+            verification_ok = 0;
+        }
+
+        /* 밀집 장면 (저 conf 임계값): 화면 전체에 작은 박스, 소수 클래스에 몰림 */
+        const int32_t sizes[2] = {12000, 30000};
+        printf("%8s %12s %12s %12s %9s\n", "N", "nms(ms)", "bucket(ms)", "grid(ms)", "speedup");
+        for (int s = 0; s < 2; s++) {
+            const int32_t num = sizes[s];
+            detection_t* src = (detection_t*)malloc((size_t)num * sizeof(detection_t));
+            detection_t* work = (detection_t*)malloc((size_t)num * sizeof(detection_t));
+            detection_t* out = (detection_t*)malloc((size_t)num * sizeof(detection_t));
+            const size_t ws_bytes = nms_workspace_size(num, 80);
+            uint8_t* scratch = (uint8_t*)malloc(ws_bytes);
+            if (!src || !work || !out || !scratch) {
+                free(src); free(work); free(out); free(scratch);
+                verification_ok = 0;
+                break;
+            }
+            for (int32_t i = 0; i < num; i++) {
+                src[i].x = (float)(rng_next() % 1000) / 1000.0f;
+                src[i].y = (float)(rng_next() % 1000) / 1000.0f;
+                src[i].w = 0.01f + (float)(rng_next() % 80) / 1000.0f;
+                src[i].h = 0.01f + (float)(rng_next() % 80) / 1000.0f;
+                src[i].conf = 0.001f + (float)(rng_next() % 999) / 1000.0f;
+                src[i].cls_id = (rng_next() % 4 == 0) ? (int32_t)(rng_next() % 80) : 0;
+            }
+            det_sort_by_conf(src, num);  /* 정렬 비용은 세 경로 공통이므로 제외 */
+
+            if (!compare_bucketed_with_nms(src, num, 80, 0.45f, num, 0) ||
+                !compare_bucketed_with_nms(src, num, 80, 0.45f, 300, NMS_GRID_MIN_CANDIDATES)) {
+                printf("✗ ERROR: grid differs from nms() at N=%d\n", (int)num);
+                verification_ok = 0;
+            }
+
+            memcpy(work, src, (size_t)num * sizeof(detection_t));
+            detection_t* ref_out = NULL;
+            int32_t cnt = 0;
+            uint64_t t0 = timer_read64();
+            nms(work, num, &ref_out, &cnt, 0.45f, num);
+            const uint64_t t_ref = timer_delta64(t0, timer_read64());
+            free(ref_out);
+
+            nms_workspace_t ws;
+            nms_workspace_init(&ws, scratch, ws_bytes, num, 80);
+            ws.grid_min_candidates = INT32_MAX;
+            t0 = timer_read64();
+            nms_bucketed(work, num, &ws, 0.45f, num, out, &cnt);
+            const uint64_t t_bucket = timer_delta64(t0, timer_read64());
+
+            ws.grid_min_candidates = NMS_GRID_MIN_CANDIDATES;
+            t0 = timer_read64();
+            nms_bucketed(work, num, &ws, 0.45f, num, out, &cnt);
+            const uint64_t t_grid = timer_delta64(t0, timer_read64());
+
+            printf("%8d %12.3f %12.3f %12.3f %8.1fx\n", (int)num,
+                   (double)t_ref / 1000.0, (double)t_bucket / 1000.0, (double)t_grid / 1000.0,
+                   t_grid > 0 ? (double)t_bucket / (double)t_grid : 0.0);
+            free(src); free(work); free(out); free(scratch);
+        }
+    }
+
+    // 8. 비트마스크 IoU 행렬 NMS: 단일/배치 모두 nms()와 동일한지 + 배치 처리량
+    printf("\n=== Bitmask NMS ===\n");
+    {
+        detection_t edge[6] = {
+            {0.5f, 0.5f, 0.2f, 0.2f, 0.9f, 0}, {0.5f, 0.5f, 0.2f, 0.2f, 0.8f, 0},
+            {0.7f, 0.5f, 0.2f, 0.2f, 0.7f, 0}, {0.5f, 0.5f, 0.0f, 0.2f, 0.6f, 0},
+            {0.3f, 0.3f, 0.2f, 0.2f, 0.5f, 0}, {0.39f, 0.39f, 0.02f, 0.02f, 0.4f, 0},
+        };
+        int bm_ok = compare_bucketed_with_nms(input_detections, num_input, 3,
+                                              TV_NMS_IOU_THRESHOLD, TV_NMS_MAX_DETECTIONS, -1) &&
+                    compare_bucketed_with_nms(edge, 6, 1, 0.45f, 100, -1) &&
+                    compare_bucketed_with_nms(edge, 6, 1, 0.0f, 100, -1) &&
+                    compare_bucketed_with_nms(edge, 6, 1, -0.1f, 100, -1);
+
+        /* 배치: 이미지마다 후보 수/클래스 분포가 다른 8장 (64 경계 전후 크기 포함) */
+        enum { NB = 8, NB_MAX = 3000 };
+        const int32_t nb_sizes[NB] = {0, 1, 63, 64, 65, 500, 1200, 3000};
+        static detection_t batch_src[NB][NB_MAX], batch_in[NB][NB_MAX], batch_out[NB][NB_MAX];
+        nms_batch_item_t items[NB];
+        for (int b = 0; b < NB; b++) {
+            const int32_t ncls = (b & 1) ? 80 : 2;
+            for (int32_t i = 0; i < nb_sizes[b]; i++) {
+                detection_t* d = &batch_src[b][i];
+                d->x = 0.2f + (float)(rng_next() % 600) / 1000.0f;
+                d->y = 0.2f + (float)(rng_next() % 600) / 1000.0f;
+                d->w = 0.02f + (float)(rng_next() % 200) / 1000.0f;
+                d->h = 0.02f + (float)(rng_next() % 200) / 1000.0f;
+                d->conf = 0.01f + (float)(rng_next() % 990) / 1000.0f;
+                d->cls_id = (int32_t)(rng_next() % (uint32_t)ncls);
+            }
+            memcpy(batch_in[b], batch_src[b], (size_t)nb_sizes[b] * sizeof(detection_t));
+            items[b].detections = batch_in[b];
+            items[b].num_detections = nb_sizes[b];
+            items[b].output = batch_out[b];
+            items[b].output_count = -1;
+        }
+        static uint8_t batch_scratch[NMS_WORKSPACE_BYTES(NB_MAX, 80)];
+        nms_workspace_t ws;
+        if (nms_workspace_init(&ws, batch_scratch, sizeof(batch_scratch), NB_MAX, 80) != 0 ||
+            nms_bitmask_batch(items, NB, &ws, 0.45f, 300) != 0) {
+            bm_ok = 0;
+        }
+        for (int b = 0; b < NB && bm_ok; b++) {
+            detection_t* ref_out = NULL;
+            int32_t ref_cnt = 0;
+            memcpy(batch_in[b], batch_src[b], (size_t)nb_sizes[b] * sizeof(detection_t));
+            nms(batch_in[b], nb_sizes[b], &ref_out, &ref_cnt, 0.45f, 300);
+            if (ref_cnt != items[b].output_count ||
+                (ref_cnt > 0 && memcmp(ref_out, batch_out[b], (size_t)ref_cnt * sizeof(detection_t)) != 0)) {
+                printf("✗ ERROR: batch image %d differs from nms()\n", b);
+                bm_ok = 0;
+            }
+            free(ref_out);
+        }
+        if (bm_ok) {
+            printf("✓ nms_bitmask / nms_bitmask_batch match nms()\n");
+        } else {
+            printf("✗ ERROR: bitmask NMS differs from nms()\n");
+            verification_ok = 0;
+        }
+
+        /* 처리량: 같은 8장을 반복, 이미지별 nms_bucketed 호출 vs 배치 1회 (입력은 이미 정렬됨) */
+        const int reps = 20;
+        int32_t cnt = 0;
+        ws.grid_min_candidates = NMS_GRID_MIN_CANDIDATES;
+        uint64_t t0 = timer_read64();
+        for (int r = 0; r < reps; r++)
+            for (int b = 0; b < NB; b++)
+                nms_bucketed(batch_in[b], nb_sizes[b], &ws, 0.45f, 300, batch_out[b], &cnt);
+        const uint64_t t_bucket = timer_delta64(t0, timer_read64());
+        t0 = timer_read64();
+        for (int r = 0; r < reps; r++) nms_bitmask_batch(items, NB, &ws, 0.45f, 300);
+        const uint64_t t_batch = timer_delta64(t0, timer_read64());
+        printf("%d images x %d reps: bucketed %.3f ms/batch, bitmask batch %.3f ms/batch\n",
+               NB, reps, (double)t_bucket / 1000.0 / reps, (double)t_batch / 1000.0 / reps);
+    }
+
     // 정리
     if (output_detections) {
         free(output_detections);
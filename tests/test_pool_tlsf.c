@@ -0,0 +1,203 @@
+/* TLSF 풀 할당자 테스트 + first-fit 대비 단편화/지연 벤치마크 (혼합 크기 랜덤 alloc/free). */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/utils/pool_tlsf.h"
+#include "../csrc/utils/pool_first_fit.h"
+#include "../csrc/utils/mem_plan.h"
+#include "../csrc/utils/mcycle.h"
+
+#define REGION_BYTES (22u * 1024u * 1024u)
+#define SLOTS 256
+
+static uint32_t rng_state = 7u;
+static uint32_t rng_next(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+/* 피처맵/임시 버퍼 느낌의 크기 분포: 대부분 수 KB, 가끔 수백 KB ~ 1.6MB */
+static size_t random_size(void) {
+    const uint32_t r = rng_next() % 100;
+    if (r < 70) return 16 + rng_next() % 4096;
+    if (r < 95) return 4096 + rng_next() % (128u * 1024u);
+    return 128u * 1024u + rng_next() % (1500u * 1024u);
+}
+
+typedef struct {
+    void* ptr;
+    size_t size;
+    uint8_t tag;
+} slot_t;
+
+/* 각 블록 앞뒤 바이트에 tag를 써 두고 free 직전에 확인 (겹침/헤더 침범 검출) */
+static int check_slot(const slot_t* s) {
+    const uint8_t* b = (const uint8_t*)s->ptr;
+    return b[0] == s->tag && b[s->size - 1] == s->tag && b[s->size / 2] == s->tag;
+}
+
+static void fill_slot(slot_t* s) {
+    uint8_t* b = (uint8_t*)s->ptr;
+    b[0] = s->tag;
+    b[s->size / 2] = s->tag;
+    b[s->size - 1] = s->tag;
+}
+
+typedef struct {
+    double avg_alloc_ns, avg_free_ns;
+    uint64_t max_alloc_us, max_free_us;
+    int failed;
+    int corrupt;
+    size_t free_blocks, total_free, largest_free;
+} bench_result_t;
+
+/* use_tlsf: 1=TLSF, 0=first-fit. 같은 시드 → 같은 요청 열 */
+static void run_workload(int use_tlsf, void* region, int ops, bench_result_t* r) {
+    static pool_tlsf_t tlsf;
+    static pool_ff_t ff;
+    static slot_t slots[SLOTS];
+    memset(slots, 0, sizeof(slots));
+    memset(r, 0, sizeof(*r));
+    if (use_tlsf) pool_tlsf_init(&tlsf, region, REGION_BYTES);
+    else pool_ff_init(&ff, region, REGION_BYTES);
+    rng_state = 7u;
+
+    uint64_t t_alloc = 0, t_free = 0;
+    int n_alloc = 0, n_free = 0;
+    for (int i = 0; i < ops; i++) {
+        slot_t* s = &slots[rng_next() % SLOTS];
+        if (s->ptr) {
+            if (!check_slot(s)) r->corrupt++;
+            const uint64_t t0 = timer_read64();
+            if (use_tlsf) pool_tlsf_free(&tlsf, s->ptr); else pool_ff_free(&ff, s->ptr);
+            const uint64_t dt = timer_delta64(t0, timer_read64());
+            t_free += dt; n_free++;
+            if (dt > r->max_free_us) r->max_free_us = dt;
+            s->ptr = NULL;
+        } else {
+            s->size = random_size();
+            s->tag = (uint8_t)(1 + rng_next() % 250);
+            const uint64_t t0 = timer_read64();
+            s->ptr = use_tlsf ? pool_tlsf_alloc(&tlsf, s->size) : pool_ff_alloc(&ff, s->size);
+            const uint64_t dt = timer_delta64(t0, timer_read64());
+            t_alloc += dt; n_alloc++;
+            if (dt > r->max_alloc_us) r->max_alloc_us = dt;
+            if (s->ptr && ((uintptr_t)s->ptr & 63u)) r->corrupt++;  /* 64B 정렬 위반도 오류로 */
+            if (s->ptr) fill_slot(s); else r->failed++;
+        }
+    }
+    if (use_tlsf) {
+        pool_tlsf_free_stats(&tlsf, &r->free_blocks, &r->total_free);
+        r->largest_free = pool_tlsf_largest_free(&tlsf);
+    } else {
+        pool_ff_free_stats(&ff, &r->free_blocks, &r->total_free);
+        r->largest_free = pool_ff_largest_free(&ff);
+    }
+    for (int i = 0; i < SLOTS; i++) {
+        if (slots[i].ptr && !check_slot(&slots[i])) r->corrupt++;
+    }
+    r->avg_alloc_ns = n_alloc ? (double)t_alloc * 1000.0 / n_alloc : 0.0;
+    r->avg_free_ns = n_free ? (double)t_free * 1000.0 / n_free : 0.0;
+}
+
+int main(void) {
+    printf("=== TLSF Pool Test ===\n\n");
+    int ok = 1;
+    void* region = malloc(REGION_BYTES);
+    if (!region) return 1;
+
+    /* 1. 기본 동작: 64B 정렬, 병합 후 원상 복구, 너무 큰 요청, 이중 free */
+    {
+        pool_tlsf_t p;
+        pool_tlsf_init(&p, region, REGION_BYTES);
+        const size_t initial = pool_tlsf_largest_free(&p);
+        void* a = pool_tlsf_alloc(&p, 1);
+        void* b = pool_tlsf_alloc(&p, 1000);
+        void* c = pool_tlsf_alloc(&p, 3u * 1024u * 1024u);
+        if (!a || !b || !c || ((uintptr_t)a & 63u) || ((uintptr_t)b & 63u) || ((uintptr_t)c & 63u)) {
+            printf("ERROR: basic alloc/alignment\n");
+            ok = 0;
+        }
+        if (pool_tlsf_alloc(&p, REGION_BYTES) != NULL) { printf("ERROR: oversize alloc succeeded\n"); ok = 0; }
+        pool_tlsf_free(&p, b);
+        pool_tlsf_free(&p, b);  /* 무시되어야 함 */
+        pool_tlsf_free(&p, a);
+        pool_tlsf_free(&p, c);
+        size_t nfree = 0, total = 0;
+        pool_tlsf_free_stats(&p, &nfree, &total);
+        if (nfree != 1 || pool_tlsf_largest_free(&p) != initial || total != initial) {
+            printf("ERROR: coalescing (free blocks=%u)\n", (unsigned)nfree);
+            ok = 0;
+        }
+        /* 영역 전부를 한 블록으로 받을 수 있어야 함 (2단 올림으로 못 찾는 경우는 바로 아래 구간) */
+        void* big = pool_tlsf_alloc(&p, initial / 2);
+        if (!big) { printf("ERROR: large alloc\n"); ok = 0; }
+        pool_tlsf_free(&p, big);
+    }
+
+    /* 2. 랜덤 워크로드: 데이터 무결성 + first-fit 대비 단편화/지연 */
+    {
+        const int ops = 200000;
+        bench_result_t rt, rf;
+        run_workload(1, region, ops, &rt);
+        run_workload(0, region, ops, &rf);
+        printf("%d random ops, %d slots, sizes 16B..1.6MB, %u MB region\n", ops, SLOTS,
+               (unsigned)(REGION_BYTES >> 20));
+        printf("%10s %10s %10s %9s %9s %7s %10s %10s %8s\n", "allocator", "alloc(ns)", "free(ns)",
+               "max_a(us)", "max_f(us)", "failed", "free_blks", "largest", "frag");
+        const bench_result_t* rs[2] = {&rt, &rf};
+        const char* names[2] = {"tlsf", "first-fit"};
+        for (int i = 0; i < 2; i++) {
+            const bench_result_t* r = rs[i];
+            const double frag = r->total_free ? 1.0 - (double)r->largest_free / (double)r->total_free : 0.0;
+            printf("%10s %10.1f %10.1f %9llu %9llu %7d %10u %9uK %8.3f\n", names[i], r->avg_alloc_ns,
+                   r->avg_free_ns, (unsigned long long)r->max_alloc_us, (unsigned long long)r->max_free_us,
+                   r->failed, (unsigned)r->free_blocks, (unsigned)(r->largest_free / 1024u), frag);
+        }
+        if (rt.corrupt || rf.corrupt) { printf("ERROR: block contents corrupted / misaligned\n"); ok = 0; }
+    }
+
+    /* 3. YOLOv5n 실제 alloc/free 순서(main.c와 동일): 두 할당자의 high-water vs 계획 peak */
+    {
+        static mem_plan_t plan;
+        static pool_tlsf_t tlsf;
+        static pool_ff_t ff;
+        void* ptrs[MEM_PLAN_MAX_TENSORS];
+        mem_plan_build_yolov5n(&plan, 1, 1);
+        size_t high[2] = {0, 0};
+        for (int use_tlsf = 1; use_tlsf >= 0; use_tlsf--) {
+            if (use_tlsf) pool_tlsf_init(&tlsf, region, REGION_BYTES);
+            else pool_ff_init(&ff, region, REGION_BYTES);
+            int fail = 0;
+            for (int32_t e = 0; e < plan.num_events; e++) {
+                const int32_t ev = plan.events[e];
+                if (ev >= 0) {
+                    ptrs[ev] = use_tlsf ? pool_tlsf_alloc(&tlsf, plan.tensors[ev].size)
+                                        : pool_ff_alloc(&ff, plan.tensors[ev].size);
+                    if (!ptrs[ev]) fail = 1;
+                } else if (use_tlsf) {
+                    pool_tlsf_free(&tlsf, ptrs[~ev]);
+                } else {
+                    pool_ff_free(&ff, ptrs[~ev]);
+                }
+            }
+            high[use_tlsf] = use_tlsf ? tlsf.high_water : ff.high_water;
+            if (fail) { printf("ERROR: yolov5n sequence failed (%s)\n", use_tlsf ? "tlsf" : "first-fit"); ok = 0; }
+        }
+        size_t nfree = 0;
+        pool_tlsf_free_stats(&tlsf, &nfree, NULL);
+        if (nfree != 1) { printf("ERROR: yolov5n sequence left %u free blocks\n", (unsigned)nfree); ok = 0; }
+        printf("\nYOLOv5n sequence: high-water tlsf %u KB, first-fit %u KB, planned %u KB\n",
+               (unsigned)(high[1] / 1024u), (unsigned)(high[0] / 1024u), (unsigned)(plan.peak / 1024u));
+    }
+
+    free(region);
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
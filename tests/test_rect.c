@@ -0,0 +1,150 @@
+/* 직사각형/가변 입력 테스트: 640x640 letterbox에서 회색 여백을 잘라낸 640x384(rect) 결과가 정사각형과 같은 검출,
+ * 320x320 입력 동작, 32의 배수가 아닌 입력 거부, 입력 면적별 지연. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../csrc/blocks/yolov5n.h"
+#include "../csrc/utils/image_loader.h"
+
+#ifdef USE_WEIGHTS_W8
+#define WEIGHTS_PATH "assets/weights_w8.bin"
+#else
+#define WEIGHTS_PATH "assets/weights.bin"
+#endif
+
+#define BOX_TOL_PX 3.0f
+#define CONF_TOL   0.08f  /* 여백(패딩) 문맥이 달라 conf는 조금 다름 */
+
+static detection_t sq_dets[YOLO_MAX_DETECTIONS], rect_dets[YOLO_MAX_DETECTIONS], small_dets[YOLO_MAX_DETECTIONS];
+
+/* src의 행 [y0, y0+h) 만 남긴 이미지 (rect letterbox = 정사각형 letterbox의 가운데 띠) */
+static int crop_rows(const preprocessed_image_t* src, int32_t y0, int32_t h, preprocessed_image_t* dst) {
+    *dst = *src;
+    dst->h = h;
+    dst->pad_y = src->pad_y - y0;
+    dst->data = (float*)malloc((size_t)3 * h * src->w * sizeof(float));
+    if (!dst->data) return -1;
+    dst->data_owned = 1;
+    for (int32_t c = 0; c < 3; c++)
+        memcpy(dst->data + (size_t)c * h * src->w, src->data + ((size_t)c * src->h + y0) * src->w,
+               (size_t)h * src->w * sizeof(float));
+    return 0;
+}
+
+/* 2x2 평균 다운샘플 (320x320 저지연 입력 흉내) */
+static int half_size(const preprocessed_image_t* src, preprocessed_image_t* dst) {
+    *dst = *src;
+    dst->h = src->h / 2;
+    dst->w = src->w / 2;
+    dst->data = (float*)malloc((size_t)3 * dst->h * dst->w * sizeof(float));
+    if (!dst->data) return -1;
+    dst->data_owned = 1;
+    for (int32_t c = 0; c < 3; c++) {
+        for (int32_t y = 0; y < dst->h; y++) {
+            const float* r0 = src->data + ((size_t)c * src->h + 2 * y) * src->w;
+            const float* r1 = r0 + src->w;
+            float* d = dst->data + ((size_t)c * dst->h + y) * dst->w;
+            for (int32_t x = 0; x < dst->w; x++)
+                d[x] = 0.25f * (r0[2 * x] + r0[2 * x + 1] + r1[2 * x] + r1[2 * x + 1]);
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    printf("=== Rectangular Input Test ===\n\n");
+    int ok = 1;
+    preprocessed_image_t sq, rect, small;
+    static yolo_ctx_t ctx;
+    int32_t n_sq = 0, n_rect = 0, n_small = 0;
+
+    if (image_load_from_bin("data/input/preprocessed_image.bin", &sq) != 0) {
+        fprintf(stderr, "Failed to load image\n");
+        return 1;
+    }
+    /* 1280x720 → 640x360 내용 (pad_y 140). 최소 letterbox는 384행: 가운데 행 [128, 512) */
+    const int32_t rect_h = 384, y0 = (sq.h - rect_h) / 2;
+    if (crop_rows(&sq, y0, rect_h, &rect) != 0 || half_size(&sq, &small) != 0) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    if (yolo_ctx_init_from_file(&ctx, WEIGHTS_PATH) != 0) {
+        fprintf(stderr, "Failed to init context (%s)\n", WEIGHTS_PATH);
+        return 1;
+    }
+    ctx.verbose = 0;
+
+    /* 1. 정사각형 640x640 → 640x384 rect: 같은 물체, 좌표는 원본 픽셀 기준으로 일치 */
+    if (yolo_infer(&ctx, &sq, sq_dets, YOLO_MAX_DETECTIONS, &n_sq) != 0 || n_sq <= 0) {
+        printf("ERROR: square inference\n");
+        ok = 0;
+    }
+    const uint64_t t_sq = ctx.profile.total;
+    if (yolo_ctx_set_input(&ctx, 1, rect.h, rect.w) != 0 ||
+        yolo_infer(&ctx, &rect, rect_dets, YOLO_MAX_DETECTIONS, &n_rect) != 0) {
+        printf("ERROR: rect inference\n");
+        ok = 0;
+    }
+    const uint64_t t_rect = ctx.profile.total;
+    const size_t peak_rect = ctx.plan.peak;
+    if (ctx.in_h != rect_h || ctx.in_w != 640 || !ctx.plan_active) { printf("ERROR: rect plan\n"); ok = 0; }
+    if (n_rect != n_sq) {
+        printf("ERROR: detection count square %d vs rect %d\n", (int)n_sq, (int)n_rect);
+        ok = 0;
+    }
+    for (int32_t i = 0; i < n_sq && i < n_rect; i++) {
+        const detection_t* a = &sq_dets[i];
+        const detection_t* b = &rect_dets[i];
+        const float dx = a->x * sq.w - b->x * rect.w;
+        const float dy = (a->y * sq.h - (float)y0) - b->y * rect.h;
+        const float dw = a->w * sq.w - b->w * rect.w;
+        const float dh = a->h * sq.h - b->h * rect.h;
+        if (a->cls_id != b->cls_id || fabsf(a->conf - b->conf) > CONF_TOL || fabsf(dx) > BOX_TOL_PX ||
+            fabsf(dy) > BOX_TOL_PX || fabsf(dw) > BOX_TOL_PX || fabsf(dh) > BOX_TOL_PX) {
+            printf("ERROR: det %d cls %d/%d conf %.3f/%.3f box diff (%.1f, %.1f, %.1f, %.1f) px\n", (int)i,
+                   (int)a->cls_id, (int)b->cls_id, a->conf, b->conf, dx, dy, dw, dh);
+            ok = 0;
+        }
+    }
+    printf("640x640: %d dets, %.2f ms | 640x384: %d dets, %.2f ms (%.0f%%), planned peak %u KB\n",
+           (int)n_sq, t_sq / 1000.0, (int)n_rect, t_rect / 1000.0,
+           t_sq ? 100.0 * (double)t_rect / (double)t_sq : 0.0, (unsigned)(peak_rect / 1024u));
+
+    /* 2. 320x320 (크기 바뀌면 계획 자동 재구성) */
+    if (yolo_infer(&ctx, &small, small_dets, YOLO_MAX_DETECTIONS, &n_small) != 0 || n_small <= 0 ||
+        ctx.in_h != 320 || ctx.in_w != 320) {
+        printf("ERROR: 320x320 inference (%d dets)\n", (int)n_small);
+        ok = 0;
+    }
+    printf("320x320: %d dets, %.2f ms, planned peak %u KB\n", (int)n_small, ctx.profile.total / 1000.0,
+           (unsigned)(ctx.plan.peak / 1024u));
+
+    /* 3. 32의 배수가 아닌 입력 / 배치 안 크기 불일치 → -1 */
+    {
+        preprocessed_image_t bad = rect;
+        int32_t cnt = 0, cnts[2];
+        bad.h = 380;
+        const preprocessed_image_t* mixed[2] = {&sq, &rect};
+        if (yolo_infer(&ctx, &bad, small_dets, YOLO_MAX_DETECTIONS, &cnt) != -1 ||
+            yolo_infer_batch(&ctx, mixed, 2, sq_dets, 1, cnts) != -1 ||
+            yolo_ctx_set_input(&ctx, 1, 640, 630) != -1) {
+            printf("ERROR: bad shape accepted\n");
+            ok = 0;
+        }
+    }
+
+    yolo_ctx_destroy(&ctx);
+    image_free(&small);
+    image_free(&rect);
+    image_free(&sq);
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
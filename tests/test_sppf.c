@@ -52,8 +52,8 @@ int main(void) {
     // SPPF 블록 실행 (Fused)
     sppf_nchw_f32(
         tv_sppf_x, n, c_in, h, w,
-        cv1_w, 128, cv1_b,  // cv1: 256->128
-        cv2_w, 256, cv2_b,  // cv2: 512->256
+        cv1_w, 0.0f, 0, 128, cv1_b,  // cv1: 256->128
+        cv2_w, 0.0f, 0, 256, cv2_b,  // cv2: 512->256
         5,                   // pool_k=5
         y_out);
 
@@ -0,0 +1,155 @@
+/* SPPF 풀링 테스트: 분리형 한 번 풀링 = maxpool2d 3단 cascade (비트 동일, FP32/Q, k 3·5·7, 1x1~직사각형, 배치 간격),
+ * SPPF 블록 = 예전 경로 (cv1 → 풀링 3회 → concat4 → cv2, 배치 2), L9 크기 cascade/분리형 시간 출력.
+ * 플래그 없이 빌드. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/operations/maxpool2d.h"
+#include "../csrc/operations/conv2d.h"
+#include "../csrc/operations/silu.h"
+#include "../csrc/operations/concat.h"
+#include "../csrc/blocks/sppf.h"
+#include "../csrc/utils/feature_pool.h"
+#include "../csrc/utils/mcycle.h"
+
+#define MAX_PLANE (3 * 64 * 40 * 40)
+#define BENCH_ITER 20
+
+static float xf[MAX_PLANE], c1[MAX_PLANE], c2[MAX_PLANE], c3[MAX_PLANE], cat[4 * MAX_PLANE];
+static int32_t xq[MAX_PLANE], q1[MAX_PLANE], q2[MAX_PLANE], q3[MAX_PLANE], catq[4 * MAX_PLANE];
+static float row_tmp[2 * 64];
+
+static int check(int cond, const char* what) {
+    if (!cond) printf("ERROR: %s\n", what);
+    return cond;
+}
+
+/* 값이 겹치도록 작은 정수 범위 (동률 max 포함), 음수 포함 */
+static void fill(int32_t count, uint32_t seed) {
+    for (int32_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        xq[i] = (int32_t)(seed >> 16) % 41 - 30;
+        xf[i] = (float)xq[i] * 0.37f;
+    }
+}
+
+/* x → 구간 4개짜리 버퍼 (이미지마다 [x | y1 | y2 | y3]) */
+static int pool_case(int32_t n, int32_t c, int32_t h, int32_t w, int32_t k) {
+    const int32_t plane = c * h * w;
+    fill(n * plane, (uint32_t)(h * 131 + w * 7 + k));
+    maxpool2d_nchw_f32(xf, n, c, h, w, k, 1, k / 2, c1, h, w);
+    maxpool2d_nchw_f32(c1, n, c, h, w, k, 1, k / 2, c2, h, w);
+    maxpool2d_nchw_f32(c2, n, c, h, w, k, 1, k / 2, c3, h, w);
+    maxpool2d_nchw_q(xq, n, c, h, w, k, 1, k / 2, q1, h, w);
+    maxpool2d_nchw_q(q1, n, c, h, w, k, 1, k / 2, q2, h, w);
+    maxpool2d_nchw_q(q2, n, c, h, w, k, 1, k / 2, q3, h, w);
+
+    memset(cat, 0, sizeof(float) * 4 * (size_t)n * plane);
+    memset(catq, 0, sizeof(int32_t) * 4 * (size_t)n * plane);
+    for (int32_t ni = 0; ni < n; ni++) {
+        memcpy(cat + ni * 4 * plane, xf + ni * plane, sizeof(float) * (size_t)plane);
+        memcpy(catq + ni * 4 * plane, xq + ni * plane, sizeof(int32_t) * (size_t)plane);
+    }
+    maxpool2d_sppf_nchw_f32(cat, n, c, h, w, k, 4 * plane, cat + plane, cat + 2 * plane, cat + 3 * plane, row_tmp);
+    maxpool2d_sppf_nchw_q(catq, n, c, h, w, k, 4 * plane, catq + plane, catq + 2 * plane, catq + 3 * plane,
+                          (int32_t*)row_tmp);
+
+    int same = 1;
+    for (int32_t ni = 0; ni < n && same; ni++) {
+        const float* s = cat + ni * 4 * plane;
+        const int32_t* sq = catq + ni * 4 * plane;
+        const size_t b = sizeof(float) * (size_t)plane;
+        same = memcmp(s, xf + ni * plane, b) == 0 && memcmp(s + plane, c1 + ni * plane, b) == 0 &&
+               memcmp(s + 2 * plane, c2 + ni * plane, b) == 0 && memcmp(s + 3 * plane, c3 + ni * plane, b) == 0 &&
+               memcmp(sq + plane, q1 + ni * plane, b) == 0 && memcmp(sq + 2 * plane, q2 + ni * plane, b) == 0 &&
+               memcmp(sq + 3 * plane, q3 + ni * plane, b) == 0;
+    }
+    if (!same) printf("  mismatch n=%d c=%d %dx%d k=%d\n", (int)n, (int)c, (int)h, (int)w, (int)k);
+    return same;
+}
+
+static void rand_f(float* p, int32_t count, float scale) {
+    for (int32_t i = 0; i < count; i++) p[i] = ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) * scale;
+}
+
+int main(void) {
+    printf("=== SPPF Pooling Test ===\n\n");
+    int ok = 1;
+
+    /* 1. 분리형 = cascade (FP32/Q 비트 동일) */
+    {
+        static const int32_t shapes[][2] = {{1, 1}, {2, 3}, {5, 7}, {13, 13}, {20, 20}, {12, 20}, {40, 40}, {3, 40}};
+        static const int32_t ks[] = {3, 5, 7};
+        int32_t cases = 0;
+        for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++)
+            for (size_t ki = 0; ki < sizeof(ks) / sizeof(ks[0]); ki++) {
+                ok &= check(pool_case(2, 3, shapes[s][0], shapes[s][1], ks[ki]), "separable == cascade");
+                cases++;
+            }
+        printf("separable pool == 3x cascade (FP32, Q): %d cases\n", (int)cases);
+    }
+
+    /* 2. SPPF 블록 = 예전 경로 (cv1 → cascade → concat4 → cv2), 배치 2 */
+    {
+        const int32_t n = 2, ci = 32, c_ = 16, co = 32, h = 20, w = 20, hw = h * w;
+        static float x[2 * 32 * 400], wt1[16 * 32], wt2[32 * 64], b1[16], b2[32];
+        static float x1[2 * 16 * 400], y1[2 * 16 * 400], y2[2 * 16 * 400], y3[2 * 16 * 400];
+        static float ref_cat[2 * 64 * 400], ref[2 * 32 * 400], out[2 * 32 * 400];
+        srand(11);
+        rand_f(x, n * ci * hw, 2.0f);
+        rand_f(wt1, c_ * ci, 0.3f);
+        rand_f(wt2, co * 4 * c_, 0.2f);
+        rand_f(b1, c_, 0.1f);
+        rand_f(b2, co, 0.1f);
+        conv2d_nchw_f32(x, n, ci, h, w, wt1, c_, 1, 1, b1, 1, 1, 0, 0, 1, x1, h, w);
+        silu_nchw_f32(x1, n, c_, h, w, x1);
+        maxpool2d_nchw_f32(x1, n, c_, h, w, 5, 1, 2, y1, h, w);
+        maxpool2d_nchw_f32(y1, n, c_, h, w, 5, 1, 2, y2, h, w);
+        maxpool2d_nchw_f32(y2, n, c_, h, w, 5, 1, 2, y3, h, w);
+        concat4_nchw_f32(x1, c_, y1, c_, y2, c_, y3, c_, n, h, w, ref_cat);
+        conv2d_nchw_f32(ref_cat, n, 4 * c_, h, w, wt2, co, 1, 1, b2, 1, 1, 0, 0, 1, ref, h, w);
+        silu_nchw_f32(ref, n, co, h, w, ref);
+
+        feature_pool_init();
+        memset(out, 0, sizeof(out));
+        sppf_nchw_f32(x, n, ci, h, w, wt1, 0.0f, 0, c_, b1, wt2, 0.0f, 0, co, b2, 5, out);
+        ok &= check(memcmp(out, ref, sizeof(out)) == 0, "SPPF block == cv1 + cascade + concat4 + cv2");
+        printf("SPPF block (n=2, 32->16->32 @20x20) == previous pipeline: %s\n",
+               memcmp(out, ref, sizeof(out)) == 0 ? "bit-identical" : "DIFFERS");
+    }
+
+    /* 3. 시간: L9 크기 (128ch, 640 입력 20x20 / 1280 입력 40x40) cascade 3회 vs 분리형 1회 */
+    {
+        static const int32_t sizes[] = {20, 40};
+        printf("\n pool 5x5 x3, 128ch | cascade ms | separable ms\n");
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            const int32_t c = 128, h = sizes[s], w = sizes[s], plane = c * h * w;
+            float* big = (float*)malloc(sizeof(float) * 4 * (size_t)plane);
+            if (!big) continue;
+            rand_f(big, plane, 1.0f);
+            uint64_t t0 = timer_read64();
+            for (int32_t it = 0; it < BENCH_ITER; it++) {
+                maxpool2d_nchw_f32(big, 1, c, h, w, 5, 1, 2, big + plane, h, w);
+                maxpool2d_nchw_f32(big + plane, 1, c, h, w, 5, 1, 2, big + 2 * plane, h, w);
+                maxpool2d_nchw_f32(big + 2 * plane, 1, c, h, w, 5, 1, 2, big + 3 * plane, h, w);
+            }
+            const double t_cascade = timer_delta64(t0, timer_read64()) / 1000.0 / BENCH_ITER;
+            t0 = timer_read64();
+            for (int32_t it = 0; it < BENCH_ITER; it++)
+                maxpool2d_sppf_nchw_f32(big, 1, c, h, w, 5, 4 * plane, big + plane, big + 2 * plane, big + 3 * plane,
+                                        row_tmp);
+            const double t_sep = timer_delta64(t0, timer_read64()) / 1000.0 / BENCH_ITER;
+            printf("   %2dx%-2d            | %10.3f | %12.3f\n", (int)h, (int)w, t_cascade, t_sep);
+            free(big);
+        }
+    }
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
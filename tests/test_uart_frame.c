@@ -0,0 +1,185 @@
+/* UART 이진 프레임 테스트: CRC-16 검사값, 원본/delta 프레임 왕복 (끝값·큰 delta·0개·300개),
+ * delta 크기 < 원본, 손상·잘림·버전·max_dets·cap 부족 → -1/0, 로그 텍스트 섞인 스트림 재동기,
+ * 호스트 백엔드(파일)로 쓴 프레임 = 인코딩 결과, python3 있으면 recv_detections_uart.py --file 결과 = detections.bin 형식.
+ * 플래그 없이 빌드. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/utils/uart_dump.h"
+#include "../csrc/blocks/decode.h"
+
+#define MAX_DETS 300
+
+static int check(int cond, const char* what) {
+    if (!cond) printf("ERROR: %s\n", what);
+    return cond;
+}
+
+static void make_dets(hw_detection_t* d, int32_t n, uint32_t seed) {
+    for (int32_t i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        d[i].x = (uint16_t)(seed >> 8) % 640;
+        d[i].y = (uint16_t)(seed >> 12) % 640;
+        d[i].w = (uint16_t)(10 + (seed >> 4) % 300);
+        d[i].h = (uint16_t)(10 + (seed >> 6) % 400);
+        d[i].class_id = (uint8_t)(i % 80);
+        d[i].confidence = (uint8_t)(255 - i % 200);
+        d[i].reserved[0] = 0;
+        d[i].reserved[1] = 0;
+    }
+}
+
+static int roundtrip(const hw_detection_t* d, int32_t n, uint8_t flags, uint8_t* buf, int32_t* bytes) {
+    static hw_detection_t out[MAX_DETS];
+    yolo_frame_info_t info;
+    const int32_t len = yolo_frame_encode(d, n, 77u, 123456u, flags, buf, YOLO_FRAME_MAX_BYTES(MAX_DETS));
+    if (bytes) *bytes = len;
+    if (len <= 0) return 0;
+    memset(out, 0xEE, sizeof(out));
+    if (yolo_frame_decode(buf, len, &info, out, MAX_DETS) != len) return 0;
+    return info.count == n && info.frame_id == 77u && info.time == 123456u && info.flags == flags &&
+           memcmp(out, d, (size_t)n * sizeof(hw_detection_t)) == 0;
+}
+
+int main(void) {
+    printf("=== UART Frame Test ===\n\n");
+    int ok = 1;
+    static uint8_t buf[YOLO_FRAME_MAX_BYTES(MAX_DETS)];
+    static hw_detection_t dets[MAX_DETS], out[MAX_DETS];
+    yolo_frame_info_t info;
+
+    /* 1. CRC-16/CCITT-FALSE 검사값 */
+    ok &= check(yolo_crc16((const uint8_t*)"123456789", 9) == 0x29B1, "crc16 check value");
+    ok &= check(sizeof(hw_detection_t) == 12, "hw_detection_t 12 bytes");
+
+    /* 2. 왕복: 원본/delta, 0개·1개·300개, 끝값과 큰 delta */
+    make_dets(dets, MAX_DETS, 1u);
+    dets[1].x = 65535; dets[1].y = 0; dets[1].w = 65535; dets[1].h = 0;
+    dets[2].x = 0; dets[2].y = 65535;
+    int32_t raw_bytes = 0, delta_bytes = 0;
+    ok &= check(roundtrip(dets, 0, 0, buf, &raw_bytes) && raw_bytes == YOLO_FRAME_HEAD_BYTES + YOLO_FRAME_CRC_BYTES,
+                "empty frame");
+    ok &= check(roundtrip(dets, 1, YOLO_FRAME_FLAG_DELTA, buf, NULL), "delta 1 det");
+    ok &= check(roundtrip(dets, MAX_DETS, 0, buf, &raw_bytes), "raw 300 dets");
+    ok &= check(roundtrip(dets, MAX_DETS, YOLO_FRAME_FLAG_DELTA | YOLO_FRAME_FLAG_KCYCLES, buf, &delta_bytes),
+                "delta 300 dets (+kcycles flag)");
+    ok &= check(raw_bytes == YOLO_FRAME_HEAD_BYTES + MAX_DETS * YOLO_FRAME_RAW_DET_BYTES + YOLO_FRAME_CRC_BYTES,
+                "raw size");
+
+    /* 3. 모여 있는 작은 검출 (군중): delta가 원본보다 작음. 예전 hex 덤프 = "YOLO\n" + "14\n" + 2 × 12바이트/개 + "\n" */
+    for (int32_t i = 0; i < 20; i++) {
+        dets[i].x = (uint16_t)(300 + i * 5);
+        dets[i].y = (uint16_t)(200 + (i % 4) * 9);
+        dets[i].w = (uint16_t)(20 + i);
+        dets[i].h = (uint16_t)(40 + i);
+    }
+    int32_t raw20 = 0, delta20 = 0;
+    ok &= check(roundtrip(dets, 20, 0, buf, &raw20) && roundtrip(dets, 20, YOLO_FRAME_FLAG_DELTA, buf, &delta20),
+                "20 dets roundtrip");
+    ok &= check(delta20 < raw20, "delta smaller than raw");
+    printf("20 dets: hex dump %d B, raw frame %d B, delta frame %d B\n", 5 + 3 + 20 * 24 + 1, (int)raw20, (int)delta20);
+
+    /* 4. 잘못된 프레임 */
+    int32_t len = yolo_frame_encode(dets, 20, 1u, 2u, YOLO_FRAME_FLAG_DELTA, buf, (int32_t)sizeof(buf));
+    ok &= check(yolo_frame_decode(buf, len - 1, &info, out, MAX_DETS) == 0, "truncated -> need more");
+    ok &= check(yolo_frame_decode(buf, 3, &info, out, MAX_DETS) == 0, "header only -> need more");
+    ok &= check(yolo_frame_decode(buf, len, &info, out, 19) == -1, "count > max_dets");
+    buf[20] ^= 0x10;
+    ok &= check(yolo_frame_decode(buf, len, &info, out, MAX_DETS) == -1, "corrupt byte -> crc");
+    buf[20] ^= 0x10;
+    buf[4] = YOLO_FRAME_VERSION + 1;
+    {
+        const uint16_t crc = yolo_crc16(buf + 2, len - 4);
+        buf[len - 2] = (uint8_t)crc;
+        buf[len - 1] = (uint8_t)(crc >> 8);
+    }
+    ok &= check(yolo_frame_decode(buf, len, &info, out, MAX_DETS) == -1, "unknown version");
+    buf[1] = 0x00;
+    ok &= check(yolo_frame_decode(buf, len, &info, out, MAX_DETS) == -1, "bad sync");
+    ok &= check(yolo_frame_encode(dets, 20, 0u, 0u, 0, buf, YOLO_FRAME_HEAD_BYTES + 19 * 10) == -1, "cap too small");
+    ok &= check(yolo_frame_encode(dets, YOLO_FRAME_MAX_COUNT + 1, 0u, 0u, 0, buf, (int32_t)sizeof(buf)) == -1,
+                "count > frame max");
+
+    /* 5. 로그 텍스트 + 프레임 3개 (원본/delta 섞음, A5로 시작하는 잡음 포함) → 재동기해서 전부 */
+    {
+        static uint8_t stream[3 * YOLO_FRAME_MAX_BYTES(40) + 256];
+        int32_t s = 0, found = 0;
+        const char* logs[3] = {"Sending 40 detections to UART...\n", "\xA5\x5A\x03garbage\n", "\xA5"};
+        for (int32_t f = 0; f < 3; f++) {
+            memcpy(stream + s, logs[f], strlen(logs[f]));
+            s += (int32_t)strlen(logs[f]);
+            make_dets(dets, 40, (uint32_t)f + 100u);
+            s += yolo_frame_encode(dets, 40, (uint32_t)f, 1000u * (uint32_t)f, f == 1 ? YOLO_FRAME_FLAG_DELTA : 0,
+                                   stream + s, (int32_t)sizeof(stream) - s);
+        }
+        for (int32_t p = 0; p < s;) {
+            const int32_t n = yolo_frame_decode(stream + p, s - p, &info, out, MAX_DETS);
+            if (n <= 0) {
+                p++;
+                continue;
+            }
+            make_dets(dets, 40, info.frame_id + 100u);
+            ok &= check(info.frame_id == (uint32_t)found && info.time == 1000u * info.frame_id &&
+                        memcmp(out, dets, 40 * sizeof(hw_detection_t)) == 0, "resync frame content");
+            found++;
+            p += n;
+        }
+        ok &= check(found == 3, "resync finds 3 frames");
+    }
+
+    /* 6. 호스트 백엔드: 파일에 쓴 바이트 = 인코딩 결과 (파이프·pty도 같은 경로) */
+    {
+        const char* path = "data/output/test_uart_frame.bin";
+        make_dets(dets, 5, 3u);
+        ok &= check(yolo_uart_send_frame(dets, 5, 0u, 0u, 0, buf, (int32_t)sizeof(buf)) == 0, "send before open = no-op");
+        if (yolo_uart_open(path) == 0) {
+            int32_t total = 0;
+            for (uint32_t f = 0; f < 2; f++)
+                total += yolo_uart_send_frame(dets, 5, f, 500u + f, f ? YOLO_FRAME_FLAG_DELTA : 0, buf,
+                                              (int32_t)sizeof(buf));
+            yolo_uart_close();
+            static uint8_t back[2 * YOLO_FRAME_MAX_BYTES(5)];
+            FILE* fp = fopen(path, "rb");
+            const int32_t got = fp ? (int32_t)fread(back, 1, sizeof(back), fp) : -1;
+            if (fp) fclose(fp);
+            const int32_t n0 = yolo_frame_decode(back, got, &info, out, MAX_DETS);
+            ok &= check(got == total && n0 > 0 && info.frame_id == 0 && memcmp(out, dets, 5 * sizeof(hw_detection_t)) == 0,
+                        "host backend frame 0");
+            ok &= check(n0 > 0 && yolo_frame_decode(back + n0, got - n0, &info, out, MAX_DETS) == got - n0 &&
+                        info.frame_id == 1 && info.time == 501u && (info.flags & YOLO_FRAME_FLAG_DELTA),
+                        "host backend frame 1");
+#ifndef _WIN32
+            /* Python 수신기: 마지막 프레임 → detections.bin (1 + 12×n) */
+            if (system("python3 -c 1 > /dev/null 2>&1") == 0) {
+                const char* bin = "data/output/test_uart_frame_det.bin";
+                char cmd[256];
+                snprintf(cmd, sizeof(cmd), "python3 tools/recv_detections_uart.py --file %s --frames 2 --out %s > /dev/null",
+                         path, bin);
+                const int rc = system(cmd);
+                uint8_t det_bin[1 + 5 * 12] = {0};
+                fp = fopen(bin, "rb");
+                const size_t nb = fp ? fread(det_bin, 1, sizeof(det_bin), fp) : 0;
+                if (fp) fclose(fp);
+                ok &= check(rc == 0 && nb == sizeof(det_bin) && det_bin[0] == 5 && memcmp(det_bin + 1, dets, 60) == 0,
+                            "python receiver -> detections.bin");
+                remove(bin);
+                printf("python receiver: checked\n");
+            } else {
+                printf("(python3 not found: receiver check skipped)\n");
+            }
+#endif
+            remove(path);
+        } else {
+            printf("(cannot open %s: host backend check skipped)\n", path);
+        }
+    }
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
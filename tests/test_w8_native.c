@@ -0,0 +1,140 @@
+/* W8 직접 사용 테스트: SPPF INT8 가중치 직접 = 디양자화 FP32 가중치 결과, SPPF가 FP32 사본을 만들지 않음,
+ * 디양자화 캐시 (텐서별 1회, 같은 포인터, 값 = int8 × scale), 예전 round-robin 풀 대비 메모리·SPPF 시간.
+ * -DUSE_WEIGHTS_W8로 빌드하면 W8 컨텍스트 추론 후 캐시가 비어 있는지도 확인. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../csrc/blocks/sppf.h"
+#include "../csrc/blocks/yolov5n.h"
+#include "../csrc/utils/weights_loader.h"
+#include "../csrc/utils/image_loader.h"
+#include "../csrc/utils/feature_pool.h"
+#include "../csrc/utils/mcycle.h"
+
+#define W8_PATH    "assets/weights_w8.bin"
+#define SPPF_TOL   1e-4f
+#define BENCH_ITER 3
+#define OLD_POOL_SLOTS 10  /* 예전 WEIGHTS_DEQUANT_POOL_SIZE */
+
+static float x[256 * 20 * 20], y_w8[256 * 20 * 20], y_f32[256 * 20 * 20];
+
+int main(void) {
+    printf("=== W8 Native Weights Test ===\n\n");
+    int ok = 1;
+    weights_loader_t w8;
+    weights_ref_t cv1, cv2, b1, b2;
+
+    if (weights_load_from_file_w8(W8_PATH, &w8) != 0 || weights_bind(&w8, "model.9.cv1.conv.weight", &cv1) != 0 ||
+        weights_bind(&w8, "model.9.cv2.conv.weight", &cv2) != 0 || weights_bind(&w8, "model.9.cv1.conv.bias", &b1) != 0 ||
+        weights_bind(&w8, "model.9.cv2.conv.bias", &b2) != 0 || !cv1.is_int8 || !cv2.is_int8) {
+        fprintf(stderr, "Failed to load %s (L9 INT8 weights)\n", W8_PATH);
+        return 1;
+    }
+    feature_pool_init();  /* SPPF 임시 버퍼 */
+    srand(7);
+    for (size_t i = 0; i < sizeof(x) / sizeof(x[0]); i++) x[i] = (float)rand() / (float)RAND_MAX * 4.0f - 2.0f;
+
+    /* 1. SPPF INT8 직접: FP32 사본 없음 (캐시 0), 결과 = 디양자화 FP32 가중치 SPPF */
+    sppf_nchw_f32(x, 1, 256, 20, 20, cv1.data, cv1.scale, 1, 128, (const float*)b1.data,
+                  cv2.data, cv2.scale, 1, 256, (const float*)b2.data, 5, y_w8);
+    if (w8.dequant_bytes != 0) { printf("ERROR: SPPF W8 created FP32 copies\n"); ok = 0; }
+    const float* cv1_f = weights_ref_data(&w8, &cv1);
+    const float* cv2_f = weights_ref_data(&w8, &cv2);
+    if (!cv1_f || !cv2_f) {
+        printf("ERROR: dequant cache alloc\n");
+        return 1;
+    }
+    sppf_nchw_f32(x, 1, 256, 20, 20, cv1_f, 0.0f, 0, 128, (const float*)b1.data,
+                  cv2_f, 0.0f, 0, 256, (const float*)b2.data, 5, y_f32);
+    {
+        float max_diff = 0.0f;
+        for (size_t i = 0; i < sizeof(y_w8) / sizeof(y_w8[0]); i++) {
+            const float d = fabsf(y_w8[i] - y_f32[i]);
+            if (d > max_diff) max_diff = d;
+        }
+        float amax = 0.0f;
+        for (size_t i = 0; i < sizeof(y_w8) / sizeof(y_w8[0]); i++) amax = fmaxf(amax, fabsf(y_w8[i]));
+        printf("SPPF W8 vs dequantized FP32: max diff %g (max |y| %g)\n", max_diff, amax);
+        if (!(max_diff < SPPF_TOL) || amax == 0.0f) { printf("ERROR: SPPF W8 differs\n"); ok = 0; }
+    }
+
+    /* 2. 캐시: 텐서별 1회 (같은 포인터), 값 = int8 × scale, FP32 텐서는 캐시 없음 */
+    {
+        const size_t bytes = (cv1.num_elements + cv2.num_elements) * sizeof(float);
+        const float* again = weights_get_tensor_data(&w8, "model.9.cv1.conv.weight");
+        const int8_t* q = (const int8_t*)cv1.data;
+        int bad = again != cv1_f || w8.dequant_bytes != bytes ||
+                  weights_get_tensor_data(&w8, "model.9.cv1.conv.bias") != (const float*)b1.data;
+        for (size_t i = 0; i < cv1.num_elements && !bad; i++)
+            if (cv1_f[i] != (float)q[i] * cv1.scale) bad = 1;
+        if (bad) { printf("ERROR: dequant cache\n"); ok = 0; }
+    }
+
+    /* 3. 메모리: 예전 풀 (슬롯 10 × 최대 INT8 텐서) vs 캐시 */
+    {
+        size_t max_int8 = 0;
+        for (int32_t i = 0; i < w8.num_tensors; i++)
+            if (w8.tensors[i].dtype == WEIGHTS_DTYPE_INT8 && w8.tensors[i].num_elements > max_int8)
+                max_int8 = w8.tensors[i].num_elements;
+        printf("round-robin pool (old): %u KB | dequant cache: %u KB (SPPF FP32 reference only)\n",
+               (unsigned)(OLD_POOL_SLOTS * max_int8 * sizeof(float) / 1024u), (unsigned)(w8.dequant_bytes / 1024u));
+    }
+
+    /* 4. SPPF 시간: INT8 직접 vs 예전 방식 (호출마다 두 가중치 디양자화 + FP32 SPPF) */
+    {
+        static float tmp1[128 * 256], tmp2[256 * 512];
+        const int8_t* q1 = (const int8_t*)cv1.data;
+        const int8_t* q2 = (const int8_t*)cv2.data;
+        uint64_t t0 = timer_read64();
+        for (int it = 0; it < BENCH_ITER; it++)
+            sppf_nchw_f32(x, 1, 256, 20, 20, cv1.data, cv1.scale, 1, 128, (const float*)b1.data,
+                          cv2.data, cv2.scale, 1, 256, (const float*)b2.data, 5, y_w8);
+        const double ms_w8 = timer_delta64(t0, timer_read64()) / 1000.0 / BENCH_ITER;
+        t0 = timer_read64();
+        for (int it = 0; it < BENCH_ITER; it++) {
+            for (size_t i = 0; i < cv1.num_elements; i++) tmp1[i] = (float)q1[i] * cv1.scale;
+            for (size_t i = 0; i < cv2.num_elements; i++) tmp2[i] = (float)q2[i] * cv2.scale;
+            sppf_nchw_f32(x, 1, 256, 20, 20, tmp1, 0.0f, 0, 128, (const float*)b1.data,
+                          tmp2, 0.0f, 0, 256, (const float*)b2.data, 5, y_f32);
+        }
+        const double ms_old = timer_delta64(t0, timer_read64()) / 1000.0 / BENCH_ITER;
+        printf("\n SPPF (1x256x20x20)      | ms/call\n");
+        printf(" INT8 direct             | %7.3f\n", ms_w8);
+        printf(" dequant per call + FP32 | %7.3f\n", ms_old);
+    }
+    weights_free(&w8);
+    if (w8.tensors || w8.dequant_bytes) { printf("ERROR: weights_free\n"); ok = 0; }
+
+#ifdef USE_WEIGHTS_W8
+    /* 5. W8 컨텍스트 1프레임: 추론 경로 전체가 INT8 직접 → 캐시 0 */
+    {
+        static yolo_ctx_t ctx;
+        static detection_t dets[YOLO_MAX_DETECTIONS];
+        preprocessed_image_t img;
+        int32_t cnt = 0;
+        if (image_load_from_bin("data/input/preprocessed_image.bin", &img) != 0 ||
+            yolo_ctx_init_from_file(&ctx, W8_PATH) != 0) {
+            fprintf(stderr, "Failed to load image / W8 context\n");
+            return 1;
+        }
+        ctx.verbose = 0;
+        if (yolo_infer(&ctx, &img, dets, YOLO_MAX_DETECTIONS, &cnt) != 0 || cnt <= 0 || ctx.weights.dequant_bytes != 0) {
+            printf("ERROR: W8 frame (%d dets, cache %u bytes)\n", (int)cnt, (unsigned)ctx.weights.dequant_bytes);
+            ok = 0;
+        }
+        printf("W8 frame: %d dets, dequant cache %u bytes\n", (int)cnt, (unsigned)ctx.weights.dequant_bytes);
+        yolo_ctx_destroy(&ctx);
+        image_free(&img);
+    }
+#endif
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
@@ -0,0 +1,156 @@
+/* 가중치 바인딩/해시 조회 테스트: 해시 조회 = 선형 탐색 (FP32/W8 전 텐서, "model.model." 별칭, 없는 이름),
+ * 컨텍스트 바인딩이 전 텐서를 이름 조회와 같은 포인터/scale/dtype으로 잡음, 프레임당 조회 비용 (선형 vs 해시 vs 바인딩). */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/blocks/yolov5n.h"
+#include "../csrc/utils/weights_loader.h"
+#include "../csrc/utils/mcycle.h"
+
+#ifdef USE_WEIGHTS_W8
+#define WEIGHTS_PATH "assets/weights_w8.bin"
+#else
+#define WEIGHTS_PATH "assets/weights.bin"
+#endif
+
+#define BENCH_FRAMES 200
+
+/* 인덱스를 뺀 사본 → weights_find_tensor가 선형 탐색 */
+static weights_loader_t linear_view(const weights_loader_t* w) {
+    weights_loader_t v = *w;
+    v.index = NULL;
+    v.index_mask = 0;
+    return v;
+}
+
+/* 텐서 하나짜리 weights.bin 형식 ("model.model.0.conv.bias", FP32 2개) */
+static int alias_blob(uint8_t* buf, size_t cap, size_t* len) {
+    static const char name[] = "model.model.0.conv.bias";
+    const uint32_t num = 1, key_len = (uint32_t)strlen(name), ndim = 1, dim = 2;
+    const float vals[2] = {1.5f, -2.0f};
+    size_t off = 0;
+    if (cap < 64) return -1;
+    memcpy(buf + off, &num, 4); off += 4;
+    memcpy(buf + off, &key_len, 4); off += 4;
+    memcpy(buf + off, name, key_len); off += key_len;
+    memcpy(buf + off, &ndim, 4); off += 4;
+    memcpy(buf + off, &dim, 4); off += 4;
+    off = (off + 3u) & ~(size_t)3u;
+    memcpy(buf + off, vals, sizeof(vals)); off += sizeof(vals);
+    *len = off;
+    return 0;
+}
+
+int main(void) {
+    printf("=== Weights Binding Test ===\n\n");
+    int ok = 1;
+    weights_loader_t fp, w8;
+    static yolo_ctx_t ctx;
+
+    if (weights_load_from_file("assets/weights.bin", &fp) != 0 ||
+        weights_load_from_file_w8("assets/weights_w8.bin", &w8) != 0) {
+        fprintf(stderr, "Failed to load weights\n");
+        return 1;
+    }
+
+    /* 1. 해시 조회 = 선형 탐색 (전 텐서), 없는 이름 NULL */
+    {
+        const weights_loader_t* ws[2] = {&fp, &w8};
+        for (int k = 0; k < 2; k++) {
+            const weights_loader_t* w = ws[k];
+            const weights_loader_t lin = linear_view(w);
+            if (!w->index) { printf("ERROR: no index\n"); ok = 0; }
+            for (int32_t i = 0; i < w->num_tensors; i++) {
+                const char* name = w->tensors[i].name;
+                if (weights_find_tensor(w, name) != &w->tensors[i] || weights_find_tensor(&lin, name) != &w->tensors[i]) {
+                    printf("ERROR: lookup %s\n", name);
+                    ok = 0;
+                }
+            }
+            if (weights_find_tensor(w, "model.99.conv.weight") || weights_find_tensor(w, "") ||
+                weights_find_tensor(&lin, "model.99.conv.weight")) {
+                printf("ERROR: missing name found\n");
+                ok = 0;
+            }
+        }
+        printf("index: FP32 %d tensors / %u slots, W8 %d tensors / %u slots\n", (int)fp.num_tensors,
+               (unsigned)(fp.index_mask + 1u), (int)w8.num_tensors, (unsigned)(w8.index_mask + 1u));
+    }
+
+    /* 2. "model.X" → "model.model.X" 별칭 (해시/선형 같음) */
+    {
+        static uint32_t blob[32];
+        size_t len = 0;
+        weights_loader_t a;
+        if (alias_blob((uint8_t*)blob, sizeof(blob), &len) != 0 ||
+            weights_init_from_memory((uintptr_t)blob, len, &a) != 0) {
+            printf("ERROR: alias blob\n");
+            ok = 0;
+        } else {
+            const weights_loader_t lin = linear_view(&a);
+            const float* b = weights_get_tensor_data(&a, "model.0.conv.bias");
+            if (!b || b[0] != 1.5f || weights_find_tensor(&lin, "model.0.conv.bias") != &a.tensors[0] ||
+                weights_find_tensor(&a, "0.conv.bias")) {
+                printf("ERROR: model.model. alias\n");
+                ok = 0;
+            }
+            weights_free(&a);
+        }
+    }
+
+    /* 3. 컨텍스트 바인딩: 전 텐서, 이름 조회와 같은 (ptr, scale, is_int8) */
+    if (yolo_ctx_init_from_file(&ctx, WEIGHTS_PATH) != 0) {
+        fprintf(stderr, "Failed to init context (%s)\n", WEIGHTS_PATH);
+        return 1;
+    }
+    if (ctx.bound_tensors != ctx.weights.num_tensors) {
+        printf("ERROR: bound %d of %d tensors\n", (int)ctx.bound_tensors, (int)ctx.weights.num_tensors);
+        ok = 0;
+    }
+    {
+        float s;
+        int i8;
+        const yolo_layer_bind_t* l6 = &ctx.bind[6];
+        const void* p = weights_get_tensor_for_conv(&ctx.weights, "model.6.m.2.cv2.conv.weight", &s, &i8);
+        if (l6->n != 3 || l6->m_cv2w[2] != p || l6->m_cv2s[2] != s || l6->m_cv2i[2] != i8 ||
+            l6->m_cv2b[2] != weights_get_tensor_data(&ctx.weights, "model.6.m.2.cv2.conv.bias") ||
+            ctx.bind[24].cv[2].w.data != weights_get_tensor_for_conv(&ctx.weights, "model.24.m.2.weight", &s, &i8) ||
+            ctx.bind[9].cv[1].w.num_elements != (size_t)256 * 512 || ctx.bind[11].cv[0].w.data) {
+            printf("ERROR: binding differs from name lookup\n");
+            ok = 0;
+        }
+    }
+
+    /* 4. 프레임당 가중치 조회 비용: 바인딩된 텐서 전부를 이름으로 (선형 / 해시) vs 바인딩 (조회 없음) */
+    {
+        const weights_loader_t lin = linear_view(&ctx.weights);
+        const int32_t nt = ctx.weights.num_tensors;
+        volatile uintptr_t sink = 0;
+        uint64_t t0 = timer_read64();
+        for (int f = 0; f < BENCH_FRAMES; f++)
+            for (int32_t i = 0; i < nt; i++) sink += (uintptr_t)weights_find_tensor(&lin, ctx.weights.tensors[i].name);
+        const double us_lin = timer_delta64(t0, timer_read64()) / (double)BENCH_FRAMES;
+        t0 = timer_read64();
+        for (int f = 0; f < BENCH_FRAMES; f++)
+            for (int32_t i = 0; i < nt; i++) sink += (uintptr_t)weights_find_tensor(&ctx.weights, ctx.weights.tensors[i].name);
+        const double us_hash = timer_delta64(t0, timer_read64()) / (double)BENCH_FRAMES;
+        (void)sink;
+        printf("\n lookup      | us/frame (%d tensors)\n", (int)nt);
+        printf(" linear      | %8.2f\n", us_lin);
+        printf(" hash        | %8.2f\n", us_hash);
+        printf(" bound       | %8.2f (init only)\n", 0.0);
+    }
+
+    yolo_ctx_destroy(&ctx);
+    weights_free(&fp);
+    weights_free(&w8);
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
@@ -0,0 +1,207 @@
+/* 인덱스 컨테이너(.ymdl) 테스트: 스트림(.bin)과 텐서 동일 (FP32/W8, mmap·COPY·메모리), payload 64B 정렬,
+ * 해시가 파일 안 (생성 없음) + 전 텐서 조회, 컨텍스트 바인딩, 잘못된 헤더 → -1, 스트림 vs 컨테이너 init 시간.
+ * 준비: python tools/pack_weights_container.py  (assets/weights.bin, weights_w8.bin → *.ymdl) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/blocks/yolov5n.h"
+#include "../csrc/utils/weights_loader.h"
+#include "../csrc/utils/weights_container.h"
+#include "../csrc/utils/mcycle.h"
+
+#define FP32_PATH  "assets/weights.bin"
+#define W8_PATH    "assets/weights_w8.bin"
+#define FP32_YMDL  "assets/weights.ymdl"
+#define W8_YMDL    "assets/weights_w8.ymdl"
+#define BENCH_ITER 50
+
+static int same_weights(const weights_loader_t* a, const weights_loader_t* b) {
+    if (a->num_tensors != b->num_tensors || a->num_tensors <= 0) return 0;
+    for (int i = 0; i < a->num_tensors; i++) {
+        const tensor_info_t* x = &a->tensors[i];
+        const tensor_info_t* y = &b->tensors[i];
+        if (strcmp(x->name, y->name) != 0 || x->dtype != y->dtype || x->num_elements != y->num_elements ||
+            x->scale != y->scale || x->ndim != y->ndim || memcmp(x->shape, y->shape, sizeof(x->shape)) != 0)
+            return 0;
+        if (x->dtype == WEIGHTS_DTYPE_INT8 ? memcmp(x->data_int8, y->data_int8, x->num_elements) != 0
+                                           : memcmp(x->data, y->data, x->num_elements * sizeof(float)) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+/* payload가 base 기준 64B 정렬, 해시는 base 안 (컨테이너 파일을 그대로 사용) */
+static int in_place(const weights_loader_t* w, const void* base, size_t size) {
+    const char* lo = (const char*)base;
+    if (!w->container || w->container != base || (const char*)w->index < lo || (const char*)w->index >= lo + size)
+        return 0;
+    for (int i = 0; i < w->num_tensors; i++) {
+        const tensor_info_t* t = &w->tensors[i];
+        const char* p = t->dtype == WEIGHTS_DTYPE_INT8 ? (const char*)t->data_int8 : (const char*)t->data;
+        if (p < lo || p >= lo + size || (size_t)(p - lo) % WEIGHTS_CONTAINER_ALIGN != 0 || t->data_owned ||
+            t->name < lo || t->name >= lo + size)
+            return 0;
+    }
+    return 1;
+}
+
+static uint8_t* read_all(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    const long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t* buf = n > 0 ? (uint8_t*)malloc((size_t)n) : NULL;
+    if (buf && fread(buf, 1, (size_t)n, f) != (size_t)n) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    *size = (size_t)n;
+    return buf;
+}
+
+/* 메모리에 올린 파일에서 init만 반복 (DDR 경로와 같음, 파일 I/O 제외) */
+static double init_us(const uint8_t* buf, size_t size) {
+    weights_loader_t w;
+    const uint64_t t0 = timer_read64();
+    for (int it = 0; it < BENCH_ITER; it++) {
+        if (weights_init_from_memory((uintptr_t)buf, size, &w) != 0) return -1.0;
+        weights_free(&w);
+    }
+    return timer_delta64(t0, timer_read64()) / (double)BENCH_ITER;
+}
+
+int main(void) {
+    printf("=== Weights Container Test ===\n\n");
+    int ok = 1;
+    weights_loader_t bin, bin8, map, map8, copy8;
+
+    if (weights_load_from_file(FP32_PATH, &bin) != 0 || weights_load_from_file_w8(W8_PATH, &bin8) != 0 ||
+        weights_load_from_file(FP32_YMDL, &map) != 0 || weights_load_from_file_w8(W8_YMDL, &map8) != 0 ||
+        weights_load_from_file_w8_ex(W8_YMDL, &copy8, WEIGHTS_LOAD_COPY) != 0) {
+        fprintf(stderr, "Failed to load %s / %s (pack_weights_container.py)\n", FP32_YMDL, W8_YMDL);
+        return 1;
+    }
+
+    /* 1. 컨테이너 = 스트림 (FP32, W8 mmap, W8 COPY), 제자리 참조 + 64B 정렬 */
+    if (!same_weights(&bin, &map) || !same_weights(&bin8, &map8) || !same_weights(&bin8, &copy8)) {
+        printf("ERROR: container tensors differ from stream\n");
+        ok = 0;
+    }
+    if (bin.container || !map.container || copy8.map_base || !copy8.blob || map.layout != WEIGHTS_LAYOUT_OIHW) {
+        printf("ERROR: container / blob flags\n");
+        ok = 0;
+    }
+    if ((map.map_base && !in_place(&map, map.map_base, map.map_size)) ||
+        (map8.map_base && !in_place(&map8, map8.map_base, map8.map_size)) ||
+        !in_place(&copy8, copy8.blob, ((const weights_container_header_t*)copy8.blob)->file_size)) {
+        printf("ERROR: container not used in place / payload not 64B aligned\n");
+        ok = 0;
+    }
+    printf("FP32: %d tensors, %u KB | W8: %d tensors, %u KB (index %u slots in file)\n", (int)map.num_tensors,
+           (unsigned)(map.map_size / 1024u), (int)map8.num_tensors, (unsigned)(map8.map_size / 1024u),
+           (unsigned)(map8.index_mask + 1u));
+
+    /* 2. 파일 안 해시로 전 텐서 조회 + 별칭/없는 이름, INT8 디양자화 캐시 */
+    {
+        const weights_loader_t* ws[2] = {&map, &map8};
+        for (int k = 0; k < 2; k++)
+            for (int32_t i = 0; i < ws[k]->num_tensors; i++)
+                if (weights_find_tensor(ws[k], ws[k]->tensors[i].name) != &ws[k]->tensors[i]) {
+                    printf("ERROR: lookup %s\n", ws[k]->tensors[i].name);
+                    ok = 0;
+                }
+        if (weights_find_tensor(&map, "model.99.conv.weight") || weights_find_tensor(&map8, "")) {
+            printf("ERROR: missing name found\n");
+            ok = 0;
+        }
+        const float* a = weights_get_tensor_data(&bin8, "model.0.conv.weight");
+        const float* b = weights_get_tensor_data(&map8, "model.0.conv.weight");
+        if (!a || !b || memcmp(a, b, 16 * 3 * 6 * 6 * sizeof(float)) != 0) { printf("ERROR: W8 dequant\n"); ok = 0; }
+    }
+
+    /* 3. 컨텍스트: 컨테이너로 init → 전 텐서 바인딩 */
+    {
+        static yolo_ctx_t ctx;
+#ifdef USE_WEIGHTS_W8
+        const char* path = W8_YMDL;
+#else
+        const char* path = FP32_YMDL;
+#endif
+        if (yolo_ctx_init_from_file(&ctx, path) != 0 || !ctx.weights.container ||
+            ctx.bound_tensors != ctx.weights.num_tensors) {
+            printf("ERROR: context from %s\n", path);
+            ok = 0;
+        }
+        yolo_ctx_destroy(&ctx);
+    }
+
+    /* 4. 메모리 init (DDR 경로): 잘못된 헤더/잘린 파일/다른 layout → -1, 비정렬 payload → -1 */
+    {
+        size_t size = 0;
+        uint8_t* buf = read_all(W8_YMDL, &size);
+        uint8_t* bad = buf ? (uint8_t*)malloc(size) : NULL;
+        weights_loader_t w;
+        if (!buf || !bad) {
+            printf("ERROR: read %s\n", W8_YMDL);
+            ok = 0;
+        } else {
+            weights_container_header_t* h = (weights_container_header_t*)bad;
+            weights_container_entry_t* e = (weights_container_entry_t*)(bad + ((weights_container_header_t*)buf)->dir_offset);
+            int rejected = 1;
+            if (weights_init_from_memory((uintptr_t)buf, size, &w) != 0 || !same_weights(&w, &bin8)) {
+                printf("ERROR: init from memory\n");
+                ok = 0;
+            } else {
+                weights_free(&w);
+            }
+            memcpy(bad, buf, size); h->version = 2;
+            rejected &= weights_init_from_memory((uintptr_t)bad, size, &w) == -1;
+            memcpy(bad, buf, size); h->layout = 1;
+            rejected &= weights_init_from_memory((uintptr_t)bad, size, &w) == -1;
+            memcpy(bad, buf, size);
+            rejected &= weights_init_from_memory((uintptr_t)bad, size - 64, &w) == -1;
+            memcpy(bad, buf, size); e[3].data_offset += 4;
+            rejected &= weights_init_from_memory((uintptr_t)bad, size, &w) == -1;
+            memcpy(bad, buf, size); e[5].data_bytes += 1;
+            rejected &= weights_init_from_memory((uintptr_t)bad, size, &w) == -1;
+            if (!rejected) { printf("ERROR: bad container accepted\n"); ok = 0; }
+        }
+        free(bad);
+        free(buf);
+    }
+
+    /* 5. init 시간 (메모리에 올린 파일, 스트림 파싱 + 해시 생성 vs 디렉터리 대입). 호스트의 메모리 init은 FP32 스트림만 */
+    {
+        size_t sb = 0, sc = 0, sc8 = 0;
+        uint8_t* b = read_all(FP32_PATH, &sb);
+        uint8_t* c = read_all(FP32_YMDL, &sc);
+        uint8_t* c8 = read_all(W8_YMDL, &sc8);
+        if (b && c && c8) {
+            printf("\n init (memory)  | us\n");
+            printf(" FP32 stream    | %8.2f\n", init_us(b, sb));
+            printf(" FP32 container | %8.2f\n", init_us(c, sc));
+            printf(" W8 container   | %8.2f\n", init_us(c8, sc8));
+        }
+        free(b);
+        free(c);
+        free(c8);
+    }
+
+    weights_free(&copy8);
+    if (copy8.blob || copy8.container || copy8.tensors) { printf("ERROR: weights_free\n"); ok = 0; }
+    weights_free(&bin);
+    weights_free(&bin8);
+    weights_free(&map);
+    weights_free(&map8);
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
@@ -0,0 +1,202 @@
+/* 가중치 mmap 로드 테스트: COPY(fread+복사) vs MMAP(제자리 파싱) 텐서 동일 (FP32/W8),
+ * 방식별 로드 시간·첫 접근 시간·RSS 증가 (Linux: 자식 프로세스마다 측정), 두 프로세스 매핑 시 PSS 공유. */
+#if defined(__linux__)
+#define _DEFAULT_SOURCE
+#define TEST_PROC 1
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/utils/weights_loader.h"
+#include "../csrc/utils/mcycle.h"
+
+#ifdef TEST_PROC
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#define FP32_PATH "assets/weights.bin"
+#define W8_PATH   "assets/weights_w8.bin"
+
+static int same_weights(const weights_loader_t* a, const weights_loader_t* b) {
+    if (a->num_tensors != b->num_tensors || a->num_tensors <= 0) return 0;
+    for (int i = 0; i < a->num_tensors; i++) {
+        const tensor_info_t* x = &a->tensors[i];
+        const tensor_info_t* y = &b->tensors[i];
+        if (strcmp(x->name, y->name) != 0 || x->dtype != y->dtype || x->num_elements != y->num_elements ||
+            x->scale != y->scale || memcmp(x->shape, y->shape, sizeof(x->shape)) != 0)
+            return 0;
+        if (x->dtype == WEIGHTS_DTYPE_INT8 ? memcmp(x->data_int8, y->data_int8, x->num_elements) != 0
+                                           : memcmp(x->data, y->data, x->num_elements * sizeof(float)) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+/* 텐서가 매핑 안을 가리키는지 (복사 없음) */
+static int in_map(const weights_loader_t* w) {
+    const char* lo = (const char*)w->map_base;
+    for (int i = 0; i < w->num_tensors; i++) {
+        const char* p = w->tensors[i].dtype == WEIGHTS_DTYPE_INT8 ? (const char*)w->tensors[i].data_int8
+                                                                  : (const char*)w->tensors[i].data;
+        if (!lo || p < lo || p >= lo + w->map_size || w->tensors[i].data_owned) return 0;
+    }
+    return 1;
+}
+
+/* 첫 프레임처럼 모든 가중치를 한 번 읽음 (mmap이면 여기서 page fault) */
+static float touch_all(const weights_loader_t* w) {
+    float s = 0.0f;
+    for (int i = 0; i < w->num_tensors; i++) {
+        const tensor_info_t* t = &w->tensors[i];
+        for (size_t j = 0; j < t->num_elements; j += 16)
+            s += t->dtype == WEIGHTS_DTYPE_INT8 ? (float)t->data_int8[j] : t->data[j];
+    }
+    return s;
+}
+
+#ifdef TEST_PROC
+/* /proc/self/status·smaps_rollup의 "key: N kB" (없으면 -1) */
+static long proc_kb(const char* file, const char* key) {
+    char line[256];
+    long v = -1;
+    const size_t n = strlen(key);
+    FILE* f = fopen(file, "r");
+    if (!f) return -1;
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, key, n) == 0 && line[n] == ':') {
+            v = strtol(line + n + 1, NULL, 10);
+            break;
+        }
+    }
+    fclose(f);
+    return v;
+}
+
+/* 자식 프로세스에서 로드 1회: 로드/첫 접근 시간, RssAnon/RssFile 증가 */
+static void measure(const char* label, const char* path, int w8, unsigned flags) {
+    fflush(stdout);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        weights_loader_t w;
+        const long anon0 = proc_kb("/proc/self/status", "RssAnon"), file0 = proc_kb("/proc/self/status", "RssFile");
+        const uint64_t t0 = timer_read64();
+        const int ret = w8 ? weights_load_from_file_w8_ex(path, &w, flags) : weights_load_from_file_ex(path, &w, flags);
+        const uint64_t t_load = timer_delta64(t0, timer_read64());
+        if (ret != 0) _exit(1);
+        const long anon1 = proc_kb("/proc/self/status", "RssAnon"), file1 = proc_kb("/proc/self/status", "RssFile");
+        const uint64_t t1 = timer_read64();
+        volatile float s = touch_all(&w);
+        (void)s;
+        const uint64_t t_touch = timer_delta64(t1, timer_read64());
+        const long anon2 = proc_kb("/proc/self/status", "RssAnon"), file2 = proc_kb("/proc/self/status", "RssFile");
+        printf(" %-14s | %7.2f | %8.2f | %6ld / %6ld | %6ld / %6ld\n", label, t_load / 1000.0, t_touch / 1000.0,
+               anon1 - anon0, file1 - file0, anon2 - anon0, file2 - file0);
+        weights_free(&w);
+        fflush(stdout);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) printf(" %-14s | failed\n", label);
+}
+#endif
+
+int main(void) {
+    printf("=== Weights mmap Test ===\n\n");
+    int ok = 1;
+    weights_loader_t copy, map, copy8, map8;
+
+    /* 1. COPY vs MMAP: 같은 텐서, MMAP은 매핑 안을 제자리 참조 */
+    if (weights_load_from_file_ex(FP32_PATH, &copy, WEIGHTS_LOAD_COPY) != 0 ||
+        weights_load_from_file_ex(FP32_PATH, &map, WEIGHTS_LOAD_MMAP) != 0 ||
+        weights_load_from_file_w8_ex(W8_PATH, &copy8, WEIGHTS_LOAD_COPY) != 0 ||
+        weights_load_from_file_w8_ex(W8_PATH, &map8, WEIGHTS_LOAD_POPULATE | WEIGHTS_LOAD_WILLNEED) != 0) {
+        fprintf(stderr, "Failed to load %s / %s\n", FP32_PATH, W8_PATH);
+        return 1;
+    }
+    if (copy.map_base || !same_weights(&copy, &map) || !same_weights(&copy8, &map8)) {
+        printf("ERROR: mmap tensors differ from copy\n");
+        ok = 0;
+    }
+#ifdef TEST_PROC
+    if (!in_map(&map) || !in_map(&map8)) { printf("ERROR: mmap tensors are not in place\n"); ok = 0; }
+#endif
+    /* INT8 → FP32 조회 (디양자화 풀은 매핑과 별도 버퍼) */
+    {
+        const float* a = weights_get_tensor_data(&copy8, "model.0.conv.weight");
+        const float* b = weights_get_tensor_data(&map8, "model.0.conv.weight");
+        if (!a || !b || memcmp(a, b, 16 * 3 * 6 * 6 * sizeof(float)) != 0) { printf("ERROR: W8 dequant\n"); ok = 0; }
+    }
+    printf("FP32: %d tensors, mapped %u KB | W8: %d tensors, mapped %u KB\n", (int)map.num_tensors,
+           (unsigned)(map.map_size / 1024u), (int)map8.num_tensors, (unsigned)(map8.map_size / 1024u));
+
+    /* 2. 잘못된 경로 → -1, 해제 후 매핑 없음 */
+    {
+        weights_loader_t bad;
+        if (weights_load_from_file_ex("assets/no_such_weights.bin", &bad, WEIGHTS_LOAD_MMAP) != -1) {
+            printf("ERROR: missing file accepted\n");
+            ok = 0;
+        }
+    }
+    weights_free(&map);
+    if (map.map_base || map.tensors) { printf("ERROR: weights_free left mapping\n"); ok = 0; }
+
+#ifdef TEST_PROC
+    /* 3. 방식별 로드 시간 / 첫 접근 / RSS 증가 KB (로드 직후, 첫 접근 후) */
+    printf("\n mode           | load ms | touch ms | anon/file (load) | anon/file (touched)\n");
+    measure("FP32 copy", FP32_PATH, 0, WEIGHTS_LOAD_COPY);
+    measure("FP32 mmap", FP32_PATH, 0, WEIGHTS_LOAD_MMAP);
+    measure("FP32 populate", FP32_PATH, 0, WEIGHTS_LOAD_POPULATE);
+    measure("FP32 willneed", FP32_PATH, 0, WEIGHTS_LOAD_WILLNEED);
+    measure("W8 copy", W8_PATH, 1, WEIGHTS_LOAD_COPY);
+    measure("W8 mmap", W8_PATH, 1, WEIGHTS_LOAD_MMAP);
+
+    /* 4. 두 프로세스가 같은 파일을 매핑: 자식의 PSS(file) 증가 ≈ 파일 크기 / 2 (물리 페이지 1벌 공유) */
+    if (proc_kb("/proc/self/smaps_rollup", "Pss_File") >= 0) {
+        weights_loader_t parent;
+        if (weights_load_from_file_ex(FP32_PATH, &parent, WEIGHTS_LOAD_POPULATE) != 0) {
+            printf("ERROR: parent mmap\n");
+            ok = 0;
+        } else {
+            int fds[2];
+            long delta = -1;
+            if (pipe(fds) == 0) {
+                fflush(stdout);
+                const pid_t pid = fork();
+                if (pid == 0) {
+                    weights_loader_t child;
+                    weights_free(&parent);  /* fork로 물려받은 매핑은 빼고 자기 매핑만 */
+                    const long p0 = proc_kb("/proc/self/smaps_rollup", "Pss_File");
+                    long d = -1;
+                    if (weights_load_from_file_ex(FP32_PATH, &child, WEIGHTS_LOAD_POPULATE) == 0)
+                        d = proc_kb("/proc/self/smaps_rollup", "Pss_File") - p0;
+                    if (write(fds[1], &d, sizeof(d)) != (ssize_t)sizeof(d)) _exit(1);
+                    _exit(0);
+                }
+                if (read(fds[0], &delta, sizeof(delta)) != (ssize_t)sizeof(delta)) delta = -1;
+                waitpid(pid, NULL, 0);
+                close(fds[0]);
+                close(fds[1]);
+            }
+            const long size_kb = (long)(parent.map_size / 1024u);
+            printf("\nshared mapping: 2nd process PSS(file) +%ld KB for %ld KB of weights\n", delta, size_kb);
+            if (delta < 0 || delta > size_kb * 3 / 4) { printf("ERROR: weights not shared\n"); ok = 0; }
+            weights_free(&parent);
+        }
+    }
+#endif
+
+    weights_free(&copy);
+    weights_free(&copy8);
+    weights_free(&map8);
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
@@ -0,0 +1,164 @@
+/* 레이어 스트리밍 테스트: 스트리밍 추론 = 전체 상주 추론 (파일/메모리 원본, 프레임 반복 비트 동일),
+ * 텐서 포인터가 슬롯 안 (그룹 g → 슬롯 g & 1), 상주 바이트 < 전체 payload, 레이어마다 읽기·미리 읽기 횟수,
+ * 스트림 형식(.bin)/잘린 컨테이너/없는 파일 → -1, 겹침(1 - 대기/읽기)·프레임 시간 출력.
+ * 준비: python tools/pack_weights_container.py. 동기 읽기 비교: -DWEIGHTS_STREAM_NO_THREAD로 다시 빌드 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../csrc/blocks/yolov5n.h"
+#include "../csrc/utils/image_loader.h"
+#include "../csrc/utils/weights_stream.h"
+#include "../csrc/utils/mcycle.h"
+
+#ifdef USE_WEIGHTS_W8
+#define BIN_PATH  "assets/weights_w8.bin"
+#define YMDL_PATH "assets/weights_w8.ymdl"
+#else
+#define BIN_PATH  "assets/weights.bin"
+#define YMDL_PATH "assets/weights.ymdl"
+#endif
+#define STREAM_FRAMES 2
+
+typedef struct {
+    detection_t dets[YOLO_MAX_DETECTIONS];
+    int32_t count;
+    int ret;
+} result_t;
+
+static void run(yolo_ctx_t* ctx, const preprocessed_image_t* img, result_t* r) {
+    r->ret = yolo_infer(ctx, img, r->dets, YOLO_MAX_DETECTIONS, &r->count);
+}
+
+static int same_dets(const result_t* a, const result_t* b) {
+    return a->ret == 0 && b->ret == 0 && a->count == b->count &&
+           memcmp(a->dets, b->dets, (size_t)a->count * sizeof(detection_t)) == 0;
+}
+
+static uint8_t* read_all(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    const long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t* buf = n > 0 ? (uint8_t*)malloc((size_t)n) : NULL;
+    if (buf && fread(buf, 1, (size_t)n, f) != (size_t)n) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    *size = (size_t)n;
+    return buf;
+}
+
+/* 모든 payload 포인터가 두 슬롯 영역 (2 × slot_bytes) 안 */
+static int in_slots(const yolo_ctx_t* ctx, const weights_stream_stats_t* st) {
+    const char* lo = NULL;
+    const char* hi = NULL;
+    for (int32_t i = 0; i < ctx->weights.num_tensors; i++) {
+        const tensor_info_t* t = &ctx->weights.tensors[i];
+        const char* p = t->dtype == WEIGHTS_DTYPE_INT8 ? (const char*)t->data_int8 : (const char*)t->data;
+        const size_t n = t->num_elements * (t->dtype == WEIGHTS_DTYPE_INT8 ? 1u : sizeof(float));
+        if (!p || t->data_owned || t->dequant) return 0;
+        if (!lo || p < lo) lo = p;
+        if (!hi || p + n > hi) hi = p + n;
+    }
+    return lo && (size_t)(hi - lo) <= 2u * st->slot_bytes + 64u;
+}
+
+int main(void) {
+    printf("=== Weights Stream Test ===\n\n");
+    int ok = 1;
+    preprocessed_image_t img;
+    static yolo_ctx_t ref_ctx, ctx;
+    static result_t ref, r;
+    weights_stream_stats_t st;
+
+    if (image_load_from_bin("data/input/preprocessed_image.bin", &img) != 0) {
+        fprintf(stderr, "Failed to load image\n");
+        return 1;
+    }
+    if (yolo_ctx_init_from_file(&ref_ctx, BIN_PATH) != 0) {
+        fprintf(stderr, "Failed to init reference context (%s)\n", BIN_PATH);
+        image_free(&img);
+        return 1;
+    }
+    ref_ctx.verbose = 0;
+    run(&ref_ctx, &img, &ref);
+    const uint64_t t_ref = ref_ctx.profile.total;
+    yolo_ctx_destroy(&ref_ctx);
+    if (ref.ret != 0 || ref.count <= 0) { printf("ERROR: reference inference\n"); ok = 0; }
+
+    /* 1. 파일 스트리밍: 프레임마다 전체 상주와 비트 동일, 포인터는 슬롯 안, 레이어마다 1회 읽기 */
+    if (yolo_ctx_init_streaming_file(&ctx, YMDL_PATH) != 0) {
+        fprintf(stderr, "Failed to open stream %s (pack_weights_container.py)\n", YMDL_PATH);
+        image_free(&img);
+        return 1;
+    }
+    ctx.verbose = 0;
+    uint64_t t_stream = 0;
+    for (int f = 0; f < STREAM_FRAMES; f++) {
+        run(&ctx, &img, &r);
+        t_stream += ctx.profile.total;
+        if (!same_dets(&ref, &r)) { printf("ERROR: streamed frame %d differs\n", f); ok = 0; }
+    }
+    weights_stream_get_stats(ctx.stream, &st);
+    if (ctx.bound_tensors != ctx.weights.num_tensors || !in_slots(&ctx, &st)) {
+        printf("ERROR: stream bindings / tensor pointers outside slots\n");
+        ok = 0;
+    }
+    /* init에서 L0 1회 + 프레임마다 그룹 수만큼 (동기 모드는 첫 프레임 L0가 init 때 읽은 그대로 → 1회 적음) */
+    const uint32_t per_run = 1u + (uint32_t)(STREAM_FRAMES * st.groups);
+    if (st.groups <= 1 || st.loads + 1u < per_run || st.loads > per_run || st.resident_bytes >= st.total_bytes ||
+        st.bytes < (uint64_t)(STREAM_FRAMES - 1) * st.total_bytes) {
+        printf("ERROR: stream stats (groups %d, loads %u, resident %u, total %u)\n", (int)st.groups,
+               (unsigned)st.loads, (unsigned)st.resident_bytes, (unsigned)st.total_bytes);
+        ok = 0;
+    }
+    printf("file: %d layers, slot %u KB, resident %u KB of %u KB (%.0f%%), %u loads, %u prefetched\n", (int)st.groups,
+           (unsigned)(st.slot_bytes / 1024u), (unsigned)(st.resident_bytes / 1024u), (unsigned)(st.total_bytes / 1024u),
+           100.0 * st.resident_bytes / st.total_bytes, (unsigned)st.loads, (unsigned)st.hits);
+    printf("\n              | frame ms | read ms | stall ms | overlap\n");
+    printf(" resident     | %8.2f |       - |        - |       -\n", t_ref / 1000.0);
+    printf(" stream file  | %8.2f | %7.2f | %8.2f | %6.0f%%\n", t_stream / 1000.0 / STREAM_FRAMES,
+           st.read_time / 1000.0, st.stall_time / 1000.0, st.overlap * 100.0);
+    yolo_ctx_destroy(&ctx);
+    if (ctx.stream || ctx.weights.tensors) { printf("ERROR: destroy\n"); ok = 0; }
+
+    /* 2. 메모리(플래시 대용) 스트리밍 */
+    {
+        size_t size = 0;
+        uint8_t* buf = read_all(YMDL_PATH, &size);
+        if (!buf || yolo_ctx_init_streaming_memory(&ctx, buf, size) != 0) {
+            printf("ERROR: stream from memory\n");
+            ok = 0;
+        } else {
+            ctx.verbose = 0;
+            run(&ctx, &img, &r);
+            weights_stream_get_stats(ctx.stream, &st);
+            if (!same_dets(&ref, &r)) { printf("ERROR: memory-streamed frame differs\n"); ok = 0; }
+            printf(" stream mem   | %8.2f | %7.2f | %8.2f | %6.0f%%\n", ctx.profile.total / 1000.0,
+                   st.read_time / 1000.0, st.stall_time / 1000.0, st.overlap * 100.0);
+            yolo_ctx_destroy(&ctx);
+
+            /* 3. 잘못된 원본 → -1: 잘린 컨테이너, 스트림 형식, 없는 파일 */
+            int rejected = yolo_ctx_init_streaming_memory(&ctx, buf, size - 64) == -1;
+            rejected &= yolo_ctx_init_streaming_file(&ctx, BIN_PATH) == -1;
+            rejected &= yolo_ctx_init_streaming_file(&ctx, "assets/no_such_file.ymdl") == -1;
+            if (!rejected || ctx.stream) { printf("ERROR: bad stream source accepted\n"); ok = 0; }
+        }
+        free(buf);
+    }
+#ifdef WEIGHTS_STREAM_NO_THREAD
+    printf("\n(sync reads: -DWEIGHTS_STREAM_NO_THREAD, overlap 0)\n");
+#endif
+
+    image_free(&img);
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
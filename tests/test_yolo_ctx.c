@@ -0,0 +1,125 @@
+/* 추론 컨텍스트 테스트: 컨텍스트 2개 공존(교차·스레드 동시 추론) 결과 동일, 풀 분리, 로드 제외 프레임 지연. */
+#include <stdio.h>
+#include <string.h>
+
+#include "../csrc/blocks/yolov5n.h"
+#include "../csrc/utils/image_loader.h"
+#include "../csrc/utils/mcycle.h"
+
+#if defined(__unix__) && !defined(YOLO_SINGLE_THREAD)
+#include <pthread.h>
+#define TEST_THREADS 1
+#endif
+
+#ifdef USE_WEIGHTS_W8
+#define WEIGHTS_PATH "assets/weights_w8.bin"
+#else
+#define WEIGHTS_PATH "assets/weights.bin"
+#endif
+
+typedef struct {
+    yolo_ctx_t* ctx;
+    const preprocessed_image_t* img;
+    detection_t dets[YOLO_MAX_DETECTIONS];
+    int32_t count;
+    int ret;
+} job_t;
+
+static void* run_job(void* arg) {
+    job_t* j = (job_t*)arg;
+    j->ret = yolo_infer(j->ctx, j->img, j->dets, YOLO_MAX_DETECTIONS, &j->count);
+    return NULL;
+}
+
+static int same_dets(const job_t* a, const job_t* b) {
+    return a->ret == 0 && b->ret == 0 && a->count == b->count &&
+           memcmp(a->dets, b->dets, (size_t)a->count * sizeof(detection_t)) == 0;
+}
+
+/* 현재 프레임의 풀 계측: 계획 모드, 실패 없음, 모두 반환 */
+static int pool_ok(yolo_ctx_t* ctx) {
+    feature_pool_t* prev = feature_pool_bind(ctx->pool);
+    feature_pool_stats_t st;
+    feature_pool_get_stats(&st);
+    feature_pool_bind(prev);
+    return ctx->plan_active && st.failed_allocs == 0 && st.num_allocs == ctx->plan.num_tensors &&
+           st.live_bytes == 0;
+}
+
+int main(void) {
+    printf("=== Inference Context Test ===\n\n");
+    int ok = 1;
+    preprocessed_image_t img;
+    static yolo_ctx_t ctx_a, ctx_b;
+    static job_t ref, ja, jb;
+
+    if (image_load_from_bin("data/input/preprocessed_image.bin", &img) != 0) {
+        fprintf(stderr, "Failed to load image\n");
+        return 1;
+    }
+    uint64_t t0 = timer_read64();
+    const int init_a = yolo_ctx_init_from_file(&ctx_a, WEIGHTS_PATH);
+    const uint64_t t_init = timer_delta64(t0, timer_read64());
+    if (init_a != 0 || yolo_ctx_init_from_file(&ctx_b, WEIGHTS_PATH) != 0) {
+        fprintf(stderr, "Failed to init contexts (%s)\n", WEIGHTS_PATH);
+        image_free(&img);
+        return 1;
+    }
+    ctx_a.verbose = ctx_b.verbose = 0;
+    if (!ctx_a.pool || ctx_a.pool == ctx_b.pool) { printf("ERROR: contexts share a pool\n"); ok = 0; }
+
+    /* 1. 잘못된 인자 → -1, 컨텍스트는 그대로 사용 가능 */
+    int32_t cnt = -1;
+    if (yolo_infer(&ctx_a, &img, ref.dets, 0, &cnt) != -1 || yolo_infer(&ctx_a, NULL, ref.dets, 1, &cnt) != -1) {
+        printf("ERROR: bad arguments accepted\n");
+        ok = 0;
+    }
+
+    /* 2. 순차: A → B → A (A 두 번째는 로드 없는 반복 프레임) */
+    ref.ctx = &ctx_a; ref.img = &img;
+    ja.ctx = &ctx_b; ja.img = &img;
+    jb.ctx = &ctx_a; jb.img = &img;
+    run_job(&ref);
+    const uint64_t t_first = ctx_a.profile.total;
+    run_job(&ja);
+    run_job(&jb);
+    const uint64_t t_second = ctx_a.profile.total;
+    if (ref.ret != 0 || ref.count <= 0) { printf("ERROR: reference inference (count=%d)\n", (int)ref.count); ok = 0; }
+    if (!same_dets(&ref, &ja) || !same_dets(&ref, &jb)) { printf("ERROR: sequential contexts differ\n"); ok = 0; }
+    if (!pool_ok(&ctx_a) || !pool_ok(&ctx_b)) { printf("ERROR: pool stats after frame\n"); ok = 0; }
+    printf("sequential A/B/A: %d detections, identical\n", (int)ref.count);
+    printf("init (load+plan) %.2f ms | frame 1 %.2f ms | frame 2 %.2f ms (load excluded)\n",
+           t_init / 1000.0, t_first / 1000.0, t_second / 1000.0);
+
+#ifdef TEST_THREADS
+    /* 3. 스레드 2개에서 A, B 동시 추론 (풀 바인딩·conv 스크래치·시간 기록이 스레드별) */
+    {
+        pthread_t th_a, th_b;
+        memset(ja.dets, 0, sizeof(ja.dets));
+        memset(jb.dets, 0, sizeof(jb.dets));
+        ja.ctx = &ctx_a;
+        jb.ctx = &ctx_b;
+        if (pthread_create(&th_a, NULL, run_job, &ja) != 0 || pthread_create(&th_b, NULL, run_job, &jb) != 0) {
+            printf("ERROR: pthread_create\n");
+            ok = 0;
+        } else {
+            pthread_join(th_a, NULL);
+            pthread_join(th_b, NULL);
+            if (!same_dets(&ref, &ja) || !same_dets(&ref, &jb)) { printf("ERROR: concurrent contexts differ\n"); ok = 0; }
+            else printf("concurrent A||B: identical\n");
+        }
+    }
+#endif
+
+    yolo_ctx_destroy(&ctx_a);
+    yolo_ctx_destroy(&ctx_b);
+    image_free(&img);
+
+    printf("\n");
+    if (ok) {
+        printf("Result: OK\n");
+        return 0;
+    }
+    printf("Result: NG\n");
+    return 1;
+}
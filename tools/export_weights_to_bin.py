@@ -79,6 +79,7 @@ def main() -> int:
     ap.add_argument("--pt", default="assets/yolov5n.pt")
     ap.add_argument("--out", default="assets/weights.bin")
     ap.add_argument("--trust-pickle", action="store_true", help="PyTorch 2.6+ weights_only=False")
+    ap.add_argument("--container", default=None, help="(선택) 인덱스 컨테이너도 출력 (예: assets/weights.ymdl)")
     ap.add_argument(
         "--classic",
         action="store_true",
@@ -179,6 +180,11 @@ def main() -> int:
     
     print(f"Wrote {num_tensors} tensors to {out_path}")
     print(f"File size: {out_path.stat().st_size / (1024*1024):.2f} MB")
+    if args.container:
+        from pack_weights_container import read_stream, write_container
+
+        size = write_container(Path(args.container), read_stream(out_path, w8=False))
+        print(f"Wrote {args.container} ({size / (1024*1024):.2f} MB, indexed container)")
     return 0
 
 
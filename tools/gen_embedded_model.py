@@ -0,0 +1,134 @@
+# -*- coding: utf-8 -*-
+"""
+인덱스 컨테이너(.ymdl) → 링크용 임베디드 모델 (-DYOLO_EMBEDDED_MODEL 빌드)
+
+- yolo_model_blob.S: 텐서별 `.incbin "<container>", offset, bytes` (64B 정렬). 데이터는 컨테이너 파일에서
+  어셈블러가 직접 읽음 (C 배열 리터럴 생성 없음).
+- yolo_model_embedded.c: 정적 초기화된 tensor_info_t 테이블 (이름·shape·scale·payload 포인터) + 이름 해시 +
+  `const weights_loader_t yolo_embedded_weights`. 부팅 시 파싱·heap 없음 (weights_init_embedded = 구조체 대입).
+- 섹션: 기본 `.rodata.yolo_weights`. --hot 정규식에 맞는 텐서는 `.yolo_weights_hot`
+  → 링커 스크립트에서 BRAM 등 빠른 영역에 배치 (docs/VITIS_BUILD.md).
+
+사용:
+  python tools/gen_embedded_model.py --in assets/weights_w8.ymdl
+  python tools/gen_embedded_model.py --in assets/weights_w8.bin --w8 --hot "model\\.(0|1)\\."
+  gcc ... -DYOLO_EMBEDDED_MODEL build/embedded/yolo_model_embedded.c build/embedded/yolo_model_blob.S
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+from pack_weights_container import DTYPE_INT8, MAGIC, read_container, read_stream, write_container
+
+SECTION = ".rodata.yolo_weights"
+SECTION_HOT = ".yolo_weights_hot"
+
+
+def _c_float(v: float) -> str:
+    """정확한 float 리터럴 (C99 16진 부동소수점)"""
+    return "0.0f" if v == 0.0 else float(v).hex() + "f"
+
+
+def write_blob_asm(path: Path, container: Path, entries, hot) -> None:
+    src = container.resolve().as_posix()
+    lines = [
+        "/* 생성: tools/gen_embedded_model.py (직접 수정하지 말 것). 데이터: %s */" % src,
+        "#if defined(__ELF__)",
+        "#define YOLO_SEC(name) .section name, \"a\"",
+        "#else",
+        "#define YOLO_SEC(name) .section name, \"dr\"",
+        "#endif",
+        "",
+    ]
+    for i, e in enumerate(entries):
+        lines += [
+            "    YOLO_SEC(%s)" % (SECTION_HOT if hot[i] else SECTION),
+            "    .balign 64",
+            "    .global yolo_w_%d" % i,
+            "yolo_w_%d:  /* %s */" % (i, e["name"]),
+            '    .incbin "%s", %d, %d' % (src, e["data_offset"], e["data_bytes"]),
+        ]
+    lines += ["", "#if defined(__linux__) && defined(__ELF__)", "    .section .note.GNU-stack, \"\", %progbits", "#endif", ""]
+    path.write_text("\n".join(lines), encoding="utf-8")
+
+
+def write_table_c(path: Path, hdr, entries, index) -> None:
+    n = len(entries)
+    out = [
+        "/* 생성: tools/gen_embedded_model.py (직접 수정하지 말 것). 텐서 %d개, payload는 yolo_model_blob.S */" % n,
+        '#include "utils/weights_loader.h"',
+        "",
+    ]
+    out += ["extern const uint8_t yolo_w_%d[];" % i for i in range(n)]
+    out += ["", "static tensor_info_t s_tensors[%d] = {" % n]
+    for i, e in enumerate(entries):
+        shape = ", ".join(str(d) for d in e["shape"])
+        if e["dtype"] == DTYPE_INT8:
+            data = ".data_int8 = (int8_t*)yolo_w_%d, .scale = %s" % (i, _c_float(e["scale"]))
+        else:
+            data = ".data = (float*)yolo_w_%d" % i
+        out.append('    {.name = (char*)"%s", %s, .dtype = %d, .ndim = %d, .shape = {%s}, .num_elements = %du},'
+                   % (e["name"], data, e["dtype"], len(e["shape"]), shape, e["num_elements"]))
+    out += ["};", "", "/* FNV-1a open addressing (weights_loader.c와 같은 탐색): 텐서 번호 + 1, 0 = 빈 슬롯 */",
+            "static const int32_t s_index[%d] = {" % len(index)]
+    for k in range(0, len(index), 16):
+        out.append("    " + ", ".join(str(v) for v in index[k:k + 16]) + ",")
+    out += [
+        "};",
+        "",
+        "const weights_loader_t yolo_embedded_weights = {",
+        "    .tensors = s_tensors,",
+        "    .num_tensors = %d," % n,
+        "    .index = s_index,",
+        "    .index_mask = %du," % (len(index) - 1),
+        "    .layout = %du," % hdr["layout"],
+        "    .embedded = 1,",
+        "};",
+        "",
+    ]
+    path.write_text("\n".join(out), encoding="utf-8")
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="Generate a linkable embedded model (.incbin + static tensor table)")
+    ap.add_argument("--in", dest="in_path", default="assets/weights_w8.ymdl",
+                    help="컨테이너 .ymdl 또는 스트림 .bin (스트림이면 out-dir에 컨테이너를 만들어 사용)")
+    ap.add_argument("--w8", action="store_true", help="스트림 입력이 weights_w8.bin 형식")
+    ap.add_argument("--out-dir", default="build/embedded", help="생성 파일 위치")
+    ap.add_argument("--hot", default=None, help="빠른 메모리 섹션(.yolo_weights_hot)에 둘 텐서 이름 정규식")
+    args = ap.parse_args()
+
+    in_path = Path(args.in_path)
+    out_dir = Path(args.out_dir)
+    if not in_path.exists():
+        print(f"Error: Not found {in_path}", file=sys.stderr)
+        return 1
+    out_dir.mkdir(parents=True, exist_ok=True)
+    with in_path.open("rb") as f:
+        is_container = f.read(4) == MAGIC
+    container = in_path
+    if not is_container:
+        container = out_dir / "model.ymdl"
+        write_container(container, read_stream(in_path, args.w8))
+
+    hdr, entries, index = read_container(container)
+    hot_re = re.compile(args.hot) if args.hot else None
+    hot = [bool(hot_re and hot_re.search(e["name"])) for e in entries]
+    write_blob_asm(out_dir / "yolo_model_blob.S", container, entries, hot)
+    write_table_c(out_dir / "yolo_model_embedded.c", hdr, entries, index)
+
+    def section_bytes(flag: bool) -> int:
+        return sum((e["data_bytes"] + 63) & ~63 for e, h in zip(entries, hot) if h == flag)
+
+    print(f"Wrote {out_dir / 'yolo_model_blob.S'}, {out_dir / 'yolo_model_embedded.c'} ({len(entries)} tensors from {container})")
+    print(f"  {SECTION}: {section_bytes(False) / 1024:.1f} KB | {SECTION_HOT}: {section_bytes(True) / 1024:.1f} KB "
+          f"({sum(hot)} tensors)")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
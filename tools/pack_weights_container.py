@@ -0,0 +1,197 @@
+# -*- coding: utf-8 -*-
+"""
+weights.bin / weights_w8.bin (순차 스트림) → 인덱스 컨테이너 (.ymdl). C: csrc/utils/weights_container.h
+
+- 고정 헤더 64B → 텐서 디렉터리 (64B 레코드: 이름/dtype/shape/scale/payload 오프셋)
+  → 이름 해시 (FNV-1a, open addressing, C 로더와 같은 탐색) → 이름 문자열 → payload (각 64B 정렬).
+- C 로더는 헤더 확인 후 디렉터리/해시/payload를 제자리 참조 (스트림 파싱·해시 생성 없음).
+- layout: 가중치 배치 버전 (0 = OIHW, PyTorch 그대로). 커널 pre-pack 배치는 새 번호로 추가.
+
+사용:
+  python tools/pack_weights_container.py                       # 두 파일 모두 (assets/*.bin → assets/*.ymdl)
+  python tools/pack_weights_container.py --in assets/weights_w8.bin --w8 --out assets/weights_w8.ymdl
+"""
+
+from __future__ import annotations
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+
+MAGIC = b"YMDL"
+VERSION = 1
+ALIGN = 64
+LAYOUT_OIHW = 0
+MAX_DIMS = 8
+
+DTYPE_FLOAT32 = 0
+DTYPE_INT8 = 1
+
+HEADER_FMT = "<4sHH9I5I"   # 64B
+ENTRY_FMT = "<5IfBBH8iI"   # 64B
+HEADER_SIZE = struct.calcsize(HEADER_FMT)
+ENTRY_SIZE = struct.calcsize(ENTRY_FMT)
+assert HEADER_SIZE == 64 and ENTRY_SIZE == 64
+
+FNV_BASIS = 2166136261
+FNV_PRIME = 16777619
+
+
+def fnv1a(data: bytes) -> int:
+    h = FNV_BASIS
+    for b in data:
+        h ^= b
+        h = (h * FNV_PRIME) & 0xFFFFFFFF
+    return h
+
+
+def _align4(pos: int) -> int:
+    return (pos + 3) & ~3
+
+
+def read_stream(path: Path, w8: bool):
+    """스트림 형식 → [(key, shape, dtype, scale, payload bytes)]. w8: weights_w8.bin (텐서별 dtype 바이트)"""
+    data = path.read_bytes()
+    end = len(data)
+    pos = 0
+    if end < 4:
+        raise ValueError("File too short")
+    (num,) = struct.unpack_from("<I", data, 0)
+    pos = 4
+    tensors = []
+    for i in range(num):
+        if pos + 4 > end:
+            raise ValueError(f"Tensor {i}: truncated key_len")
+        (key_len,) = struct.unpack_from("<I", data, pos)
+        pos += 4
+        if key_len > 1024 or pos + key_len > end:
+            raise ValueError(f"Tensor {i}: invalid key_len")
+        key = data[pos:pos + key_len].decode("utf-8")
+        pos += key_len
+        (ndim,) = struct.unpack_from("<I", data, pos)
+        pos += 4
+        if ndim > MAX_DIMS:
+            raise ValueError(f"Tensor {i} ({key}): ndim {ndim} > {MAX_DIMS}")
+        shape = list(struct.unpack_from("<" + "I" * ndim, data, pos))
+        pos += 4 * ndim
+        n = 1
+        for d in shape:
+            n *= d
+        dtype, scale = DTYPE_FLOAT32, 0.0
+        if w8:
+            dtype = data[pos]
+            pos += 1
+            if dtype == DTYPE_INT8:
+                (scale,) = struct.unpack_from("<f", data, pos)
+                pos += 4
+            elif dtype != DTYPE_FLOAT32:
+                raise ValueError(f"Tensor {i} ({key}): unknown dtype {dtype}")
+        pos = _align4(pos)
+        nbytes = n if dtype == DTYPE_INT8 else 4 * n
+        if pos + nbytes > end:
+            raise ValueError(f"Tensor {i} ({key}): truncated data")
+        tensors.append((key, shape, dtype, scale, bytes(data[pos:pos + nbytes])))
+        pos += nbytes
+    return tensors
+
+
+def write_container(path: Path, tensors, layout: int = LAYOUT_OIHW) -> int:
+    """tensors: [(key, shape, dtype, scale, payload)] → 컨테이너 파일. 반환: 파일 크기"""
+    n = len(tensors)
+    slots = 16
+    while slots < 2 * n:
+        slots <<= 1
+    dir_off = HEADER_SIZE
+    index_off = dir_off + n * ENTRY_SIZE
+    names_off = index_off + 4 * slots
+
+    names = bytearray()
+    name_pos = []
+    hashes = []
+    for key, *_ in tensors:
+        kb = key.encode("utf-8")
+        name_pos.append(names_off + len(names))
+        hashes.append(fnv1a(kb))
+        names += kb + b"\x00"
+
+    data_off = (names_off + len(names) + ALIGN - 1) & ~(ALIGN - 1)
+    payload_pos = []
+    pos = data_off
+    for *_, payload in tensors:
+        payload_pos.append(pos)
+        pos = (pos + len(payload) + ALIGN - 1) & ~(ALIGN - 1)
+    file_size = pos
+
+    # 해시: 텐서 순서대로 삽입 (같은 이름이면 앞 텐서가 먼저 → C 선형 탐색과 같은 결과)
+    index = [0] * slots
+    for i, h in enumerate(hashes):
+        s = h & (slots - 1)
+        while index[s]:
+            s = (s + 1) & (slots - 1)
+        index[s] = i + 1
+
+    out = bytearray(file_size)
+    struct.pack_into(HEADER_FMT, out, 0, MAGIC, VERSION, HEADER_SIZE, n, slots, layout, ENTRY_SIZE,
+                     dir_off, index_off, names_off, data_off, file_size, 0, 0, 0, 0, 0)
+    for i, (key, shape, dtype, scale, payload) in enumerate(tensors):
+        num = len(payload) if dtype == DTYPE_INT8 else len(payload) // 4
+        dims = list(shape) + [0] * (MAX_DIMS - len(shape))
+        struct.pack_into(ENTRY_FMT, out, dir_off + i * ENTRY_SIZE, name_pos[i], hashes[i], payload_pos[i],
+                         len(payload), num, scale, dtype, len(shape), 0, *dims, 0)
+        out[payload_pos[i]:payload_pos[i] + len(payload)] = payload
+    struct.pack_into("<%dI" % slots, out, index_off, *index)
+    out[names_off:names_off + len(names)] = names
+    path.write_bytes(bytes(out))
+    return file_size
+
+
+def read_container(path: Path):
+    """컨테이너 → (header dict, [dict(name, hash, data_offset, data_bytes, num_elements, scale, dtype, shape)], index)"""
+    data = path.read_bytes()
+    if len(data) < HEADER_SIZE or data[:4] != MAGIC:
+        raise ValueError(f"{path}: not a container")
+    f = struct.unpack_from(HEADER_FMT, data, 0)
+    keys = ("magic", "version", "header_size", "num_tensors", "index_slots", "layout", "entry_size",
+            "dir_offset", "index_offset", "names_offset", "data_offset", "file_size")
+    hdr = dict(zip(keys, f[:len(keys)]))
+    if hdr["version"] != VERSION or hdr["entry_size"] != ENTRY_SIZE or hdr["file_size"] > len(data):
+        raise ValueError(f"{path}: unsupported container (version {hdr['version']})")
+    entries = []
+    for i in range(hdr["num_tensors"]):
+        e = struct.unpack_from(ENTRY_FMT, data, hdr["dir_offset"] + i * ENTRY_SIZE)
+        name_end = data.index(b"\x00", e[0])
+        entries.append({
+            "name": data[e[0]:name_end].decode("utf-8"), "hash": e[1], "data_offset": e[2], "data_bytes": e[3],
+            "num_elements": e[4], "scale": e[5], "dtype": e[6], "shape": list(e[9:9 + e[7]]),
+        })
+    index = list(struct.unpack_from("<%dI" % hdr["index_slots"], data, hdr["index_offset"]))
+    return hdr, entries, index
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="Pack weights.bin / weights_w8.bin into an indexed, 64B-aligned container")
+    ap.add_argument("--in", dest="in_path", default=None, help="입력 스트림 (생략: assets/weights.bin, weights_w8.bin 둘 다)")
+    ap.add_argument("--out", default=None, help="출력 .ymdl (생략: 입력 이름의 확장자만 변경)")
+    ap.add_argument("--w8", action="store_true", help="입력이 weights_w8.bin 형식 (텐서별 dtype)")
+    args = ap.parse_args()
+
+    if args.in_path:
+        jobs = [(Path(args.in_path), args.w8, Path(args.out) if args.out else None)]
+    else:
+        jobs = [(Path("assets/weights.bin"), False, None), (Path("assets/weights_w8.bin"), True, None)]
+    for in_path, w8, out_path in jobs:
+        if not in_path.exists():
+            print(f"Error: Not found {in_path}", file=sys.stderr)
+            return 1
+        out_path = out_path or in_path.with_suffix(".ymdl")
+        tensors = read_stream(in_path, w8)
+        size = write_container(out_path, tensors)
+        n8 = sum(1 for t in tensors if t[2] == DTYPE_INT8)
+        print(f"Wrote {out_path}: {len(tensors)} tensors ({n8} INT8), {size / (1024 * 1024):.2f} MB "
+              f"(stream {in_path.stat().st_size / (1024 * 1024):.2f} MB)")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
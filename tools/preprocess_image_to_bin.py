@@ -1,4 +1,7 @@
-"""이미지 전처리 (letterbox + normalize) → C용 .bin 저장."""
+"""이미지 전처리 (letterbox + normalize) → C용 .bin 저장.
+
+--dtype u8: 정규화 없이 uint8 픽셀 그대로 (FP32의 1/4 크기). C는 L0 가중치에 /255를 접어 직접 읽음.
+"""
 
 from __future__ import annotations
 
@@ -8,18 +11,33 @@ import numpy as np
 from PIL import Image
 import struct
 
+# 헤더 size 필드 상위 4비트 (csrc/utils/image_loader.h IMAGE_FMT_*)
+FMT_F32_CHW = 0
+FMT_U8_CHW = 1
+FMT_U8_HWC = 2
+
 
 def main() -> int:
     ap = argparse.ArgumentParser(description="Preprocess image for YOLOv5n inference")
     ap.add_argument("--img", required=True, help="입력 이미지 경로")
     ap.add_argument("--out", required=True, help="출력 .bin 파일 경로")
     ap.add_argument("--size", type=int, default=640, help="이미지 리사이즈 크기")
+    ap.add_argument("--rect", action="store_true",
+                    help="최소 letterbox: 긴 변=size, 짧은 변은 32의 배수로만 패딩 (예: 1280x720 → 640x384)")
+    ap.add_argument("--dtype", choices=("f32", "u8"), default="f32",
+                    help="픽셀 형식: f32 (0..1 정규화) / u8 (0..255, 정규화는 C의 L0에서)")
+    ap.add_argument("--layout", choices=("chw", "hwc"), default="chw",
+                    help="u8 픽셀 배치 (f32는 항상 chw)")
+    ap.add_argument("--ppm", default=None,
+                    help="디코드한 원본 RGB를 PPM(P6)으로도 저장 (C letterbox 입력/비교용, 예: data/input/zidane.ppm)")
     ap.add_argument("--quiet", action="store_true", help="로그 출력 비활성화")
     args = ap.parse_args()
 
     # 이미지 로드 및 전처리
     img = Image.open(args.img).convert('RGB')
     original_w, original_h = img.size
+    if args.ppm:
+        img.save(Path(args.ppm).expanduser().resolve(), format="PPM")
     
     # 리사이즈 (비율 유지)
     scale = min(args.size / original_w, args.size / original_h)
@@ -27,21 +45,35 @@ def main() -> int:
     new_h = int(original_h * scale)
     img_resized = img.resize((new_w, new_h), Image.Resampling.BILINEAR)
     
-    # 패딩 추가 (정사각형으로 만들기)
-    img_padded = Image.new('RGB', (args.size, args.size), (114, 114, 114))
-    paste_x = (args.size - new_w) // 2
-    paste_y = (args.size - new_h) // 2
+    # 패딩 추가 (기본 정사각형, --rect면 각 변을 stride 32의 배수로)
+    if args.rect:
+        pad_w = (new_w + 31) // 32 * 32
+        pad_h = (new_h + 31) // 32 * 32
+    else:
+        pad_w = pad_h = args.size
+    img_padded = Image.new('RGB', (pad_w, pad_h), (114, 114, 114))
+    paste_x = (pad_w - new_w) // 2
+    paste_y = (pad_h - new_h) // 2
     img_padded.paste(img_resized, (paste_x, paste_y))
     
-    # Numpy 배열로 변환 및 정규화
-    img_np = np.array(img_padded, dtype=np.float32) / 255.0
-    img_nchw = img_np.transpose(2, 0, 1)  # (H, W, C) -> (C, H, W) NCHW
+    # Numpy 배열로 변환 (f32: 정규화 + NCHW, u8: 그대로 CHW/HWC)
+    img_hwc = np.array(img_padded, dtype=np.uint8)
+    if args.dtype == "f32":
+        pixels = (img_hwc.astype(np.float32) / 255.0).transpose(2, 0, 1)  # (H, W, C) -> (C, H, W) NCHW
+        fmt = FMT_F32_CHW
+    elif args.layout == "hwc":
+        pixels = img_hwc
+        fmt = FMT_U8_HWC
+    else:
+        pixels = img_hwc.transpose(2, 0, 1)
+        fmt = FMT_U8_CHW
+    pixels = np.ascontiguousarray(pixels)
     
     if not args.quiet:
         print(f"Original size: {original_w}x{original_h}")
         print(f"Resized size: {new_w}x{new_h}")
-        print(f"Padded size: {args.size}x{args.size}")
-        print(f"Image array shape: {img_nchw.shape}")
+        print(f"Padded size: {pad_w}x{pad_h}")
+        print(f"Image array shape: {pixels.shape} {pixels.dtype}")
 
     # .bin 파일로 저장
     out_path = Path(args.out).expanduser().resolve()
@@ -53,10 +85,11 @@ def main() -> int:
         f.write(struct.pack("f", scale))
         f.write(struct.pack("I", paste_x))
         f.write(struct.pack("I", paste_y))
-        f.write(struct.pack("I", args.size))
+        # size: 비트 0-15 W, 16-27 H (정사각형은 0), 28-31 픽셀 형식
+        f.write(struct.pack("I", (fmt << 28) | (0 if pad_w == pad_h else pad_h << 16) | pad_w))
         
-        # 이미지 데이터 (C, H, W) float32
-        f.write(img_nchw.astype(np.float32).tobytes())
+        # 이미지 데이터: float32 (C, H, W) 또는 uint8 (C, H, W) / (H, W, C)
+        f.write(pixels.tobytes())
     
     if not args.quiet:
         file_size_mb = out_path.stat().st_size / (1024 * 1024)
@@ -105,6 +105,7 @@ def main() -> int:
     ap.add_argument("--weights", default="assets/weights.bin", help="입력 weights.bin (FP32)")
     ap.add_argument("--out-weights", default="assets/weights_w8.bin", help="출력 INT8/FP32 혼합 가중치")
     ap.add_argument("--out-scales", default=None, help="(선택) scales.bin 출력. 비우면 scale은 w8 내부에만 포함")
+    ap.add_argument("--container", default=None, help="(선택) 인덱스 컨테이너도 출력 (예: assets/weights_w8.ymdl)")
     ap.add_argument("--quiet", action="store_true", help="요약만 출력")
     args = ap.parse_args()
 
@@ -166,6 +167,11 @@ def main() -> int:
     size_orig = weights_path.stat().st_size
     print(f"Wrote {out_weights_path} ({size_w8 / (1024*1024):.2f} MB, scale per-tensor in w8)")
     print(f"Original weights.bin: {size_orig / (1024*1024):.2f} MB → W8 ~{100*size_w8/size_orig:.0f}%")
+    if args.container:
+        from pack_weights_container import read_stream, write_container
+
+        size = write_container(Path(args.container), read_stream(out_weights_path, w8=True))
+        print(f"Wrote {args.container} ({size / (1024*1024):.2f} MB, indexed container)")
     return 0
 
 
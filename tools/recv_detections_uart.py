@@ -1,58 +1,210 @@
 #!/usr/bin/env python3
-"""UART YOLO 검출 결과 수신 → detections.bin 저장."""
+"""UART/스트림 YOLO 검출 이진 프레임 수신 → detections.bin 저장.
+
+프레임 형식은 csrc/utils/uart_dump.h 참고 (sync A5 5A, len, version, flags, frame_id, time, u16 count,
+레코드(원본 10B 또는 delta/varint), CRC-16/CCITT-FALSE). 로그 텍스트가 섞여도 sync + CRC로 프레임만 골라냄.
+
+  보드:  python tools/recv_detections_uart.py --port COM3
+  호스트: mkfifo /tmp/yolo.fifo; ./main 5 data/input/preprocessed_image.bin - /tmp/yolo.fifo &
+         python tools/recv_detections_uart.py --file /tmp/yolo.fifo --frames 5
+"""
 from __future__ import annotations
 
 import argparse
+import struct
 import sys
 
+SYNC = b"\xA5\x5A"
+VERSION = 1
+FLAG_DELTA = 0x01
+FLAG_KCYCLES = 0x02
+HEAD_BYTES = 16
+CRC_BYTES = 2
+DET_RECORD_SIZE = 12  # detections.bin 레코드: <HHHHBBBB
 
-def main() -> int:
-    ap = argparse.ArgumentParser(description="Receive YOLO detections from UART")
-    ap.add_argument("--port", default=None, help="Serial port (e.g. COM3, /dev/ttyUSB0)")
-    ap.add_argument("--baud", type=int, default=115200, help="Baud rate")
-    ap.add_argument("--out", default="data/output/detections_uart.bin", help="Output .bin path")
-    args = ap.parse_args()
 
-    try:
-        import serial
-    except ImportError:
-        print("pip install pyserial", file=sys.stderr)
-        return 1
+def crc16(data: bytes) -> int:
+    """CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)."""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
 
-    if not args.port:
-        print("--port required (e.g. COM3 or /dev/ttyUSB0)", file=sys.stderr)
-        return 1
 
-    ser = serial.Serial(args.port, args.baud, timeout=2.0)
+def _varint(buf: bytes, pos: int, end: int) -> tuple[int, int]:
+    v = 0
+    for shift in (0, 7, 14):
+        if pos >= end:
+            raise ValueError("truncated varint")
+        b = buf[pos]
+        pos += 1
+        v |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return v, pos
+    raise ValueError("varint too long")
+
+
+def _unzigzag(z: int) -> int:
+    return (z >> 1) ^ -(z & 1)
+
+
+def decode_frame(buf: bytes) -> tuple[int, dict | None]:
+    """buf 시작의 프레임 디코드 (C yolo_frame_decode와 같은 규칙).
+
+    반환 (n, frame): n > 0 소비 바이트와 frame dict, n == 0 데이터 부족, n == -1 프레임 아님(1바이트 건너뜀).
+    frame = {flags, frame_id, time, count, dets: [(x, y, w, h, class_id, confidence), ...]}
+    """
+    if len(buf) < 1:
+        return 0, None
+    if buf[0] != SYNC[0]:
+        return -1, None
+    if len(buf) < 2:
+        return 0, None
+    if buf[1] != SYNC[1]:
+        return -1, None
+    if len(buf) < 4:
+        return 0, None
+    body = struct.unpack_from("<H", buf, 2)[0]
+    if body < HEAD_BYTES - 4:
+        return -1, None
+    total = 4 + body + CRC_BYTES
+    if len(buf) < total:
+        return 0, None
+    if crc16(buf[2 : 4 + body]) != struct.unpack_from("<H", buf, 4 + body)[0]:
+        return -1, None
+    version, flags, frame_id, time, count = struct.unpack_from("<BBIIH", buf, 4)
+    if version != VERSION:
+        return -1, None
+
+    dets = []
+    pos, end = HEAD_BYTES, 4 + body
+    x = y = 0
     try:
-        # "YOLO\n"
-        while True:
-            line = ser.readline().decode("ascii", errors="ignore").strip()
-            if line == "YOLO":
+        for _ in range(count):
+            if flags & FLAG_DELTA:
+                zx, pos = _varint(buf, pos, end)
+                zy, pos = _varint(buf, pos, end)
+                w, pos = _varint(buf, pos, end)
+                h, pos = _varint(buf, pos, end)
+                x += _unzigzag(zx)
+                y += _unzigzag(zy)
+                if not (0 <= x <= 0xFFFF and 0 <= y <= 0xFFFF and w <= 0xFFFF and h <= 0xFFFF):
+                    return -1, None
+            else:
+                if end - pos < 8:
+                    return -1, None
+                x, y, w, h = struct.unpack_from("<HHHH", buf, pos)
+                pos += 8
+            if end - pos < 2:
+                return -1, None
+            dets.append((x, y, w, h, buf[pos], buf[pos + 1]))
+            pos += 2
+    except ValueError:
+        return -1, None
+    if pos != end:
+        return -1, None
+    return total, {"flags": flags, "frame_id": frame_id, "time": time, "count": count, "dets": dets}
+
+
+class FrameReader:
+    """바이트 스트림 → 프레임. 프레임 밖 바이트(로그 텍스트 등)는 skipped로 집계."""
+
+    def __init__(self) -> None:
+        self.buf = bytearray()
+        self.skipped = 0
+
+    def feed(self, data: bytes) -> list[dict]:
+        self.buf += data
+        frames = []
+        while self.buf:
+            i = self.buf.find(SYNC[:1])
+            if i < 0:
+                self.skipped += len(self.buf)
+                self.buf.clear()
                 break
-            if line:
-                print("skip:", line)
+            if i:
+                self.skipped += i
+                del self.buf[:i]
+            n, frame = decode_frame(bytes(self.buf))
+            if n == 0:
+                break
+            if n < 0:
+                self.skipped += 1
+                del self.buf[:1]
+                continue
+            frames.append(frame)
+            del self.buf[:n]
+        return frames
+
 
-        # count (2 hex chars)
-        line = ser.readline().decode("ascii", errors="ignore").strip()
-        count = int(line, 16) if line else 0
+def write_detections_bin(path: str, dets: list) -> int:
+    """detections.bin: 1바이트 개수 (최대 255) + 12바이트 레코드."""
+    count = min(len(dets), 255)
+    with open(path, "wb") as f:
+        f.write(bytes([count]))
+        for x, y, w, h, cls, conf in dets[:count]:
+            f.write(struct.pack("<HHHHBBBB", x, y, w, h, cls, conf, 0, 0))
+    return 1 + count * DET_RECORD_SIZE
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="Receive YOLO detection frames from UART or a pipe/pty/file")
+    src = ap.add_mutually_exclusive_group()
+    src.add_argument("--port", default=None, help="Serial port (e.g. COM3, /dev/ttyUSB0)")
+    src.add_argument("--file", default=None, help="Pipe/pty/capture file written by host ./main (4th arg)")
+    ap.add_argument("--baud", type=int, default=115200, help="Baud rate")
+    ap.add_argument("--frames", type=int, default=1, help="Frames to receive (last one is saved)")
+    ap.add_argument("--timeout", type=float, default=30.0, help="Serial: give up after this many idle seconds")
+    ap.add_argument("--out", default="data/output/detections_uart.bin", help="Output .bin path")
+    args = ap.parse_args()
 
-        # 12*count bytes as hex (one line, no spaces)
-        line = ser.readline().decode("ascii", errors="ignore").strip()
-        if not line or len(line) < 12 * count * 2:
-            print("short payload", file=sys.stderr)
+    if args.file:
+        stream = open(args.file, "rb", buffering=0)
+        read = lambda: stream.read(4096)  # noqa: E731
+    else:
+        try:
+            import serial
+        except ImportError:
+            print("pip install pyserial", file=sys.stderr)
+            return 1
+        if not args.port:
+            print("--port or --file required (e.g. COM3, /dev/ttyUSB0, /tmp/yolo.fifo)", file=sys.stderr)
             return 1
-        raw = bytes.fromhex(line[: 12 * count * 2])
+        stream = serial.Serial(args.port, args.baud, timeout=args.timeout)
+        read = lambda: stream.read(max(1, stream.in_waiting))  # noqa: E731
+
+    reader = FrameReader()
+    last = None
+    received = 0
+    try:
+        while received < args.frames:
+            data = read()
+            if not data:
+                break  # EOF (파이프 닫힘/파일 끝) 또는 시리얼 타임아웃
+            for frame in reader.feed(data):
+                unit = "kcycles" if frame["flags"] & FLAG_KCYCLES else "us"
+                print(
+                    f"frame {frame['frame_id']}: {frame['count']} detections, time {frame['time']} {unit}"
+                    f"{' (delta)' if frame['flags'] & FLAG_DELTA else ''}"
+                )
+                last = frame
+                received += 1
     finally:
-        ser.close()
+        stream.close()
 
-    # detections.bin: 1 byte count + 12*count bytes
-    out_path = args.out
-    with open(out_path, "wb") as f:
-        f.write(bytes([count]))
-        f.write(raw)
-    print(f"Saved {count} detections to {out_path} ({1 + len(raw)} bytes)")
-    return 0
+    if reader.skipped:
+        print(f"skipped {reader.skipped} non-frame bytes")
+    if last is None:
+        print("no valid frame received", file=sys.stderr)
+        return 1
+    if last["count"] > 255:
+        print(f"warning: {last['count']} detections, detections.bin keeps the first 255", file=sys.stderr)
+    size = write_detections_bin(args.out, last["dets"])
+    print(f"Saved {min(last['count'], 255)} detections to {args.out} ({size} bytes)")
+    return 0 if received >= args.frames else 1
 
 
 if __name__ == "__main__":